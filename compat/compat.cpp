@@ -0,0 +1,170 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <windows.h>
+#include <dxgi1_6.h>
+#include <d3d12.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+namespace
+{
+    thread_local DWORD lastError = ERROR_SUCCESS;
+
+    struct Event
+    {
+        std::mutex              mutex;
+        std::condition_variable cond;
+        bool                    manualReset;
+        bool                    signaled;
+    };
+}
+
+HANDLE CreateEventW(SECURITY_ATTRIBUTES* attributes, BOOL manualReset, BOOL initialState, LPCWSTR name)
+{
+    if (attributes != nullptr || name != nullptr)
+    {
+        SetLastError(ERROR_INVALID_PARAMETER);
+        return nullptr;
+    }
+
+    auto event = new Event;
+    event->manualReset = manualReset != FALSE;
+    event->signaled    = initialState != FALSE;
+    return event;
+}
+
+BOOL SetEvent(HANDLE handle)
+{
+    if (handle == nullptr)
+    {
+        SetLastError(ERROR_INVALID_HANDLE);
+        return FALSE;
+    }
+
+    auto event = static_cast<Event*>(handle);
+    {
+        std::lock_guard<std::mutex> lock(event->mutex);
+        event->signaled = true;
+    }
+    if (event->manualReset)
+    {
+        event->cond.notify_all();
+    }
+    else
+    {
+        event->cond.notify_one();
+    }
+    return TRUE;
+}
+
+BOOL ResetEvent(HANDLE handle)
+{
+    if (handle == nullptr)
+    {
+        SetLastError(ERROR_INVALID_HANDLE);
+        return FALSE;
+    }
+
+    auto event = static_cast<Event*>(handle);
+    std::lock_guard<std::mutex> lock(event->mutex);
+    event->signaled = false;
+    return TRUE;
+}
+
+DWORD WaitForSingleObject(HANDLE handle, DWORD milliseconds)
+{
+    if (handle == nullptr)
+    {
+        SetLastError(ERROR_INVALID_HANDLE);
+        return WAIT_FAILED;
+    }
+
+    auto event = static_cast<Event*>(handle);
+    std::unique_lock<std::mutex> lock(event->mutex);
+    auto signaled = [event] () { return event->signaled; };
+    if (milliseconds == INFINITE)
+    {
+        event->cond.wait(lock, signaled);
+    }
+    else if (!event->cond.wait_for(lock, std::chrono::milliseconds(milliseconds), signaled))
+    {
+        return WAIT_TIMEOUT;
+    }
+
+    // an auto reset event releases one waiter
+    if (!event->manualReset)
+    {
+        event->signaled = false;
+    }
+    return WAIT_OBJECT_0;
+}
+
+BOOL CloseHandle(HANDLE handle)
+{
+    if (handle == nullptr)
+    {
+        SetLastError(ERROR_INVALID_HANDLE);
+        return FALSE;
+    }
+
+    delete static_cast<Event*>(handle);
+    return TRUE;
+}
+
+DWORD GetLastError()
+{
+    return lastError;
+}
+
+void SetLastError(DWORD error)
+{
+    lastError = error;
+}
+
+HRESULT WINAPI CreateDXGIFactory2(UINT, REFIID, void** ppFactory)
+{
+    if (ppFactory != nullptr)
+    {
+        *ppFactory = nullptr;
+    }
+    return DXGI_ERROR_UNSUPPORTED;
+}
+
+HRESULT WINAPI D3D12CreateDevice(IUnknown*, D3D_FEATURE_LEVEL, REFIID, void** ppDevice)
+{
+    if (ppDevice != nullptr)
+    {
+        *ppDevice = nullptr;
+    }
+    return DXGI_ERROR_UNSUPPORTED;
+}
+
+HRESULT WINAPI D3D12GetDebugInterface(REFIID, void** ppvDebug)
+{
+    if (ppvDebug != nullptr)
+    {
+        *ppvDebug = nullptr;
+    }
+    return DXGI_ERROR_UNSUPPORTED;
+}
@@ -0,0 +1,790 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_COMPAT_D3D12_H_
+#define _D12W_COMPAT_D3D12_H_
+
+#include "unknwn.h"
+#include "d3dcommon.h"
+#include "dxgicommon.h"
+#include "dxgiformat.h"
+
+#define D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT  ( 256 )
+#define D3D12_DEFAULT_MSAA_RESOURCE_PLACEMENT_ALIGNMENT ( 4194304 )
+#define D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT      ( 65536 )
+#define D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT        ( 4096 )
+#define D3D12_TEXTURE_DATA_PITCH_ALIGNMENT              ( 256 )
+#define D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT          ( 512 )
+#define D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES         ( 0xffffffff )
+
+typedef UINT64 D3D12_GPU_VIRTUAL_ADDRESS;
+typedef RECT D3D12_RECT;
+typedef D3D_PRIMITIVE_TOPOLOGY D3D12_PRIMITIVE_TOPOLOGY;
+
+typedef enum D3D12_COMMAND_LIST_TYPE
+{
+    D3D12_COMMAND_LIST_TYPE_DIRECT        = 0,
+    D3D12_COMMAND_LIST_TYPE_BUNDLE        = 1,
+    D3D12_COMMAND_LIST_TYPE_COMPUTE       = 2,
+    D3D12_COMMAND_LIST_TYPE_COPY          = 3,
+    D3D12_COMMAND_LIST_TYPE_VIDEO_DECODE  = 4,
+    D3D12_COMMAND_LIST_TYPE_VIDEO_PROCESS = 5,
+    D3D12_COMMAND_LIST_TYPE_VIDEO_ENCODE  = 6
+} D3D12_COMMAND_LIST_TYPE;
+
+typedef enum D3D12_COMMAND_QUEUE_FLAGS
+{
+    D3D12_COMMAND_QUEUE_FLAG_NONE                = 0,
+    D3D12_COMMAND_QUEUE_FLAG_DISABLE_GPU_TIMEOUT = 0x1
+} D3D12_COMMAND_QUEUE_FLAGS;
+DEFINE_ENUM_FLAG_OPERATORS(D3D12_COMMAND_QUEUE_FLAGS)
+
+typedef enum D3D12_COMMAND_QUEUE_PRIORITY
+{
+    D3D12_COMMAND_QUEUE_PRIORITY_NORMAL          = 0,
+    D3D12_COMMAND_QUEUE_PRIORITY_HIGH            = 100,
+    D3D12_COMMAND_QUEUE_PRIORITY_GLOBAL_REALTIME = 10000
+} D3D12_COMMAND_QUEUE_PRIORITY;
+
+typedef struct D3D12_COMMAND_QUEUE_DESC
+{
+    D3D12_COMMAND_LIST_TYPE   Type;
+    INT                       Priority;
+    D3D12_COMMAND_QUEUE_FLAGS Flags;
+    UINT                      NodeMask;
+} D3D12_COMMAND_QUEUE_DESC;
+
+typedef enum D3D12_DESCRIPTOR_HEAP_TYPE
+{
+    D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV = 0,
+    D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER     = 1,
+    D3D12_DESCRIPTOR_HEAP_TYPE_RTV         = 2,
+    D3D12_DESCRIPTOR_HEAP_TYPE_DSV         = 3,
+    D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES   = 4
+} D3D12_DESCRIPTOR_HEAP_TYPE;
+
+typedef enum D3D12_DESCRIPTOR_HEAP_FLAGS
+{
+    D3D12_DESCRIPTOR_HEAP_FLAG_NONE           = 0,
+    D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE = 0x1
+} D3D12_DESCRIPTOR_HEAP_FLAGS;
+DEFINE_ENUM_FLAG_OPERATORS(D3D12_DESCRIPTOR_HEAP_FLAGS)
+
+typedef struct D3D12_DESCRIPTOR_HEAP_DESC
+{
+    D3D12_DESCRIPTOR_HEAP_TYPE  Type;
+    UINT                        NumDescriptors;
+    D3D12_DESCRIPTOR_HEAP_FLAGS Flags;
+    UINT                        NodeMask;
+} D3D12_DESCRIPTOR_HEAP_DESC;
+
+typedef struct D3D12_CPU_DESCRIPTOR_HANDLE
+{
+    SIZE_T ptr;
+} D3D12_CPU_DESCRIPTOR_HANDLE;
+
+typedef struct D3D12_GPU_DESCRIPTOR_HANDLE
+{
+    UINT64 ptr;
+} D3D12_GPU_DESCRIPTOR_HANDLE;
+
+typedef enum D3D12_HEAP_TYPE
+{
+    D3D12_HEAP_TYPE_DEFAULT  = 1,
+    D3D12_HEAP_TYPE_UPLOAD   = 2,
+    D3D12_HEAP_TYPE_READBACK = 3,
+    D3D12_HEAP_TYPE_CUSTOM   = 4
+} D3D12_HEAP_TYPE;
+
+typedef enum D3D12_CPU_PAGE_PROPERTY
+{
+    D3D12_CPU_PAGE_PROPERTY_UNKNOWN       = 0,
+    D3D12_CPU_PAGE_PROPERTY_NOT_AVAILABLE = 1,
+    D3D12_CPU_PAGE_PROPERTY_WRITE_COMBINE = 2,
+    D3D12_CPU_PAGE_PROPERTY_WRITE_BACK    = 3
+} D3D12_CPU_PAGE_PROPERTY;
+
+typedef enum D3D12_MEMORY_POOL
+{
+    D3D12_MEMORY_POOL_UNKNOWN = 0,
+    D3D12_MEMORY_POOL_L0      = 1,
+    D3D12_MEMORY_POOL_L1      = 2
+} D3D12_MEMORY_POOL;
+
+typedef struct D3D12_HEAP_PROPERTIES
+{
+    D3D12_HEAP_TYPE         Type;
+    D3D12_CPU_PAGE_PROPERTY CPUPageProperty;
+    D3D12_MEMORY_POOL       MemoryPoolPreference;
+    UINT                    CreationNodeMask;
+    UINT                    VisibleNodeMask;
+} D3D12_HEAP_PROPERTIES;
+
+typedef enum D3D12_HEAP_FLAGS
+{
+    D3D12_HEAP_FLAG_NONE                           = 0,
+    D3D12_HEAP_FLAG_SHARED                         = 0x1,
+    D3D12_HEAP_FLAG_DENY_BUFFERS                   = 0x4,
+    D3D12_HEAP_FLAG_ALLOW_DISPLAY                  = 0x8,
+    D3D12_HEAP_FLAG_SHARED_CROSS_ADAPTER           = 0x20,
+    D3D12_HEAP_FLAG_DENY_RT_DS_TEXTURES            = 0x40,
+    D3D12_HEAP_FLAG_DENY_NON_RT_DS_TEXTURES        = 0x80,
+    D3D12_HEAP_FLAG_HARDWARE_PROTECTED             = 0x100,
+    D3D12_HEAP_FLAG_ALLOW_WRITE_WATCH              = 0x200,
+    D3D12_HEAP_FLAG_ALLOW_SHADER_ATOMICS           = 0x400,
+    D3D12_HEAP_FLAG_ALLOW_ALL_BUFFERS_AND_TEXTURES = 0,
+    D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS             = 0xc0,
+    D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES  = 0x44,
+    D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES      = 0x84
+} D3D12_HEAP_FLAGS;
+DEFINE_ENUM_FLAG_OPERATORS(D3D12_HEAP_FLAGS)
+
+typedef struct D3D12_HEAP_DESC
+{
+    UINT64                SizeInBytes;
+    D3D12_HEAP_PROPERTIES Properties;
+    UINT64                Alignment;
+    D3D12_HEAP_FLAGS      Flags;
+} D3D12_HEAP_DESC;
+
+typedef enum D3D12_RESOURCE_DIMENSION
+{
+    D3D12_RESOURCE_DIMENSION_UNKNOWN   = 0,
+    D3D12_RESOURCE_DIMENSION_BUFFER    = 1,
+    D3D12_RESOURCE_DIMENSION_TEXTURE1D = 2,
+    D3D12_RESOURCE_DIMENSION_TEXTURE2D = 3,
+    D3D12_RESOURCE_DIMENSION_TEXTURE3D = 4
+} D3D12_RESOURCE_DIMENSION;
+
+typedef enum D3D12_TEXTURE_LAYOUT
+{
+    D3D12_TEXTURE_LAYOUT_UNKNOWN                = 0,
+    D3D12_TEXTURE_LAYOUT_ROW_MAJOR              = 1,
+    D3D12_TEXTURE_LAYOUT_64KB_UNDEFINED_SWIZZLE = 2,
+    D3D12_TEXTURE_LAYOUT_64KB_STANDARD_SWIZZLE  = 3
+} D3D12_TEXTURE_LAYOUT;
+
+typedef enum D3D12_RESOURCE_FLAGS
+{
+    D3D12_RESOURCE_FLAG_NONE                      = 0,
+    D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET       = 0x1,
+    D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL       = 0x2,
+    D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS    = 0x4,
+    D3D12_RESOURCE_FLAG_DENY_SHADER_RESOURCE      = 0x8,
+    D3D12_RESOURCE_FLAG_ALLOW_CROSS_ADAPTER       = 0x10,
+    D3D12_RESOURCE_FLAG_ALLOW_SIMULTANEOUS_ACCESS = 0x20
+} D3D12_RESOURCE_FLAGS;
+DEFINE_ENUM_FLAG_OPERATORS(D3D12_RESOURCE_FLAGS)
+
+typedef struct D3D12_RESOURCE_DESC
+{
+    D3D12_RESOURCE_DIMENSION Dimension;
+    UINT64                   Alignment;
+    UINT64                   Width;
+    UINT                     Height;
+    UINT16                   DepthOrArraySize;
+    UINT16                   MipLevels;
+    DXGI_FORMAT              Format;
+    DXGI_SAMPLE_DESC         SampleDesc;
+    D3D12_TEXTURE_LAYOUT     Layout;
+    D3D12_RESOURCE_FLAGS     Flags;
+} D3D12_RESOURCE_DESC;
+
+typedef struct D3D12_RESOURCE_ALLOCATION_INFO
+{
+    UINT64 SizeInBytes;
+    UINT64 Alignment;
+} D3D12_RESOURCE_ALLOCATION_INFO;
+
+typedef enum D3D12_RESOURCE_STATES
+{
+    D3D12_RESOURCE_STATE_COMMON                     = 0,
+    D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER = 0x1,
+    D3D12_RESOURCE_STATE_INDEX_BUFFER               = 0x2,
+    D3D12_RESOURCE_STATE_RENDER_TARGET              = 0x4,
+    D3D12_RESOURCE_STATE_UNORDERED_ACCESS           = 0x8,
+    D3D12_RESOURCE_STATE_DEPTH_WRITE                = 0x10,
+    D3D12_RESOURCE_STATE_DEPTH_READ                 = 0x20,
+    D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE  = 0x40,
+    D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE      = 0x80,
+    D3D12_RESOURCE_STATE_STREAM_OUT                 = 0x100,
+    D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT          = 0x200,
+    D3D12_RESOURCE_STATE_COPY_DEST                  = 0x400,
+    D3D12_RESOURCE_STATE_COPY_SOURCE                = 0x800,
+    D3D12_RESOURCE_STATE_RESOLVE_DEST               = 0x1000,
+    D3D12_RESOURCE_STATE_RESOLVE_SOURCE             = 0x2000,
+    D3D12_RESOURCE_STATE_GENERIC_READ               = 0xac3,
+    D3D12_RESOURCE_STATE_PRESENT                    = 0,
+    D3D12_RESOURCE_STATE_PREDICATION                = 0x200
+} D3D12_RESOURCE_STATES;
+DEFINE_ENUM_FLAG_OPERATORS(D3D12_RESOURCE_STATES)
+
+typedef enum D3D12_RESOURCE_BARRIER_TYPE
+{
+    D3D12_RESOURCE_BARRIER_TYPE_TRANSITION = 0,
+    D3D12_RESOURCE_BARRIER_TYPE_ALIASING   = 1,
+    D3D12_RESOURCE_BARRIER_TYPE_UAV        = 2
+} D3D12_RESOURCE_BARRIER_TYPE;
+
+typedef enum D3D12_RESOURCE_BARRIER_FLAGS
+{
+    D3D12_RESOURCE_BARRIER_FLAG_NONE       = 0,
+    D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY = 0x1,
+    D3D12_RESOURCE_BARRIER_FLAG_END_ONLY   = 0x2
+} D3D12_RESOURCE_BARRIER_FLAGS;
+DEFINE_ENUM_FLAG_OPERATORS(D3D12_RESOURCE_BARRIER_FLAGS)
+
+struct ID3D12Resource;
+
+typedef struct D3D12_RESOURCE_TRANSITION_BARRIER
+{
+    ID3D12Resource*       pResource;
+    UINT                  Subresource;
+    D3D12_RESOURCE_STATES StateBefore;
+    D3D12_RESOURCE_STATES StateAfter;
+} D3D12_RESOURCE_TRANSITION_BARRIER;
+
+typedef struct D3D12_RESOURCE_ALIASING_BARRIER
+{
+    ID3D12Resource* pResourceBefore;
+    ID3D12Resource* pResourceAfter;
+} D3D12_RESOURCE_ALIASING_BARRIER;
+
+typedef struct D3D12_RESOURCE_UAV_BARRIER
+{
+    ID3D12Resource* pResource;
+} D3D12_RESOURCE_UAV_BARRIER;
+
+typedef struct D3D12_RESOURCE_BARRIER
+{
+    D3D12_RESOURCE_BARRIER_TYPE  Type;
+    D3D12_RESOURCE_BARRIER_FLAGS Flags;
+    union
+    {
+        D3D12_RESOURCE_TRANSITION_BARRIER Transition;
+        D3D12_RESOURCE_ALIASING_BARRIER   Aliasing;
+        D3D12_RESOURCE_UAV_BARRIER        UAV;
+    };
+} D3D12_RESOURCE_BARRIER;
+
+typedef struct D3D12_RANGE
+{
+    SIZE_T Begin;
+    SIZE_T End;
+} D3D12_RANGE;
+
+typedef struct D3D12_BOX
+{
+    UINT left;
+    UINT top;
+    UINT front;
+    UINT right;
+    UINT bottom;
+    UINT back;
+} D3D12_BOX;
+
+typedef struct D3D12_DEPTH_STENCIL_VALUE
+{
+    FLOAT Depth;
+    UINT8 Stencil;
+} D3D12_DEPTH_STENCIL_VALUE;
+
+typedef struct D3D12_CLEAR_VALUE
+{
+    DXGI_FORMAT Format;
+    union
+    {
+        FLOAT                     Color[4];
+        D3D12_DEPTH_STENCIL_VALUE DepthStencil;
+    };
+} D3D12_CLEAR_VALUE;
+
+typedef enum D3D12_FENCE_FLAGS
+{
+    D3D12_FENCE_FLAG_NONE                 = 0,
+    D3D12_FENCE_FLAG_SHARED               = 0x1,
+    D3D12_FENCE_FLAG_SHARED_CROSS_ADAPTER = 0x2,
+    D3D12_FENCE_FLAG_NON_MONITORED        = 0x4
+} D3D12_FENCE_FLAGS;
+DEFINE_ENUM_FLAG_OPERATORS(D3D12_FENCE_FLAGS)
+
+typedef enum D3D12_FEATURE
+{
+    D3D12_FEATURE_D3D12_OPTIONS  = 0,
+    D3D12_FEATURE_ARCHITECTURE   = 1,
+    D3D12_FEATURE_FEATURE_LEVELS = 2
+} D3D12_FEATURE;
+
+typedef enum D3D12_SHADER_MIN_PRECISION_SUPPORT
+{
+    D3D12_SHADER_MIN_PRECISION_SUPPORT_NONE   = 0,
+    D3D12_SHADER_MIN_PRECISION_SUPPORT_10_BIT = 0x1,
+    D3D12_SHADER_MIN_PRECISION_SUPPORT_16_BIT = 0x2
+} D3D12_SHADER_MIN_PRECISION_SUPPORT;
+DEFINE_ENUM_FLAG_OPERATORS(D3D12_SHADER_MIN_PRECISION_SUPPORT)
+
+typedef enum D3D12_TILED_RESOURCES_TIER
+{
+    D3D12_TILED_RESOURCES_TIER_NOT_SUPPORTED = 0,
+    D3D12_TILED_RESOURCES_TIER_1             = 1,
+    D3D12_TILED_RESOURCES_TIER_2             = 2,
+    D3D12_TILED_RESOURCES_TIER_3             = 3
+} D3D12_TILED_RESOURCES_TIER;
+
+typedef enum D3D12_RESOURCE_BINDING_TIER
+{
+    D3D12_RESOURCE_BINDING_TIER_1 = 1,
+    D3D12_RESOURCE_BINDING_TIER_2 = 2,
+    D3D12_RESOURCE_BINDING_TIER_3 = 3
+} D3D12_RESOURCE_BINDING_TIER;
+
+typedef enum D3D12_CONSERVATIVE_RASTERIZATION_TIER
+{
+    D3D12_CONSERVATIVE_RASTERIZATION_TIER_NOT_SUPPORTED = 0,
+    D3D12_CONSERVATIVE_RASTERIZATION_TIER_1             = 1,
+    D3D12_CONSERVATIVE_RASTERIZATION_TIER_2             = 2,
+    D3D12_CONSERVATIVE_RASTERIZATION_TIER_3             = 3
+} D3D12_CONSERVATIVE_RASTERIZATION_TIER;
+
+typedef enum D3D12_CROSS_NODE_SHARING_TIER
+{
+    D3D12_CROSS_NODE_SHARING_TIER_NOT_SUPPORTED = 0,
+    D3D12_CROSS_NODE_SHARING_TIER_1_EMULATED    = 1,
+    D3D12_CROSS_NODE_SHARING_TIER_1             = 2,
+    D3D12_CROSS_NODE_SHARING_TIER_2             = 3
+} D3D12_CROSS_NODE_SHARING_TIER;
+
+typedef enum D3D12_RESOURCE_HEAP_TIER
+{
+    D3D12_RESOURCE_HEAP_TIER_1 = 1,
+    D3D12_RESOURCE_HEAP_TIER_2 = 2
+} D3D12_RESOURCE_HEAP_TIER;
+
+typedef struct D3D12_FEATURE_DATA_D3D12_OPTIONS
+{
+    BOOL                                  DoublePrecisionFloatShaderOps;
+    BOOL                                  OutputMergerLogicOp;
+    D3D12_SHADER_MIN_PRECISION_SUPPORT    MinPrecisionSupport;
+    D3D12_TILED_RESOURCES_TIER            TiledResourcesTier;
+    D3D12_RESOURCE_BINDING_TIER           ResourceBindingTier;
+    BOOL                                  PSSpecifiedStencilRefSupported;
+    BOOL                                  TypedUAVLoadAdditionalFormats;
+    BOOL                                  ROVsSupported;
+    D3D12_CONSERVATIVE_RASTERIZATION_TIER ConservativeRasterizationTier;
+    UINT                                  MaxGPUVirtualAddressBitsPerResource;
+    BOOL                                  StandardSwizzle64KBSupported;
+    D3D12_CROSS_NODE_SHARING_TIER         CrossNodeSharingTier;
+    BOOL                                  CrossAdapterRowMajorTextureSupported;
+    BOOL                                  VPAndRTArrayIndexFromAnyShaderFeedingRasterizerSupportedWithoutGSEmulation;
+    D3D12_RESOURCE_HEAP_TIER              ResourceHeapTier;
+} D3D12_FEATURE_DATA_D3D12_OPTIONS;
+
+typedef struct D3D12_FEATURE_DATA_FEATURE_LEVELS
+{
+    UINT                     NumFeatureLevels;
+    const D3D_FEATURE_LEVEL* pFeatureLevelsRequested;
+    D3D_FEATURE_LEVEL        MaxSupportedFeatureLevel;
+} D3D12_FEATURE_DATA_FEATURE_LEVELS;
+
+typedef struct D3D12_SUBRESOURCE_FOOTPRINT
+{
+    DXGI_FORMAT Format;
+    UINT        Width;
+    UINT        Height;
+    UINT        Depth;
+    UINT        RowPitch;
+} D3D12_SUBRESOURCE_FOOTPRINT;
+
+typedef struct D3D12_PLACED_SUBRESOURCE_FOOTPRINT
+{
+    UINT64                      Offset;
+    D3D12_SUBRESOURCE_FOOTPRINT Footprint;
+} D3D12_PLACED_SUBRESOURCE_FOOTPRINT;
+
+typedef enum D3D12_TEXTURE_COPY_TYPE
+{
+    D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX = 0,
+    D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT  = 1
+} D3D12_TEXTURE_COPY_TYPE;
+
+typedef struct D3D12_TEXTURE_COPY_LOCATION
+{
+    ID3D12Resource*         pResource;
+    D3D12_TEXTURE_COPY_TYPE Type;
+    union
+    {
+        D3D12_PLACED_SUBRESOURCE_FOOTPRINT PlacedFootprint;
+        UINT                               SubresourceIndex;
+    };
+} D3D12_TEXTURE_COPY_LOCATION;
+
+typedef struct D3D12_VIEWPORT
+{
+    FLOAT TopLeftX;
+    FLOAT TopLeftY;
+    FLOAT Width;
+    FLOAT Height;
+    FLOAT MinDepth;
+    FLOAT MaxDepth;
+} D3D12_VIEWPORT;
+
+typedef struct D3D12_CONSTANT_BUFFER_VIEW_DESC
+{
+    D3D12_GPU_VIRTUAL_ADDRESS BufferLocation;
+    UINT                      SizeInBytes;
+} D3D12_CONSTANT_BUFFER_VIEW_DESC;
+
+typedef struct D3D12_INDEX_BUFFER_VIEW
+{
+    D3D12_GPU_VIRTUAL_ADDRESS BufferLocation;
+    UINT                      SizeInBytes;
+    DXGI_FORMAT               Format;
+} D3D12_INDEX_BUFFER_VIEW;
+
+typedef struct D3D12_VERTEX_BUFFER_VIEW
+{
+    D3D12_GPU_VIRTUAL_ADDRESS BufferLocation;
+    UINT                      SizeInBytes;
+    UINT                      StrideInBytes;
+} D3D12_VERTEX_BUFFER_VIEW;
+
+typedef enum D3D12_CLEAR_FLAGS
+{
+    D3D12_CLEAR_FLAG_DEPTH   = 0x1,
+    D3D12_CLEAR_FLAG_STENCIL = 0x2
+} D3D12_CLEAR_FLAGS;
+DEFINE_ENUM_FLAG_OPERATORS(D3D12_CLEAR_FLAGS)
+
+typedef enum D3D12_QUERY_TYPE
+{
+    D3D12_QUERY_TYPE_OCCLUSION        = 0,
+    D3D12_QUERY_TYPE_BINARY_OCCLUSION = 1,
+    D3D12_QUERY_TYPE_TIMESTAMP        = 2
+} D3D12_QUERY_TYPE;
+
+typedef enum D3D12_PREDICATION_OP
+{
+    D3D12_PREDICATION_OP_EQUAL_ZERO     = 0,
+    D3D12_PREDICATION_OP_NOT_EQUAL_ZERO = 1
+} D3D12_PREDICATION_OP;
+
+typedef enum D3D12_TILE_COPY_FLAGS
+{
+    D3D12_TILE_COPY_FLAG_NONE = 0
+} D3D12_TILE_COPY_FLAGS;
+DEFINE_ENUM_FLAG_OPERATORS(D3D12_TILE_COPY_FLAGS)
+
+typedef enum D3D12_TILE_MAPPING_FLAGS
+{
+    D3D12_TILE_MAPPING_FLAG_NONE = 0
+} D3D12_TILE_MAPPING_FLAGS;
+DEFINE_ENUM_FLAG_OPERATORS(D3D12_TILE_MAPPING_FLAGS)
+
+typedef enum D3D12_TILE_RANGE_FLAGS
+{
+    D3D12_TILE_RANGE_FLAG_NONE = 0
+} D3D12_TILE_RANGE_FLAGS;
+DEFINE_ENUM_FLAG_OPERATORS(D3D12_TILE_RANGE_FLAGS)
+
+typedef enum D3D12_MULTIPLE_FENCE_WAIT_FLAGS
+{
+    D3D12_MULTIPLE_FENCE_WAIT_FLAG_NONE = 0,
+    D3D12_MULTIPLE_FENCE_WAIT_FLAG_ANY  = 0x1,
+    D3D12_MULTIPLE_FENCE_WAIT_FLAG_ALL  = 0
+} D3D12_MULTIPLE_FENCE_WAIT_FLAGS;
+DEFINE_ENUM_FLAG_OPERATORS(D3D12_MULTIPLE_FENCE_WAIT_FLAGS)
+
+typedef enum D3D12_RESIDENCY_PRIORITY
+{
+    D3D12_RESIDENCY_PRIORITY_MINIMUM = 0x28000000,
+    D3D12_RESIDENCY_PRIORITY_LOW     = 0x50000000,
+    D3D12_RESIDENCY_PRIORITY_NORMAL  = 0x78000000,
+    D3D12_RESIDENCY_PRIORITY_HIGH    = static_cast<int>(0xa0010000),
+    D3D12_RESIDENCY_PRIORITY_MAXIMUM = static_cast<int>(0xc8000000)
+} D3D12_RESIDENCY_PRIORITY;
+
+typedef enum D3D12_FILTER
+{
+    D3D12_FILTER_MIN_MAG_MIP_POINT  = 0,
+    D3D12_FILTER_MIN_MAG_MIP_LINEAR = 0x15,
+    D3D12_FILTER_ANISOTROPIC        = 0x55
+} D3D12_FILTER;
+
+typedef enum D3D12_TEXTURE_ADDRESS_MODE
+{
+    D3D12_TEXTURE_ADDRESS_MODE_WRAP   = 1,
+    D3D12_TEXTURE_ADDRESS_MODE_MIRROR = 2,
+    D3D12_TEXTURE_ADDRESS_MODE_CLAMP  = 3,
+    D3D12_TEXTURE_ADDRESS_MODE_BORDER = 4
+} D3D12_TEXTURE_ADDRESS_MODE;
+
+typedef enum D3D12_COMPARISON_FUNC
+{
+    D3D12_COMPARISON_FUNC_NEVER  = 1,
+    D3D12_COMPARISON_FUNC_LESS   = 2,
+    D3D12_COMPARISON_FUNC_EQUAL  = 3,
+    D3D12_COMPARISON_FUNC_ALWAYS = 8
+} D3D12_COMPARISON_FUNC;
+
+typedef struct D3D12_SAMPLER_DESC
+{
+    D3D12_FILTER               Filter;
+    D3D12_TEXTURE_ADDRESS_MODE AddressU;
+    D3D12_TEXTURE_ADDRESS_MODE AddressV;
+    D3D12_TEXTURE_ADDRESS_MODE AddressW;
+    FLOAT                      MipLODBias;
+    UINT                       MaxAnisotropy;
+    D3D12_COMPARISON_FUNC      ComparisonFunc;
+    FLOAT                      BorderColor[4];
+    FLOAT                      MinLOD;
+    FLOAT                      MaxLOD;
+} D3D12_SAMPLER_DESC;
+
+typedef struct D3D12_PACKED_MIP_INFO
+{
+    UINT8 NumStandardMips;
+    UINT8 NumPackedMips;
+    UINT  NumTilesForPackedMips;
+    UINT  StartTileIndexInOverallResource;
+} D3D12_PACKED_MIP_INFO;
+
+typedef struct D3D12_TILE_SHAPE
+{
+    UINT WidthInTexels;
+    UINT HeightInTexels;
+    UINT DepthInTexels;
+} D3D12_TILE_SHAPE;
+
+// only passed by pointer on this side
+typedef struct D3D12_GRAPHICS_PIPELINE_STATE_DESC D3D12_GRAPHICS_PIPELINE_STATE_DESC;
+typedef struct D3D12_COMPUTE_PIPELINE_STATE_DESC D3D12_COMPUTE_PIPELINE_STATE_DESC;
+typedef struct D3D12_PIPELINE_STATE_STREAM_DESC D3D12_PIPELINE_STATE_STREAM_DESC;
+typedef struct D3D12_COMMAND_SIGNATURE_DESC D3D12_COMMAND_SIGNATURE_DESC;
+typedef struct D3D12_QUERY_HEAP_DESC D3D12_QUERY_HEAP_DESC;
+typedef struct D3D12_SHADER_RESOURCE_VIEW_DESC D3D12_SHADER_RESOURCE_VIEW_DESC;
+typedef struct D3D12_UNORDERED_ACCESS_VIEW_DESC D3D12_UNORDERED_ACCESS_VIEW_DESC;
+typedef struct D3D12_RENDER_TARGET_VIEW_DESC D3D12_RENDER_TARGET_VIEW_DESC;
+typedef struct D3D12_DEPTH_STENCIL_VIEW_DESC D3D12_DEPTH_STENCIL_VIEW_DESC;
+typedef struct D3D12_STREAM_OUTPUT_BUFFER_VIEW D3D12_STREAM_OUTPUT_BUFFER_VIEW;
+typedef struct D3D12_DISCARD_REGION D3D12_DISCARD_REGION;
+typedef struct D3D12_TILED_RESOURCE_COORDINATE D3D12_TILED_RESOURCE_COORDINATE;
+typedef struct D3D12_TILE_REGION_SIZE D3D12_TILE_REGION_SIZE;
+typedef struct D3D12_SUBRESOURCE_TILING D3D12_SUBRESOURCE_TILING;
+
+D12W_COMPAT_INTERFACE(ID3D12Object, IUnknown)
+{
+    virtual HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID guid, UINT* pDataSize, void* pData) = 0;
+    virtual HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID guid, UINT DataSize, const void* pData) = 0;
+    virtual HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID guid, const IUnknown* pData) = 0;
+    virtual HRESULT STDMETHODCALLTYPE SetName(LPCWSTR Name) = 0;
+};
+
+D12W_COMPAT_INTERFACE(ID3D12DeviceChild, ID3D12Object)
+{
+    virtual HRESULT STDMETHODCALLTYPE GetDevice(REFIID riid, void** ppvDevice) = 0;
+};
+
+D12W_COMPAT_INTERFACE(ID3D12Pageable, ID3D12DeviceChild) {};
+
+// root signatures, pipeline states, query heaps and command signatures are opaque on this side
+D12W_COMPAT_INTERFACE(ID3D12RootSignature, ID3D12DeviceChild) {};
+D12W_COMPAT_INTERFACE(ID3D12PipelineState, ID3D12Pageable) {};
+D12W_COMPAT_INTERFACE(ID3D12QueryHeap, ID3D12Pageable) {};
+D12W_COMPAT_INTERFACE(ID3D12CommandSignature, ID3D12Pageable) {};
+
+D12W_COMPAT_INTERFACE(ID3D12Heap, ID3D12Pageable)
+{
+    virtual D3D12_HEAP_DESC STDMETHODCALLTYPE GetDesc() = 0;
+};
+
+D12W_COMPAT_INTERFACE(ID3D12Resource, ID3D12Pageable)
+{
+    virtual HRESULT STDMETHODCALLTYPE Map(UINT Subresource, const D3D12_RANGE* pReadRange, void** ppData) = 0;
+    virtual void STDMETHODCALLTYPE Unmap(UINT Subresource, const D3D12_RANGE* pWrittenRange) = 0;
+    virtual D3D12_RESOURCE_DESC STDMETHODCALLTYPE GetDesc() = 0;
+    virtual D3D12_GPU_VIRTUAL_ADDRESS STDMETHODCALLTYPE GetGPUVirtualAddress() = 0;
+    virtual HRESULT STDMETHODCALLTYPE WriteToSubresource(UINT DstSubresource, const D3D12_BOX* pDstBox, const void* pSrcData, UINT SrcRowPitch, UINT SrcDepthPitch) = 0;
+    virtual HRESULT STDMETHODCALLTYPE ReadFromSubresource(void* pDstData, UINT DstRowPitch, UINT DstDepthPitch, UINT SrcSubresource, const D3D12_BOX* pSrcBox) = 0;
+    virtual HRESULT STDMETHODCALLTYPE GetHeapProperties(D3D12_HEAP_PROPERTIES* pHeapProperties, D3D12_HEAP_FLAGS* pHeapFlags) = 0;
+};
+
+D12W_COMPAT_INTERFACE(ID3D12CommandAllocator, ID3D12Pageable)
+{
+    virtual HRESULT STDMETHODCALLTYPE Reset() = 0;
+};
+
+D12W_COMPAT_INTERFACE(ID3D12Fence, ID3D12Pageable)
+{
+    virtual UINT64 STDMETHODCALLTYPE GetCompletedValue() = 0;
+    virtual HRESULT STDMETHODCALLTYPE SetEventOnCompletion(UINT64 Value, HANDLE hEvent) = 0;
+    virtual HRESULT STDMETHODCALLTYPE Signal(UINT64 Value) = 0;
+};
+
+D12W_COMPAT_INTERFACE(ID3D12Fence1, ID3D12Fence)
+{
+    virtual D3D12_FENCE_FLAGS STDMETHODCALLTYPE GetCreationFlags() = 0;
+};
+
+D12W_COMPAT_INTERFACE(ID3D12DescriptorHeap, ID3D12Pageable)
+{
+    virtual D3D12_DESCRIPTOR_HEAP_DESC STDMETHODCALLTYPE GetDesc() = 0;
+    virtual D3D12_CPU_DESCRIPTOR_HANDLE STDMETHODCALLTYPE GetCPUDescriptorHandleForHeapStart() = 0;
+    virtual D3D12_GPU_DESCRIPTOR_HANDLE STDMETHODCALLTYPE GetGPUDescriptorHandleForHeapStart() = 0;
+};
+
+D12W_COMPAT_INTERFACE(ID3D12CommandList, ID3D12DeviceChild)
+{
+    virtual D3D12_COMMAND_LIST_TYPE STDMETHODCALLTYPE GetType() = 0;
+};
+
+D12W_COMPAT_INTERFACE(ID3D12GraphicsCommandList, ID3D12CommandList)
+{
+    virtual HRESULT STDMETHODCALLTYPE Close() = 0;
+    virtual HRESULT STDMETHODCALLTYPE Reset(ID3D12CommandAllocator* pAllocator, ID3D12PipelineState* pInitialState) = 0;
+    virtual void STDMETHODCALLTYPE ClearState(ID3D12PipelineState* pPipelineState) = 0;
+    virtual void STDMETHODCALLTYPE DrawInstanced(UINT VertexCountPerInstance, UINT InstanceCount, UINT StartVertexLocation, UINT StartInstanceLocation) = 0;
+    virtual void STDMETHODCALLTYPE DrawIndexedInstanced(UINT IndexCountPerInstance, UINT InstanceCount, UINT StartIndexLocation, INT BaseVertexLocation, UINT StartInstanceLocation) = 0;
+    virtual void STDMETHODCALLTYPE Dispatch(UINT ThreadGroupCountX, UINT ThreadGroupCountY, UINT ThreadGroupCountZ) = 0;
+    virtual void STDMETHODCALLTYPE CopyBufferRegion(ID3D12Resource* pDstBuffer, UINT64 DstOffset, ID3D12Resource* pSrcBuffer, UINT64 SrcOffset, UINT64 NumBytes) = 0;
+    virtual void STDMETHODCALLTYPE CopyTextureRegion(const D3D12_TEXTURE_COPY_LOCATION* pDst, UINT DstX, UINT DstY, UINT DstZ, const D3D12_TEXTURE_COPY_LOCATION* pSrc, const D3D12_BOX* pSrcBox) = 0;
+    virtual void STDMETHODCALLTYPE CopyResource(ID3D12Resource* pDstResource, ID3D12Resource* pSrcResource) = 0;
+    virtual void STDMETHODCALLTYPE CopyTiles(ID3D12Resource* pTiledResource, const D3D12_TILED_RESOURCE_COORDINATE* pTileRegionStartCoordinate, const D3D12_TILE_REGION_SIZE* pTileRegionSize, ID3D12Resource* pBuffer, UINT64 BufferStartOffsetInBytes, D3D12_TILE_COPY_FLAGS Flags) = 0;
+    virtual void STDMETHODCALLTYPE ResolveSubresource(ID3D12Resource* pDstResource, UINT DstSubresource, ID3D12Resource* pSrcResource, UINT SrcSubresource, DXGI_FORMAT Format) = 0;
+    virtual void STDMETHODCALLTYPE IASetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY PrimitiveTopology) = 0;
+    virtual void STDMETHODCALLTYPE RSSetViewports(UINT NumViewports, const D3D12_VIEWPORT* pViewports) = 0;
+    virtual void STDMETHODCALLTYPE RSSetScissorRects(UINT NumRects, const D3D12_RECT* pRects) = 0;
+    virtual void STDMETHODCALLTYPE OMSetBlendFactor(const FLOAT BlendFactor[4]) = 0;
+    virtual void STDMETHODCALLTYPE OMSetStencilRef(UINT StencilRef) = 0;
+    virtual void STDMETHODCALLTYPE SetPipelineState(ID3D12PipelineState* pPipelineState) = 0;
+    virtual void STDMETHODCALLTYPE ResourceBarrier(UINT NumBarriers, const D3D12_RESOURCE_BARRIER* pBarriers) = 0;
+    virtual void STDMETHODCALLTYPE ExecuteBundle(ID3D12GraphicsCommandList* pCommandList) = 0;
+    virtual void STDMETHODCALLTYPE SetDescriptorHeaps(UINT NumDescriptorHeaps, ID3D12DescriptorHeap* const* ppDescriptorHeaps) = 0;
+    virtual void STDMETHODCALLTYPE SetComputeRootSignature(ID3D12RootSignature* pRootSignature) = 0;
+    virtual void STDMETHODCALLTYPE SetGraphicsRootSignature(ID3D12RootSignature* pRootSignature) = 0;
+    virtual void STDMETHODCALLTYPE SetComputeRootDescriptorTable(UINT RootParameterIndex, D3D12_GPU_DESCRIPTOR_HANDLE BaseDescriptor) = 0;
+    virtual void STDMETHODCALLTYPE SetGraphicsRootDescriptorTable(UINT RootParameterIndex, D3D12_GPU_DESCRIPTOR_HANDLE BaseDescriptor) = 0;
+    virtual void STDMETHODCALLTYPE SetComputeRoot32BitConstant(UINT RootParameterIndex, UINT SrcData, UINT DestOffsetIn32BitValues) = 0;
+    virtual void STDMETHODCALLTYPE SetGraphicsRoot32BitConstant(UINT RootParameterIndex, UINT SrcData, UINT DestOffsetIn32BitValues) = 0;
+    virtual void STDMETHODCALLTYPE SetComputeRoot32BitConstants(UINT RootParameterIndex, UINT Num32BitValuesToSet, const void* pSrcData, UINT DestOffsetIn32BitValues) = 0;
+    virtual void STDMETHODCALLTYPE SetGraphicsRoot32BitConstants(UINT RootParameterIndex, UINT Num32BitValuesToSet, const void* pSrcData, UINT DestOffsetIn32BitValues) = 0;
+    virtual void STDMETHODCALLTYPE SetComputeRootConstantBufferView(UINT RootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS BufferLocation) = 0;
+    virtual void STDMETHODCALLTYPE SetGraphicsRootConstantBufferView(UINT RootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS BufferLocation) = 0;
+    virtual void STDMETHODCALLTYPE SetComputeRootShaderResourceView(UINT RootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS BufferLocation) = 0;
+    virtual void STDMETHODCALLTYPE SetGraphicsRootShaderResourceView(UINT RootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS BufferLocation) = 0;
+    virtual void STDMETHODCALLTYPE SetComputeRootUnorderedAccessView(UINT RootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS BufferLocation) = 0;
+    virtual void STDMETHODCALLTYPE SetGraphicsRootUnorderedAccessView(UINT RootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS BufferLocation) = 0;
+    virtual void STDMETHODCALLTYPE IASetIndexBuffer(const D3D12_INDEX_BUFFER_VIEW* pView) = 0;
+    virtual void STDMETHODCALLTYPE IASetVertexBuffers(UINT StartSlot, UINT NumViews, const D3D12_VERTEX_BUFFER_VIEW* pViews) = 0;
+    virtual void STDMETHODCALLTYPE SOSetTargets(UINT StartSlot, UINT NumViews, const D3D12_STREAM_OUTPUT_BUFFER_VIEW* pViews) = 0;
+    virtual void STDMETHODCALLTYPE OMSetRenderTargets(UINT NumRenderTargetDescriptors, const D3D12_CPU_DESCRIPTOR_HANDLE* pRenderTargetDescriptors, BOOL RTsSingleHandleToDescriptorRange, const D3D12_CPU_DESCRIPTOR_HANDLE* pDepthStencilDescriptor) = 0;
+    virtual void STDMETHODCALLTYPE ClearDepthStencilView(D3D12_CPU_DESCRIPTOR_HANDLE DepthStencilView, D3D12_CLEAR_FLAGS ClearFlags, FLOAT Depth, UINT8 Stencil, UINT NumRects, const D3D12_RECT* pRects) = 0;
+    virtual void STDMETHODCALLTYPE ClearRenderTargetView(D3D12_CPU_DESCRIPTOR_HANDLE RenderTargetView, const FLOAT ColorRGBA[4], UINT NumRects, const D3D12_RECT* pRects) = 0;
+    virtual void STDMETHODCALLTYPE ClearUnorderedAccessViewUint(D3D12_GPU_DESCRIPTOR_HANDLE ViewGPUHandleInCurrentHeap, D3D12_CPU_DESCRIPTOR_HANDLE ViewCPUHandle, ID3D12Resource* pResource, const UINT Values[4], UINT NumRects, const D3D12_RECT* pRects) = 0;
+    virtual void STDMETHODCALLTYPE ClearUnorderedAccessViewFloat(D3D12_GPU_DESCRIPTOR_HANDLE ViewGPUHandleInCurrentHeap, D3D12_CPU_DESCRIPTOR_HANDLE ViewCPUHandle, ID3D12Resource* pResource, const FLOAT Values[4], UINT NumRects, const D3D12_RECT* pRects) = 0;
+    virtual void STDMETHODCALLTYPE DiscardResource(ID3D12Resource* pResource, const D3D12_DISCARD_REGION* pRegion) = 0;
+    virtual void STDMETHODCALLTYPE BeginQuery(ID3D12QueryHeap* pQueryHeap, D3D12_QUERY_TYPE Type, UINT Index) = 0;
+    virtual void STDMETHODCALLTYPE EndQuery(ID3D12QueryHeap* pQueryHeap, D3D12_QUERY_TYPE Type, UINT Index) = 0;
+    virtual void STDMETHODCALLTYPE ResolveQueryData(ID3D12QueryHeap* pQueryHeap, D3D12_QUERY_TYPE Type, UINT StartIndex, UINT NumQueries, ID3D12Resource* pDestinationBuffer, UINT64 AlignedDestinationBufferOffset) = 0;
+    virtual void STDMETHODCALLTYPE SetPredication(ID3D12Resource* pBuffer, UINT64 AlignedBufferOffset, D3D12_PREDICATION_OP Operation) = 0;
+    virtual void STDMETHODCALLTYPE SetMarker(UINT Metadata, const void* pData, UINT Size) = 0;
+    virtual void STDMETHODCALLTYPE BeginEvent(UINT Metadata, const void* pData, UINT Size) = 0;
+    virtual void STDMETHODCALLTYPE EndEvent() = 0;
+    virtual void STDMETHODCALLTYPE ExecuteIndirect(ID3D12CommandSignature* pCommandSignature, UINT MaxCommandCount, ID3D12Resource* pArgumentBuffer, UINT64 ArgumentBufferOffset, ID3D12Resource* pCountBuffer, UINT64 CountBufferOffset) = 0;
+};
+
+D12W_COMPAT_INTERFACE(ID3D12CommandQueue, ID3D12Pageable)
+{
+    virtual void STDMETHODCALLTYPE UpdateTileMappings(ID3D12Resource* pResource, UINT NumResourceRegions, const D3D12_TILED_RESOURCE_COORDINATE* pResourceRegionStartCoordinates, const D3D12_TILE_REGION_SIZE* pResourceRegionSizes, ID3D12Heap* pHeap, UINT NumRanges, const D3D12_TILE_RANGE_FLAGS* pRangeFlags, const UINT* pHeapRangeStartOffsets, const UINT* pRangeTileCounts, D3D12_TILE_MAPPING_FLAGS Flags) = 0;
+    virtual void STDMETHODCALLTYPE CopyTileMappings(ID3D12Resource* pDstResource, const D3D12_TILED_RESOURCE_COORDINATE* pDstRegionStartCoordinate, ID3D12Resource* pSrcResource, const D3D12_TILED_RESOURCE_COORDINATE* pSrcRegionStartCoordinate, const D3D12_TILE_REGION_SIZE* pRegionSize, D3D12_TILE_MAPPING_FLAGS Flags) = 0;
+    virtual void STDMETHODCALLTYPE ExecuteCommandLists(UINT NumCommandLists, ID3D12CommandList* const* ppCommandLists) = 0;
+    virtual void STDMETHODCALLTYPE SetMarker(UINT Metadata, const void* pData, UINT Size) = 0;
+    virtual void STDMETHODCALLTYPE BeginEvent(UINT Metadata, const void* pData, UINT Size) = 0;
+    virtual void STDMETHODCALLTYPE EndEvent() = 0;
+    virtual HRESULT STDMETHODCALLTYPE Signal(ID3D12Fence* pFence, UINT64 Value) = 0;
+    virtual HRESULT STDMETHODCALLTYPE Wait(ID3D12Fence* pFence, UINT64 Value) = 0;
+    virtual HRESULT STDMETHODCALLTYPE GetTimestampFrequency(UINT64* pFrequency) = 0;
+    virtual HRESULT STDMETHODCALLTYPE GetClockCalibration(UINT64* pGpuTimestamp, UINT64* pCpuTimestamp) = 0;
+    virtual D3D12_COMMAND_QUEUE_DESC STDMETHODCALLTYPE GetDesc() = 0;
+};
+
+D12W_COMPAT_INTERFACE(ID3D12Device, ID3D12Object)
+{
+    virtual UINT STDMETHODCALLTYPE GetNodeCount() = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateCommandQueue(const D3D12_COMMAND_QUEUE_DESC* pDesc, REFIID riid, void** ppCommandQueue) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE type, REFIID riid, void** ppCommandAllocator) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateGraphicsPipelineState(const D3D12_GRAPHICS_PIPELINE_STATE_DESC* pDesc, REFIID riid, void** ppPipelineState) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateComputePipelineState(const D3D12_COMPUTE_PIPELINE_STATE_DESC* pDesc, REFIID riid, void** ppPipelineState) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateCommandList(UINT nodeMask, D3D12_COMMAND_LIST_TYPE type, ID3D12CommandAllocator* pCommandAllocator, ID3D12PipelineState* pInitialState, REFIID riid, void** ppCommandList) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CheckFeatureSupport(D3D12_FEATURE Feature, void* pFeatureSupportData, UINT FeatureSupportDataSize) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateDescriptorHeap(const D3D12_DESCRIPTOR_HEAP_DESC* pDescriptorHeapDesc, REFIID riid, void** ppvHeap) = 0;
+    virtual UINT STDMETHODCALLTYPE GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE DescriptorHeapType) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateRootSignature(UINT nodeMask, const void* pBlobWithRootSignature, SIZE_T blobLengthInBytes, REFIID riid, void** ppvRootSignature) = 0;
+    virtual void STDMETHODCALLTYPE CreateConstantBufferView(const D3D12_CONSTANT_BUFFER_VIEW_DESC* pDesc, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor) = 0;
+    virtual void STDMETHODCALLTYPE CreateShaderResourceView(ID3D12Resource* pResource, const D3D12_SHADER_RESOURCE_VIEW_DESC* pDesc, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor) = 0;
+    virtual void STDMETHODCALLTYPE CreateUnorderedAccessView(ID3D12Resource* pResource, ID3D12Resource* pCounterResource, const D3D12_UNORDERED_ACCESS_VIEW_DESC* pDesc, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor) = 0;
+    virtual void STDMETHODCALLTYPE CreateRenderTargetView(ID3D12Resource* pResource, const D3D12_RENDER_TARGET_VIEW_DESC* pDesc, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor) = 0;
+    virtual void STDMETHODCALLTYPE CreateDepthStencilView(ID3D12Resource* pResource, const D3D12_DEPTH_STENCIL_VIEW_DESC* pDesc, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor) = 0;
+    virtual void STDMETHODCALLTYPE CreateSampler(const D3D12_SAMPLER_DESC* pDesc, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor) = 0;
+    virtual void STDMETHODCALLTYPE CopyDescriptors(UINT NumDestDescriptorRanges, const D3D12_CPU_DESCRIPTOR_HANDLE* pDestDescriptorRangeStarts, const UINT* pDestDescriptorRangeSizes, UINT NumSrcDescriptorRanges, const D3D12_CPU_DESCRIPTOR_HANDLE* pSrcDescriptorRangeStarts, const UINT* pSrcDescriptorRangeSizes, D3D12_DESCRIPTOR_HEAP_TYPE DescriptorHeapsType) = 0;
+    virtual void STDMETHODCALLTYPE CopyDescriptorsSimple(UINT NumDescriptors, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptorRangeStart, D3D12_CPU_DESCRIPTOR_HANDLE SrcDescriptorRangeStart, D3D12_DESCRIPTOR_HEAP_TYPE DescriptorHeapsType) = 0;
+    virtual D3D12_RESOURCE_ALLOCATION_INFO STDMETHODCALLTYPE GetResourceAllocationInfo(UINT visibleMask, UINT numResourceDescs, const D3D12_RESOURCE_DESC* pResourceDescs) = 0;
+    virtual D3D12_HEAP_PROPERTIES STDMETHODCALLTYPE GetCustomHeapProperties(UINT nodeMask, D3D12_HEAP_TYPE heapType) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateCommittedResource(const D3D12_HEAP_PROPERTIES* pHeapProperties, D3D12_HEAP_FLAGS HeapFlags, const D3D12_RESOURCE_DESC* pDesc, D3D12_RESOURCE_STATES InitialResourceState, const D3D12_CLEAR_VALUE* pOptimizedClearValue, REFIID riidResource, void** ppvResource) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateHeap(const D3D12_HEAP_DESC* pDesc, REFIID riid, void** ppvHeap) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreatePlacedResource(ID3D12Heap* pHeap, UINT64 HeapOffset, const D3D12_RESOURCE_DESC* pDesc, D3D12_RESOURCE_STATES InitialState, const D3D12_CLEAR_VALUE* pOptimizedClearValue, REFIID riid, void** ppvResource) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateReservedResource(const D3D12_RESOURCE_DESC* pDesc, D3D12_RESOURCE_STATES InitialState, const D3D12_CLEAR_VALUE* pOptimizedClearValue, REFIID riid, void** ppvResource) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateSharedHandle(ID3D12DeviceChild* pObject, const SECURITY_ATTRIBUTES* pAttributes, DWORD Access, LPCWSTR Name, HANDLE* pHandle) = 0;
+    virtual HRESULT STDMETHODCALLTYPE OpenSharedHandle(HANDLE NTHandle, REFIID riid, void** ppvObj) = 0;
+    virtual HRESULT STDMETHODCALLTYPE OpenSharedHandleByName(LPCWSTR Name, DWORD Access, HANDLE* pNTHandle) = 0;
+    virtual HRESULT STDMETHODCALLTYPE MakeResident(UINT NumObjects, ID3D12Pageable* const* ppObjects) = 0;
+    virtual HRESULT STDMETHODCALLTYPE Evict(UINT NumObjects, ID3D12Pageable* const* ppObjects) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateFence(UINT64 InitialValue, D3D12_FENCE_FLAGS Flags, REFIID riid, void** ppFence) = 0;
+    virtual HRESULT STDMETHODCALLTYPE GetDeviceRemovedReason() = 0;
+    virtual void STDMETHODCALLTYPE GetCopyableFootprints(const D3D12_RESOURCE_DESC* pResourceDesc, UINT FirstSubresource, UINT NumSubresources, UINT64 BaseOffset, D3D12_PLACED_SUBRESOURCE_FOOTPRINT* pLayouts, UINT* pNumRows, UINT64* pRowSizeInBytes, UINT64* pTotalBytes) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateQueryHeap(const D3D12_QUERY_HEAP_DESC* pDesc, REFIID riid, void** ppvHeap) = 0;
+    virtual HRESULT STDMETHODCALLTYPE SetStablePowerState(BOOL Enable) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateCommandSignature(const D3D12_COMMAND_SIGNATURE_DESC* pDesc, ID3D12RootSignature* pRootSignature, REFIID riid, void** ppvCommandSignature) = 0;
+    virtual void STDMETHODCALLTYPE GetResourceTiling(ID3D12Resource* pTiledResource, UINT* pNumTilesForEntireResource, D3D12_PACKED_MIP_INFO* pPackedMipDesc, D3D12_TILE_SHAPE* pStandardTileShapeForNonPackedMips, UINT* pNumSubresourceTilings, UINT FirstSubresourceTilingToGet, D3D12_SUBRESOURCE_TILING* pSubresourceTilingsForNonPackedMips) = 0;
+    virtual LUID STDMETHODCALLTYPE GetAdapterLuid() = 0;
+};
+
+D12W_COMPAT_INTERFACE(ID3D12Device1, ID3D12Device)
+{
+    virtual HRESULT STDMETHODCALLTYPE CreatePipelineLibrary(const void* pLibraryBlob, SIZE_T BlobLength, REFIID riid, void** ppPipelineLibrary) = 0;
+    virtual HRESULT STDMETHODCALLTYPE SetEventOnMultipleFenceCompletion(ID3D12Fence* const* ppFences, const UINT64* pFenceValues, UINT NumFences, D3D12_MULTIPLE_FENCE_WAIT_FLAGS Flags, HANDLE hEvent) = 0;
+    virtual HRESULT STDMETHODCALLTYPE SetResidencyPriority(UINT NumObjects, ID3D12Pageable* const* ppObjects, const D3D12_RESIDENCY_PRIORITY* pPriorities) = 0;
+};
+
+D12W_COMPAT_INTERFACE(ID3D12Device2, ID3D12Device1)
+{
+    virtual HRESULT STDMETHODCALLTYPE CreatePipelineState(const D3D12_PIPELINE_STATE_STREAM_DESC* pDesc, REFIID riid, void** ppPipelineState) = 0;
+};
+
+/*
+ * There is no D3D12 runtime on this platform, these always fail with
+ * DXGI_ERROR_UNSUPPORTED. The null backend provides devices.
+ */
+HRESULT WINAPI D3D12CreateDevice(IUnknown* pAdapter, D3D_FEATURE_LEVEL MinimumFeatureLevel, REFIID riid, void** ppDevice);
+HRESULT WINAPI D3D12GetDebugInterface(REFIID riid, void** ppvDebug);
+
+#include "d3d12sdklayers.h"
+
+#endif
@@ -0,0 +1,51 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_COMPAT_D3D12SDKLAYERS_H_
+#define _D12W_COMPAT_D3D12SDKLAYERS_H_
+
+#include "unknwn.h"
+
+typedef enum D3D12_GPU_BASED_VALIDATION_FLAGS
+{
+    D3D12_GPU_BASED_VALIDATION_FLAGS_NONE                   = 0,
+    D3D12_GPU_BASED_VALIDATION_FLAGS_DISABLE_STATE_TRACKING = 0x1
+} D3D12_GPU_BASED_VALIDATION_FLAGS;
+DEFINE_ENUM_FLAG_OPERATORS(D3D12_GPU_BASED_VALIDATION_FLAGS)
+
+D12W_COMPAT_INTERFACE(ID3D12Debug, IUnknown)
+{
+    virtual void STDMETHODCALLTYPE EnableDebugLayer() = 0;
+};
+
+D12W_COMPAT_INTERFACE(ID3D12Debug1, IUnknown)
+{
+    virtual void STDMETHODCALLTYPE EnableDebugLayer() = 0;
+    virtual void STDMETHODCALLTYPE SetEnableGPUBasedValidation(BOOL Enable) = 0;
+    virtual void STDMETHODCALLTYPE SetEnableSynchronizedCommandQueueValidation(BOOL Enable) = 0;
+};
+
+D12W_COMPAT_INTERFACE(ID3D12Debug2, IUnknown)
+{
+    virtual void STDMETHODCALLTYPE SetGPUBasedValidationFlags(D3D12_GPU_BASED_VALIDATION_FLAGS Flags) = 0;
+};
+
+#endif
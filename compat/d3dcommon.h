@@ -0,0 +1,54 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_COMPAT_D3DCOMMON_H_
+#define _D12W_COMPAT_D3DCOMMON_H_
+
+#include "unknwn.h"
+
+typedef enum D3D_FEATURE_LEVEL
+{
+    D3D_FEATURE_LEVEL_1_0_CORE = 0x1000,
+    D3D_FEATURE_LEVEL_9_1      = 0x9100,
+    D3D_FEATURE_LEVEL_9_2      = 0x9200,
+    D3D_FEATURE_LEVEL_9_3      = 0x9300,
+    D3D_FEATURE_LEVEL_10_0     = 0xa000,
+    D3D_FEATURE_LEVEL_10_1     = 0xa100,
+    D3D_FEATURE_LEVEL_11_0     = 0xb000,
+    D3D_FEATURE_LEVEL_11_1     = 0xb100,
+    D3D_FEATURE_LEVEL_12_0     = 0xc000,
+    D3D_FEATURE_LEVEL_12_1     = 0xc100,
+    D3D_FEATURE_LEVEL_12_2     = 0xc200
+} D3D_FEATURE_LEVEL;
+
+typedef enum D3D_PRIMITIVE_TOPOLOGY
+{
+    D3D_PRIMITIVE_TOPOLOGY_UNDEFINED     = 0,
+    D3D_PRIMITIVE_TOPOLOGY_POINTLIST     = 1,
+    D3D_PRIMITIVE_TOPOLOGY_LINELIST      = 2,
+    D3D_PRIMITIVE_TOPOLOGY_LINESTRIP     = 3,
+    D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST  = 4,
+    D3D_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP = 5
+} D3D_PRIMITIVE_TOPOLOGY;
+
+inline constexpr GUID WKPDID_D3DDebugObjectNameW = {0x4cca5fd8, 0x921f, 0x42c8, {0x85, 0x78, 0xeb, 0x9e, 0x2c, 0x9d, 0xcd, 0xb3}};
+
+#endif
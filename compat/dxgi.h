@@ -0,0 +1,113 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_COMPAT_DXGI_H_
+#define _D12W_COMPAT_DXGI_H_
+
+#include "unknwn.h"
+#include "dxgicommon.h"
+#include "dxgiformat.h"
+
+#define DXGI_CREATE_FACTORY_DEBUG 0x1
+
+typedef enum DXGI_ADAPTER_FLAG
+{
+    DXGI_ADAPTER_FLAG_NONE        = 0,
+    DXGI_ADAPTER_FLAG_REMOTE      = 1,
+    DXGI_ADAPTER_FLAG_SOFTWARE    = 2,
+    DXGI_ADAPTER_FLAG_FORCE_DWORD = 0xffffffff
+} DXGI_ADAPTER_FLAG;
+
+typedef struct DXGI_ADAPTER_DESC
+{
+    WCHAR  Description[128];
+    UINT   VendorId;
+    UINT   DeviceId;
+    UINT   SubSysId;
+    UINT   Revision;
+    SIZE_T DedicatedVideoMemory;
+    SIZE_T DedicatedSystemMemory;
+    SIZE_T SharedSystemMemory;
+    LUID   AdapterLuid;
+} DXGI_ADAPTER_DESC;
+
+typedef struct DXGI_ADAPTER_DESC1
+{
+    WCHAR  Description[128];
+    UINT   VendorId;
+    UINT   DeviceId;
+    UINT   SubSysId;
+    UINT   Revision;
+    SIZE_T DedicatedVideoMemory;
+    SIZE_T DedicatedSystemMemory;
+    SIZE_T SharedSystemMemory;
+    LUID   AdapterLuid;
+    UINT   Flags;
+} DXGI_ADAPTER_DESC1;
+
+typedef struct DXGI_SWAP_CHAIN_DESC DXGI_SWAP_CHAIN_DESC;
+
+D12W_COMPAT_INTERFACE(IDXGIObject, IUnknown)
+{
+    virtual HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID Name, UINT DataSize, const void* pData) = 0;
+    virtual HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID Name, const IUnknown* pUnknown) = 0;
+    virtual HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID Name, UINT* pDataSize, void* pData) = 0;
+    virtual HRESULT STDMETHODCALLTYPE GetParent(REFIID riid, void** ppParent) = 0;
+};
+
+D12W_COMPAT_INTERFACE(IDXGIDeviceSubObject, IDXGIObject)
+{
+    virtual HRESULT STDMETHODCALLTYPE GetDevice(REFIID riid, void** ppDevice) = 0;
+};
+
+// outputs, devices and swap chains are not used on this side, their methods are left out
+D12W_COMPAT_INTERFACE(IDXGIOutput, IDXGIObject) {};
+D12W_COMPAT_INTERFACE(IDXGIDevice, IDXGIObject) {};
+D12W_COMPAT_INTERFACE(IDXGISwapChain, IDXGIDeviceSubObject) {};
+
+D12W_COMPAT_INTERFACE(IDXGIAdapter, IDXGIObject)
+{
+    virtual HRESULT STDMETHODCALLTYPE EnumOutputs(UINT Output, IDXGIOutput** ppOutput) = 0;
+    virtual HRESULT STDMETHODCALLTYPE GetDesc(DXGI_ADAPTER_DESC* pDesc) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CheckInterfaceSupport(REFGUID InterfaceName, LARGE_INTEGER* pUMDVersion) = 0;
+};
+
+D12W_COMPAT_INTERFACE(IDXGIAdapter1, IDXGIAdapter)
+{
+    virtual HRESULT STDMETHODCALLTYPE GetDesc1(DXGI_ADAPTER_DESC1* pDesc) = 0;
+};
+
+D12W_COMPAT_INTERFACE(IDXGIFactory, IDXGIObject)
+{
+    virtual HRESULT STDMETHODCALLTYPE EnumAdapters(UINT Adapter, IDXGIAdapter** ppAdapter) = 0;
+    virtual HRESULT STDMETHODCALLTYPE MakeWindowAssociation(HWND WindowHandle, UINT Flags) = 0;
+    virtual HRESULT STDMETHODCALLTYPE GetWindowAssociation(HWND* pWindowHandle) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateSwapChain(IUnknown* pDevice, DXGI_SWAP_CHAIN_DESC* pDesc, IDXGISwapChain** ppSwapChain) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateSoftwareAdapter(HMODULE Module, IDXGIAdapter** ppAdapter) = 0;
+};
+
+D12W_COMPAT_INTERFACE(IDXGIFactory1, IDXGIFactory)
+{
+    virtual HRESULT STDMETHODCALLTYPE EnumAdapters1(UINT Adapter, IDXGIAdapter1** ppAdapter) = 0;
+    virtual BOOL STDMETHODCALLTYPE IsCurrent() = 0;
+};
+
+#endif
@@ -0,0 +1,86 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_COMPAT_DXGI1_2_H_
+#define _D12W_COMPAT_DXGI1_2_H_
+
+#include "dxgi.h"
+
+typedef enum DXGI_GRAPHICS_PREEMPTION_GRANULARITY
+{
+    DXGI_GRAPHICS_PREEMPTION_DMA_BUFFER_BOUNDARY  = 0,
+    DXGI_GRAPHICS_PREEMPTION_PRIMITIVE_BOUNDARY   = 1,
+    DXGI_GRAPHICS_PREEMPTION_TRIANGLE_BOUNDARY    = 2,
+    DXGI_GRAPHICS_PREEMPTION_PIXEL_BOUNDARY       = 3,
+    DXGI_GRAPHICS_PREEMPTION_INSTRUCTION_BOUNDARY = 4
+} DXGI_GRAPHICS_PREEMPTION_GRANULARITY;
+
+typedef enum DXGI_COMPUTE_PREEMPTION_GRANULARITY
+{
+    DXGI_COMPUTE_PREEMPTION_DMA_BUFFER_BOUNDARY   = 0,
+    DXGI_COMPUTE_PREEMPTION_DISPATCH_BOUNDARY     = 1,
+    DXGI_COMPUTE_PREEMPTION_THREAD_GROUP_BOUNDARY = 2,
+    DXGI_COMPUTE_PREEMPTION_THREAD_BOUNDARY       = 3,
+    DXGI_COMPUTE_PREEMPTION_INSTRUCTION_BOUNDARY  = 4
+} DXGI_COMPUTE_PREEMPTION_GRANULARITY;
+
+typedef struct DXGI_ADAPTER_DESC2
+{
+    WCHAR                                Description[128];
+    UINT                                 VendorId;
+    UINT                                 DeviceId;
+    UINT                                 SubSysId;
+    UINT                                 Revision;
+    SIZE_T                               DedicatedVideoMemory;
+    SIZE_T                               DedicatedSystemMemory;
+    SIZE_T                               SharedSystemMemory;
+    LUID                                 AdapterLuid;
+    UINT                                 Flags;
+    DXGI_GRAPHICS_PREEMPTION_GRANULARITY GraphicsPreemptionGranularity;
+    DXGI_COMPUTE_PREEMPTION_GRANULARITY  ComputePreemptionGranularity;
+} DXGI_ADAPTER_DESC2;
+
+typedef struct DXGI_SWAP_CHAIN_DESC1 DXGI_SWAP_CHAIN_DESC1;
+typedef struct DXGI_SWAP_CHAIN_FULLSCREEN_DESC DXGI_SWAP_CHAIN_FULLSCREEN_DESC;
+
+D12W_COMPAT_INTERFACE(IDXGISwapChain1, IDXGISwapChain) {};
+
+D12W_COMPAT_INTERFACE(IDXGIAdapter2, IDXGIAdapter1)
+{
+    virtual HRESULT STDMETHODCALLTYPE GetDesc2(DXGI_ADAPTER_DESC2* pDesc) = 0;
+};
+
+D12W_COMPAT_INTERFACE(IDXGIFactory2, IDXGIFactory1)
+{
+    virtual BOOL STDMETHODCALLTYPE IsWindowedStereoEnabled() = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateSwapChainForHwnd(IUnknown* pDevice, HWND hWnd, const DXGI_SWAP_CHAIN_DESC1* pDesc, const DXGI_SWAP_CHAIN_FULLSCREEN_DESC* pFullscreenDesc, IDXGIOutput* pRestrictToOutput, IDXGISwapChain1** ppSwapChain) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateSwapChainForCoreWindow(IUnknown* pDevice, IUnknown* pWindow, const DXGI_SWAP_CHAIN_DESC1* pDesc, IDXGIOutput* pRestrictToOutput, IDXGISwapChain1** ppSwapChain) = 0;
+    virtual HRESULT STDMETHODCALLTYPE GetSharedResourceAdapterLuid(HANDLE hResource, LUID* pLuid) = 0;
+    virtual HRESULT STDMETHODCALLTYPE RegisterStereoStatusWindow(HWND WindowHandle, UINT wMsg, DWORD* pdwCookie) = 0;
+    virtual HRESULT STDMETHODCALLTYPE RegisterStereoStatusEvent(HANDLE hEvent, DWORD* pdwCookie) = 0;
+    virtual void STDMETHODCALLTYPE UnregisterStereoStatus(DWORD dwCookie) = 0;
+    virtual HRESULT STDMETHODCALLTYPE RegisterOcclusionStatusWindow(HWND WindowHandle, UINT wMsg, DWORD* pdwCookie) = 0;
+    virtual HRESULT STDMETHODCALLTYPE RegisterOcclusionStatusEvent(HANDLE hEvent, DWORD* pdwCookie) = 0;
+    virtual void STDMETHODCALLTYPE UnregisterOcclusionStatus(DWORD dwCookie) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateSwapChainForComposition(IUnknown* pDevice, const DXGI_SWAP_CHAIN_DESC1* pDesc, IDXGIOutput* pRestrictToOutput, IDXGISwapChain1** ppSwapChain) = 0;
+};
+
+#endif
@@ -0,0 +1,73 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_COMPAT_DXGI1_6_H_
+#define _D12W_COMPAT_DXGI1_6_H_
+
+#include "dxgi1_5.h"
+
+typedef enum DXGI_ADAPTER_FLAG3
+{
+    DXGI_ADAPTER_FLAG3_NONE                         = 0,
+    DXGI_ADAPTER_FLAG3_REMOTE                       = 1,
+    DXGI_ADAPTER_FLAG3_SOFTWARE                     = 2,
+    DXGI_ADAPTER_FLAG3_ACG_COMPATIBLE               = 4,
+    DXGI_ADAPTER_FLAG3_SUPPORT_MONITORED_FENCES     = 8,
+    DXGI_ADAPTER_FLAG3_SUPPORT_NON_MONITORED_FENCES = 0x10,
+    DXGI_ADAPTER_FLAG3_KEYED_MUTEX_CONFORMANCE      = 0x20,
+    DXGI_ADAPTER_FLAG3_FORCE_DWORD                  = 0xffffffff
+} DXGI_ADAPTER_FLAG3;
+DEFINE_ENUM_FLAG_OPERATORS(DXGI_ADAPTER_FLAG3)
+
+typedef struct DXGI_ADAPTER_DESC3
+{
+    WCHAR                                Description[128];
+    UINT                                 VendorId;
+    UINT                                 DeviceId;
+    UINT                                 SubSysId;
+    UINT                                 Revision;
+    SIZE_T                               DedicatedVideoMemory;
+    SIZE_T                               DedicatedSystemMemory;
+    SIZE_T                               SharedSystemMemory;
+    LUID                                 AdapterLuid;
+    DXGI_ADAPTER_FLAG3                   Flags;
+    DXGI_GRAPHICS_PREEMPTION_GRANULARITY GraphicsPreemptionGranularity;
+    DXGI_COMPUTE_PREEMPTION_GRANULARITY  ComputePreemptionGranularity;
+} DXGI_ADAPTER_DESC3;
+
+typedef enum DXGI_GPU_PREFERENCE
+{
+    DXGI_GPU_PREFERENCE_UNSPECIFIED      = 0,
+    DXGI_GPU_PREFERENCE_MINIMUM_POWER    = 1,
+    DXGI_GPU_PREFERENCE_HIGH_PERFORMANCE = 2
+} DXGI_GPU_PREFERENCE;
+
+D12W_COMPAT_INTERFACE(IDXGIAdapter4, IDXGIAdapter3)
+{
+    virtual HRESULT STDMETHODCALLTYPE GetDesc3(DXGI_ADAPTER_DESC3* pDesc) = 0;
+};
+
+D12W_COMPAT_INTERFACE(IDXGIFactory6, IDXGIFactory5)
+{
+    virtual HRESULT STDMETHODCALLTYPE EnumAdapterByGpuPreference(UINT Adapter, DXGI_GPU_PREFERENCE GpuPreference, REFIID riid, void** ppvAdapter) = 0;
+};
+
+#endif
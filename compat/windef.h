@@ -0,0 +1,201 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_COMPAT_WINDEF_H_
+#define _D12W_COMPAT_WINDEF_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+/*
+ * The basic Win32 types, with the sizes they have on Windows.
+ */
+
+typedef int32_t        HRESULT;
+typedef int            BOOL;
+typedef int            INT;
+typedef unsigned int   UINT;
+typedef int8_t         INT8;
+typedef uint8_t        UINT8;
+typedef int16_t        INT16;
+typedef uint16_t       UINT16;
+typedef int32_t        INT32;
+typedef uint32_t       UINT32;
+typedef int64_t        INT64;
+typedef uint64_t       UINT64;
+typedef int32_t        LONG;
+typedef uint32_t       ULONG;
+typedef int64_t        LONGLONG;
+typedef uint64_t       ULONGLONG;
+typedef uint8_t        BYTE;
+typedef uint16_t       WORD;
+typedef uint32_t       DWORD;
+typedef size_t         SIZE_T;
+typedef float          FLOAT;
+typedef char           CHAR;
+typedef wchar_t        WCHAR;
+typedef const char*    LPCSTR;
+typedef char*          LPSTR;
+typedef const wchar_t* LPCWSTR;
+typedef wchar_t*       LPWSTR;
+typedef void*          LPVOID;
+typedef void*          HANDLE;
+
+struct HWND__;
+typedef HWND__* HWND;
+struct HINSTANCE__;
+typedef HINSTANCE__* HMODULE;
+
+#ifndef FALSE
+#define FALSE 0
+#endif
+#ifndef TRUE
+#define TRUE 1
+#endif
+
+typedef struct _LUID
+{
+    DWORD LowPart;
+    LONG  HighPart;
+} LUID;
+
+typedef union _LARGE_INTEGER
+{
+    struct
+    {
+        DWORD LowPart;
+        LONG  HighPart;
+    };
+    struct
+    {
+        DWORD LowPart;
+        LONG  HighPart;
+    } u;
+    LONGLONG QuadPart;
+} LARGE_INTEGER;
+
+typedef struct tagRECT
+{
+    LONG left;
+    LONG top;
+    LONG right;
+    LONG bottom;
+} RECT;
+
+typedef struct _SECURITY_ATTRIBUTES SECURITY_ATTRIBUTES;
+
+typedef struct _GUID
+{
+    uint32_t Data1;
+    uint16_t Data2;
+    uint16_t Data3;
+    uint8_t  Data4[8];
+} GUID;
+
+typedef GUID        IID;
+typedef const GUID& REFGUID;
+typedef const IID&  REFIID;
+
+inline bool operator == (const GUID& a, const GUID& b)
+{
+    return std::memcmp(&a, &b, sizeof(GUID)) == 0;
+}
+
+inline bool operator != (const GUID& a, const GUID& b)
+{
+    return !(a == b);
+}
+
+#define STDMETHODCALLTYPE
+#define WINAPI
+
+#define DEFINE_ENUM_FLAG_OPERATORS(ENUMTYPE) \
+    constexpr ENUMTYPE operator | (ENUMTYPE a, ENUMTYPE b) { return ENUMTYPE(std::underlying_type_t<ENUMTYPE>(a) | std::underlying_type_t<ENUMTYPE>(b)); } \
+    constexpr ENUMTYPE operator & (ENUMTYPE a, ENUMTYPE b) { return ENUMTYPE(std::underlying_type_t<ENUMTYPE>(a) & std::underlying_type_t<ENUMTYPE>(b)); } \
+    constexpr ENUMTYPE operator ^ (ENUMTYPE a, ENUMTYPE b) { return ENUMTYPE(std::underlying_type_t<ENUMTYPE>(a) ^ std::underlying_type_t<ENUMTYPE>(b)); } \
+    constexpr ENUMTYPE operator ~ (ENUMTYPE a) { return ENUMTYPE(~std::underlying_type_t<ENUMTYPE>(a)); } \
+    inline ENUMTYPE& operator |= (ENUMTYPE& a, ENUMTYPE b) { return a = a | b; } \
+    inline ENUMTYPE& operator &= (ENUMTYPE& a, ENUMTYPE b) { return a = a & b; } \
+    inline ENUMTYPE& operator ^= (ENUMTYPE& a, ENUMTYPE b) { return a = a ^ b; }
+
+namespace d12w::compat
+{
+    constexpr uint64_t Fnv1a(std::string_view text, uint64_t hash)
+    {
+        for (auto c : text)
+        {
+            hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001b3ull;
+        }
+        return hash;
+    }
+
+    /*
+     * Make the IID of an interface from its name.
+     *
+     * The IIDs are not the ones of the Windows SDK. They only need to be
+     * distinct within the process, since there is no runtime on the other
+     * side that knows the real ones.
+     */
+    constexpr GUID MakeGuid(std::string_view name)
+    {
+        auto high = Fnv1a(name, 0xcbf29ce484222325ull);
+        auto low  = Fnv1a(name, 0x84222325cbf29ce4ull);
+
+        auto guid = GUID{};
+        guid.Data1 = static_cast<uint32_t>(high >> 32);
+        guid.Data2 = static_cast<uint16_t>(high >> 16);
+        guid.Data3 = static_cast<uint16_t>(high);
+        for (auto i = 0; i < 8; i++)
+        {
+            guid.Data4[i] = static_cast<uint8_t>(low >> (56 - 8 * i));
+        }
+        return guid;
+    }
+
+    template <typename Interface>
+    struct Uuid;
+}
+
+/*
+ * __uuidof is a Microsoft extension, the IID of an interface is looked up
+ * from a specialization of Uuid instead.
+ */
+#define __uuidof(Interface) (::d12w::compat::Uuid<Interface>::value)
+
+#define D12W_COMPAT_UUID(Interface) \
+    template <> \
+    struct d12w::compat::Uuid<Interface> \
+    { \
+        static constexpr GUID value = ::d12w::compat::MakeGuid(#Interface); \
+    };
+
+/*
+ * Declare a COM interface, the counterpart of MIDL_INTERFACE.
+ */
+#define D12W_COMPAT_INTERFACE(Interface, Base) \
+    struct Interface; \
+    D12W_COMPAT_UUID(Interface) \
+    struct Interface : public Base
+
+#endif
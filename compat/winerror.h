@@ -0,0 +1,94 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_COMPAT_WINERROR_H_
+#define _D12W_COMPAT_WINERROR_H_
+
+#include "windef.h"
+
+#define SUCCEEDED(hr) (static_cast<HRESULT>(hr) >= 0)
+#define FAILED(hr) (static_cast<HRESULT>(hr) < 0)
+
+#define _HRESULT_TYPEDEF_(code) (static_cast<HRESULT>(code))
+
+#define ERROR_SUCCESS                            0L
+#define ERROR_FILE_NOT_FOUND                     2L
+#define ERROR_PATH_NOT_FOUND                     3L
+#define ERROR_ACCESS_DENIED                      5L
+#define ERROR_INVALID_HANDLE                     6L
+#define ERROR_NOT_ENOUGH_MEMORY                  8L
+#define ERROR_INVALID_PARAMETER                  87L
+#define ERROR_INVALID_WINDOW_HANDLE              1400L
+#define ERROR_CLASS_ALREADY_EXISTS               1410L
+#define ERROR_CLASS_DOES_NOT_EXIST               1411L
+
+#define S_OK                                     _HRESULT_TYPEDEF_(0x00000000L)
+#define S_FALSE                                  _HRESULT_TYPEDEF_(0x00000001L)
+#define E_NOTIMPL                                _HRESULT_TYPEDEF_(0x80004001L)
+#define E_NOINTERFACE                            _HRESULT_TYPEDEF_(0x80004002L)
+#define E_POINTER                                _HRESULT_TYPEDEF_(0x80004003L)
+#define E_ABORT                                  _HRESULT_TYPEDEF_(0x80004004L)
+#define E_FAIL                                   _HRESULT_TYPEDEF_(0x80004005L)
+#define E_UNEXPECTED                             _HRESULT_TYPEDEF_(0x8000FFFFL)
+#define E_ACCESSDENIED                           _HRESULT_TYPEDEF_(0x80070005L)
+#define E_HANDLE                                 _HRESULT_TYPEDEF_(0x80070006L)
+#define E_OUTOFMEMORY                            _HRESULT_TYPEDEF_(0x8007000EL)
+#define E_INVALIDARG                             _HRESULT_TYPEDEF_(0x80070057L)
+
+#define DXGI_STATUS_OCCLUDED                     _HRESULT_TYPEDEF_(0x087A0001L)
+#define DXGI_STATUS_CLIPPED                      _HRESULT_TYPEDEF_(0x087A0002L)
+#define DXGI_STATUS_MODE_CHANGED                 _HRESULT_TYPEDEF_(0x087A0007L)
+#define DXGI_STATUS_MODE_CHANGE_IN_PROGRESS      _HRESULT_TYPEDEF_(0x087A0008L)
+
+#define DXGI_ERROR_INVALID_CALL                  _HRESULT_TYPEDEF_(0x887A0001L)
+#define DXGI_ERROR_NOT_FOUND                     _HRESULT_TYPEDEF_(0x887A0002L)
+#define DXGI_ERROR_MORE_DATA                     _HRESULT_TYPEDEF_(0x887A0003L)
+#define DXGI_ERROR_UNSUPPORTED                   _HRESULT_TYPEDEF_(0x887A0004L)
+#define DXGI_ERROR_DEVICE_REMOVED                _HRESULT_TYPEDEF_(0x887A0005L)
+#define DXGI_ERROR_DEVICE_HUNG                   _HRESULT_TYPEDEF_(0x887A0006L)
+#define DXGI_ERROR_DEVICE_RESET                  _HRESULT_TYPEDEF_(0x887A0007L)
+#define DXGI_ERROR_WAS_STILL_DRAWING             _HRESULT_TYPEDEF_(0x887A000AL)
+#define DXGI_ERROR_FRAME_STATISTICS_DISJOINT     _HRESULT_TYPEDEF_(0x887A000BL)
+#define DXGI_ERROR_GRAPHICS_VIDPN_SOURCE_IN_USE  _HRESULT_TYPEDEF_(0x887A000CL)
+#define DXGI_ERROR_DRIVER_INTERNAL_ERROR         _HRESULT_TYPEDEF_(0x887A0020L)
+#define DXGI_ERROR_NONEXCLUSIVE                  _HRESULT_TYPEDEF_(0x887A0021L)
+#define DXGI_ERROR_NOT_CURRENTLY_AVAILABLE       _HRESULT_TYPEDEF_(0x887A0022L)
+#define DXGI_ERROR_REMOTE_CLIENT_DISCONNECTED    _HRESULT_TYPEDEF_(0x887A0023L)
+#define DXGI_ERROR_REMOTE_OUTOFMEMORY            _HRESULT_TYPEDEF_(0x887A0024L)
+#define DXGI_ERROR_MODE_CHANGE_IN_PROGRESS       _HRESULT_TYPEDEF_(0x887A0025L)
+#define DXGI_ERROR_ACCESS_LOST                   _HRESULT_TYPEDEF_(0x887A0026L)
+#define DXGI_ERROR_WAIT_TIMEOUT                  _HRESULT_TYPEDEF_(0x887A0027L)
+#define DXGI_ERROR_SESSION_DISCONNECTED          _HRESULT_TYPEDEF_(0x887A0028L)
+#define DXGI_ERROR_RESTRICT_TO_OUTPUT_STALE      _HRESULT_TYPEDEF_(0x887A0029L)
+#define DXGI_ERROR_CANNOT_PROTECT_CONTENT        _HRESULT_TYPEDEF_(0x887A002AL)
+#define DXGI_ERROR_ACCESS_DENIED                 _HRESULT_TYPEDEF_(0x887A002BL)
+#define DXGI_ERROR_NAME_ALREADY_EXISTS           _HRESULT_TYPEDEF_(0x887A002CL)
+#define DXGI_ERROR_SDK_COMPONENT_MISSING         _HRESULT_TYPEDEF_(0x887A002DL)
+#define DXGI_ERROR_NOT_CURRENT                   _HRESULT_TYPEDEF_(0x887A002EL)
+#define DXGI_ERROR_HW_PROTECTION_OUTOFMEMORY     _HRESULT_TYPEDEF_(0x887A0030L)
+#define DXGI_ERROR_DYNAMIC_CODE_POLICY_VIOLATION _HRESULT_TYPEDEF_(0x887A0031L)
+#define DXGI_ERROR_NON_COMPOSITED_UI             _HRESULT_TYPEDEF_(0x887A0032L)
+
+#define D3D12_ERROR_ADAPTER_NOT_FOUND            _HRESULT_TYPEDEF_(0x887E0001L)
+#define D3D12_ERROR_DRIVER_VERSION_MISMATCH      _HRESULT_TYPEDEF_(0x887E0002L)
+#define D3D12_ERROR_INVALID_REDIST               _HRESULT_TYPEDEF_(0x887E0003L)
+
+#endif
@@ -0,0 +1,244 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_ATOMIC_COMPTR_H_
+#define _D12W_ATOMIC_COMPTR_H_
+
+#include <atomic>
+#include <cstdint>
+
+#include "defines.h"
+#include "ComPtr.h"
+
+namespace d12w
+{
+    /*!
+     * Atomic COM Smart Pointer
+     *
+     * AtomicComPtr allows to publish a COM object from one thread and pick
+     * it up from others without an external mutex, for example when a loader
+     * thread hot-swaps a pipeline state that the render thread uses.
+     *
+     * The implementation uses split reference counting: the pointer and a
+     * count of in-flight loads share one 64-bit word. Load borrows a reference
+     * by incrementing the local count, takes a real reference on the COM
+     * object and then gives the borrowed one back. Before the pointer is replaced
+     * the outstanding borrows are converted into real references on the old
+     * object, so a concurrent Load never touches a released object. Loads are 
+     * cheap, replacing the value costs an additional Load.
+     *
+     * @note The pointer is stored in the lower 48 bits, which covers the user
+     * mode address space on all supported platforms. At most 65535 loads may
+     * be in flight at the same time.
+     */
+    template <typename ComClass>
+    class D12W_EXPORT AtomicComPtr
+    {
+    public:
+        /*!
+         * Create a null pointer.
+         */
+        AtomicComPtr() noexcept = default;
+
+        /*!
+         * Create an atomic pointer holding value.
+         *
+         * @param value the initial value
+         */
+        explicit
+        AtomicComPtr(ComPtr<ComClass> value) noexcept
+        : state(Pack(value.Detach())) {}
+
+        AtomicComPtr(const AtomicComPtr<ComClass>&) = delete;
+
+        /*!
+         * Release the held object.
+         */
+        ~AtomicComPtr()
+        {
+            auto obj = Unpack(state.load(std::memory_order_acquire));
+            if (obj)
+            {
+                obj->Release();
+            }
+        }
+
+        AtomicComPtr<ComClass>& operator = (const AtomicComPtr<ComClass>&) = delete;
+
+        /*!
+         * Check if the underlying atomic is lock free.
+         *
+         * This is always the case on x64 and x86 with cmpxchg8b.
+         */
+        bool IsLockFree() const noexcept
+        {
+            return state.is_lock_free();
+        }
+
+        /*!
+         * Get a reference to the current value.
+         *
+         * @return the current value with increased reference count
+         */
+        ComPtr<ComClass> Load() const noexcept
+        {
+            auto old = state.fetch_add(COUNT_ONE, std::memory_order_acquire);
+            auto obj = Unpack(old);
+            if (obj)
+            {
+                obj->AddRef();
+            }
+            ReturnBorrow(obj);
+
+            auto result = ComPtr<ComClass>{};
+            result.Attach(obj);
+            return result;
+        }
+
+        /*!
+         * Replace the current value.
+         *
+         * @param desired the new value
+         */
+        void Store(ComPtr<ComClass> desired) noexcept
+        {
+            Exchange(std::move(desired));
+        }
+
+        /*!
+         * Replace the current value and return the previous one.
+         *
+         * @param desired the new value
+         * @return the previous value
+         */
+        ComPtr<ComClass> Exchange(ComPtr<ComClass> desired) noexcept
+        {
+            auto old = Load();
+            while (!TryReplace(old, desired.Get()))
+            {
+                old = Load();
+            }
+            static_cast<void>(desired.Detach());
+            return old;
+        }
+
+        /*!
+         * Replace the current value if it is expected.
+         *
+         * @param expected the value to compare with, on failure it is updated to the current value
+         * @param desired the new value
+         * @return true if the value was replaced
+         */
+        bool CompareExchange(ComPtr<ComClass>& expected, ComPtr<ComClass> desired) noexcept
+        {
+            if (TryReplace(expected, desired.Get()))
+            {
+                static_cast<void>(desired.Detach());
+                return true;
+            }
+
+            expected = Load();
+            return false;
+        }
+
+    private:
+        static constexpr uint64_t POINTER_MASK = (uint64_t{1} << 48) - 1;
+        static constexpr uint64_t COUNT_ONE    = uint64_t{1} << 48;
+
+        mutable std::atomic<uint64_t> state = 0;
+
+        static uint64_t Pack(ComClass* obj) noexcept
+        {
+            return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(obj));
+        }
+
+        static ComClass* Unpack(uint64_t value) noexcept
+        {
+            return reinterpret_cast<ComClass*>(static_cast<uintptr_t>(value & POINTER_MASK));
+        }
+
+        static uint64_t Count(uint64_t value) noexcept
+        {
+            return value >> 48;
+        }
+
+        void ReturnBorrow(ComClass* obj) const noexcept
+        {
+            auto cur = state.load(std::memory_order_relaxed);
+            while (Unpack(cur) == obj && Count(cur) > 0)
+            {
+                if (state.compare_exchange_weak(cur, cur - COUNT_ONE, std::memory_order_release, std::memory_order_relaxed))
+                {
+                    return;
+                }
+            }
+
+            // The pointer was replaced while the reference was borrowed,
+            // the replacing thread converted the borrow into a real reference.
+            if (obj)
+            {
+                obj->Release();
+            }
+        }
+
+        // Replace current with desired. The caller holds a reference to current, 
+        // which keeps it alive while the outstanding borrows are converted into 
+        // real references. This must happen before the new value is published,
+        // since a borrower gives its reference back as soon as it sees the change.
+        bool TryReplace(const ComPtr<ComClass>& current, ComClass* desired) noexcept
+        {
+            auto obj = current.Get();
+            auto added = uint64_t{0};
+            auto cur = state.load(std::memory_order_relaxed);
+            while (Unpack(cur) == obj)
+            {
+                if (obj)
+                {
+                    for (; added < Count(cur); added++)
+                    {
+                        obj->AddRef();
+                    }
+                }
+
+                if (state.compare_exchange_weak(cur, Pack(desired), std::memory_order_acq_rel, std::memory_order_relaxed))
+                {
+                    if (obj)
+                    {
+                        // surplus from borrows returned in the meantime and the reference held by this
+                        for (added = added - Count(cur) + 1; added > 0; added--)
+                        {
+                            obj->Release();
+                        }
+                    }
+                    return true;
+                }
+            }
+
+            for (; added > 0; added--)
+            {
+                obj->Release();
+            }
+            return false;
+        }
+    };
+}
+
+#endif
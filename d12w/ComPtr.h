@@ -24,6 +24,8 @@
 
 #include <atomic>
 #include <algorithm>
+#include <utility>
+#include <type_traits>
 
 #include "defines.h"
 #include "util.h"
@@ -59,7 +61,7 @@ namespace d12w
          * or else you will leak memory.
          */
         ComPtr(ComClass* obj)
-        : object(object) 
+        : object(obj) 
         {
             AddRef();
         }
@@ -77,6 +79,45 @@ namespace d12w
             AddRef();
         }
 
+        /*!
+         * Converting Constructor
+         *
+         * Make a new reference from a ComPtr to a derived interface.
+         *
+         * @param other the ComPtr to copy
+         */
+        template <typename OtherComClass, typename = std::enable_if_t<std::is_base_of_v<ComClass, OtherComClass>>>
+        ComPtr(const ComPtr<OtherComClass>& other)
+        : object(other.Get())
+        {
+            AddRef();
+        }
+
+        /*!
+         * Converting Move Constructor
+         *
+         * Take over the reference of a ComPtr to a derived interface.
+         *
+         * @param other the ComPtr to move from
+         */
+        template <typename OtherComClass, typename = std::enable_if_t<std::is_base_of_v<ComClass, OtherComClass>>>
+        ComPtr(ComPtr<OtherComClass>&& other) noexcept
+        : object(other.Detach()) {}
+
+        /*!
+         * Move Constructor
+         *
+         * Take over the reference of other without touching the reference count.
+         * The other ComPtr is left as null pointer.
+         *
+         * @param other the ComPtr to move from
+         */
+        ComPtr(ComPtr<ComClass>&& other) noexcept
+        : object(other.object)
+        {
+            other.object = nullptr;
+        }
+
         /*!
          * Reduce the reference count.
          */
@@ -99,6 +140,21 @@ namespace d12w
             return *this;
         }
 
+        /*!
+         * Move Assignment Operator
+         *
+         * Take over the reference of other without touching its reference count. 
+         * The previously held object is released and other is left as null pointer.
+         *
+         * @param other the ComPtr to move from
+         */
+        ComPtr<ComClass>& operator = (ComPtr<ComClass>&& other) noexcept
+        {
+            ComPtr<ComClass> tmp(std::move(other));
+            Swap(tmp);
+            return *this;
+        }
+
         /*!
          * Is Equal Operator 
          *
@@ -110,7 +166,7 @@ namespace d12w
          *
          * @param rhs the ComPtr to compare with
          */
-        bool operator == (const ComPtr<ComClass>& rhs)
+        bool operator == (const ComPtr<ComClass>& rhs) const
         {
             return object == rhs.object;
         }
@@ -126,7 +182,7 @@ namespace d12w
          *
          * @param rhs the ComPtr to compare with
          */
-        bool operator != (const ComPtr<ComClass>& rhs)
+        bool operator != (const ComPtr<ComClass>& rhs) const
         {
             return object != rhs.object;
         }
@@ -181,6 +237,78 @@ namespace d12w
             return &object;
         }
 
+        /*!
+         * Get the underlying pointer.
+         *
+         * The reference count is not changed.
+         *
+         * @return the managed COM object
+         */
+        ComClass* Get() const noexcept
+        {
+            return object;
+        }
+
+        /*!
+         * Get the address of the underlying pointer.
+         *
+         * Unlike ReleaseAndGetAddressOf, the currently held object is 
+         * not released. Use this to pass the pointer to functions that take
+         * an array of pointers or only read the value.
+         *
+         * @return the address of the pointer to COM object
+         */
+        ComClass** GetAddressOf() noexcept
+        {
+            return &object;
+        }
+
+        /*!
+         * Release the object and get the address of the underlying pointer.
+         *
+         * This is the safe way to pass a ComPtr as out-parameter to COM 
+         * functions, since the previously held object is released instead of 
+         * being overwritten and leaked.
+         *
+         * @return the address of the now null pointer to COM object
+         */
+        ComClass** ReleaseAndGetAddressOf() noexcept
+        {
+            Release();
+            return &object;
+        }
+
+        /*!
+         * Take ownership of a naked pointer.
+         *
+         * Unlike the wrapping constructor, the reference count is not increased;
+         * the ComPtr takes over the reference that the caller holds. The 
+         * previously held object is released.
+         *
+         * @param obj the COM object to take ownership of
+         */
+        void Attach(ComClass* obj) noexcept
+        {
+            Release();
+            object = obj;
+        }
+
+        /*!
+         * Give up ownership of the underlying pointer.
+         *
+         * The reference count is not changed and the ComPtr is left as null 
+         * pointer. The caller is responsible to release the returned object.
+         *
+         * @return the previously managed COM object
+         */
+        [[nodiscard]]
+        ComClass* Detach() noexcept
+        {
+            auto obj = object;
+            object = nullptr;
+            return obj;
+        }
+
         /*!
          * Arrow Operator
          *
@@ -214,15 +342,64 @@ namespace d12w
             return __uuidof(ComClass);
         }
 
+        /*!
+         * Query a different interface of the COM object.
+         *
+         * @return the COM object as NewComClass
+         *
+         * @throws std::runtime_error if the object does not implement NewComClass
+         *
+         * @see TryAs
+         */
         template <typename NewComClass>
-        ComPtr<NewComClass> As()
+        ComPtr<NewComClass> As() const
         {
-            auto newPtr = ComPtr<NewComClass>{};
-            auto hr = object->QueryInterface(newPtr.UUID(), reinterpret_cast<void**>(&newPtr));
+            auto hr = HRESULT{0};
+            auto newPtr = TryAs<NewComClass>(&hr);
             D12W_CHECK_SUCCESS(hr);
             return newPtr;
         }
 
+        /*!
+         * Query a different interface of the COM object without throwing.
+         *
+         * This function is intended for capability probing, where a missing 
+         * interface is an expected outcome and not an error. 
+         *
+         * If NewComClass is a base of ComClass the cast is resolved at compile 
+         * time and QueryInterface is not called.
+         *
+         * @param result optional HRESULT of the query, E_POINTER if this is null
+         * @return the COM object as NewComClass or null if the query failed
+         */
+        template <typename NewComClass>
+        ComPtr<NewComClass> TryAs(HRESULT* result = nullptr) const noexcept
+        {
+            auto newPtr = ComPtr<NewComClass>{};
+            auto hr = HRESULT{E_POINTER};
+            if constexpr (std::is_base_of_v<NewComClass, ComClass>)
+            {
+                if (object)
+                {
+                    newPtr = ComPtr<NewComClass>{object};
+                    hr = S_OK;
+                }
+            }
+            else
+            {
+                if (object)
+                {
+                    hr = object->QueryInterface(__uuidof(NewComClass), reinterpret_cast<void**>(newPtr.GetAddressOf()));
+                }
+            }
+
+            if (result)
+            {
+                *result = hr;
+            }
+            return newPtr;
+        }
+
         /*!
          * Exception safe swap.
          *
@@ -246,7 +423,7 @@ namespace d12w
             }
         }
 
-        void Release()
+        void Release() noexcept
         {
             if (object)
             {
@@ -0,0 +1,194 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "JobPool.h"
+
+namespace d12w
+{
+    JobPool::JobPool(unsigned int threadCount)
+    {
+        for (auto i = 0u; i < threadCount; i++)
+        {
+            queues.push_back(std::make_unique<Queue>());
+        }
+        for (auto i = 0u; i < threadCount; i++)
+        {
+            threads.emplace_back([this, i] () { Work(i); });
+        }
+    }
+
+    JobPool::~JobPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            running = false;
+        }
+        wake.notify_all();
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    void JobPool::Run(size_t count, const std::function<void (size_t)>& job)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        auto loop = Loop{};
+        loop.job       = &job;
+        loop.remaining = count;
+
+        if (queues.empty())
+        {
+            for (auto i = size_t{0}; i < count; i++)
+            {
+                Execute({&loop, i});
+            }
+        }
+        else
+        {
+            // consecutive jobs go to the same queue, so that a worker runs neighbouring jobs
+            auto queueCount = queues.size();
+            auto start      = next.fetch_add(1, std::memory_order_relaxed);
+            for (auto q = size_t{0}; q < queueCount; q++)
+            {
+                auto first = count * q / queueCount;
+                auto last  = count * (q + 1) / queueCount;
+                if (first == last)
+                {
+                    continue;
+                }
+
+                auto& queue = *queues[(start + q) % queueCount];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                // workers pop from the back, so the first job of the range goes last
+                for (auto i = last; i > first; i--)
+                {
+                    queue.tasks.push_back({&loop, i - 1});
+                }
+            }
+            queued.fetch_add(count, std::memory_order_release);
+            {
+                // taking the lock orders the notification after a worker's check of queued
+                std::lock_guard<std::mutex> lock(mutex);
+            }
+            wake.notify_all();
+
+            // help with any jobs, also of other loops, until there is nothing left to steal
+            auto task = Task{};
+            while (loop.remaining.load(std::memory_order_acquire) > 0 && TrySteal(start, task))
+            {
+                Execute(task);
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(loop.mutex);
+        loop.done.wait(lock, [&loop] () { return loop.remaining.load(std::memory_order_acquire) == 0; });
+        if (loop.error)
+        {
+            std::rethrow_exception(loop.error);
+        }
+    }
+
+    unsigned int JobPool::GetThreadCount() const
+    {
+        return static_cast<unsigned int>(threads.size());
+    }
+
+    void JobPool::Work(unsigned int worker)
+    {
+        auto task = Task{};
+        for (;;)
+        {
+            if (TryPop(worker, task) || TrySteal(worker + 1, task))
+            {
+                Execute(task);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] () { return !running || queued.load(std::memory_order_acquire) > 0; });
+            if (!running)
+            {
+                return;
+            }
+        }
+    }
+
+    bool JobPool::TryPop(unsigned int worker, Task& task)
+    {
+        auto& queue = *queues[worker];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())
+        {
+            return false;
+        }
+        task = queue.tasks.back();
+        queue.tasks.pop_back();
+        queued.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool JobPool::TrySteal(unsigned int start, Task& task)
+    {
+        auto queueCount = static_cast<unsigned int>(queues.size());
+        for (auto i = 0u; i < queueCount; i++)
+        {
+            auto& queue = *queues[(start + i) % queueCount];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty())
+            {
+                task = queue.tasks.front();
+                queue.tasks.pop_front();
+                queued.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void JobPool::Execute(const Task& task)
+    {
+        auto& loop = *task.loop;
+        try
+        {
+            (*loop.job)(task.index);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(loop.mutex);
+            if (!loop.error)
+            {
+                loop.error = std::current_exception();
+            }
+        }
+
+        // the lock keeps Run from returning, and destroying the loop, before the notification
+        std::lock_guard<std::mutex> lock(loop.mutex);
+        if (loop.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            loop.done.notify_all();
+        }
+    }
+}
@@ -0,0 +1,128 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_JOB_POOL_H_
+#define _D12W_JOB_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "defines.h"
+
+namespace d12w
+{
+    /*!
+     * Work Stealing Job Pool
+     *
+     * A pool of worker threads that runs parallel loops. The jobs of a loop
+     * are spread over one queue per worker. Each worker takes jobs from
+     * the back of its own queue and, once it is empty, steals from the
+     * front of the others. So uneven jobs do not leave workers idle while
+     * one still has a long queue. The thread that calls Run works on
+     * the loop too.
+     *
+     * Run may be called from several threads and from within a job.
+     */
+    class D12W_EXPORT JobPool
+    {
+    public:
+        /*!
+         * Create a job pool.
+         *
+         * @param threadCount the number of worker threads, 0 runs all jobs on the calling thread
+         */
+        explicit
+        JobPool(unsigned int threadCount = std::thread::hardware_concurrency());
+
+        JobPool(const JobPool&) = delete;
+
+        /*!
+         * Stop the worker threads.
+         *
+         * No Run may be in progress.
+         */
+        ~JobPool();
+
+        JobPool& operator = (const JobPool&) = delete;
+
+        /*!
+         * Run a parallel loop.
+         *
+         * The call returns when all jobs are done. If jobs throw, the
+         * remaining jobs still run and the first exception is rethrown.
+         *
+         * @param count the number of jobs
+         * @param job the job, called with the indices 0 to count - 1
+         */
+        void Run(size_t count, const std::function<void (size_t)>& job);
+
+        /*!
+         * Get the number of worker threads.
+         *
+         * @return the number of worker threads
+         */
+        unsigned int GetThreadCount() const;
+
+    private:
+        struct Loop
+        {
+            const std::function<void (size_t)>* job;
+            std::atomic<size_t>                 remaining;
+            std::mutex                          mutex;
+            std::condition_variable             done;
+            std::exception_ptr                  error;
+        };
+
+        struct Task
+        {
+            Loop*  loop;
+            size_t index;
+        };
+
+        struct Queue
+        {
+            std::mutex       mutex;
+            std::deque<Task> tasks;
+        };
+
+        std::vector<std::unique_ptr<Queue>> queues;
+        std::atomic<size_t>                 queued = 0;
+        std::atomic<unsigned int>           next   = 0;
+        std::mutex                          mutex;
+        std::condition_variable             wake;
+        bool                                running = true;
+        std::vector<std::thread>            threads;
+
+        void Work(unsigned int worker);
+        bool TryPop(unsigned int worker, Task& task);
+        bool TrySteal(unsigned int start, Task& task);
+        static void Execute(const Task& task);
+    };
+}
+
+#endif
@@ -0,0 +1,122 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_RESULT_H_
+#define _D12W_RESULT_H_
+
+#include <utility>
+
+#include "defines.h"
+#include "util.h"
+
+namespace d12w
+{
+    /*!
+     * Value or HRESULT
+     *
+     * Result is returned by the non-throwing Try* functions of the wrapper.
+     * It holds the HRESULT of the call and the value, which is only valid
+     * if the call succeeded.
+     *
+     * Checking a Result costs a single branch, the exception for Value
+     * is built out of line.
+     */
+    template <typename Type>
+    class D12W_EXPORT Result
+    {
+    public:
+        /*!
+         * Create a result.
+         *
+         * @param hr the HRESULT of the call
+         * @param value the value, only relevant if hr is a success code
+         */
+        Result(HRESULT hr, Type value = Type{}) noexcept
+        : hr(hr), value(std::move(value)) {}
+
+        /*!
+         * Check if the call succeeded.
+         */
+        bool Succeeded() const noexcept
+        {
+            return SUCCEEDED(hr);
+        }
+
+        /*!
+         * Check if the call succeeded.
+         */
+        explicit operator bool () const noexcept
+        {
+            return SUCCEEDED(hr);
+        }
+
+        /*!
+         * Get the HRESULT of the call.
+         */
+        HRESULT GetHr() const noexcept
+        {
+            return hr;
+        }
+
+        /*!
+         * Get the value.
+         *
+         * @return the value
+         *
+         * @throws std::runtime_error if the call failed
+         *
+         * @{
+         */
+        Type& Value() &
+        {
+            D12W_CHECK_SUCCESS(hr);
+            return value;
+        }
+        const Type& Value() const &
+        {
+            D12W_CHECK_SUCCESS(hr);
+            return value;
+        }
+        Type&& Value() &&
+        {
+            D12W_CHECK_SUCCESS(hr);
+            return std::move(value);
+        }
+        /*! @} */
+
+        /*!
+         * Get the value or a fallback if the call failed.
+         *
+         * @param fallback the value to use if the call failed
+         * @return the value or fallback
+         */
+        Type ValueOr(Type fallback) const
+        {
+            return SUCCEEDED(hr) ? value : fallback;
+        }
+
+    private:
+        HRESULT hr;
+        Type    value;
+    };
+}
+
+#endif
@@ -0,0 +1,211 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "util.h"
+
+#ifndef NDEBUG
+
+#ifdef _WIN32
+#include <windows.h>
+#include <dbghelp.h>
+
+#pragma comment(lib, "dbghelp.lib")
+#else
+#include <execinfo.h>
+#include <dlfcn.h>
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+
+namespace d12w::util
+{
+    namespace
+    {
+        std::string basename(const std::string& file)
+        {
+            size_t i = file.find_last_of("\\/");
+            if (i == std::string::npos)
+            {
+                return file;
+            }
+            else
+            {
+                return file.substr(i + 1);
+            }
+        }
+
+        #ifdef _WIN32
+        /*
+         * Process wide DbgHelp symbol engine.
+         *
+         * SymInitialize loads the symbols of all modules and is far too
+         * expensive to be called for each callstack. DbgHelp is also
+         * single threaded, so all calls are serialized.
+         */
+        class SymbolEngine
+        {
+        public:
+            static SymbolEngine& Instance()
+            {
+                static SymbolEngine engine;
+                return engine;
+            }
+
+            std::vector<StackFrame> Symbolize(const CallStack& stack)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+
+                std::vector<StackFrame> frames;
+                frames.reserve(stack.size);
+                for (auto i = 0u; i < stack.size; i++)
+                {
+                    StackFrame f = {};
+                    f.address = reinterpret_cast<uint64_t>(stack.addresses[i]);
+                    auto address = static_cast<DWORD64>(f.address);
+
+                    auto moduleBase = initialized ? SymGetModuleBase64(process, address) : 0;
+                    char moduleBuff[MAX_PATH];
+                    if (moduleBase && GetModuleFileNameA(reinterpret_cast<HMODULE>(moduleBase), moduleBuff, MAX_PATH))
+                    {
+                        f.module = basename(moduleBuff);
+                    }
+                    else
+                    {
+                        f.module = "Unknown Module";
+                    }
+
+                    char symbolBuffer[sizeof(SYMBOL_INFO) + MAX_SYM_NAME];
+                    auto symbol = reinterpret_cast<PSYMBOL_INFO>(symbolBuffer);
+                    symbol->SizeOfStruct = sizeof(SYMBOL_INFO);
+                    symbol->MaxNameLen = MAX_SYM_NAME;
+
+                    DWORD64 offset = 0;
+                    if (initialized && SymFromAddr(process, address, &offset, symbol))
+                    {
+                        f.name = symbol->Name;
+                    }
+                    else
+                    {
+                        f.name = "Unknown Function";
+                    }
+
+                    IMAGEHLP_LINE64 line = {};
+                    line.SizeOfStruct = sizeof(IMAGEHLP_LINE64);
+
+                    DWORD lineOffset = 0;
+                    if (initialized && SymGetLineFromAddr64(process, address, &lineOffset, &line))
+                    {
+                        f.file = line.FileName;
+                        f.line = line.LineNumber;
+                    }
+                    else
+                    {
+                        f.line = 0;
+                    }
+
+                    frames.push_back(f);
+                }
+                return frames;
+            }
+
+        private:
+            std::mutex mutex;
+            HANDLE     process;
+            bool       initialized;
+
+            SymbolEngine()
+            : process(GetCurrentProcess())
+            {
+                SymSetOptions(SYMOPT_LOAD_LINES | SYMOPT_UNDNAME | SYMOPT_DEFERRED_LOADS);
+                initialized = SymInitialize(process, NULL, TRUE) != FALSE;
+            }
+
+            ~SymbolEngine()
+            {
+                if (initialized)
+                {
+                    SymCleanup(process);
+                }
+            }
+        };
+        #endif
+    }
+
+    CallStack CaptureCallStack(unsigned int skip)
+    {
+        auto stack = CallStack{};
+        #ifdef _WIN32
+        stack.size = CaptureStackBackTrace(skip + 1, static_cast<DWORD>(stack.addresses.size()), stack.addresses.data(), NULL);
+        #else
+        void* buffer[128];
+        auto count = static_cast<unsigned int>(backtrace(buffer, 128));
+        for (auto i = skip + 1; i < count && stack.size < stack.addresses.size(); i++)
+        {
+            stack.addresses[stack.size++] = buffer[i];
+        }
+        #endif
+        return stack;
+    }
+
+    std::vector<StackFrame> Symbolize(const CallStack& stack)
+    {
+        #ifdef _WIN32
+        return SymbolEngine::Instance().Symbolize(stack);
+        #else
+        std::vector<StackFrame> frames;
+        frames.reserve(stack.size);
+        for (auto i = 0u; i < stack.size; i++)
+        {
+            StackFrame f = {};
+            f.address = reinterpret_cast<uint64_t>(stack.addresses[i]);
+            f.line = 0;
+            f.module = "Unknown Module";
+            f.name = "Unknown Function";
+
+            Dl_info info = {};
+            if (dladdr(stack.addresses[i], &info))
+            {
+                if (info.dli_fname)
+                {
+                    f.module = basename(info.dli_fname);
+                }
+                if (info.dli_sname)
+                {
+                    auto status = 0;
+                    auto name = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+                    f.name = (status == 0 && name) ? name : info.dli_sname;
+                    std::free(name);
+                }
+            }
+
+            frames.push_back(f);
+        }
+        return frames;
+        #endif
+    }
+
+    std::vector<StackFrame> StackTrace()
+    {
+        return Symbolize(CaptureCallStack(1));
+    }
+}
+
+#endif
@@ -0,0 +1,170 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "BindlessTable.h"
+
+#include <cstdio>
+#include <stdexcept>
+
+#include "../util.h"
+#include "Device.h"
+
+namespace d12w::d3d
+{
+    BindlessTable::BindlessTable(Device& device, uint32_t capacity)
+    : device(device),
+      heap(device.GetShaderVisibleDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV)),
+      range(heap.AllocatePersistent(capacity)),
+      generations(capacity, 0)
+    {
+        // hand out low indices first, it eases debugging
+        freeSlots.resize(capacity);
+        for (auto i = 0u; i < capacity; i++)
+        {
+            freeSlots[i] = capacity - i - 1;
+        }
+    }
+
+    BindlessTable::~BindlessTable()
+    {
+        // the fence of the last use is unknown here, freeing the range
+        // without it could hand it out while the GPU still reads it; the
+        // range is leaked instead and throwing from here would terminate
+#ifndef NDEBUG
+        if (!released)
+        {
+            std::fputs("d12w: BindlessTable destroyed without Release, its descriptor range is leaked.\n", stderr);
+        }
+#endif
+    }
+
+    BindlessHandle BindlessTable::Allocate()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (freeSlots.empty())
+        {
+            D12W_THROW(std::runtime_error, "The bindless table is full.");
+        }
+
+        auto index = freeSlots.back();
+        freeSlots.pop_back();
+        return {index, generations[index]};
+    }
+
+    BindlessHandle BindlessTable::CreateConstantBufferView(const D3D12_CONSTANT_BUFFER_VIEW_DESC& desc)
+    {
+        auto handle = Allocate();
+        device.CreateConstantBufferView(desc, range.GetCpuHandle(handle.index));
+        return handle;
+    }
+
+    BindlessHandle BindlessTable::CreateShaderResourceView(ID3D12Resource* resource, const D3D12_SHADER_RESOURCE_VIEW_DESC* desc)
+    {
+        auto handle = Allocate();
+        device.CreateShaderResourceView(resource, desc, range.GetCpuHandle(handle.index));
+        return handle;
+    }
+
+    BindlessHandle BindlessTable::CreateUnorderedAccessView(ID3D12Resource* resource, ID3D12Resource* counterResource, const D3D12_UNORDERED_ACCESS_VIEW_DESC* desc)
+    {
+        auto handle = Allocate();
+        device.CreateUnorderedAccessView(resource, counterResource, desc, range.GetCpuHandle(handle.index));
+        return handle;
+    }
+
+    void BindlessTable::Free(BindlessHandle handle, UINT64 fenceValue)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (handle.index >= generations.size() || generations[handle.index] != handle.generation)
+        {
+            D12W_THROW(std::logic_error, "Freeing a stale bindless handle.");
+        }
+
+        // invalidate all copies of the handle now, not when the slot is reused
+        generations[handle.index]++;
+        pendingSlots.emplace_back(fenceValue, handle.index);
+    }
+
+    void BindlessTable::Retire(UINT64 completedValue)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto completed = [completedValue] (const std::pair<UINT64, uint32_t>& slot) {
+            return slot.first <= completedValue;
+        };
+
+        // frees usually come in fence order, so the completed ones are in front
+        while (!pendingSlots.empty() && completed(pendingSlots.front()))
+        {
+            freeSlots.push_back(pendingSlots.front().second);
+            pendingSlots.pop_front();
+        }
+        for (auto i = pendingSlots.begin(); i != pendingSlots.end();)
+        {
+            if (completed(*i))
+            {
+                freeSlots.push_back(i->second);
+                i = pendingSlots.erase(i);
+            }
+            else
+            {
+                ++i;
+            }
+        }
+    }
+
+    void BindlessTable::Release(UINT64 fenceValue)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        D12W_ASSERT(!released);
+
+        // pending slots are part of the range, they go back with it
+        heap.FreePersistent(range, fenceValue);
+        released = true;
+    }
+
+    bool BindlessTable::IsValid(BindlessHandle handle) const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return handle.index < generations.size() && generations[handle.index] == handle.generation;
+    }
+
+    D3D12_CPU_DESCRIPTOR_HANDLE BindlessTable::GetCpuHandle(BindlessHandle handle) const
+    {
+        D12W_ASSERT(IsValid(handle));
+        return range.GetCpuHandle(handle.index);
+    }
+
+    D3D12_GPU_DESCRIPTOR_HANDLE BindlessTable::GetGpuHandle() const
+    {
+        return range.gpu;
+    }
+
+    uint32_t BindlessTable::GetHeapIndex(BindlessHandle handle) const
+    {
+        D12W_ASSERT(IsValid(handle));
+        return range.index + handle.index;
+    }
+
+    uint32_t BindlessTable::GetCapacity() const
+    {
+        return range.count;
+    }
+}
@@ -0,0 +1,216 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_BINDLESS_TABLE_H_
+#define _D12W_BINDLESS_TABLE_H_
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+#include <d3d12.h>
+
+#include "../defines.h"
+#include "ShaderVisibleDescriptorHeap.h"
+
+namespace d12w::d3d
+{
+    class Device;
+
+    /*!
+     * Bindless Handle
+     *
+     * The index is stable for the lifetime of the handle and can be passed
+     * to shaders, for example as root constant. The generation detects
+     * handles whose slot was freed.
+     */
+    struct BindlessHandle
+    {
+        uint32_t index      = UINT32_MAX; //!< the index of the descriptor in the table
+        uint32_t generation = 0;          //!< the generation of the slot
+
+        explicit operator bool () const
+        {
+            return index != UINT32_MAX;
+        }
+    };
+
+    /*!
+     * Bindless Resource Table
+     *
+     * A large table of CBV, SRV and UAV descriptors in the persistent region
+     * of the device's shader visible heap. Bind it once per command list
+     * with GetGpuHandle and index it in shaders.
+     *
+     * Freed slots are only reused after the GPU is done with them, so a
+     * slot is never overwritten while a command list may still read it.
+     *
+     * The table is thread safe. Call Release with the fence value of the
+     * last frame that uses the table before destroying it. A table that is
+     * destroyed without Release leaks its range of the heap.
+     */
+    class D12W_EXPORT BindlessTable
+    {
+    public:
+        /*!
+         * Create a bindless table.
+         *
+         * @param device the device, must outlive the table
+         * @param capacity the number of descriptors in the table
+         */
+        BindlessTable(Device& device, uint32_t capacity);
+
+        BindlessTable(const BindlessTable&) = delete;
+
+        /*!
+         * Destroy the table.
+         *
+         * The table must be released, the range is leaked otherwise, since
+         * the GPU may still use it. Debug builds report the leak on stderr.
+         */
+        ~BindlessTable();
+
+        BindlessTable& operator = (const BindlessTable&) = delete;
+
+        /*!
+         * Allocate a slot.
+         *
+         * The descriptor of the slot must be written with GetCpuHandle before
+         * the GPU uses it.
+         *
+         * @return the handle of the slot
+         *
+         * @throws std::runtime_error if all slots are in use
+         */
+        BindlessHandle Allocate();
+
+        /*!
+         * Create a constant buffer view in a new slot.
+         *
+         * @param desc the constant buffer view
+         * @return the handle of the slot
+         */
+        BindlessHandle CreateConstantBufferView(const D3D12_CONSTANT_BUFFER_VIEW_DESC& desc);
+
+        /*!
+         * Create a shader resource view in a new slot.
+         *
+         * @param resource the resource to view
+         * @param desc the view, null to use the default view of the resource
+         * @return the handle of the slot
+         */
+        BindlessHandle CreateShaderResourceView(ID3D12Resource* resource, const D3D12_SHADER_RESOURCE_VIEW_DESC* desc = nullptr);
+
+        /*!
+         * Create an unordered access view in a new slot.
+         *
+         * @param resource the resource to view
+         * @param counterResource the resource of the UAV counter, may be null
+         * @param desc the view, null to use the default view of the resource
+         * @return the handle of the slot
+         */
+        BindlessHandle CreateUnorderedAccessView(ID3D12Resource* resource, ID3D12Resource* counterResource = nullptr, const D3D12_UNORDERED_ACCESS_VIEW_DESC* desc = nullptr);
+
+        /*!
+         * Free a slot.
+         *
+         * The handle becomes invalid at once, the slot is reused once
+         * Retire reports that the fence value was reached.
+         *
+         * @param handle the handle to free
+         * @param fenceValue the fence value of the last frame that uses the slot
+         *
+         * @throws std::logic_error if the handle is stale
+         */
+        void Free(BindlessHandle handle, UINT64 fenceValue);
+
+        /*!
+         * Reuse the slots freed up to a completed fence value.
+         *
+         * @param completedValue the completed value of the frame fence
+         */
+        void Retire(UINT64 completedValue);
+
+        /*!
+         * Release the table.
+         *
+         * The range of the table is returned to the shader visible heap
+         * once the heap's Retire reports that the fence value was reached.
+         * The table must not be used after it is released.
+         *
+         * @param fenceValue the fence value of the last frame that uses the table
+         */
+        void Release(UINT64 fenceValue);
+
+        /*!
+         * Check if a handle still refers to its slot.
+         *
+         * @param handle the handle to check
+         * @return true if the slot was not freed since the handle was allocated
+         */
+        bool IsValid(BindlessHandle handle) const;
+
+        /*!
+         * Get the CPU descriptor of a slot.
+         *
+         * @param handle the handle of the slot
+         * @return the CPU handle to write the descriptor to
+         */
+        D3D12_CPU_DESCRIPTOR_HANDLE GetCpuHandle(BindlessHandle handle) const;
+
+        /*!
+         * Get the GPU handle of the table.
+         *
+         * @return the GPU handle to bind as descriptor table
+         */
+        D3D12_GPU_DESCRIPTOR_HANDLE GetGpuHandle() const;
+
+        /*!
+         * Get the index of a slot in the shader visible heap.
+         *
+         * Use this index with ResourceDescriptorHeap in Shader Model 6.6.
+         *
+         * @param handle the handle of the slot
+         * @return the heap index
+         */
+        uint32_t GetHeapIndex(BindlessHandle handle) const;
+
+        /*!
+         * Get the number of slots in the table.
+         *
+         * @return the number of slots
+         */
+        uint32_t GetCapacity() const;
+
+    private:
+        Device&                                 device;
+        ShaderVisibleDescriptorHeap&            heap;
+        DescriptorRange                         range;
+
+        mutable std::mutex                      mutex;
+        std::vector<uint32_t>                   generations;
+        std::vector<uint32_t>                   freeSlots;
+        std::deque<std::pair<UINT64, uint32_t>> pendingSlots;
+        bool                                    released = false;
+    };
+}
+
+#endif
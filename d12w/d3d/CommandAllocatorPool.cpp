@@ -0,0 +1,102 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "CommandAllocatorPool.h"
+
+#include <algorithm>
+
+#include "../util.h"
+#include "Device.h"
+
+namespace d12w::d3d
+{
+    CommandAllocatorPool::CommandAllocatorPool(Device& device, D3D12_COMMAND_LIST_TYPE type)
+    : device(device), type(type) {}
+
+    ComPtr<ID3D12CommandAllocator> CommandAllocatorPool::Acquire()
+    {
+        auto allocator = ComPtr<ID3D12CommandAllocator>{};
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stats.acquired++;
+            if (!available.empty())
+            {
+                allocator = std::move(available.back());
+                available.pop_back();
+                idleCount = std::min(idleCount, available.size());
+            }
+            else
+            {
+                stats.created++;
+            }
+        }
+
+        // creating and resetting is done outside the lock, so that recording threads do not wait on each other
+        if (allocator)
+        {
+            auto hr = allocator->Reset();
+            D12W_CHECK_SUCCESS(hr);
+        }
+        else
+        {
+            allocator = device.CreateCommandAllocator(type);
+        }
+        return allocator;
+    }
+
+    void CommandAllocatorPool::Release(ComPtr<ID3D12CommandAllocator> allocator, UINT64 fenceValue)
+    {
+        D12W_ASSERT(allocator);
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.emplace_back(fenceValue, std::move(allocator));
+    }
+
+    void CommandAllocatorPool::Retire(UINT64 completedValue)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // allocators released out of fence order are made available late, never early
+        while (!pending.empty() && pending.front().first <= completedValue)
+        {
+            available.push_back(std::move(pending.front().second));
+            pending.pop_front();
+        }
+    }
+
+    void CommandAllocatorPool::Trim()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // available is used as a stack, the allocators at the bottom were idle the longest
+        available.erase(available.begin(), available.begin() + idleCount);
+        stats.trimmed += idleCount;
+        idleCount = available.size();
+    }
+
+    D3D12_COMMAND_LIST_TYPE CommandAllocatorPool::GetType() const
+    {
+        return type;
+    }
+
+    CommandAllocatorPoolStats CommandAllocatorPool::GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return stats;
+    }
+}
@@ -0,0 +1,137 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_COMMAND_ALLOCATOR_POOL_H_
+#define _D12W_COMMAND_ALLOCATOR_POOL_H_
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+#include <d3d12.h>
+
+#include "../defines.h"
+#include "../ComPtr.h"
+
+namespace d12w::d3d
+{
+    class Device;
+
+    /*!
+     * Command Allocator Pool Statistics
+     */
+    struct CommandAllocatorPoolStats
+    {
+        uint64_t acquired = 0; //!< the number of allocators handed out
+        uint64_t created  = 0; //!< the number of allocators created
+        uint64_t trimmed  = 0; //!< the number of idle allocators released by Trim
+    };
+
+    /*!
+     * Command Allocator Pool
+     *
+     * A command allocator can only be reset once the GPU finished all
+     * command lists recorded with it. The pool hands out allocators to
+     * recording threads and takes them back tagged with the fence value of
+     * their last submission. Allocators are reset and handed out again once
+     * that value completed. The pool grows when all allocators are in
+     * flight.
+     *
+     * Each recording thread acquires its own allocator, so recording is not
+     * serialized on one allocator per frame.
+     *
+     * The pool is thread safe.
+     */
+    class D12W_EXPORT CommandAllocatorPool
+    {
+    public:
+        /*!
+         * Create a pool.
+         *
+         * @param device the device, must outlive the pool
+         * @param type the type of command lists the allocators are for
+         */
+        CommandAllocatorPool(Device& device, D3D12_COMMAND_LIST_TYPE type);
+
+        CommandAllocatorPool(const CommandAllocatorPool&) = delete;
+
+        CommandAllocatorPool& operator = (const CommandAllocatorPool&) = delete;
+
+        /*!
+         * Get an allocator to record with.
+         *
+         * @return a reset allocator
+         */
+        ComPtr<ID3D12CommandAllocator> Acquire();
+
+        /*!
+         * Return an allocator to the pool.
+         *
+         * @param allocator the allocator
+         * @param fenceValue the fence value after which the GPU finished the command lists recorded with it
+         */
+        void Release(ComPtr<ID3D12CommandAllocator> allocator, UINT64 fenceValue);
+
+        /*!
+         * Make all allocators whose fence value completed available.
+         *
+         * @param completedValue the completed value of the fence
+         */
+        void Retire(UINT64 completedValue);
+
+        /*!
+         * Release idle allocators.
+         *
+         * Allocators that stayed unused since the last call are released.
+         * Called once every few seconds, the pool shrinks back after a
+         * peak.
+         */
+        void Trim();
+
+        /*!
+         * Get the type of command lists the allocators are for.
+         *
+         * @return the command list type
+         */
+        D3D12_COMMAND_LIST_TYPE GetType() const;
+
+        /*!
+         * Get the statistics since creation.
+         *
+         * The creations avoided by the pool are acquired minus created.
+         *
+         * @return the statistics
+         */
+        CommandAllocatorPoolStats GetStats() const;
+
+    private:
+        Device&                                                       device;
+        D3D12_COMMAND_LIST_TYPE                                       type;
+
+        mutable std::mutex                                            mutex;
+        std::deque<std::pair<UINT64, ComPtr<ID3D12CommandAllocator>>> pending;
+        std::vector<ComPtr<ID3D12CommandAllocator>>                   available;
+        size_t                                                        idleCount = 0;
+        CommandAllocatorPoolStats                                     stats;
+    };
+}
+
+#endif
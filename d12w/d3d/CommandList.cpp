@@ -0,0 +1,127 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "CommandList.h"
+
+#include "../util.h"
+#include "Device.h"
+
+namespace d12w::d3d
+{
+    CommandList::CommandList(Device& device, D3D12_COMMAND_LIST_TYPE type, ID3D12CommandAllocator* allocator, ID3D12PipelineState* initialState)
+    : list(device.CreateCommandList(type, allocator, initialState)) {}
+
+    CommandList::CommandList(ComPtr<ID3D12GraphicsCommandList> l)
+    : list(std::move(l))
+    {
+        D12W_ASSERT(list);
+    }
+
+    D3D12_COMMAND_LIST_TYPE CommandList::GetType() const
+    {
+        return list.Get()->GetType();
+    }
+
+    ID3D12GraphicsCommandList* CommandList::GetCommandList() const
+    {
+        return list.Get();
+    }
+
+    void CommandList::Reset(ID3D12CommandAllocator* allocator, ID3D12PipelineState* initialState)
+    {
+        auto hr = list->Reset(allocator, initialState);
+        D12W_CHECK_SUCCESS(hr);
+        tracker.Reset();
+    }
+
+    void CommandList::Close()
+    {
+        FlushBarriers();
+        auto hr = list->Close();
+        D12W_CHECK_SUCCESS(hr);
+    }
+
+    void CommandList::Transition(Resource& resource, D3D12_RESOURCE_STATES state, UINT subresource)
+    {
+        tracker.Transition(resource, state, subresource);
+    }
+
+    void CommandList::UavBarrier(Resource* resource)
+    {
+        tracker.UavBarrier(resource);
+    }
+
+    void CommandList::FlushBarriers()
+    {
+        tracker.Flush(list.Get());
+    }
+
+    void CommandList::ResolveBarriers(std::vector<D3D12_RESOURCE_BARRIER>& barriers) const
+    {
+        tracker.Resolve(barriers);
+    }
+
+    void CommandList::ResourceBarrier(UINT count, const D3D12_RESOURCE_BARRIER* barriers)
+    {
+        FlushBarriers();
+        list->ResourceBarrier(count, barriers);
+    }
+
+    void CommandList::CopyResource(ID3D12Resource* dest, ID3D12Resource* src)
+    {
+        FlushBarriers();
+        list->CopyResource(dest, src);
+    }
+
+    void CommandList::CopyBufferRegion(ID3D12Resource* dest, UINT64 destOffset, ID3D12Resource* src, UINT64 srcOffset, UINT64 size)
+    {
+        FlushBarriers();
+        list->CopyBufferRegion(dest, destOffset, src, srcOffset, size);
+    }
+
+    void CommandList::SetDescriptorHeaps(UINT count, ID3D12DescriptorHeap* const* heaps)
+    {
+        list->SetDescriptorHeaps(count, heaps);
+    }
+
+    void CommandList::SetPipelineState(ID3D12PipelineState* state)
+    {
+        list->SetPipelineState(state);
+    }
+
+    void CommandList::DrawInstanced(UINT vertexCount, UINT instanceCount, UINT startVertex, UINT startInstance)
+    {
+        FlushBarriers();
+        list->DrawInstanced(vertexCount, instanceCount, startVertex, startInstance);
+    }
+
+    void CommandList::DrawIndexedInstanced(UINT indexCount, UINT instanceCount, UINT startIndex, INT baseVertex, UINT startInstance)
+    {
+        FlushBarriers();
+        list->DrawIndexedInstanced(indexCount, instanceCount, startIndex, baseVertex, startInstance);
+    }
+
+    void CommandList::Dispatch(UINT x, UINT y, UINT z)
+    {
+        FlushBarriers();
+        list->Dispatch(x, y, z);
+    }
+}
@@ -0,0 +1,219 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_COMMAND_LIST_H_
+#define _D12W_COMMAND_LIST_H_
+
+#include <vector>
+#include <d3d12.h>
+
+#include "../defines.h"
+#include "../ComPtr.h"
+#include "ResourceStateTracker.h"
+
+namespace d12w::d3d
+{
+    class Device;
+    class Resource;
+
+    /*!
+     * Direct3D 12 Command List
+     *
+     * This wrapper implements ID3D12GraphicsCommandList. Commands that are
+     * not wrapped yet can be recorded on GetCommandList.
+     *
+     * Resource states are tracked with Transition. The barriers are
+     * collected and issued in one call before the next draw, dispatch or
+     * copy, the barriers into the states the list starts with are made by
+     * the CommandQueue when the list is submitted.
+     *
+     * A command list must only be used by one thread at a time.
+     */
+    class D12W_EXPORT CommandList
+    {
+    public:
+        /*!
+         * Create a command list.
+         *
+         * The list is created open, ready to record.
+         *
+         * @param device the device to create the list on
+         * @param type the type of the list
+         * @param allocator the allocator to record with, of the same type
+         * @param initialState the initial pipeline state, may be null
+         */
+        CommandList(Device& device, D3D12_COMMAND_LIST_TYPE type, ID3D12CommandAllocator* allocator, ID3D12PipelineState* initialState = nullptr);
+
+        /*!
+         * Wrap an existing command list.
+         *
+         * This allows to use an alternative implementation, like the null backend.
+         *
+         * @param list the command list to wrap
+         */
+        explicit
+        CommandList(ComPtr<ID3D12GraphicsCommandList> list);
+
+        CommandList(const CommandList&) = delete;
+
+        CommandList& operator = (const CommandList&) = delete;
+
+        /*!
+         * Get the type of the list.
+         *
+         * @return the command list type
+         */
+        D3D12_COMMAND_LIST_TYPE GetType() const;
+
+        /*!
+         * Get the wrapped command list.
+         *
+         * @return the command list
+         */
+        ID3D12GraphicsCommandList* GetCommandList() const;
+
+        /*!
+         * Reset a closed list, to record it again.
+         *
+         * The list may be reset while the GPU still executes it, the allocator
+         * must not be in use by the GPU.
+         *
+         * @param allocator the allocator to record with
+         * @param initialState the initial pipeline state, may be null
+         */
+        void Reset(ID3D12CommandAllocator* allocator, ID3D12PipelineState* initialState = nullptr);
+
+        /*!
+         * Finish recording.
+         *
+         * Collected barriers are issued.
+         */
+        void Close();
+
+        /*!
+         * Require a resource to be in a state for the next commands.
+         *
+         * @param resource the resource
+         * @param state the required state
+         * @param subresource the subresource index or D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES
+         */
+        void Transition(Resource& resource, D3D12_RESOURCE_STATES state, UINT subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES);
+
+        /*!
+         * Require unordered access writes to finish before the next commands.
+         *
+         * @param resource the resource, null for all resources
+         */
+        void UavBarrier(Resource* resource = nullptr);
+
+        /*!
+         * Issue the collected barriers now.
+         */
+        void FlushBarriers();
+
+        /*!
+         * Resolve the states the list starts with against the resources.
+         *
+         * This is called by CommandQueue when the list is submitted.
+         *
+         * @param barriers receives the barriers to execute before the list
+         */
+        void ResolveBarriers(std::vector<D3D12_RESOURCE_BARRIER>& barriers) const;
+
+        /*!
+         * Notifies the driver that it needs to synchronize multiple accesses to resources.
+         *
+         * @param count the number of barriers
+         * @param barriers the barriers
+         */
+        void ResourceBarrier(UINT count, const D3D12_RESOURCE_BARRIER* barriers);
+
+        /*!
+         * Copies the entire contents of the source resource to the destination resource.
+         *
+         * @param dest the destination resource
+         * @param src the source resource
+         */
+        void CopyResource(ID3D12Resource* dest, ID3D12Resource* src);
+
+        /*!
+         * Copies a region of a buffer from one resource to another.
+         *
+         * @param dest the destination buffer
+         * @param destOffset the offset in the destination in bytes
+         * @param src the source buffer
+         * @param srcOffset the offset in the source in bytes
+         * @param size the number of bytes to copy
+         */
+        void CopyBufferRegion(ID3D12Resource* dest, UINT64 destOffset, ID3D12Resource* src, UINT64 srcOffset, UINT64 size);
+
+        /*!
+         * Changes the currently bound descriptor heaps.
+         *
+         * @param count the number of heaps, at most one per type
+         * @param heaps the shader visible heaps
+         */
+        void SetDescriptorHeaps(UINT count, ID3D12DescriptorHeap* const* heaps);
+
+        /*!
+         * Sets all shaders and most of the fixed-function state of the pipeline.
+         *
+         * @param state the pipeline state
+         */
+        void SetPipelineState(ID3D12PipelineState* state);
+
+        /*!
+         * Draws non-indexed, instanced primitives.
+         *
+         * @param vertexCount the number of vertices per instance
+         * @param instanceCount the number of instances
+         * @param startVertex the first vertex
+         * @param startInstance the first instance
+         */
+        void DrawInstanced(UINT vertexCount, UINT instanceCount = 1, UINT startVertex = 0, UINT startInstance = 0);
+
+        /*!
+         * Draws indexed, instanced primitives.
+         *
+         * @param indexCount the number of indices per instance
+         * @param instanceCount the number of instances
+         * @param startIndex the first index
+         * @param baseVertex the value added to each index
+         * @param startInstance the first instance
+         */
+        void DrawIndexedInstanced(UINT indexCount, UINT instanceCount = 1, UINT startIndex = 0, INT baseVertex = 0, UINT startInstance = 0);
+
+        /*!
+         * Executes a compute shader on a grid of thread groups.
+         *
+         * @param x the number of thread groups in x
+         * @param y the number of thread groups in y
+         * @param z the number of thread groups in z
+         */
+        void Dispatch(UINT x, UINT y = 1, UINT z = 1);
+
+    private:
+        ComPtr<ID3D12GraphicsCommandList> list;
+        ResourceStateTracker              tracker;
+    };
+}
+
+#endif
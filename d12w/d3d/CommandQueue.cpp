@@ -0,0 +1,194 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "CommandQueue.h"
+
+#include <stdexcept>
+#include <vector>
+
+#include "../util.h"
+#include "Device.h"
+#include "CommandList.h"
+#include "CommandAllocatorPool.h"
+
+namespace d12w::d3d
+{
+    namespace
+    {
+        ComPtr<ID3D12CommandQueue> CreateQueue(Device& device, D3D12_COMMAND_LIST_TYPE type, D3D12_COMMAND_QUEUE_PRIORITY priority)
+        {
+            auto desc = D3D12_COMMAND_QUEUE_DESC{};
+            desc.Type     = type;
+            desc.Priority = priority;
+            desc.Flags    = D3D12_COMMAND_QUEUE_FLAG_NONE;
+            return device.CreateCommandQueue(desc);
+        }
+    }
+
+    CommandQueue::CommandQueue(Device& device, D3D12_COMMAND_LIST_TYPE type, D3D12_COMMAND_QUEUE_PRIORITY priority)
+    : CommandQueue(CreateQueue(device, type, priority), device.CreateFence(), &device) {}
+
+    CommandQueue::CommandQueue(ComPtr<ID3D12CommandQueue> q, ComPtr<ID3D12Fence> f, Device* d)
+    : queue(std::move(q)), fence(std::move(f)), device(d)
+    {
+        D12W_ASSERT(queue);
+        D12W_ASSERT(fence);
+        type = queue->GetDesc().Type;
+        lastValue = fence->GetCompletedValue();
+    }
+
+    CommandQueue::~CommandQueue() = default;
+
+    D3D12_COMMAND_LIST_TYPE CommandQueue::GetType() const
+    {
+        return type;
+    }
+
+    ID3D12CommandQueue* CommandQueue::GetCommandQueue() const
+    {
+        return queue.Get();
+    }
+
+    ID3D12Fence* CommandQueue::GetFence() const
+    {
+        return fence.Get();
+    }
+
+    void CommandQueue::ExecuteCommandLists(UINT count, ID3D12CommandList* const* lists)
+    {
+        queue->ExecuteCommandLists(count, lists);
+    }
+
+    void CommandQueue::ExecuteCommandLists(UINT count, CommandList* const* lists)
+    {
+        auto raw      = std::vector<ID3D12CommandList*>{};
+        auto barriers = std::vector<D3D12_RESOURCE_BARRIER>{};
+        auto fixups   = size_t{0};
+        raw.reserve(count);
+
+        // the lock keeps the resolved states in the order the lists execute
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto i = 0u; i < count; i++)
+        {
+            barriers.clear();
+            lists[i]->ResolveBarriers(barriers);
+            if (!barriers.empty())
+            {
+                raw.push_back(RecordFixup(fixups++, barriers)->GetCommandList());
+            }
+            raw.push_back(lists[i]->GetCommandList());
+        }
+        queue->ExecuteCommandLists(static_cast<UINT>(raw.size()), raw.data());
+
+        if (fixups > 0)
+        {
+            // the fixup allocators were released at this value
+            SignalUnlocked();
+        }
+    }
+
+    UINT64 CommandQueue::Signal()
+    {
+        // the lock keeps the signals in the order of their values
+        std::lock_guard<std::mutex> lock(mutex);
+        return SignalUnlocked();
+    }
+
+    void CommandQueue::Wait(const CommandQueue& other, UINT64 value)
+    {
+        auto hr = queue->Wait(other.fence.Get(), value);
+        D12W_CHECK_SUCCESS(hr);
+    }
+
+    UINT64 CommandQueue::GetLastSignaledValue() const
+    {
+        return lastValue.load(std::memory_order_acquire);
+    }
+
+    UINT64 CommandQueue::GetCompletedValue() const
+    {
+        return fence.Get()->GetCompletedValue();
+    }
+
+    bool CommandQueue::IsComplete(UINT64 value) const
+    {
+        return fence.Get()->GetCompletedValue() >= value;
+    }
+
+    void CommandQueue::WaitForValue(UINT64 value)
+    {
+        if (IsComplete(value))
+        {
+            return;
+        }
+
+        // without an event SetEventOnCompletion blocks until the value is reached
+        auto hr = fence->SetEventOnCompletion(value, nullptr);
+        D12W_CHECK_SUCCESS(hr);
+    }
+
+    void CommandQueue::WaitForIdle()
+    {
+        WaitForValue(Signal());
+    }
+
+    // mutex must be held
+    CommandList* CommandQueue::RecordFixup(size_t index, const std::vector<D3D12_RESOURCE_BARRIER>& barriers)
+    {
+        if (device == nullptr)
+        {
+            D12W_THROW(std::logic_error, "Resource states need barriers, but the command queue has no device to record them.");
+        }
+
+        if (!fixupAllocators)
+        {
+            fixupAllocators = std::make_unique<CommandAllocatorPool>(*device, type);
+        }
+        fixupAllocators->Retire(fence->GetCompletedValue());
+
+        // ExecuteCommandLists signals the next value after the lists, the allocator is free once it is reached
+        auto allocator = fixupAllocators->Acquire();
+        if (index < fixupLists.size())
+        {
+            fixupLists[index]->Reset(allocator.Get());
+        }
+        else
+        {
+            fixupLists.push_back(std::make_unique<CommandList>(*device, type, allocator.Get()));
+        }
+        fixupAllocators->Release(allocator, lastValue.load(std::memory_order_relaxed) + 1);
+
+        auto list = fixupLists[index].get();
+        list->ResourceBarrier(static_cast<UINT>(barriers.size()), barriers.data());
+        list->Close();
+        return list;
+    }
+
+    // mutex must be held
+    UINT64 CommandQueue::SignalUnlocked()
+    {
+        auto value = lastValue.load(std::memory_order_relaxed) + 1;
+        auto hr = queue->Signal(fence.Get(), value);
+        D12W_CHECK_SUCCESS(hr);
+        lastValue.store(value, std::memory_order_release);
+        return value;
+    }
+}
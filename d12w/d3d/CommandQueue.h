@@ -0,0 +1,193 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_COMMAND_QUEUE_H_
+#define _D12W_COMMAND_QUEUE_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <d3d12.h>
+
+#include "../defines.h"
+#include "../ComPtr.h"
+
+namespace d12w::d3d
+{
+    class Device;
+    class CommandList;
+    class CommandAllocatorPool;
+
+    /*!
+     * Direct3D 12 Command Queue
+     *
+     * This wrapper implements ID3D12CommandQueue together with a fence
+     * that tracks the progress of the queue. Signal advances the fence
+     * value, the returned value marks all work submitted so far.
+     *
+     * When CommandList objects are submitted, the states their tracked
+     * resources start in are resolved against the states the resources are
+     * in. Needed barriers are recorded on small command lists of the queue
+     * that execute right before each list. A submission that needed such
+     * barriers is followed by a signal, which recycles their allocators.
+     *
+     * The queue is thread safe.
+     */
+    class D12W_EXPORT CommandQueue
+    {
+    public:
+        /*!
+         * Create a command queue.
+         *
+         * @param device the device to create the queue on
+         * @param type the type of command lists the queue executes
+         * @param priority the priority of the queue
+         */
+        CommandQueue(Device& device, D3D12_COMMAND_LIST_TYPE type, D3D12_COMMAND_QUEUE_PRIORITY priority = D3D12_COMMAND_QUEUE_PRIORITY_NORMAL);
+
+        /*!
+         * Wrap an existing command queue.
+         *
+         * This allows to use an alternative implementation, like the null backend.
+         *
+         * @param queue the command queue to wrap
+         * @param fence the fence to track the progress of the queue
+         * @param device the device to record resolved barriers with, without it submitting lists that need barriers throws
+         */
+        CommandQueue(ComPtr<ID3D12CommandQueue> queue, ComPtr<ID3D12Fence> fence, Device* device = nullptr);
+
+        CommandQueue(const CommandQueue&) = delete;
+
+        ~CommandQueue();
+
+        CommandQueue& operator = (const CommandQueue&) = delete;
+
+        /*!
+         * Get the type of command lists the queue executes.
+         *
+         * @return the command list type
+         */
+        D3D12_COMMAND_LIST_TYPE GetType() const;
+
+        /*!
+         * Get the wrapped command queue.
+         *
+         * @return the command queue
+         */
+        ID3D12CommandQueue* GetCommandQueue() const;
+
+        /*!
+         * Get the fence that tracks the progress of the queue.
+         *
+         * @return the fence
+         */
+        ID3D12Fence* GetFence() const;
+
+        /*!
+         * Submits command lists for execution.
+         *
+         * @param count the number of lists
+         * @param lists the closed command lists, executed in order
+         */
+        void ExecuteCommandLists(UINT count, ID3D12CommandList* const* lists);
+
+        /*!
+         * Submits command lists for execution.
+         *
+         * The resource states of the lists are resolved, in the order the
+         * lists execute. If barriers were needed, the fence is signaled
+         * after the lists.
+         *
+         * @param count the number of lists
+         * @param lists the closed command lists, executed in order
+         * @throws std::logic_error if barriers are needed and the queue has no device
+         */
+        void ExecuteCommandLists(UINT count, CommandList* const* lists);
+
+        /*!
+         * Signal the fence of the queue.
+         *
+         * @return the fence value, reached once the GPU finished all work submitted before
+         */
+        UINT64 Signal();
+
+        /*!
+         * Make the queue wait for another queue.
+         *
+         * The wait happens on the GPU, work submitted afterwards starts
+         * once the other queue reached the value.
+         *
+         * @param other the queue to wait for
+         * @param value the fence value of the other queue
+         */
+        void Wait(const CommandQueue& other, UINT64 value);
+
+        /*!
+         * Get the last value the queue signaled.
+         *
+         * @return the last signaled fence value
+         */
+        UINT64 GetLastSignaledValue() const;
+
+        /*!
+         * Get the value the GPU completed.
+         *
+         * @return the completed fence value
+         */
+        UINT64 GetCompletedValue() const;
+
+        /*!
+         * Check if the GPU reached a fence value.
+         *
+         * @param value the fence value
+         * @return true if the value is completed
+         */
+        bool IsComplete(UINT64 value) const;
+
+        /*!
+         * Block the calling thread until the GPU reached a fence value.
+         *
+         * @param value the fence value
+         */
+        void WaitForValue(UINT64 value);
+
+        /*!
+         * Block the calling thread until the GPU finished all submitted work.
+         */
+        void WaitForIdle();
+
+    private:
+        ComPtr<ID3D12CommandQueue>                queue;
+        ComPtr<ID3D12Fence>                       fence;
+        D3D12_COMMAND_LIST_TYPE                   type;
+        std::mutex                                mutex;
+        std::atomic<UINT64>                       lastValue = 0;
+        Device*                                   device    = nullptr;
+        std::unique_ptr<CommandAllocatorPool>     fixupAllocators;
+        std::vector<std::unique_ptr<CommandList>> fixupLists;
+
+        CommandList* RecordFixup(size_t index, const std::vector<D3D12_RESOURCE_BARRIER>& barriers);
+        UINT64 SignalUnlocked();
+    };
+}
+
+#endif
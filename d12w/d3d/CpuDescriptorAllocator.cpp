@@ -0,0 +1,310 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "CpuDescriptorAllocator.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "../util.h"
+
+namespace d12w::d3d
+{
+    namespace
+    {
+        constexpr auto NONE           = UINT32_MAX;
+        constexpr auto MAX_PAGES      = 4096u;
+        constexpr auto CACHE_SIZE     = 64u;
+        constexpr auto CACHE_TRANSFER = CACHE_SIZE / 2;
+
+        std::atomic<uint64_t> nextCoreId = 1;
+
+        // The free list head is an index and a tag, the tag changes with
+        // every update, so that a compare exchange fails on ABA.
+        uint64_t Pack(uint32_t index, uint32_t tag)
+        {
+            return (uint64_t{tag} << 32) | index;
+        }
+
+        uint32_t IndexOf(uint64_t head)
+        {
+            return static_cast<uint32_t>(head);
+        }
+
+        uint32_t TagOf(uint64_t head)
+        {
+            return static_cast<uint32_t>(head >> 32);
+        }
+    }
+
+    struct CpuDescriptorAllocator::Core
+    {
+        struct Page
+        {
+            ComPtr<ID3D12DescriptorHeap>             heap;
+            SIZE_T                                   start = 0;
+            std::unique_ptr<std::atomic<uint32_t>[]> next;
+        };
+
+        ComPtr<ID3D12Device>                      device;
+        D3D12_DESCRIPTOR_HEAP_TYPE                type;
+        uint32_t                                  pageSize;
+        uint32_t                                  pageShift = 0;
+        UINT                                      incrementSize;
+        uint64_t                                  id = nextCoreId.fetch_add(1);
+
+        std::atomic<uint64_t>                     freeList = Pack(NONE, 0);
+        std::array<std::atomic<Page*>, MAX_PAGES> pages = {};
+        std::atomic<uint32_t>                     pageCount = 0;
+
+        std::mutex                                growMutex;
+        std::vector<std::unique_ptr<Page>>        storage;
+
+        Core(ComPtr<ID3D12Device> device, D3D12_DESCRIPTOR_HEAP_TYPE type, uint32_t pageSize)
+        : device(std::move(device)), type(type), pageSize(pageSize)
+        {
+            while ((uint32_t{1} << pageShift) < pageSize)
+            {
+                pageShift++;
+            }
+            incrementSize = this->device->GetDescriptorHandleIncrementSize(type);
+        }
+
+        Page& GetPage(uint32_t index)
+        {
+            return *pages[index >> pageShift].load(std::memory_order_acquire);
+        }
+
+        std::atomic<uint32_t>& Next(uint32_t index)
+        {
+            return GetPage(index).next[index & (pageSize - 1)];
+        }
+
+        D3D12_CPU_DESCRIPTOR_HANDLE GetHandle(uint32_t index)
+        {
+            return {GetPage(index).start + (index & (pageSize - 1)) * incrementSize};
+        }
+
+        // Pop up to max linked descriptors at once. If the head did not
+        // change, neither did the chain below it, so one exchange suffices.
+        uint32_t Pop(uint32_t* indices, uint32_t max)
+        {
+            auto head = freeList.load(std::memory_order_acquire);
+            for (;;)
+            {
+                auto index = IndexOf(head);
+                if (index == NONE)
+                {
+                    return 0;
+                }
+
+                auto count = 0u;
+                indices[count++] = index;
+                auto next = Next(index).load(std::memory_order_relaxed);
+                while (count < max && next != NONE)
+                {
+                    indices[count++] = next;
+                    next = Next(next).load(std::memory_order_relaxed);
+                }
+
+                if (freeList.compare_exchange_weak(head, Pack(next, TagOf(head) + 1), std::memory_order_acquire, std::memory_order_acquire))
+                {
+                    return count;
+                }
+            }
+        }
+
+        // Push a chain of descriptors, that is already linked from first to last.
+        void Push(uint32_t first, uint32_t last)
+        {
+            auto head = freeList.load(std::memory_order_relaxed);
+            do
+            {
+                Next(last).store(IndexOf(head), std::memory_order_relaxed);
+            }
+            while (!freeList.compare_exchange_weak(head, Pack(first, TagOf(head) + 1), std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        uint32_t Acquire(uint32_t* indices, uint32_t max)
+        {
+            for (;;)
+            {
+                auto count = Pop(indices, max);
+                if (count != 0)
+                {
+                    return count;
+                }
+                Grow();
+            }
+        }
+
+        void Release(const uint32_t* indices, uint32_t count)
+        {
+            if (count == 0)
+            {
+                return;
+            }
+            for (auto i = 0u; i + 1 < count; i++)
+            {
+                Next(indices[i]).store(indices[i + 1], std::memory_order_relaxed);
+            }
+            Push(indices[0], indices[count - 1]);
+        }
+
+        void Grow()
+        {
+            std::lock_guard<std::mutex> lock(growMutex);
+            if (IndexOf(freeList.load(std::memory_order_acquire)) != NONE)
+            {
+                // an other thread added a page or freed descriptors
+                return;
+            }
+
+            auto count = pageCount.load(std::memory_order_relaxed);
+            if (count == MAX_PAGES)
+            {
+                D12W_THROW(std::runtime_error, "The CPU descriptor allocator is out of pages.");
+            }
+
+            auto page = std::make_unique<Page>();
+            auto desc = D3D12_DESCRIPTOR_HEAP_DESC{type, pageSize, D3D12_DESCRIPTOR_HEAP_FLAG_NONE, 0};
+            auto hr = device->CreateDescriptorHeap(&desc, page->heap.UUID(), reinterpret_cast<void**>(&page->heap));
+            D12W_CHECK_SUCCESS(hr);
+            page->start = page->heap->GetCPUDescriptorHandleForHeapStart().ptr;
+
+            auto first = count * pageSize;
+            page->next = std::make_unique<std::atomic<uint32_t>[]>(pageSize);
+            for (auto i = 0u; i < pageSize; i++)
+            {
+                page->next[i].store(first + i + 1, std::memory_order_relaxed);
+            }
+
+            pages[count].store(page.get(), std::memory_order_release);
+            pageCount.store(count + 1, std::memory_order_release);
+            storage.push_back(std::move(page));
+
+            Push(first, first + pageSize - 1);
+        }
+    };
+
+    struct CpuDescriptorAllocator::ThreadCache
+    {
+        uint64_t                         id = 0;
+        std::weak_ptr<Core>              core;
+        uint32_t                         count = 0;
+        std::array<uint32_t, CACHE_SIZE> indices;
+
+        ~ThreadCache()
+        {
+            // return the cached descriptors, unless the allocator is gone
+            if (auto owner = core.lock())
+            {
+                owner->Release(indices.data(), count);
+            }
+        }
+    };
+
+    CpuDescriptorAllocator::CpuDescriptorAllocator(ComPtr<ID3D12Device> device, D3D12_DESCRIPTOR_HEAP_TYPE type, uint32_t pageSize)
+    {
+        D12W_ASSERT(device);
+        D12W_ASSERT(pageSize != 0 && (pageSize & (pageSize - 1)) == 0);
+        core = std::make_shared<Core>(std::move(device), type, pageSize);
+    }
+
+    CpuDescriptorAllocator::~CpuDescriptorAllocator() = default;
+
+    CpuDescriptor CpuDescriptorAllocator::Allocate()
+    {
+        auto& cache = GetThreadCache(core);
+        if (cache.count == 0)
+        {
+            cache.count = core->Acquire(cache.indices.data(), CACHE_TRANSFER);
+        }
+
+        auto index = cache.indices[--cache.count];
+        return {core->GetHandle(index), index};
+    }
+
+    void CpuDescriptorAllocator::Free(CpuDescriptor descriptor)
+    {
+        D12W_ASSERT(descriptor);
+        auto& cache = GetThreadCache(core);
+        if (cache.count == CACHE_SIZE)
+        {
+            cache.count -= CACHE_TRANSFER;
+            core->Release(cache.indices.data() + cache.count, CACHE_TRANSFER);
+        }
+        cache.indices[cache.count++] = descriptor.index;
+    }
+
+    D3D12_DESCRIPTOR_HEAP_TYPE CpuDescriptorAllocator::GetType() const
+    {
+        return core->type;
+    }
+
+    uint32_t CpuDescriptorAllocator::GetCapacity() const
+    {
+        return GetPageCount() * core->pageSize;
+    }
+
+    uint32_t CpuDescriptorAllocator::GetPageCount() const
+    {
+        return core->pageCount.load(std::memory_order_acquire);
+    }
+
+    CpuDescriptorAllocator::ThreadCache& CpuDescriptorAllocator::GetThreadCache(const std::shared_ptr<Core>& core)
+    {
+        // A thread rarely uses more than the few allocators of one device,
+        // a short list with the last hit in front beats a map.
+        thread_local std::vector<std::unique_ptr<ThreadCache>> caches;
+        thread_local ThreadCache* last = nullptr;
+
+        if (last != nullptr && last->id == core->id)
+        {
+            return *last;
+        }
+
+        for (auto& cache : caches)
+        {
+            if (cache->id == core->id)
+            {
+                last = cache.get();
+                return *last;
+            }
+        }
+
+        auto expired = [] (const std::unique_ptr<ThreadCache>& cache) {
+            return cache->core.expired();
+        };
+        caches.erase(std::remove_if(caches.begin(), caches.end(), expired), caches.end());
+
+        auto cache = std::make_unique<ThreadCache>();
+        cache->id   = core->id;
+        cache->core = core;
+        last = cache.get();
+        caches.push_back(std::move(cache));
+        return *last;
+    }
+}
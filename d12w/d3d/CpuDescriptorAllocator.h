@@ -0,0 +1,126 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_CPU_DESCRIPTOR_ALLOCATOR_H_
+#define _D12W_CPU_DESCRIPTOR_ALLOCATOR_H_
+
+#include <cstdint>
+#include <memory>
+#include <d3d12.h>
+
+#include "../defines.h"
+#include "../ComPtr.h"
+
+namespace d12w::d3d
+{
+    /*!
+     * CPU Descriptor
+     *
+     * A single descriptor allocated from a CpuDescriptorAllocator.
+     */
+    struct CpuDescriptor
+    {
+        D3D12_CPU_DESCRIPTOR_HANDLE handle = {};         //!< the descriptor handle
+        uint32_t                    index  = UINT32_MAX; //!< the index of the descriptor in its allocator
+
+        explicit operator bool () const
+        {
+            return index != UINT32_MAX;
+        }
+    };
+
+    /*!
+     * CPU Descriptor Allocator
+     *
+     * Allocates single, non shader visible descriptors of one heap type.
+     * The descriptors are carved from fixed size heap pages, which live as
+     * long as the allocator.
+     *
+     * Free descriptors are kept in a lock free list and every thread caches
+     * a few of them, so that threads creating views concurrently rarely
+     * touch shared state. Only adding a page takes a lock.
+     *
+     * The allocator is thread safe. A descriptor may be freed on any thread.
+     */
+    class D12W_EXPORT CpuDescriptorAllocator
+    {
+    public:
+        /*!
+         * Create a CPU descriptor allocator.
+         *
+         * @param device the device to create the heaps with
+         * @param type the type of the descriptors
+         * @param pageSize the number of descriptors per heap, must be a power of two
+         */
+        CpuDescriptorAllocator(ComPtr<ID3D12Device> device, D3D12_DESCRIPTOR_HEAP_TYPE type, uint32_t pageSize = 256);
+
+        CpuDescriptorAllocator(const CpuDescriptorAllocator&) = delete;
+
+        ~CpuDescriptorAllocator();
+
+        CpuDescriptorAllocator& operator = (const CpuDescriptorAllocator&) = delete;
+
+        /*!
+         * Allocate a descriptor.
+         *
+         * @return the descriptor
+         */
+        CpuDescriptor Allocate();
+
+        /*!
+         * Free a descriptor.
+         *
+         * @param descriptor the descriptor to free
+         */
+        void Free(CpuDescriptor descriptor);
+
+        /*!
+         * Get the type of the descriptors.
+         *
+         * @return the descriptor heap type
+         */
+        D3D12_DESCRIPTOR_HEAP_TYPE GetType() const;
+
+        /*!
+         * Get the number of descriptors in all pages.
+         *
+         * @return the number of descriptors
+         */
+        uint32_t GetCapacity() const;
+
+        /*!
+         * Get the number of allocated pages.
+         *
+         * @return the number of pages
+         */
+        uint32_t GetPageCount() const;
+
+    private:
+        struct Core;
+        struct ThreadCache;
+
+        std::shared_ptr<Core> core;
+
+        static ThreadCache& GetThreadCache(const std::shared_ptr<Core>& core);
+    };
+}
+
+#endif
@@ -23,7 +23,9 @@
 
 #include "../util.h"
 
+#ifdef _MSC_VER
 #pragma comment(lib, "D3D12.lib")
+#endif
 
 namespace d12w::d3d
 {
@@ -32,8 +34,15 @@ namespace d12w::d3d
         auto hr = D3D12GetDebugInterface(debug1.UUID(), reinterpret_cast<void**>(&debug1));
         D12W_CHECK_SUCCESS(hr);
 
-        hr = D3D12GetDebugInterface(debug1.UUID(), reinterpret_cast<void**>(&debug2));
-        D12W_CHECK_SUCCESS(hr);
+        // ID3D12Debug2 is not available on older runtimes.
+        debug2 = debug1.TryAs<ID3D12Debug2>();
+    }
+
+    Debug::Debug(ComPtr<ID3D12Debug1> debug)
+    : debug1(std::move(debug))
+    {
+        D12W_ASSERT(debug1);
+        debug2 = debug1.TryAs<ID3D12Debug2>();
     }
 
     void Debug::EnableDebugLayer()
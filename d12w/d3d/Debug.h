@@ -44,6 +44,16 @@ namespace d12w::d3d
          */ 
         Debug();
 
+        /*!
+         * Wrap an existing debug object.
+         *
+         * This allows to use an alternative implementation, like the null backend.
+         *
+         * @param debug the debug object to wrap
+         */
+        explicit
+        Debug(ComPtr<ID3D12Debug1> debug);
+
         Debug(const Debug&) = delete;
         ~Debug() = default;
         Debug& operator = (const Debug&) = delete;
@@ -98,6 +108,8 @@ namespace d12w::d3d
          * called before creating the D3D12 Device. These settings can't be changed or cancelled 
          * after the device is created. If you want to change the behavior of GPU-based validation 
          * at a later time, the device must be destroyed and recreated with different parameters.
+         *
+         * This method requires ID3D12Debug2, which is not available on older runtimes.
          */
         void SetGPUBasedValidationFlags(D3D12_GPU_BASED_VALIDATION_FLAGS flags);
 
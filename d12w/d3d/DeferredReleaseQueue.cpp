@@ -0,0 +1,134 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "DeferredReleaseQueue.h"
+
+#include "../util.h"
+
+namespace d12w::d3d
+{
+    DeferredReleaseQueue::DeferredReleaseQueue(bool background)
+    {
+        if (background)
+        {
+            thread = std::thread([this] () { Run(); });
+        }
+    }
+
+    DeferredReleaseQueue::~DeferredReleaseQueue()
+    {
+        if (thread.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                running = false;
+            }
+            cond.notify_all();
+            thread.join();
+        }
+
+        for (const auto& [fenceValue, object] : queued)
+        {
+            retired.push_back(object);
+        }
+        queued.clear();
+        ReleaseAll(retired);
+    }
+
+    void DeferredReleaseQueue::Retire(UINT64 completedValue)
+    {
+        auto batch = std::vector<IUnknown*>{};
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (queued.empty() || queued.front().first > completedValue)
+            {
+                return;
+            }
+
+            // with a background thread, the batch is appended to the retired objects it releases
+            auto& target = thread.joinable() ? retired : batch;
+            while (!queued.empty() && queued.front().first <= completedValue)
+            {
+                target.push_back(queued.front().second);
+                queued.pop_front();
+            }
+        }
+
+        if (thread.joinable())
+        {
+            cond.notify_all();
+        }
+        else
+        {
+            ReleaseAll(batch);
+        }
+    }
+
+    void DeferredReleaseQueue::Flush()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [this] () { return retired.empty() && releasing == 0; });
+    }
+
+    size_t DeferredReleaseQueue::GetPendingCount() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return queued.size() + retired.size() + releasing;
+    }
+
+    void DeferredReleaseQueue::Push(IUnknown* object, UINT64 fenceValue)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queued.emplace_back(fenceValue, object);
+    }
+
+    void DeferredReleaseQueue::Run()
+    {
+        auto batch = std::vector<IUnknown*>{};
+        std::unique_lock<std::mutex> lock(mutex);
+        while (running)
+        {
+            if (retired.empty())
+            {
+                cond.wait(lock);
+                continue;
+            }
+
+            // swapping keeps the capacity of both vectors, so steady state does not allocate
+            batch.swap(retired);
+            releasing = batch.size();
+            lock.unlock();
+            ReleaseAll(batch);
+            lock.lock();
+            releasing = 0;
+            cond.notify_all();
+        }
+    }
+
+    void DeferredReleaseQueue::ReleaseAll(std::vector<IUnknown*>& objects) noexcept
+    {
+        for (auto object : objects)
+        {
+            object->Release();
+        }
+        objects.clear();
+    }
+}
@@ -0,0 +1,130 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_DEFERRED_RELEASE_QUEUE_H_
+#define _D12W_DEFERRED_RELEASE_QUEUE_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <d3d12.h>
+
+#include "../defines.h"
+#include "../ComPtr.h"
+
+namespace d12w::d3d
+{
+    /*!
+     * Deferred Release Queue
+     *
+     * Objects the GPU may still use can not be released when the CPU is
+     * done with them. The queue keeps the last reference of such objects,
+     * tagged with the fence value of the last submission that uses them,
+     * and releases them in bulk once that value completed.
+     *
+     * Optionally the releases are made on a thread owned by the queue, this
+     * takes the cost of the final Release, which for resources and heaps
+     * frees memory in the driver, off the render thread.
+     *
+     * Objects are released in the order they were queued. An object queued
+     * with a smaller fence value than the one before it is released late,
+     * never early.
+     *
+     * The queue is thread safe.
+     */
+    class D12W_EXPORT DeferredReleaseQueue
+    {
+    public:
+        /*!
+         * Create a deferred release queue.
+         *
+         * @param background true to release objects on a thread owned by the queue
+         */
+        explicit
+        DeferredReleaseQueue(bool background = false);
+
+        DeferredReleaseQueue(const DeferredReleaseQueue&) = delete;
+
+        /*!
+         * Destroy the queue.
+         *
+         * All objects still in the queue are released, the GPU must be
+         * done with them.
+         */
+        ~DeferredReleaseQueue();
+
+        DeferredReleaseQueue& operator = (const DeferredReleaseQueue&) = delete;
+
+        /*!
+         * Release an object once the GPU is done with it.
+         *
+         * @param object the object, the queue takes over the reference
+         * @param fenceValue the fence value after which the GPU no longer uses the object
+         */
+        template <typename ComClass>
+        void Release(ComPtr<ComClass> object, UINT64 fenceValue)
+        {
+            if (object)
+            {
+                Push(static_cast<IUnknown*>(object.Detach()), fenceValue);
+            }
+        }
+
+        /*!
+         * Release all objects whose fence value completed.
+         *
+         * @param completedValue the completed value of the fence
+         */
+        void Retire(UINT64 completedValue);
+
+        /*!
+         * Wait until the background thread released all retired objects.
+         *
+         * Without background thread this does nothing.
+         */
+        void Flush();
+
+        /*!
+         * Get the number of objects that are not yet released.
+         *
+         * @return the number of queued and retired, but not yet released, objects
+         */
+        size_t GetPendingCount() const;
+
+    private:
+        mutable std::mutex                       mutex;
+        std::condition_variable                  cond;
+        std::deque<std::pair<UINT64, IUnknown*>> queued;
+        std::vector<IUnknown*>                   retired;
+        size_t                                   releasing = 0;
+        bool                                     running   = true;
+        std::thread                              thread;
+
+        void Push(IUnknown* object, UINT64 fenceValue);
+        void Run();
+        static void ReleaseAll(std::vector<IUnknown*>& objects) noexcept;
+    };
+}
+
+#endif
@@ -0,0 +1,190 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "DefragmentationPlanner.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace d12w::d3d
+{
+    namespace
+    {
+        uint64_t AlignUp(uint64_t value, uint64_t alignment)
+        {
+            return alignment > 1 ? (value + alignment - 1) & ~(alignment - 1) : value;
+        }
+
+        uint64_t GetUsedSize(const DefragmentationHeap& heap)
+        {
+            return std::accumulate(heap.blocks.begin(), heap.blocks.end(), uint64_t{0}, [] (uint64_t sum, const DefragmentationBlock& block) {
+                return sum + block.size;
+            });
+        }
+
+        // the free ranges of a heap, as offset and size
+        std::vector<std::pair<uint64_t, uint64_t>> GetFreeRanges(const DefragmentationHeap& heap)
+        {
+            auto blocks = heap.blocks;
+            std::sort(blocks.begin(), blocks.end(), [] (const DefragmentationBlock& a, const DefragmentationBlock& b) {
+                return a.offset < b.offset;
+            });
+
+            auto ranges = std::vector<std::pair<uint64_t, uint64_t>>{};
+            auto offset = uint64_t{0};
+            for (const auto& block : blocks)
+            {
+                if (block.offset > offset)
+                {
+                    ranges.emplace_back(offset, block.offset - offset);
+                }
+                offset = std::max(offset, block.offset + block.size);
+            }
+            if (heap.size > offset)
+            {
+                ranges.emplace_back(offset, heap.size - offset);
+            }
+            return ranges;
+        }
+
+        // first fit in the free ranges, the used range is cut out
+        bool Place(std::vector<std::pair<uint64_t, uint64_t>>& ranges, uint64_t size, uint64_t alignment)
+        {
+            for (auto i = ranges.begin(); i != ranges.end(); ++i)
+            {
+                auto start = AlignUp(i->first, alignment);
+                auto end   = i->first + i->second;
+                if (start + size <= end)
+                {
+                    auto before = std::make_pair(i->first, start - i->first);
+                    auto after  = std::make_pair(start + size, end - start - size);
+                    i = ranges.erase(i);
+                    if (after.second > 0)
+                    {
+                        i = ranges.insert(i, after);
+                    }
+                    if (before.second > 0)
+                    {
+                        ranges.insert(i, before);
+                    }
+                    return true;
+                }
+            }
+            return false;
+        }
+    }
+
+    DefragmentationPlanner::DefragmentationPlanner(double sparseThreshold)
+    : sparseThreshold(sparseThreshold) {}
+
+    std::vector<DefragmentationMove> DefragmentationPlanner::Plan(const std::vector<DefragmentationHeap>& heaps, uint64_t budget) const
+    {
+        struct Candidate
+        {
+            const DefragmentationHeap*                 heap;
+            uint64_t                                   used;
+            double                                     usage;
+            std::vector<std::pair<uint64_t, uint64_t>> freeRanges;
+        };
+
+        auto candidates = std::vector<Candidate>{};
+        for (const auto& heap : heaps)
+        {
+            if (heap.size == 0)
+            {
+                continue;
+            }
+            auto used = GetUsedSize(heap);
+            candidates.push_back({&heap, used, static_cast<double>(used) / static_cast<double>(heap.size), {}});
+        }
+        std::sort(candidates.begin(), candidates.end(), [] (const Candidate& a, const Candidate& b) {
+            return a.usage < b.usage;
+        });
+
+        // the sparsest heaps are sources, as long as the rest has room for them
+        auto sourceCount = size_t{0};
+        auto sourceUsed  = uint64_t{0};
+        auto restFree    = uint64_t{0};
+        for (const auto& candidate : candidates)
+        {
+            restFree += candidate.heap->size - candidate.used;
+        }
+        while (sourceCount < candidates.size())
+        {
+            const auto& candidate = candidates[sourceCount];
+            if (candidate.usage > sparseThreshold || candidate.used == 0)
+            {
+                if (candidate.used == 0)
+                {
+                    // empty heaps are neither sources nor good destinations
+                    sourceCount++;
+                    restFree -= candidate.heap->size;
+                    continue;
+                }
+                break;
+            }
+            auto free = candidate.heap->size - candidate.used;
+            if (sourceUsed + candidate.used > restFree - free)
+            {
+                break;
+            }
+            sourceUsed += candidate.used;
+            restFree   -= free;
+            sourceCount++;
+        }
+
+        // the densest heaps are filled first
+        for (auto i = sourceCount; i < candidates.size(); i++)
+        {
+            candidates[i].freeRanges = GetFreeRanges(*candidates[i].heap);
+        }
+
+        auto moves = std::vector<DefragmentationMove>{};
+        for (auto s = size_t{0}; s < sourceCount && budget > 0; s++)
+        {
+            auto blocks = candidates[s].heap->blocks;
+            std::sort(blocks.begin(), blocks.end(), [] (const DefragmentationBlock& a, const DefragmentationBlock& b) {
+                return a.size > b.size;
+            });
+
+            for (const auto& block : blocks)
+            {
+                if (!block.movable || block.size > budget)
+                {
+                    continue;
+                }
+
+                for (auto d = candidates.size(); d > sourceCount; d--)
+                {
+                    auto& destination = candidates[d - 1];
+                    if (Place(destination.freeRanges, block.size, block.alignment))
+                    {
+                        moves.push_back({candidates[s].heap->id, block.id, destination.heap->id, block.size});
+                        budget -= block.size;
+                        break;
+                    }
+                }
+            }
+        }
+
+        return moves;
+    }
+}
@@ -0,0 +1,103 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_DEFRAGMENTATION_PLANNER_H_
+#define _D12W_DEFRAGMENTATION_PLANNER_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "../defines.h"
+
+namespace d12w::d3d
+{
+    /*!
+     * Defragmentation Block
+     *
+     * A live allocation in a heap.
+     */
+    struct DefragmentationBlock
+    {
+        uint32_t id        = 0;    //!< the id of the block, unique in its heap
+        uint64_t offset    = 0;    //!< the offset in the heap
+        uint64_t size      = 0;    //!< the size in bytes
+        uint64_t alignment = 0;    //!< the alignment required at a new place
+        bool     movable   = true; //!< false if the block must stay where it is
+    };
+
+    /*!
+     * Defragmentation Heap
+     */
+    struct DefragmentationHeap
+    {
+        uint32_t                          id   = 0; //!< the id of the heap
+        uint64_t                          size = 0; //!< the size of the heap in bytes
+        std::vector<DefragmentationBlock> blocks;   //!< the live blocks in the heap
+    };
+
+    /*!
+     * Defragmentation Move
+     */
+    struct DefragmentationMove
+    {
+        uint32_t srcHeap = 0; //!< the heap the block is in
+        uint32_t block   = 0; //!< the id of the block
+        uint32_t dstHeap = 0; //!< the heap to move the block to
+        uint64_t size    = 0; //!< the size of the block in bytes
+    };
+
+    /*!
+     * Defragmentation Planner
+     *
+     * Plans which blocks to move, so that sparsely used heaps are emptied
+     * into densely used ones and can be released. The sparsest heaps are
+     * evacuated first, the largest blocks first, into the densest heaps
+     * that have room. A byte budget limits the copies per call, so that
+     * defragmentation can be spread over many frames.
+     *
+     * The planner only does bookkeeping on the data it is given.
+     */
+    class D12W_EXPORT DefragmentationPlanner
+    {
+    public:
+        /*!
+         * Create a planner.
+         *
+         * @param sparseThreshold heaps used up to this fraction are evacuated
+         */
+        explicit
+        DefragmentationPlanner(double sparseThreshold = 0.5);
+
+        /*!
+         * Plan moves.
+         *
+         * @param heaps the heaps, all of them must be able to hold all blocks
+         * @param budget the maximum number of bytes to move
+         * @return the moves, in the order they should be made
+         */
+        std::vector<DefragmentationMove> Plan(const std::vector<DefragmentationHeap>& heaps, uint64_t budget) const;
+
+    private:
+        double sparseThreshold;
+    };
+}
+
+#endif
@@ -0,0 +1,136 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "DescriptorCopyBatcher.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "../util.h"
+#include "Device.h"
+
+namespace d12w::d3d
+{
+    DescriptorCopyBatcher::DescriptorCopyBatcher(Device& device, D3D12_DESCRIPTOR_HEAP_TYPE type)
+    : device(device), type(type), incrementSize(device.GetDescriptorHandleIncrementSize(type)) {}
+
+    void DescriptorCopyBatcher::Add(D3D12_CPU_DESCRIPTOR_HANDLE dest, D3D12_CPU_DESCRIPTOR_HANDLE src, UINT count)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        copies.push_back({dest.ptr, src.ptr, count});
+        stats.requests++;
+        stats.descriptors += count;
+    }
+
+    void DescriptorCopyBatcher::Flush()
+    {
+        if (copies.empty())
+        {
+            return;
+        }
+
+        // tables are written in order most of the time, then this is a no-op
+        std::stable_sort(copies.begin(), copies.end(), [] (const Copy& a, const Copy& b) {
+            return a.dest < b.dest;
+        });
+
+        auto end = [this] (SIZE_T start, UINT count) {
+            return start + SIZE_T{count} * incrementSize;
+        };
+
+        // merge copies where both sides continue the previous copy
+        auto last = copies.begin();
+        for (auto i = std::next(copies.begin()); i != copies.end(); ++i)
+        {
+            D12W_ASSERT(end(last->dest, last->count) <= i->dest);
+            if (end(last->dest, last->count) == i->dest && end(last->src, last->count) == i->src)
+            {
+                last->count += i->count;
+            }
+            else
+            {
+                *(++last) = *i;
+            }
+        }
+        copies.erase(std::next(last), copies.end());
+
+        if (copies.size() == 1)
+        {
+            device.CopyDescriptorsSimple(copies[0].count, {copies[0].dest}, {copies[0].src}, type);
+        }
+        else
+        {
+            // both sides are read as one sequence of descriptors, so the
+            // destination and source ranges are merged independently
+            destStarts.clear();
+            destSizes.clear();
+            srcStarts.clear();
+            srcSizes.clear();
+            for (const auto& copy : copies)
+            {
+                if (!destStarts.empty() && end(destStarts.back().ptr, destSizes.back()) == copy.dest)
+                {
+                    destSizes.back() += copy.count;
+                }
+                else
+                {
+                    destStarts.push_back({copy.dest});
+                    destSizes.push_back(copy.count);
+                }
+
+                if (!srcStarts.empty() && end(srcStarts.back().ptr, srcSizes.back()) == copy.src)
+                {
+                    srcSizes.back() += copy.count;
+                }
+                else
+                {
+                    srcStarts.push_back({copy.src});
+                    srcSizes.push_back(copy.count);
+                }
+            }
+
+            device.CopyDescriptors(static_cast<UINT>(destStarts.size()), destStarts.data(), destSizes.data(),
+                                   static_cast<UINT>(srcStarts.size()), srcStarts.data(), srcSizes.data(), type);
+        }
+
+        stats.calls++;
+        copies.clear();
+    }
+
+    size_t DescriptorCopyBatcher::GetPendingCount() const
+    {
+        return copies.size();
+    }
+
+    const DescriptorCopyStats& DescriptorCopyBatcher::GetStats() const
+    {
+        return stats;
+    }
+
+    void DescriptorCopyBatcher::ResetStats()
+    {
+        stats = {};
+    }
+}
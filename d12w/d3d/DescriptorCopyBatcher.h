@@ -0,0 +1,132 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_DESCRIPTOR_COPY_BATCHER_H_
+#define _D12W_DESCRIPTOR_COPY_BATCHER_H_
+
+#include <cstdint>
+#include <vector>
+#include <d3d12.h>
+
+#include "../defines.h"
+
+namespace d12w::d3d
+{
+    class Device;
+
+    /*!
+     * Descriptor Copy Statistics
+     */
+    struct DescriptorCopyStats
+    {
+        uint64_t requests    = 0; //!< the number of copies added
+        uint64_t descriptors = 0; //!< the number of descriptors copied
+        uint64_t calls       = 0; //!< the number of copy calls made on the device
+    };
+
+    /*!
+     * Descriptor Copy Batcher
+     *
+     * Assembling descriptor tables one descriptor at a time costs one
+     * CopyDescriptorsSimple call per descriptor. The batcher collects the
+     * copies and makes one CopyDescriptors call on Flush. Copies to
+     * adjacent destinations from adjacent sources are merged, so the
+     * driver sees few, long ranges.
+     *
+     * The destinations of the copies in a batch must not overlap. The
+     * sources must be in non shader visible heaps and stay valid until
+     * Flush returns.
+     *
+     * The batcher is not thread safe, use one per recording thread.
+     */
+    class D12W_EXPORT DescriptorCopyBatcher
+    {
+    public:
+        /*!
+         * Create a batcher.
+         *
+         * @param device the device, must outlive the batcher
+         * @param type the descriptor heap type of the copied descriptors
+         */
+        DescriptorCopyBatcher(Device& device, D3D12_DESCRIPTOR_HEAP_TYPE type);
+
+        DescriptorCopyBatcher(const DescriptorCopyBatcher&) = delete;
+
+        DescriptorCopyBatcher& operator = (const DescriptorCopyBatcher&) = delete;
+
+        /*!
+         * Add a copy to the batch.
+         *
+         * @param dest the first destination descriptor
+         * @param src the first source descriptor
+         * @param count the number of descriptors
+         */
+        void Add(D3D12_CPU_DESCRIPTOR_HANDLE dest, D3D12_CPU_DESCRIPTOR_HANDLE src, UINT count = 1);
+
+        /*!
+         * Copy all descriptors of the batch.
+         *
+         * This must be called before the GPU uses the destinations.
+         */
+        void Flush();
+
+        /*!
+         * Get the number of copies waiting for Flush.
+         *
+         * @return the number of pending copies
+         */
+        size_t GetPendingCount() const;
+
+        /*!
+         * Get the statistics since creation or the last reset.
+         *
+         * The calls saved by batching are requests minus calls.
+         *
+         * @return the statistics
+         */
+        const DescriptorCopyStats& GetStats() const;
+
+        /*!
+         * Reset the statistics.
+         */
+        void ResetStats();
+
+    private:
+        struct Copy
+        {
+            SIZE_T dest;
+            SIZE_T src;
+            UINT   count;
+        };
+
+        Device&                                  device;
+        D3D12_DESCRIPTOR_HEAP_TYPE               type;
+        UINT                                     incrementSize;
+        std::vector<Copy>                        copies;
+        std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> destStarts;
+        std::vector<UINT>                        destSizes;
+        std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> srcStarts;
+        std::vector<UINT>                        srcSizes;
+        DescriptorCopyStats                      stats;
+    };
+}
+
+#endif
@@ -1 +1,196 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
 #include "Device.h"
+
+#include "../util.h"
+#include "../dxgi/Adapter.h"
+
+#ifdef _MSC_VER
+#pragma comment(lib, "D3D12.lib")
+#endif
+
+namespace d12w::d3d
+{
+    Device::Device(dxgi::Adapter& adapter, D3D_FEATURE_LEVEL minFeatureLevel)
+    {
+        auto hr = D3D12CreateDevice(adapter.adapter4.Get(), minFeatureLevel, device2.UUID(), reinterpret_cast<void**>(&device2));
+        D12W_CHECK_SUCCESS(hr);
+        Init();
+    }
+
+    Device::Device(ComPtr<ID3D12Device2> device)
+    : device2(std::move(device))
+    {
+        D12W_ASSERT(device2);
+        Init();
+    }
+
+    Device::~Device() = default;
+
+    bool Device::TryCreate(dxgi::Adapter& adapter, D3D_FEATURE_LEVEL minFeatureLevel) noexcept
+    {
+        // without an output pointer D3D12CreateDevice only validates and returns S_FALSE
+        auto hr = D3D12CreateDevice(adapter.adapter4.Get(), minFeatureLevel, __uuidof(ID3D12Device), nullptr);
+        return SUCCEEDED(hr);
+    }
+
+    UINT Device::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE type) const
+    {
+        D12W_ASSERT(type < D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES);
+        return incrementSizes[type];
+    }
+
+    CpuDescriptorAllocator& Device::GetCpuDescriptorAllocator(D3D12_DESCRIPTOR_HEAP_TYPE type)
+    {
+        D12W_ASSERT(type < D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES);
+        return *cpuDescriptorAllocators[type];
+    }
+
+    ShaderVisibleDescriptorHeap& Device::GetShaderVisibleDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE type)
+    {
+        D12W_ASSERT(type == D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV || type == D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER);
+        std::call_once(shaderVisibleHeapFlags[type], [this, type] () {
+            auto size = type == D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER ? 1024u : 65536u;
+            shaderVisibleHeaps[type] = std::make_unique<ShaderVisibleDescriptorHeap>(device2, type, size, size);
+        });
+        return *shaderVisibleHeaps[type];
+    }
+
+    ComPtr<ID3D12DescriptorHeap> Device::CreateDescriptorHeap(const D3D12_DESCRIPTOR_HEAP_DESC& desc)
+    {
+        auto heap = ComPtr<ID3D12DescriptorHeap>{};
+        auto hr = device2->CreateDescriptorHeap(&desc, heap.UUID(), reinterpret_cast<void**>(&heap));
+        D12W_CHECK_SUCCESS(hr);
+        return heap;
+    }
+
+    ComPtr<ID3D12CommandQueue> Device::CreateCommandQueue(const D3D12_COMMAND_QUEUE_DESC& desc)
+    {
+        auto queue = ComPtr<ID3D12CommandQueue>{};
+        auto hr = device2->CreateCommandQueue(&desc, queue.UUID(), reinterpret_cast<void**>(&queue));
+        D12W_CHECK_SUCCESS(hr);
+        return queue;
+    }
+
+    ComPtr<ID3D12CommandAllocator> Device::CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE type)
+    {
+        auto allocator = ComPtr<ID3D12CommandAllocator>{};
+        auto hr = device2->CreateCommandAllocator(type, allocator.UUID(), reinterpret_cast<void**>(&allocator));
+        D12W_CHECK_SUCCESS(hr);
+        return allocator;
+    }
+
+    ComPtr<ID3D12GraphicsCommandList> Device::CreateCommandList(D3D12_COMMAND_LIST_TYPE type, ID3D12CommandAllocator* allocator, ID3D12PipelineState* initialState)
+    {
+        auto list = ComPtr<ID3D12GraphicsCommandList>{};
+        auto hr = device2->CreateCommandList(0, type, allocator, initialState, list.UUID(), reinterpret_cast<void**>(&list));
+        D12W_CHECK_SUCCESS(hr);
+        return list;
+    }
+
+    ComPtr<ID3D12Fence> Device::CreateFence(UINT64 initialValue, D3D12_FENCE_FLAGS flags)
+    {
+        auto fence = ComPtr<ID3D12Fence>{};
+        auto hr = device2->CreateFence(initialValue, flags, fence.UUID(), reinterpret_cast<void**>(&fence));
+        D12W_CHECK_SUCCESS(hr);
+        return fence;
+    }
+
+    ComPtr<ID3D12Resource> Device::CreateCommittedResource(const D3D12_HEAP_PROPERTIES& heapProperties, D3D12_HEAP_FLAGS heapFlags, const D3D12_RESOURCE_DESC& desc, D3D12_RESOURCE_STATES initialState, const D3D12_CLEAR_VALUE* clearValue)
+    {
+        auto resource = ComPtr<ID3D12Resource>{};
+        auto hr = device2->CreateCommittedResource(&heapProperties, heapFlags, &desc, initialState, clearValue, resource.UUID(), reinterpret_cast<void**>(&resource));
+        D12W_CHECK_SUCCESS(hr);
+        return resource;
+    }
+
+    ComPtr<ID3D12Heap> Device::CreateHeap(const D3D12_HEAP_DESC& desc)
+    {
+        auto heap = ComPtr<ID3D12Heap>{};
+        auto hr = device2->CreateHeap(&desc, heap.UUID(), reinterpret_cast<void**>(&heap));
+        D12W_CHECK_SUCCESS(hr);
+        return heap;
+    }
+
+    ComPtr<ID3D12Resource> Device::CreatePlacedResource(ID3D12Heap* heap, UINT64 heapOffset, const D3D12_RESOURCE_DESC& desc, D3D12_RESOURCE_STATES initialState, const D3D12_CLEAR_VALUE* clearValue)
+    {
+        auto resource = ComPtr<ID3D12Resource>{};
+        auto hr = device2->CreatePlacedResource(heap, heapOffset, &desc, initialState, clearValue, resource.UUID(), reinterpret_cast<void**>(&resource));
+        D12W_CHECK_SUCCESS(hr);
+        return resource;
+    }
+
+    D3D12_RESOURCE_ALLOCATION_INFO Device::GetResourceAllocationInfo(const D3D12_RESOURCE_DESC& desc)
+    {
+        return device2->GetResourceAllocationInfo(0, 1, &desc);
+    }
+
+    void Device::CreateConstantBufferView(const D3D12_CONSTANT_BUFFER_VIEW_DESC& desc, D3D12_CPU_DESCRIPTOR_HANDLE descriptor)
+    {
+        device2->CreateConstantBufferView(&desc, descriptor);
+    }
+
+    void Device::CreateShaderResourceView(ID3D12Resource* resource, const D3D12_SHADER_RESOURCE_VIEW_DESC* desc, D3D12_CPU_DESCRIPTOR_HANDLE descriptor)
+    {
+        device2->CreateShaderResourceView(resource, desc, descriptor);
+    }
+
+    void Device::CreateUnorderedAccessView(ID3D12Resource* resource, ID3D12Resource* counterResource, const D3D12_UNORDERED_ACCESS_VIEW_DESC* desc, D3D12_CPU_DESCRIPTOR_HANDLE descriptor)
+    {
+        device2->CreateUnorderedAccessView(resource, counterResource, desc, descriptor);
+    }
+
+    void Device::CreateRenderTargetView(ID3D12Resource* resource, const D3D12_RENDER_TARGET_VIEW_DESC* desc, D3D12_CPU_DESCRIPTOR_HANDLE descriptor)
+    {
+        device2->CreateRenderTargetView(resource, desc, descriptor);
+    }
+
+    void Device::CreateDepthStencilView(ID3D12Resource* resource, const D3D12_DEPTH_STENCIL_VIEW_DESC* desc, D3D12_CPU_DESCRIPTOR_HANDLE descriptor)
+    {
+        device2->CreateDepthStencilView(resource, desc, descriptor);
+    }
+
+    void Device::CreateSampler(const D3D12_SAMPLER_DESC& desc, D3D12_CPU_DESCRIPTOR_HANDLE descriptor)
+    {
+        device2->CreateSampler(&desc, descriptor);
+    }
+
+    void Device::CopyDescriptors(UINT numDestRanges, const D3D12_CPU_DESCRIPTOR_HANDLE* destRangeStarts, const UINT* destRangeSizes, UINT numSrcRanges, const D3D12_CPU_DESCRIPTOR_HANDLE* srcRangeStarts, const UINT* srcRangeSizes, D3D12_DESCRIPTOR_HEAP_TYPE type)
+    {
+        device2->CopyDescriptors(numDestRanges, destRangeStarts, destRangeSizes, numSrcRanges, srcRangeStarts, srcRangeSizes, type);
+    }
+
+    void Device::CopyDescriptorsSimple(UINT count, D3D12_CPU_DESCRIPTOR_HANDLE dest, D3D12_CPU_DESCRIPTOR_HANDLE src, D3D12_DESCRIPTOR_HEAP_TYPE type)
+    {
+        device2->CopyDescriptorsSimple(count, dest, src, type);
+    }
+
+    void Device::Init()
+    {
+        for (auto i = 0u; i < D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES; i++)
+        {
+            auto type = static_cast<D3D12_DESCRIPTOR_HEAP_TYPE>(i);
+            incrementSizes[i] = device2->GetDescriptorHandleIncrementSize(type);
+            cpuDescriptorAllocators[i] = std::make_unique<CpuDescriptorAllocator>(device2, type);
+        }
+    }
+}
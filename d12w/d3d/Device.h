@@ -22,22 +22,272 @@
 #ifndef _D12W_DEVICE_H_
 #define _D12W_DEVICE_H_
 
+#include <array>
+#include <memory>
+#include <mutex>
 #include <d3d12.h>
 
 #include "../defines.h"
 #include "../ComPtr.h"
+#include "CpuDescriptorAllocator.h"
+#include "ShaderVisibleDescriptorHeap.h"
+
+namespace d12w::dxgi
+{
+    class Adapter;
+}
 
 namespace d12w::d3d
 {
+    /*!
+     * Direct3D 12 Device
+     *
+     * This wrapper implements ID3D12Device2.
+     */
     class D12W_EXPORT Device
     {
     public:
-        Device();
+        /*!
+         * Create a device on an adapter.
+         *
+         * @param adapter the adapter to create the device on
+         * @param minFeatureLevel the minimum feature level the device must support
+         */
+        explicit
+        Device(dxgi::Adapter& adapter, D3D_FEATURE_LEVEL minFeatureLevel = D3D_FEATURE_LEVEL_11_0);
+
+        /*!
+         * Wrap an existing device.
+         *
+         * This allows to use an alternative implementation, like the null backend.
+         *
+         * @param device the device to wrap
+         */
+        explicit
+        Device(ComPtr<ID3D12Device2> device);
+
+        Device(const Device&) = delete;
+
+        ~Device();
+
+        Device& operator = (const Device&) = delete;
+
+        /*!
+         * Check if a device can be created on an adapter.
+         *
+         * This performs a trial device creation, without creating the device.
+         *
+         * @param adapter the adapter to check
+         * @param minFeatureLevel the minimum feature level the device must support
+         * @return true if a device can be created
+         */
+        static bool TryCreate(dxgi::Adapter& adapter, D3D_FEATURE_LEVEL minFeatureLevel = D3D_FEATURE_LEVEL_11_0) noexcept;
+
+        /*!
+         * Gets the size of the handle increment for the given type of descriptor heap.
+         *
+         * The sizes are queried once, when the device is created.
+         *
+         * @param type the descriptor heap type
+         * @return the size of one descriptor in bytes
+         */
+        UINT GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE type) const;
+
+        /*!
+         * Get the CPU descriptor allocator for a descriptor heap type.
+         *
+         * The allocators are thread safe and can be shared by all threads
+         * that create views.
+         *
+         * @param type the descriptor heap type
+         * @return the allocator for non shader visible descriptors of that type
+         */
+        CpuDescriptorAllocator& GetCpuDescriptorAllocator(D3D12_DESCRIPTOR_HEAP_TYPE type);
+
+        /*!
+         * Get the shader visible descriptor heap for a descriptor heap type.
+         *
+         * The heap is created on first use. CBV_SRV_UAV heaps hold 65536
+         * persistent and 65536 ring descriptors, SAMPLER heaps 1024 of each,
+         * which is the sampler heap limit.
+         *
+         * @param type the descriptor heap type, CBV_SRV_UAV or SAMPLER
+         * @return the shader visible heap of that type
+         */
+        ShaderVisibleDescriptorHeap& GetShaderVisibleDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE type);
+
+        /*!
+         * Creates a descriptor heap object.
+         *
+         * @param desc the description of the heap
+         * @return the descriptor heap
+         */
+        ComPtr<ID3D12DescriptorHeap> CreateDescriptorHeap(const D3D12_DESCRIPTOR_HEAP_DESC& desc);
+
+        /*!
+         * Creates a command queue.
+         *
+         * @param desc the description of the queue
+         * @return the command queue
+         */
+        ComPtr<ID3D12CommandQueue> CreateCommandQueue(const D3D12_COMMAND_QUEUE_DESC& desc);
+
+        /*!
+         * Creates a command allocator object.
+         *
+         * @param type the type of command lists the allocator is for
+         * @return the command allocator
+         */
+        ComPtr<ID3D12CommandAllocator> CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE type);
 
+        /*!
+         * Creates a command list.
+         *
+         * The list is created open, ready to record.
+         *
+         * @param type the type of the list
+         * @param allocator the allocator to record with, of the same type
+         * @param initialState the initial pipeline state, may be null
+         * @return the command list
+         */
+        ComPtr<ID3D12GraphicsCommandList> CreateCommandList(D3D12_COMMAND_LIST_TYPE type, ID3D12CommandAllocator* allocator, ID3D12PipelineState* initialState = nullptr);
 
+        /*!
+         * Creates a fence object.
+         *
+         * @param initialValue the initial value of the fence
+         * @param flags the fence flags
+         * @return the fence
+         */
+        ComPtr<ID3D12Fence> CreateFence(UINT64 initialValue = 0, D3D12_FENCE_FLAGS flags = D3D12_FENCE_FLAG_NONE);
+
+        /*!
+         * Creates a resource and an implicit heap big enough to contain it.
+         *
+         * @param heapProperties the properties of the heap
+         * @param heapFlags the flags of the heap
+         * @param desc the description of the resource
+         * @param initialState the initial state of the resource
+         * @param clearValue the optimized clear value, may be null
+         * @return the resource
+         */
+        ComPtr<ID3D12Resource> CreateCommittedResource(const D3D12_HEAP_PROPERTIES& heapProperties, D3D12_HEAP_FLAGS heapFlags, const D3D12_RESOURCE_DESC& desc, D3D12_RESOURCE_STATES initialState, const D3D12_CLEAR_VALUE* clearValue = nullptr);
+
+        /*!
+         * Creates a heap that resources can be placed in.
+         *
+         * @param desc the description of the heap
+         * @return the heap
+         */
+        ComPtr<ID3D12Heap> CreateHeap(const D3D12_HEAP_DESC& desc);
+
+        /*!
+         * Creates a resource that is placed in a specific heap.
+         *
+         * @param heap the heap to place the resource in
+         * @param heapOffset the offset in the heap, aligned to the resource alignment
+         * @param desc the description of the resource
+         * @param initialState the initial state of the resource
+         * @param clearValue the optimized clear value, may be null
+         * @return the resource
+         */
+        ComPtr<ID3D12Resource> CreatePlacedResource(ID3D12Heap* heap, UINT64 heapOffset, const D3D12_RESOURCE_DESC& desc, D3D12_RESOURCE_STATES initialState, const D3D12_CLEAR_VALUE* clearValue = nullptr);
+
+        /*!
+         * Gets the size and alignment of memory required for a resource.
+         *
+         * @param desc the description of the resource
+         * @return the size and alignment, the size is UINT64_MAX if the description is invalid
+         */
+        D3D12_RESOURCE_ALLOCATION_INFO GetResourceAllocationInfo(const D3D12_RESOURCE_DESC& desc);
+
+        /*!
+         * Creates a constant-buffer view for accessing resource data.
+         *
+         * @param desc the constant buffer view
+         * @param descriptor the CPU descriptor to write the view to
+         */
+        void CreateConstantBufferView(const D3D12_CONSTANT_BUFFER_VIEW_DESC& desc, D3D12_CPU_DESCRIPTOR_HANDLE descriptor);
+
+        /*!
+         * Creates a shader-resource view for accessing data in a resource.
+         *
+         * @param resource the resource to view, may be null for a null descriptor
+         * @param desc the view, null to use the default view of the resource
+         * @param descriptor the CPU descriptor to write the view to
+         */
+        void CreateShaderResourceView(ID3D12Resource* resource, const D3D12_SHADER_RESOURCE_VIEW_DESC* desc, D3D12_CPU_DESCRIPTOR_HANDLE descriptor);
+
+        /*!
+         * Creates a view for unordered accessing.
+         *
+         * @param resource the resource to view, may be null for a null descriptor
+         * @param counterResource the resource of the UAV counter, may be null
+         * @param desc the view, null to use the default view of the resource
+         * @param descriptor the CPU descriptor to write the view to
+         */
+        void CreateUnorderedAccessView(ID3D12Resource* resource, ID3D12Resource* counterResource, const D3D12_UNORDERED_ACCESS_VIEW_DESC* desc, D3D12_CPU_DESCRIPTOR_HANDLE descriptor);
+
+        /*!
+         * Creates a render-target view for accessing resource data.
+         *
+         * @param resource the resource to view, may be null for a null descriptor
+         * @param desc the view, null to use the default view of the resource
+         * @param descriptor the CPU descriptor to write the view to
+         */
+        void CreateRenderTargetView(ID3D12Resource* resource, const D3D12_RENDER_TARGET_VIEW_DESC* desc, D3D12_CPU_DESCRIPTOR_HANDLE descriptor);
+
+        /*!
+         * Creates a depth-stencil view for accessing resource data.
+         *
+         * @param resource the resource to view, may be null for a null descriptor
+         * @param desc the view, null to use the default view of the resource
+         * @param descriptor the CPU descriptor to write the view to
+         */
+        void CreateDepthStencilView(ID3D12Resource* resource, const D3D12_DEPTH_STENCIL_VIEW_DESC* desc, D3D12_CPU_DESCRIPTOR_HANDLE descriptor);
+
+        /*!
+         * Create a sampler object that encapsulates sampling information for a texture.
+         *
+         * @param desc the sampler
+         * @param descriptor the CPU descriptor to write the sampler to
+         */
+        void CreateSampler(const D3D12_SAMPLER_DESC& desc, D3D12_CPU_DESCRIPTOR_HANDLE descriptor);
+
+        /*!
+         * Copies descriptors from a source to a destination.
+         *
+         * The source and destination ranges are each read as one sequence
+         * of descriptors, their total sizes must match.
+         *
+         * @param numDestRanges the number of destination ranges
+         * @param destRangeStarts the first descriptor of each destination range
+         * @param destRangeSizes the size of each destination range, null for ranges of one
+         * @param numSrcRanges the number of source ranges
+         * @param srcRangeStarts the first descriptor of each source range
+         * @param srcRangeSizes the size of each source range, null for ranges of one
+         * @param type the descriptor heap type of all descriptors
+         */
+        void CopyDescriptors(UINT numDestRanges, const D3D12_CPU_DESCRIPTOR_HANDLE* destRangeStarts, const UINT* destRangeSizes, UINT numSrcRanges, const D3D12_CPU_DESCRIPTOR_HANDLE* srcRangeStarts, const UINT* srcRangeSizes, D3D12_DESCRIPTOR_HEAP_TYPE type);
+
+        /*!
+         * Copies a range of descriptors from a source to a destination.
+         *
+         * @param count the number of descriptors to copy
+         * @param dest the first destination descriptor
+         * @param src the first source descriptor
+         * @param type the descriptor heap type of all descriptors
+         */
+        void CopyDescriptorsSimple(UINT count, D3D12_CPU_DESCRIPTOR_HANDLE dest, D3D12_CPU_DESCRIPTOR_HANDLE src, D3D12_DESCRIPTOR_HEAP_TYPE type);
 
     private:
-        //ComPtr<ID3D12Device2> object;
+        ComPtr<ID3D12Device2>                                                                          device2;
+        std::array<UINT, D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES>                                         incrementSizes;
+        std::array<std::unique_ptr<CpuDescriptorAllocator>, D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES>      cpuDescriptorAllocators;
+        std::array<std::once_flag, D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES>                               shaderVisibleHeapFlags;
+        std::array<std::unique_ptr<ShaderVisibleDescriptorHeap>, D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES> shaderVisibleHeaps;
+
+        void Init();
     };
 }
 
@@ -0,0 +1,68 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Fence.h"
+
+#include "../util.h"
+#include "Device.h"
+
+namespace d12w::d3d
+{
+    Fence::Fence(Device& device, FenceWaiter& waiter, UINT64 initialValue)
+    : Fence(device.CreateFence(initialValue), waiter) {}
+
+    Fence::Fence(ComPtr<ID3D12Fence> f, FenceWaiter& w)
+    : fence(std::move(f)), waiter(w)
+    {
+        D12W_ASSERT(fence);
+    }
+
+    ID3D12Fence* Fence::GetFence() const
+    {
+        return fence.Get();
+    }
+
+    UINT64 Fence::GetCompletedValue() const
+    {
+        return fence.Get()->GetCompletedValue();
+    }
+
+    bool Fence::IsComplete(UINT64 value) const
+    {
+        return fence.Get()->GetCompletedValue() >= value;
+    }
+
+    void Fence::Signal(UINT64 value)
+    {
+        auto hr = fence->Signal(value);
+        D12W_CHECK_SUCCESS(hr);
+    }
+
+    FenceAwaiter Fence::Reached(UINT64 value) const
+    {
+        return FenceAwaiter{waiter, fence.Get(), value};
+    }
+
+    FenceAwaiter Fence::Reached(UINT64 value, std::stop_token token) const
+    {
+        return FenceAwaiter{waiter, fence.Get(), value, std::move(token)};
+    }
+}
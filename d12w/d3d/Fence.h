@@ -0,0 +1,125 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_FENCE_H_
+#define _D12W_FENCE_H_
+
+#include <stop_token>
+#include <d3d12.h>
+
+#include "../defines.h"
+#include "../ComPtr.h"
+#include "FenceWaiter.h"
+
+namespace d12w::d3d
+{
+    class Device;
+
+    /*!
+     * Direct3D 12 Fence
+     *
+     * This wrapper implements ID3D12Fence for coroutines. Instead of
+     * blocking a thread until the GPU reached a value, a coroutine
+     * suspends with `co_await fence.Reached(value)` and is resumed by the
+     * FenceWaiter.
+     *
+     * To wait on the fence of a CommandQueue, construct a FenceAwaiter
+     * with the fence of the queue directly.
+     */
+    class D12W_EXPORT Fence
+    {
+    public:
+        /*!
+         * Create a fence.
+         *
+         * @param device the device to create the fence on
+         * @param waiter the waiter that resumes coroutines, must outlive the fence
+         * @param initialValue the initial value of the fence
+         */
+        Fence(Device& device, FenceWaiter& waiter, UINT64 initialValue = 0);
+
+        /*!
+         * Wrap an existing fence.
+         *
+         * This allows to use an alternative implementation, like the null backend.
+         *
+         * @param fence the fence to wrap
+         * @param waiter the waiter that resumes coroutines, must outlive the fence
+         */
+        Fence(ComPtr<ID3D12Fence> fence, FenceWaiter& waiter);
+
+        Fence(const Fence&) = delete;
+
+        Fence& operator = (const Fence&) = delete;
+
+        /*!
+         * Get the wrapped fence.
+         *
+         * @return the fence
+         */
+        ID3D12Fence* GetFence() const;
+
+        /*!
+         * Get the value the fence reached.
+         *
+         * @return the completed value
+         */
+        UINT64 GetCompletedValue() const;
+
+        /*!
+         * Check if the fence reached a value.
+         *
+         * @param value the fence value
+         * @return true if the value is completed
+         */
+        bool IsComplete(UINT64 value) const;
+
+        /*!
+         * Set the fence value from the CPU.
+         *
+         * @param value the new value
+         */
+        void Signal(UINT64 value);
+
+        /*!
+         * Wait for a value in a coroutine.
+         *
+         * @param value the fence value
+         * @return the awaitable, co_await yields true once the value is reached and false if the device was removed
+         */
+        FenceAwaiter Reached(UINT64 value) const;
+
+        /*!
+         * Wait for a value in a coroutine, with cancellation.
+         *
+         * @param value the fence value
+         * @param token the wait is cancelled when stop is requested
+         * @return the awaitable, co_await yields true once the value is reached and false if cancelled or the device was removed
+         */
+        FenceAwaiter Reached(UINT64 value, std::stop_token token) const;
+
+    private:
+        ComPtr<ID3D12Fence> fence;
+        FenceWaiter&        waiter;
+    };
+}
+
+#endif
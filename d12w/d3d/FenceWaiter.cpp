@@ -0,0 +1,241 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "FenceWaiter.h"
+
+#include "../util.h"
+
+namespace d12w::d3d
+{
+    FenceAwaiter::FenceAwaiter(FenceWaiter& waiter, ID3D12Fence* fence, UINT64 value, std::stop_token token)
+    : waiter(waiter), fence(fence), value(value), token(std::move(token))
+    {
+        D12W_ASSERT(fence);
+    }
+
+    bool FenceAwaiter::await_ready()
+    {
+        if (token.stop_requested())
+        {
+            state = State::CANCELLED;
+            return true;
+        }
+        auto completed = fence->GetCompletedValue();
+        if (completed == UINT64_MAX)
+        {
+            // the device was removed, the value will never be reached
+            state = State::CANCELLED;
+            return true;
+        }
+        if (completed >= value)
+        {
+            state = State::REACHED;
+            return true;
+        }
+        return false;
+    }
+
+    bool FenceAwaiter::await_suspend(std::coroutine_handle<> h)
+    {
+        handle = h;
+        if (token.stop_possible())
+        {
+            // the callback runs right here if stop was requested in the mean time
+            canceller.emplace(token, Canceller{this});
+        }
+        // once added, the coroutine may be resumed before Add returns
+        return waiter.Add(*this);
+    }
+
+    bool FenceAwaiter::await_resume() const noexcept
+    {
+        return state == State::REACHED;
+    }
+
+    void FenceAwaiter::Canceller::operator () () const noexcept
+    {
+        awaiter->waiter.Cancel(*awaiter);
+    }
+
+    FenceWaiter::FenceWaiter()
+    {
+        event = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+        if (event == nullptr)
+        {
+            D12W_THROW(std::runtime_error, util::GetLastError());
+        }
+        thread = std::thread([this] () { Run(); });
+    }
+
+    FenceWaiter::~FenceWaiter()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            running = false;
+        }
+        SetEvent(event);
+        thread.join();
+        CloseHandle(event);
+    }
+
+    size_t FenceWaiter::GetPendingCount() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return pending;
+    }
+
+    bool FenceWaiter::Add(FenceAwaiter& awaiter)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (awaiter.state != FenceAwaiter::State::WAITING)
+            {
+                return false;
+            }
+            if (!running)
+            {
+                awaiter.state = FenceAwaiter::State::CANCELLED;
+                return false;
+            }
+
+            auto& entry = entries[awaiter.fence];
+            if (!entry.fence)
+            {
+                entry.fence = ComPtr<ID3D12Fence>{awaiter.fence};
+            }
+            awaiter.position   = entry.awaiters.emplace(awaiter.value, &awaiter);
+            awaiter.registered = true;
+            pending++;
+        }
+        // the thread arms the fence, awaiter must not be touched from here on
+        SetEvent(event);
+        return true;
+    }
+
+    void FenceWaiter::Cancel(FenceAwaiter& awaiter)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (awaiter.state != FenceAwaiter::State::WAITING)
+            {
+                return;
+            }
+
+            awaiter.state = FenceAwaiter::State::CANCELLED;
+            if (!awaiter.registered)
+            {
+                // await_suspend sees the state and does not suspend
+                return;
+            }
+
+            auto entry = entries.find(awaiter.fence);
+            D12W_ASSERT(entry != entries.end());
+            entry->second.awaiters.erase(awaiter.position);
+            cancelled.push_back(&awaiter);
+        }
+        SetEvent(event);
+    }
+
+    void FenceWaiter::Run()
+    {
+        auto ready = std::vector<FenceAwaiter*>{};
+        auto stop  = false;
+
+        auto cancel = [&ready] (std::multimap<UINT64, FenceAwaiter*>& awaiters) {
+            for (auto& [value, awaiter] : awaiters)
+            {
+                awaiter->state = FenceAwaiter::State::CANCELLED;
+                ready.push_back(awaiter);
+            }
+            awaiters.clear();
+        };
+
+        while (!stop)
+        {
+            WaitForSingleObject(event, INFINITE);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stop = !running;
+                ready.swap(cancelled);
+
+                for (auto i = entries.begin(); i != entries.end();)
+                {
+                    auto& entry     = i->second;
+                    auto  completed = entry.fence->GetCompletedValue();
+
+                    if (completed == UINT64_MAX)
+                    {
+                        // the device was removed, every value reads as reached but none was
+                        cancel(entry.awaiters);
+                    }
+
+                    auto reached = entry.awaiters.upper_bound(completed);
+                    for (auto j = entry.awaiters.begin(); j != reached; ++j)
+                    {
+                        j->second->state = FenceAwaiter::State::REACHED;
+                        ready.push_back(j->second);
+                    }
+                    entry.awaiters.erase(entry.awaiters.begin(), reached);
+
+                    if (stop)
+                    {
+                        cancel(entry.awaiters);
+                    }
+
+                    if (!entry.awaiters.empty())
+                    {
+                        // a registration for a larger value stays until that value is reached,
+                        // the extra wake up is harmless
+                        auto next = entry.awaiters.begin()->first;
+                        if (next != entry.armed)
+                        {
+                            auto hr = entry.fence->SetEventOnCompletion(next, event);
+                            if (FAILED(hr))
+                            {
+                                cancel(entry.awaiters);
+                            }
+                            entry.armed = next;
+                        }
+                    }
+
+                    if (entry.awaiters.empty())
+                    {
+                        i = entries.erase(i);
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+
+                pending -= ready.size();
+            }
+
+            // resumed coroutines may wait again, so this happens without the lock
+            for (auto awaiter : ready)
+            {
+                awaiter->handle.resume();
+            }
+            ready.clear();
+        }
+    }
+}
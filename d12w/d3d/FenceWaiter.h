@@ -0,0 +1,169 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_FENCE_WAITER_H_
+#define _D12W_FENCE_WAITER_H_
+
+#include <coroutine>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <d3d12.h>
+
+#include "../defines.h"
+#include "../ComPtr.h"
+
+namespace d12w::d3d
+{
+    class FenceWaiter;
+
+    /*!
+     * Fence Awaiter
+     *
+     * The awaitable returned by Fence::Reached. The result of co_await is
+     * true when the fence reached the value and false when the wait was
+     * cancelled.
+     *
+     * Unless the value is already reached, the coroutine is resumed on the
+     * thread of the FenceWaiter.
+     */
+    class D12W_EXPORT FenceAwaiter
+    {
+    public:
+        /*!
+         * Create an awaiter.
+         *
+         * @param waiter the waiter that resumes the coroutine
+         * @param fence the fence to wait on
+         * @param value the fence value to wait for
+         * @param token a stop token that cancels the wait
+         */
+        FenceAwaiter(FenceWaiter& waiter, ID3D12Fence* fence, UINT64 value, std::stop_token token = {});
+
+        FenceAwaiter(const FenceAwaiter&) = delete;
+
+        FenceAwaiter& operator = (const FenceAwaiter&) = delete;
+
+        bool await_ready();
+        bool await_suspend(std::coroutine_handle<> handle);
+        bool await_resume() const noexcept;
+
+    private:
+        enum class State
+        {
+            WAITING,
+            REACHED,
+            CANCELLED
+        };
+
+        struct Canceller
+        {
+            FenceAwaiter* awaiter;
+            void operator () () const noexcept;
+        };
+
+        FenceWaiter&                                   waiter;
+        ID3D12Fence*                                   fence;
+        UINT64                                         value;
+        std::stop_token                                token;
+        std::coroutine_handle<>                        handle;
+        State                                          state      = State::WAITING;
+        bool                                           registered = false;
+        std::multimap<UINT64, FenceAwaiter*>::iterator position;
+        std::optional<std::stop_callback<Canceller>>   canceller;
+
+    friend class FenceWaiter;
+    };
+
+    /*!
+     * Fence Waiter
+     *
+     * Resumes coroutines that wait on fences. A single thread waits on one
+     * event for all fences that have waiting coroutines, each fence is set
+     * to signal the event when the smallest value waited on is reached.
+     * Thousands of waits thus cost no more than one blocked thread.
+     *
+     * On one fence, coroutines are resumed in the order of the values they
+     * wait for, equal values in the order the waits started. Cancelled
+     * waits are resumed with the next wake up of the thread. If the device
+     * was removed, which reads as a completed value of UINT64_MAX, or a
+     * fence can not signal the event, the waits on it are cancelled.
+     *
+     * When the waiter is destroyed, the waits still pending are cancelled
+     * and waits started afterwards complete cancelled right away.
+     *
+     * The waiter is thread safe.
+     */
+    class D12W_EXPORT FenceWaiter
+    {
+    public:
+        /*!
+         * Create a fence waiter and start its thread.
+         *
+         * @throws std::runtime_error if the event can not be created
+         */
+        FenceWaiter();
+
+        FenceWaiter(const FenceWaiter&) = delete;
+
+        /*!
+         * Cancel all waits and stop the thread.
+         */
+        ~FenceWaiter();
+
+        FenceWaiter& operator = (const FenceWaiter&) = delete;
+
+        /*!
+         * Get the number of coroutines waiting.
+         *
+         * @return the number of suspended waits
+         */
+        size_t GetPendingCount() const;
+
+    private:
+        struct Entry
+        {
+            ComPtr<ID3D12Fence>                  fence;
+            std::multimap<UINT64, FenceAwaiter*> awaiters;
+            UINT64                               armed = 0;
+        };
+
+        HANDLE                                  event;
+        mutable std::mutex                      mutex;
+        std::unordered_map<ID3D12Fence*, Entry> entries;
+        std::vector<FenceAwaiter*>              cancelled;
+        size_t                                  pending = 0;
+        bool                                    running = true;
+        std::thread                             thread;
+
+        bool Add(FenceAwaiter& awaiter);
+        void Cancel(FenceAwaiter& awaiter);
+        void Run();
+
+    friend class FenceAwaiter;
+    };
+}
+
+#endif
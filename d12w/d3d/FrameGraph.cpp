@@ -0,0 +1,373 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "FrameGraph.h"
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+
+#include "../util.h"
+
+namespace d12w::d3d
+{
+    namespace
+    {
+        constexpr auto NONE = UINT32_MAX;
+
+        uint64_t AlignUp(uint64_t value, uint64_t alignment)
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        // a step that reads or writes unordered access after an unordered access write needs a UAV barrier
+        bool IsUnorderedAccess(D3D12_RESOURCE_STATES state)
+        {
+            return (state & D3D12_RESOURCE_STATE_UNORDERED_ACCESS) != 0;
+        }
+    }
+
+    uint32_t FrameGraph::CreateResource(uint64_t size, uint64_t alignment, uint32_t category)
+    {
+        if (size == 0)
+        {
+            D12W_THROW(std::invalid_argument, "Resources can not be empty.");
+        }
+        if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+        {
+            D12W_THROW(std::invalid_argument, "The alignment must be a power of two.");
+        }
+
+        auto id = static_cast<uint32_t>(resources.size());
+        resources.push_back({size, alignment, category, false, D3D12_RESOURCE_STATE_COMMON});
+        return id;
+    }
+
+    uint32_t FrameGraph::ImportResource(D3D12_RESOURCE_STATES initialState)
+    {
+        auto id = static_cast<uint32_t>(resources.size());
+        resources.push_back({0, 1, 0, true, initialState});
+        return id;
+    }
+
+    uint32_t FrameGraph::AddPass(std::vector<FrameGraphAccess> accesses, bool keep)
+    {
+        for (const auto& access : accesses)
+        {
+            if (access.resource >= resources.size())
+            {
+                D12W_THROW(std::invalid_argument, "Invalid resource.");
+            }
+        }
+
+        auto id = static_cast<uint32_t>(passes.size());
+        passes.push_back({std::move(accesses), keep});
+        return id;
+    }
+
+    bool FrameGraph::IsImported(uint32_t resource) const
+    {
+        D12W_ASSERT(resource < resources.size());
+        return resources[resource].imported;
+    }
+
+    const std::vector<FrameGraphAccess>& FrameGraph::GetAccesses(uint32_t pass) const
+    {
+        D12W_ASSERT(pass < passes.size());
+        return passes[pass].accesses;
+    }
+
+    size_t FrameGraph::GetResourceCount() const
+    {
+        return resources.size();
+    }
+
+    size_t FrameGraph::GetPassCount() const
+    {
+        return passes.size();
+    }
+
+    void FrameGraph::Clear()
+    {
+        resources.clear();
+        passes.clear();
+    }
+
+    FrameGraphPlan FrameGraph::Compile() const
+    {
+        auto resourceCount = resources.size();
+        auto passCount     = passes.size();
+
+        // producers are the earlier writers of what a pass accesses, the passes that made the content it sees;
+        // a write also has to wait for the reads of the earlier content
+        auto producers   = std::vector<std::vector<uint32_t>>(passCount);
+        auto readsBefore = std::vector<std::vector<uint32_t>>(passCount);
+        auto needed      = std::vector<bool>(passCount);
+        auto lastWriter  = std::vector<uint32_t>(resourceCount, NONE);
+        auto lastReaders = std::vector<std::vector<uint32_t>>(resourceCount);
+        for (auto p = 0u; p < passCount; p++)
+        {
+            const auto& pass = passes[p];
+            auto keep = pass.keep;
+            for (const auto& access : pass.accesses)
+            {
+                auto writer = lastWriter[access.resource];
+                if (writer != NONE && writer != p)
+                {
+                    producers[p].push_back(writer);
+                }
+                if (access.write)
+                {
+                    for (auto reader : lastReaders[access.resource])
+                    {
+                        if (reader != p)
+                        {
+                            readsBefore[p].push_back(reader);
+                        }
+                    }
+                    keep = keep || resources[access.resource].imported;
+                }
+            }
+            needed[p] = keep;
+
+            for (const auto& access : pass.accesses)
+            {
+                if (access.write)
+                {
+                    lastWriter[access.resource] = p;
+                    lastReaders[access.resource].clear();
+                }
+            }
+            for (const auto& access : pass.accesses)
+            {
+                auto& readers = lastReaders[access.resource];
+                if (!access.write && lastWriter[access.resource] != p && (readers.empty() || readers.back() != p))
+                {
+                    readers.push_back(p);
+                }
+            }
+        }
+
+        // producers come before the pass, so one walk backwards finds all passes that contribute
+        for (auto p = passCount; p-- > 0;)
+        {
+            if (needed[p])
+            {
+                for (auto producer : producers[p])
+                {
+                    needed[producer] = true;
+                }
+            }
+        }
+
+        auto plan = FrameGraphPlan{};
+        auto stepOf = std::vector<uint32_t>(passCount, NONE);
+        for (auto p = 0u; p < passCount; p++)
+        {
+            if (!needed[p])
+            {
+                continue;
+            }
+
+            auto step = FrameGraphStep{};
+            step.pass = p;
+            for (auto producer : producers[p])
+            {
+                step.dependencies.push_back(stepOf[producer]);
+            }
+            for (auto reader : readsBefore[p])
+            {
+                if (needed[reader])
+                {
+                    step.dependencies.push_back(stepOf[reader]);
+                }
+            }
+            std::sort(step.dependencies.begin(), step.dependencies.end());
+            step.dependencies.erase(std::unique(step.dependencies.begin(), step.dependencies.end()), step.dependencies.end());
+
+            stepOf[p] = static_cast<uint32_t>(plan.steps.size());
+            plan.steps.push_back(std::move(step));
+        }
+
+        // the state of a resource in a step is the combination of its accesses in the pass
+        auto firstStep = std::vector<uint32_t>(resourceCount, NONE);
+        auto lastStep  = std::vector<uint32_t>(resourceCount, NONE);
+        auto lastState = std::vector<D3D12_RESOURCE_STATES>(resourceCount, D3D12_RESOURCE_STATE_COMMON);
+        for (auto s = 0u; s < plan.steps.size(); s++)
+        {
+            for (const auto& access : passes[plan.steps[s].pass].accesses)
+            {
+                auto r = access.resource;
+                if (lastStep[r] == s)
+                {
+                    lastState[r] = lastState[r] | access.state;
+                }
+                else
+                {
+                    lastState[r] = access.state;
+                }
+                if (firstStep[r] == NONE)
+                {
+                    firstStep[r] = s;
+                }
+                lastStep[r] = s;
+            }
+        }
+
+        plan.initialStates.resize(resourceCount);
+        for (auto r = 0u; r < resourceCount; r++)
+        {
+            plan.initialStates[r] = resources[r].imported ? resources[r].initialState : lastState[r];
+        }
+
+        // per category, largest first, at the lowest offset not used by a resource that is alive at the same time
+        auto categories = std::map<uint32_t, std::vector<uint32_t>>{};
+        for (auto r = 0u; r < resourceCount; r++)
+        {
+            if (!resources[r].imported && firstStep[r] != NONE)
+            {
+                categories[resources[r].category].push_back(r);
+                plan.unaliasedSize += AlignUp(resources[r].size, resources[r].alignment);
+            }
+        }
+
+        plan.placements.resize(resourceCount);
+        auto aliased = std::vector<bool>(resourceCount);
+        auto placed  = std::vector<uint32_t>{};
+        for (auto& [category, members] : categories)
+        {
+            std::sort(members.begin(), members.end(), [this, &firstStep] (uint32_t a, uint32_t b) {
+                if (resources[a].size != resources[b].size)
+                {
+                    return resources[a].size > resources[b].size;
+                }
+                return firstStep[a] != firstStep[b] ? firstStep[a] < firstStep[b] : a < b;
+            });
+
+            // placed keeps the resources placed so far sorted by offset, so the first fit is found in one walk
+            auto heapIndex = static_cast<uint32_t>(plan.heaps.size());
+            auto heap      = FrameGraphHeap{category, 0, 1};
+            placed.clear();
+            for (auto r : members)
+            {
+                const auto& resource = resources[r];
+
+                auto offset = uint64_t{0};
+                for (auto q : placed)
+                {
+                    if (firstStep[q] > lastStep[r] || firstStep[r] > lastStep[q])
+                    {
+                        continue;
+                    }
+
+                    auto begin = plan.placements[q].offset;
+                    if (offset + resource.size <= begin)
+                    {
+                        break;
+                    }
+                    offset = std::max(offset, AlignUp(begin + resources[q].size, resource.alignment));
+                }
+
+                plan.placements[r] = {heapIndex, offset};
+                heap.size      = std::max(heap.size, offset + resource.size);
+                heap.alignment = std::max(heap.alignment, resource.alignment);
+
+                auto position = std::upper_bound(placed.begin(), placed.end(), offset, [&plan] (uint64_t value, uint32_t q) {
+                    return value < plan.placements[q].offset;
+                });
+                placed.insert(position, r);
+            }
+            plan.heaps.push_back(heap);
+
+            // a resource alone in its memory needs no aliasing barrier; in offset order a range overlaps
+            // an earlier one if it starts before the furthest end so far and a later one if the next range
+            // starts before its end
+            auto furthest = uint64_t{0};
+            for (auto i = 0u; i < placed.size(); i++)
+            {
+                auto r     = placed[i];
+                auto begin = plan.placements[r].offset;
+                auto end   = begin + resources[r].size;
+                if (i > 0 && begin < furthest)
+                {
+                    aliased[r] = true;
+                }
+                if (i + 1 < placed.size() && plan.placements[placed[i + 1]].offset < end)
+                {
+                    aliased[r] = true;
+                }
+                furthest = std::max(furthest, end);
+            }
+        }
+
+        auto state      = plan.initialStates;
+        auto uavWritten = std::vector<bool>(resourceCount);
+        auto combined   = std::vector<D3D12_RESOURCE_STATES>(resourceCount);
+        auto written    = std::vector<bool>(resourceCount);
+        auto seen       = std::vector<uint32_t>(resourceCount, NONE);
+        auto used       = std::vector<uint32_t>{};
+        for (auto s = 0u; s < plan.steps.size(); s++)
+        {
+            auto& step = plan.steps[s];
+
+            used.clear();
+            for (const auto& access : passes[step.pass].accesses)
+            {
+                auto r = access.resource;
+                if (seen[r] != s)
+                {
+                    seen[r]     = s;
+                    combined[r] = access.state;
+                    written[r]  = access.write;
+                    used.push_back(r);
+                }
+                else
+                {
+                    combined[r] = combined[r] | access.state;
+                    written[r]  = written[r] || access.write;
+                }
+            }
+
+            for (auto r : used)
+            {
+                if (aliased[r] && firstStep[r] == s)
+                {
+                    step.barriers.push_back({FrameGraphBarrierType::ALIASING, r, state[r], state[r]});
+                    uavWritten[r] = false;
+                }
+
+                if (state[r] != combined[r])
+                {
+                    step.barriers.push_back({FrameGraphBarrierType::TRANSITION, r, state[r], combined[r]});
+                    state[r] = combined[r];
+                }
+                else if (uavWritten[r] && IsUnorderedAccess(combined[r]))
+                {
+                    step.barriers.push_back({FrameGraphBarrierType::UAV, r, state[r], state[r]});
+                }
+                uavWritten[r] = written[r] && IsUnorderedAccess(combined[r]);
+            }
+        }
+        plan.finalStates = std::move(state);
+
+        return plan;
+    }
+}
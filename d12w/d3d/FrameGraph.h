@@ -0,0 +1,250 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_FRAME_GRAPH_H_
+#define _D12W_FRAME_GRAPH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <d3d12.h>
+
+#include "../defines.h"
+
+namespace d12w::d3d
+{
+    /*!
+     * Frame Graph Access
+     *
+     * How a pass uses a resource.
+     */
+    struct FrameGraphAccess
+    {
+        uint32_t              resource = 0;                          //!< the resource
+        D3D12_RESOURCE_STATES state    = D3D12_RESOURCE_STATE_COMMON; //!< the state the pass uses the resource in
+        bool                  write    = false;                      //!< true if the pass writes the resource
+    };
+
+    /*!
+     * Frame Graph Barrier Type
+     */
+    enum class FrameGraphBarrierType
+    {
+        TRANSITION, //!< the resource changes state
+        ALIASING,   //!< the resource starts to use memory that other resources used
+        UAV         //!< unordered access writes must finish before the next ones
+    };
+
+    /*!
+     * Frame Graph Barrier
+     *
+     * A barrier before a pass, on a resource of the graph.
+     */
+    struct FrameGraphBarrier
+    {
+        FrameGraphBarrierType type     = FrameGraphBarrierType::TRANSITION; //!< the type of barrier
+        uint32_t              resource = 0;                                 //!< the resource
+        D3D12_RESOURCE_STATES before   = D3D12_RESOURCE_STATE_COMMON;       //!< the state before a transition
+        D3D12_RESOURCE_STATES after    = D3D12_RESOURCE_STATE_COMMON;       //!< the state after a transition
+    };
+
+    /*!
+     * Frame Graph Step
+     *
+     * A pass that survived culling, in the order it is recorded.
+     */
+    struct FrameGraphStep
+    {
+        uint32_t                       pass = 0;     //!< the pass
+        std::vector<uint32_t>          dependencies; //!< the earlier steps that must finish before this one, sorted
+        std::vector<FrameGraphBarrier> barriers;     //!< the barriers to issue before the pass
+    };
+
+    /*!
+     * Frame Graph Placement
+     *
+     * Where a transient resource lives.
+     */
+    struct FrameGraphPlacement
+    {
+        uint32_t heap   = UINT32_MAX; //!< the heap, UINT32_MAX if the resource is imported or not used
+        uint64_t offset = 0;          //!< the offset in the heap
+    };
+
+    /*!
+     * Frame Graph Heap
+     *
+     * A heap the transient resources of one category share.
+     */
+    struct FrameGraphHeap
+    {
+        uint32_t category  = 0; //!< the category of the resources in it
+        uint64_t size      = 0; //!< the size in bytes
+        uint64_t alignment = 0; //!< the largest alignment of the resources in it
+    };
+
+    /*!
+     * Frame Graph Plan
+     *
+     * The result of compiling a frame graph.
+     */
+    struct FrameGraphPlan
+    {
+        std::vector<FrameGraphStep>        steps;             //!< the passes to record, in order
+        std::vector<FrameGraphPlacement>   placements;        //!< the placement of every resource
+        std::vector<FrameGraphHeap>        heaps;             //!< the heaps for the transient resources
+        std::vector<D3D12_RESOURCE_STATES> initialStates;     //!< the state of every resource before the first step
+        std::vector<D3D12_RESOURCE_STATES> finalStates;       //!< the state of every resource after the last step
+        uint64_t                           unaliasedSize = 0; //!< the memory the used transient resources would need without aliasing
+    };
+
+    /*!
+     * Frame Graph
+     *
+     * The passes of a frame and the resources they use. Passes declare the
+     * resources they read and write; Compile works out what to record:
+     *
+     * - Passes that contribute to nothing are culled. A pass is kept if it is
+     *   marked to be kept or writes an imported resource, and so are the
+     *   passes that write what kept passes access. Writes count as reads of
+     *   the earlier content, since a pass may only overwrite parts.
+     * - The remaining passes keep the order they were added in, which is
+     *   the order the accesses are meant to happen in. The dependencies of
+     *   each step can be fed into a QueueGraph to spread the frame over
+     *   several queues.
+     * - The barriers before each step are derived from the states of the
+     *   accesses. A resource used in several states in one pass is put into
+     *   the combination of these states.
+     * - Transient resources only exist from their first to their last use.
+     *   Resources of the same category whose uses do not overlap share
+     *   memory; they are placed largest first, each at the lowest offset
+     *   that is free during its uses. A resource that shares memory gets an
+     *   aliasing barrier before its first use and must then be fully
+     *   written, with a clear, discard or copy, before it is read.
+     *
+     * Transient resources are created in the state of their last use, so
+     * the frame ends in the state it starts with and can be recorded again
+     * without extra barriers. Imported resources start in the state given
+     * when they are imported and are never aliased.
+     *
+     * The graph does not touch the GPU, FrameGraphExecutor runs a plan.
+     */
+    class D12W_EXPORT FrameGraph
+    {
+    public:
+        /*!
+         * Create an empty graph.
+         */
+        FrameGraph() = default;
+
+        /*!
+         * Add a transient resource.
+         *
+         * @param size the size of the resource in bytes
+         * @param alignment the alignment of the resource, a power of two
+         * @param category the resources that may share memory, as required by the heap tier
+         * @return the id of the resource
+         * @throws std::invalid_argument if size is 0 or alignment is no power of two
+         */
+        uint32_t CreateResource(uint64_t size, uint64_t alignment, uint32_t category = 0);
+
+        /*!
+         * Add a resource that lives outside of the graph.
+         *
+         * @param initialState the state of the resource when the frame starts
+         * @return the id of the resource
+         */
+        uint32_t ImportResource(D3D12_RESOURCE_STATES initialState);
+
+        /*!
+         * Add a pass.
+         *
+         * @param accesses the resources the pass uses
+         * @param keep true if the pass has effects outside of the graph and must not be culled
+         * @return the id of the pass, passes are numbered in the order they are added
+         * @throws std::invalid_argument if an access uses an unknown resource
+         */
+        uint32_t AddPass(std::vector<FrameGraphAccess> accesses, bool keep = false);
+
+        /*!
+         * Check if a resource is imported.
+         *
+         * @param resource the resource
+         * @return true if the resource was added with ImportResource
+         */
+        bool IsImported(uint32_t resource) const;
+
+        /*!
+         * Get the accesses of a pass.
+         *
+         * @param pass the pass
+         * @return the accesses given to AddPass
+         */
+        const std::vector<FrameGraphAccess>& GetAccesses(uint32_t pass) const;
+
+        /*!
+         * Get the number of resources.
+         *
+         * @return the number of resources
+         */
+        size_t GetResourceCount() const;
+
+        /*!
+         * Get the number of passes.
+         *
+         * @return the number of passes
+         */
+        size_t GetPassCount() const;
+
+        /*!
+         * Remove all resources and passes.
+         */
+        void Clear();
+
+        /*!
+         * Cull the passes, derive the barriers and place the transient resources.
+         *
+         * @return the plan for the frame
+         */
+        FrameGraphPlan Compile() const;
+
+    private:
+        struct ResourceInfo
+        {
+            uint64_t              size;
+            uint64_t              alignment;
+            uint32_t              category;
+            bool                  imported;
+            D3D12_RESOURCE_STATES initialState;
+        };
+
+        struct Pass
+        {
+            std::vector<FrameGraphAccess> accesses;
+            bool                          keep;
+        };
+
+        std::vector<ResourceInfo> resources;
+        std::vector<Pass>         passes;
+    };
+}
+
+#endif
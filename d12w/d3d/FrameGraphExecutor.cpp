@@ -0,0 +1,268 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "FrameGraphExecutor.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "../util.h"
+#include "CommandList.h"
+#include "Device.h"
+#include "Resource.h"
+
+namespace d12w::d3d
+{
+    namespace
+    {
+        // the categories of ResourceAllocator, resources of different categories can not share a heap on tier 1 hardware
+        constexpr auto CATEGORY_COUNT = 3u;
+
+        constexpr auto RT_DS_FLAGS = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
+
+        const D3D12_HEAP_FLAGS CATEGORY_FLAGS[CATEGORY_COUNT] = {D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS, D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES, D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES};
+
+        UINT64 AlignUp(UINT64 value, UINT64 alignment)
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        uint32_t GetCategory(const D3D12_RESOURCE_DESC& desc)
+        {
+            if (desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+            {
+                return 0u;
+            }
+            return (desc.Flags & RT_DS_FLAGS) ? 2u : 1u;
+        }
+
+        D3D12_RESOURCE_BARRIER MakeBarrier(const FrameGraphBarrier& barrier, ID3D12Resource* resource)
+        {
+            auto result = D3D12_RESOURCE_BARRIER{};
+            result.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+            switch (barrier.type)
+            {
+            case FrameGraphBarrierType::TRANSITION:
+                result.Type                   = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+                result.Transition.pResource   = resource;
+                result.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+                result.Transition.StateBefore = barrier.before;
+                result.Transition.StateAfter  = barrier.after;
+                break;
+            case FrameGraphBarrierType::ALIASING:
+                // no resource before, any resource that used the memory may have been active
+                result.Type                     = D3D12_RESOURCE_BARRIER_TYPE_ALIASING;
+                result.Aliasing.pResourceBefore = nullptr;
+                result.Aliasing.pResourceAfter  = resource;
+                break;
+            case FrameGraphBarrierType::UAV:
+                result.Type          = D3D12_RESOURCE_BARRIER_TYPE_UAV;
+                result.UAV.pResource = resource;
+                break;
+            }
+            return result;
+        }
+    }
+
+    FrameGraphExecutor::FrameGraphExecutor(Device& device)
+    : device(device), heaps(CATEGORY_COUNT) {}
+
+    FrameGraphExecutor::~FrameGraphExecutor() = default;
+
+    uint32_t FrameGraphExecutor::CreateResource(const D3D12_RESOURCE_DESC& desc, const D3D12_CLEAR_VALUE* clearValue)
+    {
+        auto info = device.GetResourceAllocationInfo(desc);
+        auto id   = graph.CreateResource(info.SizeInBytes, info.Alignment, GetCategory(desc));
+
+        auto entry = Entry{};
+        entry.desc = desc;
+        if (clearValue != nullptr)
+        {
+            entry.hasClearValue = true;
+            entry.clearValue    = *clearValue;
+        }
+        entries.push_back(std::move(entry));
+        return id;
+    }
+
+    uint32_t FrameGraphExecutor::ImportResource(Resource& resource)
+    {
+        auto id = graph.ImportResource(resource.GetState());
+
+        auto entry = Entry{};
+        entry.imported = &resource;
+        entries.push_back(std::move(entry));
+        return id;
+    }
+
+    uint32_t FrameGraphExecutor::AddPass(std::vector<FrameGraphAccess> accesses, Record record, bool keep)
+    {
+        auto id = graph.AddPass(std::move(accesses), keep);
+        records.push_back(std::move(record));
+        return id;
+    }
+
+    void FrameGraphExecutor::Compile()
+    {
+        compiled = false;
+
+        // the resources of the last compilation release the memory before it is reused
+        for (auto& entry : entries)
+        {
+            entry.placed = nullptr;
+        }
+
+        plan = graph.Compile();
+
+        for (const auto& planned : plan.heaps)
+        {
+            D12W_ASSERT(planned.category < CATEGORY_COUNT);
+            auto& heap = heaps[planned.category];
+            if (heap.heap && heap.size >= planned.size && heap.alignment >= planned.alignment)
+            {
+                continue;
+            }
+
+            heap.heap = nullptr;
+
+            auto desc = D3D12_HEAP_DESC{};
+            desc.SizeInBytes     = AlignUp(planned.size, D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT);
+            desc.Properties.Type = D3D12_HEAP_TYPE_DEFAULT;
+            desc.Alignment       = planned.alignment > D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT ? D3D12_DEFAULT_MSAA_RESOURCE_PLACEMENT_ALIGNMENT : D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+            desc.Flags           = CATEGORY_FLAGS[planned.category];
+
+            heap.heap      = device.CreateHeap(desc);
+            heap.size      = desc.SizeInBytes;
+            heap.alignment = desc.Alignment;
+        }
+
+        for (auto r = 0u; r < entries.size(); r++)
+        {
+            const auto& placement = plan.placements[r];
+            if (placement.heap == UINT32_MAX)
+            {
+                continue;
+            }
+
+            auto& entry      = entries[r];
+            auto  heap       = heaps[plan.heaps[placement.heap].category].heap.Get();
+            auto  clearValue = entry.hasClearValue ? &entry.clearValue : nullptr;
+            entry.placed = device.CreatePlacedResource(heap, placement.offset, entry.desc, plan.initialStates[r], clearValue);
+        }
+
+        compiled = true;
+    }
+
+    void FrameGraphExecutor::Execute(CommandList& list)
+    {
+        if (!compiled)
+        {
+            D12W_THROW(std::logic_error, "The frame graph is not compiled.");
+        }
+
+        auto barriers = std::vector<D3D12_RESOURCE_BARRIER>{};
+        auto imported = std::vector<std::pair<Resource*, D3D12_RESOURCE_STATES>>{};
+        for (const auto& step : plan.steps)
+        {
+            // imported resources are transitioned on every use, the list resolves the state they are really in
+            imported.clear();
+            for (const auto& access : graph.GetAccesses(step.pass))
+            {
+                auto resource = entries[access.resource].imported;
+                if (resource == nullptr)
+                {
+                    continue;
+                }
+
+                auto i = std::find_if(imported.begin(), imported.end(), [resource] (const auto& use) {
+                    return use.first == resource;
+                });
+                if (i != imported.end())
+                {
+                    i->second = i->second | access.state;
+                }
+                else
+                {
+                    imported.emplace_back(resource, access.state);
+                }
+            }
+            for (const auto& [resource, state] : imported)
+            {
+                list.Transition(*resource, state);
+            }
+
+            barriers.clear();
+            for (const auto& barrier : step.barriers)
+            {
+                const auto& entry = entries[barrier.resource];
+                if (entry.imported == nullptr)
+                {
+                    barriers.push_back(MakeBarrier(barrier, entry.placed.Get()));
+                }
+                else if (barrier.type == FrameGraphBarrierType::UAV)
+                {
+                    list.UavBarrier(entry.imported);
+                }
+            }
+
+            // ResourceBarrier issues the tracked barriers first
+            if (!barriers.empty())
+            {
+                list.ResourceBarrier(static_cast<UINT>(barriers.size()), barriers.data());
+            }
+            else
+            {
+                list.FlushBarriers();
+            }
+
+            if (records[step.pass])
+            {
+                records[step.pass](list);
+            }
+        }
+    }
+
+    ID3D12Resource* FrameGraphExecutor::GetResource(uint32_t resource) const
+    {
+        D12W_ASSERT(resource < entries.size());
+        const auto& entry = entries[resource];
+        return entry.imported != nullptr ? entry.imported->GetResource() : entry.placed.Get();
+    }
+
+    const FrameGraph& FrameGraphExecutor::GetGraph() const
+    {
+        return graph;
+    }
+
+    const FrameGraphPlan& FrameGraphExecutor::GetPlan() const
+    {
+        return plan;
+    }
+
+    void FrameGraphExecutor::Clear()
+    {
+        compiled = false;
+        plan     = {};
+        graph.Clear();
+        entries.clear();
+        records.clear();
+    }
+}
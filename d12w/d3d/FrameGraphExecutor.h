@@ -0,0 +1,178 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_FRAME_GRAPH_EXECUTOR_H_
+#define _D12W_FRAME_GRAPH_EXECUTOR_H_
+
+#include <functional>
+#include <vector>
+#include <d3d12.h>
+
+#include "../defines.h"
+#include "../ComPtr.h"
+#include "FrameGraph.h"
+
+namespace d12w::d3d
+{
+    class Device;
+    class Resource;
+    class CommandList;
+
+    /*!
+     * Frame Graph Executor
+     *
+     * Runs a FrameGraph on a device. Transient resources are described like
+     * committed resources; Compile creates one default heap per resource
+     * category, large enough for the aliased resources, and places the
+     * resources in it. Heaps are kept when the graph is compiled again and
+     * they are still large enough.
+     *
+     * Execute records the passes on a command list. The barriers of the
+     * transient resources are issued as compiled, the graph owns these
+     * resources and knows their states. Imported resources go through the
+     * state tracking of the command list, so their states are resolved when
+     * the list is submitted, like for any other tracked resource.
+     *
+     * The resources of a compilation are only valid until the next one. The
+     * GPU must be done with the frames that use them before Compile or
+     * Clear is called.
+     */
+    class D12W_EXPORT FrameGraphExecutor
+    {
+    public:
+        /*!
+         * Records the work of a pass.
+         */
+        using Record = std::function<void (CommandList& list)>;
+
+        /*!
+         * Create an executor.
+         *
+         * @param device the device to create the heaps and resources on
+         */
+        explicit
+        FrameGraphExecutor(Device& device);
+
+        FrameGraphExecutor(const FrameGraphExecutor&) = delete;
+
+        ~FrameGraphExecutor();
+
+        FrameGraphExecutor& operator = (const FrameGraphExecutor&) = delete;
+
+        /*!
+         * Add a transient resource.
+         *
+         * @param desc the description of the resource
+         * @param clearValue the optimized clear value of render targets and depth stencils
+         * @return the id of the resource
+         */
+        uint32_t CreateResource(const D3D12_RESOURCE_DESC& desc, const D3D12_CLEAR_VALUE* clearValue = nullptr);
+
+        /*!
+         * Add a resource that lives outside of the graph.
+         *
+         * @param resource the resource, it must outlive the executor or the next Clear
+         * @return the id of the resource
+         */
+        uint32_t ImportResource(Resource& resource);
+
+        /*!
+         * Add a pass.
+         *
+         * @param accesses the resources the pass uses
+         * @param record records the work of the pass, the barriers are issued before
+         * @param keep true if the pass has effects outside of the graph and must not be culled
+         * @return the id of the pass
+         * @throws std::invalid_argument if an access uses an unknown resource
+         */
+        uint32_t AddPass(std::vector<FrameGraphAccess> accesses, Record record, bool keep = false);
+
+        /*!
+         * Compile the graph and create the transient resources.
+         */
+        void Compile();
+
+        /*!
+         * Record the frame.
+         *
+         * @param list the command list to record on
+         * @throws std::logic_error if the graph was not compiled
+         */
+        void Execute(CommandList& list);
+
+        /*!
+         * Get a resource of the graph.
+         *
+         * Transient resources exist after Compile, if a pass that was not
+         * culled uses them.
+         *
+         * @param resource the resource
+         * @return the resource or nullptr if it was not created
+         */
+        ID3D12Resource* GetResource(uint32_t resource) const;
+
+        /*!
+         * Get the graph.
+         *
+         * @return the graph
+         */
+        const FrameGraph& GetGraph() const;
+
+        /*!
+         * Get the result of the last Compile.
+         *
+         * @return the plan
+         */
+        const FrameGraphPlan& GetPlan() const;
+
+        /*!
+         * Remove all resources and passes, the heaps are kept.
+         */
+        void Clear();
+
+    private:
+        struct Entry
+        {
+            Resource*              imported      = nullptr;
+            D3D12_RESOURCE_DESC    desc          = {};
+            bool                   hasClearValue = false;
+            D3D12_CLEAR_VALUE      clearValue    = {};
+            ComPtr<ID3D12Resource> placed;
+        };
+
+        struct Heap
+        {
+            ComPtr<ID3D12Heap> heap;
+            uint64_t           size      = 0;
+            uint64_t           alignment = 0;
+        };
+
+        Device&             device;
+        FrameGraph          graph;
+        FrameGraphPlan      plan;
+        bool                compiled = false;
+        std::vector<Entry>  entries;
+        std::vector<Record> records;
+        std::vector<Heap>   heaps;
+    };
+}
+
+#endif
@@ -0,0 +1,108 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "ParallelRecorder.h"
+
+#include <algorithm>
+
+#include "../util.h"
+#include "Device.h"
+
+namespace d12w::d3d
+{
+    ParallelRecorder::ParallelRecorder(Device& device, CommandAllocatorPool& allocators, JobPool& jobs)
+    : device(device), allocators(allocators), jobs(jobs) {}
+
+    UINT64 ParallelRecorder::Record(CommandQueue& queue, size_t count, size_t chunkSize, const RecordFunction& record)
+    {
+        D12W_ASSERT(chunkSize > 0);
+        D12W_ASSERT(queue.GetType() == allocators.GetType());
+        if (count == 0)
+        {
+            return 0;
+        }
+
+        auto chunkCount = (count + chunkSize - 1) / chunkSize;
+        if (lists.size() < chunkCount)
+        {
+            lists.resize(chunkCount);
+        }
+        listAllocators.assign(chunkCount, nullptr);
+
+        try
+        {
+            jobs.Run(chunkCount, [&] (size_t chunk) {
+                auto allocator = allocators.Acquire();
+                listAllocators[chunk] = allocator;
+
+                auto& list = lists[chunk];
+                if (list)
+                {
+                    list->Reset(allocator);
+                }
+                else
+                {
+                    list = std::make_unique<CommandList>(device, allocators.GetType(), allocator);
+                }
+
+                auto begin = chunk * chunkSize;
+                auto end   = std::min(begin + chunkSize, count);
+                try
+                {
+                    record(*list, begin, end);
+                }
+                catch (...)
+                {
+                    // a closed list can be reset on the next call
+                    list->Close();
+                    throw;
+                }
+                list->Close();
+            });
+        }
+        catch (...)
+        {
+            // nothing was submitted, the allocators are free once the earlier work is done
+            for (auto& allocator : listAllocators)
+            {
+                if (allocator)
+                {
+                    allocators.Release(std::move(allocator), queue.GetLastSignaledValue());
+                }
+            }
+            throw;
+        }
+
+        submission.clear();
+        for (auto i = size_t{0}; i < chunkCount; i++)
+        {
+            submission.push_back(lists[i].get());
+        }
+        queue.ExecuteCommandLists(static_cast<UINT>(chunkCount), submission.data());
+        auto fenceValue = queue.Signal();
+
+        for (auto& allocator : listAllocators)
+        {
+            allocators.Release(std::move(allocator), fenceValue);
+        }
+        return fenceValue;
+    }
+}
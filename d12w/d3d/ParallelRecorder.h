@@ -0,0 +1,100 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_PARALLEL_RECORDER_H_
+#define _D12W_PARALLEL_RECORDER_H_
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include <d3d12.h>
+
+#include "../defines.h"
+#include "../ComPtr.h"
+#include "../JobPool.h"
+#include "CommandList.h"
+#include "CommandQueue.h"
+#include "CommandAllocatorPool.h"
+
+namespace d12w::d3d
+{
+    class Device;
+
+    /*!
+     * Parallel Command List Recorder
+     *
+     * Splits a list of items, for example the draws of a frame, into
+     * chunks and records each chunk into its own command list on a job
+     * pool. The lists are then submitted in order with one
+     * ExecuteCommandLists call, so the GPU sees the items in their
+     * original order.
+     *
+     * The command lists are kept and reset each time, the allocators come
+     * from a pool and are returned with the fence value of the submission.
+     *
+     * A recorder must only be used by one thread at a time.
+     */
+    class D12W_EXPORT ParallelRecorder
+    {
+    public:
+        /*!
+         * Record the items begin to end - 1 into a list.
+         */
+        using RecordFunction = std::function<void (CommandList& list, size_t begin, size_t end)>;
+
+        /*!
+         * Create a recorder.
+         *
+         * @param device the device to create command lists on
+         * @param allocators the allocator pool, its type is the type of the lists
+         * @param jobs the job pool to record on
+         */
+        ParallelRecorder(Device& device, CommandAllocatorPool& allocators, JobPool& jobs);
+
+        ParallelRecorder(const ParallelRecorder&) = delete;
+
+        ParallelRecorder& operator = (const ParallelRecorder&) = delete;
+
+        /*!
+         * Record items in parallel and submit them.
+         *
+         * The record function is called concurrently for different chunks.
+         * If it throws nothing is submitted and the exception is rethrown.
+         *
+         * @param queue the queue to submit to, of the type of the allocators
+         * @param count the number of items
+         * @param chunkSize the number of items per command list
+         * @param record the function that records a chunk of items
+         * @return the fence value of the submission, 0 if there are no items
+         */
+        UINT64 Record(CommandQueue& queue, size_t count, size_t chunkSize, const RecordFunction& record);
+
+    private:
+        Device&                                     device;
+        CommandAllocatorPool&                       allocators;
+        JobPool&                                    jobs;
+        std::vector<std::unique_ptr<CommandList>>   lists;
+        std::vector<ComPtr<ID3D12CommandAllocator>> listAllocators;
+        std::vector<CommandList*>                   submission;
+    };
+}
+
+#endif
@@ -0,0 +1,151 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "QueueGraph.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "../util.h"
+
+namespace d12w::d3d
+{
+    namespace
+    {
+        // positions are 1 based, 0 means nothing of that queue is known to be done
+        using Clock = std::vector<uint32_t>;
+    }
+
+    QueueGraph::QueueGraph(uint32_t queueCount)
+    : queueCount(queueCount)
+    {
+        D12W_ASSERT(queueCount > 0);
+    }
+
+    uint32_t QueueGraph::Add(uint32_t queue, std::vector<uint32_t> dependencies)
+    {
+        if (queue >= queueCount)
+        {
+            D12W_THROW(std::invalid_argument, "Invalid queue.");
+        }
+
+        auto id = static_cast<uint32_t>(items.size());
+        for (auto dependency : dependencies)
+        {
+            if (dependency >= id)
+            {
+                D12W_THROW(std::invalid_argument, "Items can only depend on earlier items.");
+            }
+        }
+
+        items.push_back({queue, std::move(dependencies)});
+        return id;
+    }
+
+    uint32_t QueueGraph::GetQueue(uint32_t item) const
+    {
+        D12W_ASSERT(item < items.size());
+        return items[item].queue;
+    }
+
+    size_t QueueGraph::GetItemCount() const
+    {
+        return items.size();
+    }
+
+    void QueueGraph::Clear()
+    {
+        items.clear();
+    }
+
+    std::vector<QueueStep> QueueGraph::Compile() const
+    {
+        auto steps    = std::vector<QueueStep>(items.size());
+        auto position = std::vector<uint32_t>(items.size());
+        auto clocks   = std::vector<Clock>(items.size());
+
+        auto queueClocks = std::vector<Clock>(queueCount, Clock(queueCount, 0));
+        auto queueItems  = std::vector<std::vector<uint32_t>>(queueCount);
+
+        auto required = std::vector<uint32_t>(queueCount);
+        auto waits    = std::vector<uint32_t>{};
+        for (auto id = 0u; id < items.size(); id++)
+        {
+            const auto& item  = items[id];
+            auto&       clock = queueClocks[item.queue];
+
+            // the latest item of each other queue the item depends on, if the clock does not cover it yet
+            std::fill(required.begin(), required.end(), 0);
+            for (auto dependency : item.dependencies)
+            {
+                auto queue = items[dependency].queue;
+                if (queue != item.queue && position[dependency] > clock[queue])
+                {
+                    required[queue] = std::max(required[queue], position[dependency]);
+                }
+            }
+
+            // a wait is redundant if the item waited for by another wait already ran after it
+            waits.clear();
+            for (auto queue = 0u; queue < queueCount; queue++)
+            {
+                if (required[queue] == 0)
+                {
+                    continue;
+                }
+
+                auto covered = false;
+                for (auto other = 0u; other < queueCount && !covered; other++)
+                {
+                    if (other != queue && required[other] != 0)
+                    {
+                        const auto& otherClock = clocks[queueItems[other][required[other] - 1]];
+                        covered = otherClock[queue] >= required[queue];
+                    }
+                }
+                if (!covered)
+                {
+                    waits.push_back(queue);
+                }
+            }
+
+            for (auto queue : waits)
+            {
+                auto waitedItem = queueItems[queue][required[queue] - 1];
+                steps[waitedItem].signal = true;
+                steps[id].waits.push_back({queue, waitedItem});
+
+                const auto& waitedClock = clocks[waitedItem];
+                for (auto i = 0u; i < queueCount; i++)
+                {
+                    clock[i] = std::max(clock[i], waitedClock[i]);
+                }
+            }
+
+            queueItems[item.queue].push_back(id);
+            position[id] = static_cast<uint32_t>(queueItems[item.queue].size());
+            clock[item.queue] = position[id];
+            clocks[id] = clock;
+        }
+
+        return steps;
+    }
+}
@@ -0,0 +1,129 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_QUEUE_GRAPH_H_
+#define _D12W_QUEUE_GRAPH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../defines.h"
+
+namespace d12w::d3d
+{
+    /*!
+     * Queue Wait
+     *
+     * A queue waits until another queue finished an item.
+     */
+    struct QueueWait
+    {
+        uint32_t queue = 0; //!< the queue to wait for
+        uint32_t item  = 0; //!< the item to wait for, it is on that queue
+    };
+
+    /*!
+     * Queue Step
+     *
+     * How to submit one item.
+     */
+    struct QueueStep
+    {
+        std::vector<QueueWait> waits;          //!< the waits to insert before the item
+        bool                   signal = false; //!< true if other queues wait for the item, so it must be followed by a signal
+    };
+
+    /*!
+     * Queue Graph
+     *
+     * Work items on several queues, like direct, compute and copy, with
+     * dependencies between them. Items on the same queue run in the order
+     * they were added. Compile finds the cross queue waits that are
+     * needed, and no more.
+     *
+     * Each queue keeps a vector clock: for every queue, the last item it
+     * is known to run after. A dependency that the clock already covers,
+     * directly or through an earlier wait, needs no wait. Of the remaining
+     * dependencies a wait is dropped when the clock of another wait of the
+     * same item covers it. This is the transitive reduction of the cross
+     * queue dependencies.
+     */
+    class D12W_EXPORT QueueGraph
+    {
+    public:
+        /*!
+         * Create an empty graph.
+         *
+         * @param queueCount the number of queues
+         */
+        explicit
+        QueueGraph(uint32_t queueCount);
+
+        /*!
+         * Add an item.
+         *
+         * @param queue the queue the item runs on
+         * @param dependencies the earlier items that must finish before the item starts
+         * @return the id of the item, items are numbered in the order they are added
+         */
+        uint32_t Add(uint32_t queue, std::vector<uint32_t> dependencies = {});
+
+        /*!
+         * Get the queue of an item.
+         *
+         * @param item the item
+         * @return the queue of the item
+         */
+        uint32_t GetQueue(uint32_t item) const;
+
+        /*!
+         * Get the number of items.
+         *
+         * @return the number of items
+         */
+        size_t GetItemCount() const;
+
+        /*!
+         * Remove all items.
+         */
+        void Clear();
+
+        /*!
+         * Find the waits and signals.
+         *
+         * @return one step per item, in the order of the items
+         */
+        std::vector<QueueStep> Compile() const;
+
+    private:
+        struct Item
+        {
+            uint32_t              queue;
+            std::vector<uint32_t> dependencies;
+        };
+
+        uint32_t          queueCount;
+        std::vector<Item> items;
+    };
+}
+
+#endif
@@ -0,0 +1,107 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "QueueScheduler.h"
+
+#include "../util.h"
+#include "CommandQueue.h"
+#include "CommandList.h"
+
+namespace d12w::d3d
+{
+    QueueScheduler::QueueScheduler(std::vector<CommandQueue*> q)
+    : queues(std::move(q)), graph(static_cast<uint32_t>(queues.size())), pending(queues.size()) {}
+
+    uint32_t QueueScheduler::Add(uint32_t queue, UINT count, CommandList* const* lists, std::vector<uint32_t> dependencies)
+    {
+        auto id = graph.Add(queue, std::move(dependencies));
+
+        for (auto i = 0u; i < count; i++)
+        {
+            D12W_ASSERT(lists[i]->GetType() == queues[queue]->GetType());
+        }
+        itemLists.emplace_back(lists, lists + count);
+        return id;
+    }
+
+    std::vector<UINT64> QueueScheduler::Execute()
+    {
+        auto steps       = graph.Compile();
+        auto fenceValues = std::vector<UINT64>(steps.size(), 0);
+        auto used        = std::vector<bool>(queues.size(), false);
+
+        waitCount = 0;
+        for (auto id = 0u; id < steps.size(); id++)
+        {
+            auto queue = graph.GetQueue(id);
+            used[queue] = true;
+
+            const auto& step = steps[id];
+            if (!step.waits.empty())
+            {
+                Flush(queue);
+                for (const auto& wait : step.waits)
+                {
+                    // the waited item comes earlier, so its signal is already made
+                    D12W_ASSERT(fenceValues[wait.item] != 0);
+                    queues[queue]->Wait(*queues[wait.queue], fenceValues[wait.item]);
+                    waitCount++;
+                }
+            }
+
+            pending[queue].insert(pending[queue].end(), itemLists[id].begin(), itemLists[id].end());
+            if (step.signal)
+            {
+                Flush(queue);
+                fenceValues[id] = queues[queue]->Signal();
+            }
+        }
+
+        auto result = std::vector<UINT64>(queues.size(), 0);
+        for (auto queue = 0u; queue < queues.size(); queue++)
+        {
+            if (used[queue])
+            {
+                Flush(queue);
+                result[queue] = queues[queue]->Signal();
+            }
+        }
+
+        graph.Clear();
+        itemLists.clear();
+        return result;
+    }
+
+    size_t QueueScheduler::GetWaitCount() const
+    {
+        return waitCount;
+    }
+
+    void QueueScheduler::Flush(uint32_t queue)
+    {
+        auto& lists = pending[queue];
+        if (!lists.empty())
+        {
+            queues[queue]->ExecuteCommandLists(static_cast<UINT>(lists.size()), lists.data());
+            lists.clear();
+        }
+    }
+}
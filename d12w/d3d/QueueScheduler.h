@@ -0,0 +1,105 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_QUEUE_SCHEDULER_H_
+#define _D12W_QUEUE_SCHEDULER_H_
+
+#include <cstdint>
+#include <vector>
+#include <d3d12.h>
+
+#include "../defines.h"
+#include "QueueGraph.h"
+
+namespace d12w::d3d
+{
+    class CommandQueue;
+    class CommandList;
+
+    /*!
+     * Queue Scheduler
+     *
+     * Submits work to several queues, for example to overlap async compute
+     * and copies with graphics. Each item names its queue and the earlier
+     * items it depends on. The scheduler inserts the cross queue Signal and
+     * Wait pairs the dependencies need, leaving out those that are already
+     * implied by others (see QueueGraph). Consecutive items on a queue
+     * without a wait or signal between them are submitted with one
+     * ExecuteCommandLists call.
+     *
+     * An item is submitted before the items that depend on it, so the
+     * resource states of its lists are resolved first. Items on different
+     * queues without a dependency must not use the same resources.
+     *
+     * The scheduler is not thread safe.
+     */
+    class D12W_EXPORT QueueScheduler
+    {
+    public:
+        /*!
+         * Create a scheduler.
+         *
+         * @param queues the queues, they are referred to by index and must outlive the scheduler
+         */
+        explicit
+        QueueScheduler(std::vector<CommandQueue*> queues);
+
+        QueueScheduler(const QueueScheduler&) = delete;
+
+        QueueScheduler& operator = (const QueueScheduler&) = delete;
+
+        /*!
+         * Add an item.
+         *
+         * @param queue the index of the queue to run the item on
+         * @param count the number of command lists
+         * @param lists the closed command lists of the item, they must stay alive until Execute
+         * @param dependencies the earlier items that must finish before the item starts
+         * @return the id of the item
+         */
+        uint32_t Add(uint32_t queue, UINT count, CommandList* const* lists, std::vector<uint32_t> dependencies = {});
+
+        /*!
+         * Submit all items.
+         *
+         * @return for each queue the fence value after which its items finished, 0 for queues without items
+         */
+        std::vector<UINT64> Execute();
+
+        /*!
+         * Get the number of waits inserted by the last Execute.
+         *
+         * @return the number of waits
+         */
+        size_t GetWaitCount() const;
+
+    private:
+        std::vector<CommandQueue*>             queues;
+        QueueGraph                             graph;
+        std::vector<std::vector<CommandList*>> itemLists;
+        std::vector<std::vector<CommandList*>> pending;
+        size_t                                 waitCount = 0;
+
+        void Flush(uint32_t queue);
+    };
+}
+
+#endif
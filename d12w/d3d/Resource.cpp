@@ -0,0 +1,121 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Resource.h"
+
+#include <algorithm>
+
+#include "../util.h"
+
+namespace d12w::d3d
+{
+    namespace
+    {
+        UINT GetPlaneCount(DXGI_FORMAT format)
+        {
+            switch (format)
+            {
+                case DXGI_FORMAT_R24G8_TYPELESS:
+                case DXGI_FORMAT_D24_UNORM_S8_UINT:
+                case DXGI_FORMAT_R32G8X24_TYPELESS:
+                case DXGI_FORMAT_D32_FLOAT_S8X24_UINT:
+                case DXGI_FORMAT_NV12:
+                case DXGI_FORMAT_P010:
+                case DXGI_FORMAT_P016:
+                    return 2;
+                default:
+                    return 1;
+            }
+        }
+
+        UINT CountSubresources(const D3D12_RESOURCE_DESC& desc)
+        {
+            if (desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+            {
+                return 1;
+            }
+            auto arraySize = desc.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D ? 1u : desc.DepthOrArraySize;
+            return desc.MipLevels * arraySize * GetPlaneCount(desc.Format);
+        }
+    }
+
+    Resource::Resource(ComPtr<ID3D12Resource> r, D3D12_RESOURCE_STATES initialState)
+    : resource(std::move(r)), state(initialState)
+    {
+        D12W_ASSERT(resource);
+        subresourceCount = CountSubresources(resource->GetDesc());
+    }
+
+    ID3D12Resource* Resource::GetResource() const
+    {
+        return resource.Get();
+    }
+
+    UINT Resource::GetSubresourceCount() const
+    {
+        return subresourceCount;
+    }
+
+    D3D12_RESOURCE_STATES Resource::GetState(UINT subresource) const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return GetStateUnlocked(subresource);
+    }
+
+    void Resource::SetState(D3D12_RESOURCE_STATES newState, UINT subresource)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        SetStateUnlocked(newState, subresource);
+    }
+
+    D3D12_RESOURCE_STATES Resource::GetStateUnlocked(UINT subresource) const
+    {
+        D12W_ASSERT(subresource < subresourceCount);
+        return states.empty() ? state : states[subresource];
+    }
+
+    void Resource::SetStateUnlocked(D3D12_RESOURCE_STATES newState, UINT subresource)
+    {
+        if (subresource == D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES)
+        {
+            state = newState;
+            states.clear();
+            return;
+        }
+
+        D12W_ASSERT(subresource < subresourceCount);
+        if (states.empty())
+        {
+            if (newState == state)
+            {
+                return;
+            }
+            states.assign(subresourceCount, state);
+        }
+        states[subresource] = newState;
+
+        if (std::all_of(states.begin(), states.end(), [newState] (auto s) { return s == newState; }))
+        {
+            state = newState;
+            states.clear();
+        }
+    }
+}
@@ -0,0 +1,111 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_RESOURCE_H_
+#define _D12W_RESOURCE_H_
+
+#include <mutex>
+#include <vector>
+#include <d3d12.h>
+
+#include "../defines.h"
+#include "../ComPtr.h"
+
+namespace d12w::d3d
+{
+    /*!
+     * Direct3D 12 Resource
+     *
+     * This wrapper implements ID3D12Resource together with the state the
+     * resource is in once all submitted work executed. The state is kept
+     * for the whole resource and only split per subresource when the
+     * subresources are in different states.
+     *
+     * Command lists record the states they need with
+     * CommandList::Transition, the command queue resolves them against
+     * this state when the lists are submitted.
+     *
+     * The resource is thread safe.
+     */
+    class D12W_EXPORT Resource
+    {
+    public:
+        /*!
+         * Wrap a resource.
+         *
+         * @param resource the resource, as created by the device or the ResourceAllocator
+         * @param initialState the state the resource was created in
+         */
+        Resource(ComPtr<ID3D12Resource> resource, D3D12_RESOURCE_STATES initialState);
+
+        Resource(const Resource&) = delete;
+
+        Resource& operator = (const Resource&) = delete;
+
+        /*!
+         * Get the wrapped resource.
+         *
+         * @return the resource
+         */
+        ID3D12Resource* GetResource() const;
+
+        /*!
+         * Get the number of subresources.
+         *
+         * @return mip levels times array slices times planes
+         */
+        UINT GetSubresourceCount() const;
+
+        /*!
+         * Get the state of a subresource after all submitted work.
+         *
+         * @param subresource the subresource index
+         * @return the state of the subresource
+         */
+        D3D12_RESOURCE_STATES GetState(UINT subresource = 0) const;
+
+        /*!
+         * Set the state after all submitted work.
+         *
+         * Use this when the state was changed outside of the tracking, for
+         * example with barriers recorded by hand.
+         *
+         * @param state the new state
+         * @param subresource the subresource index or D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES
+         */
+        void SetState(D3D12_RESOURCE_STATES state, UINT subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES);
+
+    private:
+        ComPtr<ID3D12Resource>             resource;
+        UINT                               subresourceCount;
+        mutable std::mutex                 mutex;
+        D3D12_RESOURCE_STATES              state;
+        std::vector<D3D12_RESOURCE_STATES> states;
+
+        // mutex must be held
+        D3D12_RESOURCE_STATES GetStateUnlocked(UINT subresource) const;
+        void SetStateUnlocked(D3D12_RESOURCE_STATES state, UINT subresource);
+
+    friend class ResourceStateTracker;
+    };
+}
+
+#endif
@@ -0,0 +1,373 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "ResourceAllocator.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "../util.h"
+#include "CommandList.h"
+#include "CommandQueue.h"
+#include "Device.h"
+
+namespace d12w::d3d
+{
+    namespace
+    {
+        UINT64 AlignUp(UINT64 value, UINT64 alignment)
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        constexpr auto RT_DS_FLAGS = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
+    }
+
+    ResourceAllocator::ResourceAllocator(Device& device, UINT64 heapSize)
+    : device(device), heapSize(AlignUp(heapSize, D3D12_DEFAULT_MSAA_RESOURCE_PLACEMENT_ALIGNMENT))
+    {
+        const D3D12_HEAP_TYPE heapTypes[] = {D3D12_HEAP_TYPE_DEFAULT, D3D12_HEAP_TYPE_UPLOAD, D3D12_HEAP_TYPE_READBACK};
+        const D3D12_HEAP_FLAGS categoryFlags[] = {D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS, D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES, D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES};
+        for (auto i = 0u; i < POOL_COUNT; i++)
+        {
+            pools[i].type  = heapTypes[i / CATEGORY_COUNT];
+            pools[i].flags = categoryFlags[i % CATEGORY_COUNT];
+        }
+    }
+
+    ResourceAllocation ResourceAllocator::CreateResource(D3D12_HEAP_TYPE heapType, const D3D12_RESOURCE_DESC& desc, D3D12_RESOURCE_STATES initialState, const D3D12_CLEAR_VALUE* clearValue)
+    {
+        auto placedDesc = desc;
+        auto info = GetAllocationInfo(placedDesc);
+        if (info.SizeInBytes == UINT64_MAX)
+        {
+            D12W_THROW(std::invalid_argument, "Invalid resource description.");
+        }
+
+        auto allocation = Reserve(GetPoolIndex(heapType, desc), info);
+        try
+        {
+            allocation.resource = device.CreatePlacedResource(allocation.heap, allocation.offset, placedDesc, initialState, clearValue);
+        }
+        catch (...)
+        {
+            Free(allocation);
+            throw;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto& placement = pools[allocation.pool].heaps[allocation.heapIndex]->placements[allocation.block.block];
+        placement.resource  = allocation.resource.Get();
+        placement.desc      = placedDesc;
+        placement.offset    = allocation.offset;
+        placement.size      = info.SizeInBytes;
+        placement.alignment = info.Alignment;
+        return allocation;
+    }
+
+    void ResourceAllocator::Free(ResourceAllocation& allocation)
+    {
+        if (!allocation)
+        {
+            return;
+        }
+
+        // release the resource before its memory can be reused
+        allocation.resource = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            D12W_ASSERT(allocation.pool < POOL_COUNT && allocation.heapIndex < pools[allocation.pool].heaps.size());
+            auto& heap = pools[allocation.pool].heaps[allocation.heapIndex];
+            D12W_ASSERT(heap);
+            heap->placements.erase(allocation.block.block);
+            heap->allocator.Free(allocation.block);
+        }
+        allocation = {};
+    }
+
+    std::vector<ResourceMove> ResourceAllocator::BeginDefragmentation(UINT64 budget)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto moves = std::vector<ResourceMove>{};
+
+        // the DEFAULT pools come first, the others are mapped and must stay
+        for (auto poolIndex = 0u; poolIndex < CATEGORY_COUNT && budget > 0; poolIndex++)
+        {
+            auto& pool = pools[poolIndex];
+
+            auto heaps = std::vector<DefragmentationHeap>{};
+            for (auto i = 0u; i < pool.heaps.size(); i++)
+            {
+                if (!pool.heaps[i])
+                {
+                    continue;
+                }
+
+                auto heap = DefragmentationHeap{};
+                heap.id   = i;
+                heap.size = pool.heaps[i]->allocator.GetStats().size;
+                for (const auto& [block, placement] : pool.heaps[i]->placements)
+                {
+                    heap.blocks.push_back({block, placement.offset, placement.size, placement.alignment, !placement.moving});
+                }
+                heaps.push_back(std::move(heap));
+            }
+
+            for (const auto& planned : planner.Plan(heaps, budget))
+            {
+                auto& source = pool.heaps[planned.srcHeap]->placements[planned.block];
+                auto& target = *pool.heaps[planned.dstHeap];
+
+                // the plan is made on a simplified view of the heap, the real allocation may still fail
+                auto block = target.allocator.Allocate(source.size, source.alignment);
+                if (!block)
+                {
+                    continue;
+                }
+
+                auto move = ResourceMove{};
+                move.source                = source.resource;
+                move.sourceHeapIndex       = planned.srcHeap;
+                move.sourceBlock           = planned.block;
+                move.destination.heap      = target.heap.Get();
+                move.destination.offset    = block.offset;
+                move.destination.size      = source.size;
+                move.destination.pool      = poolIndex;
+                move.destination.heapIndex = planned.dstHeap;
+                move.destination.block     = block;
+                try
+                {
+                    move.destination.resource = device.CreatePlacedResource(target.heap.Get(), block.offset, source.desc, D3D12_RESOURCE_STATE_COPY_DEST);
+                }
+                catch (...)
+                {
+                    target.allocator.Free(block);
+                    throw;
+                }
+
+                // the destination is not moved either until the move is done
+                auto placement = source;
+                placement.resource = move.destination.resource.Get();
+                placement.offset   = block.offset;
+                placement.moving   = true;
+                target.placements[block.block] = placement;
+
+                source.moving = true;
+                budget -= source.size;
+                moves.push_back(std::move(move));
+            }
+        }
+
+        return moves;
+    }
+
+    void ResourceAllocator::CompleteMove(ResourceAllocation& allocation, ResourceMove& move)
+    {
+        D12W_ASSERT(allocation.resource.Get() == move.source);
+        Free(allocation);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto placement = FindPlacement(move.destination.pool, move.destination.heapIndex, move.destination.block.block, move.destination.resource.Get());
+            D12W_ASSERT(placement != nullptr);
+            placement->moving = false;
+        }
+        allocation = std::move(move.destination);
+        move = {};
+    }
+
+    void ResourceAllocator::CancelMove(ResourceMove& move)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            // the source may have been freed in the meantime and its block
+            // reused, even in another heap after a Trim
+            auto placement = FindPlacement(move.destination.pool, move.sourceHeapIndex, move.sourceBlock, move.source);
+            if (placement != nullptr)
+            {
+                placement->moving = false;
+            }
+        }
+        Free(move.destination);
+        move = {};
+    }
+
+    UINT64 ResourceAllocator::SubmitMoves(CommandQueue& queue, CommandList& list, const std::vector<ResourceMove>& moves)
+    {
+        for (const auto& move : moves)
+        {
+            D12W_ASSERT(move.source != nullptr && move.destination.resource);
+            list.CopyResource(move.destination.resource.Get(), move.source);
+        }
+        list.Close();
+
+        auto lists = std::array<CommandList*, 1>{&list};
+        queue.ExecuteCommandLists(static_cast<UINT>(lists.size()), lists.data());
+        return queue.Signal();
+    }
+
+    void ResourceAllocator::CompleteMoves(CommandQueue& queue, UINT64 fenceValue, const std::vector<ResourceAllocation*>& allocations, std::vector<ResourceMove>& moves)
+    {
+        if (allocations.size() != moves.size())
+        {
+            D12W_THROW(std::invalid_argument, "Each move needs the allocation of its source.");
+        }
+
+        queue.WaitForValue(fenceValue);
+        for (auto i = 0u; i < moves.size(); i++)
+        {
+            CompleteMove(*allocations[i], moves[i]);
+        }
+        moves.clear();
+    }
+
+    void ResourceAllocator::Trim()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& pool : pools)
+        {
+            for (auto& heap : pool.heaps)
+            {
+                if (heap && heap->allocator.IsEmpty())
+                {
+                    heap = nullptr;
+                }
+            }
+        }
+    }
+
+    std::vector<ResourceHeapStats> ResourceAllocator::GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto stats = std::vector<ResourceHeapStats>{};
+        for (const auto& pool : pools)
+        {
+            for (const auto& heap : pool.heaps)
+            {
+                if (heap)
+                {
+                    stats.push_back({pool.type, pool.flags, heap->allocator.GetStats()});
+                }
+            }
+        }
+        return stats;
+    }
+
+    uint32_t ResourceAllocator::GetPoolIndex(D3D12_HEAP_TYPE heapType, const D3D12_RESOURCE_DESC& desc) const
+    {
+        D12W_ASSERT(heapType == D3D12_HEAP_TYPE_DEFAULT || heapType == D3D12_HEAP_TYPE_UPLOAD || heapType == D3D12_HEAP_TYPE_READBACK);
+
+        auto category = 0u;
+        if (desc.Dimension != D3D12_RESOURCE_DIMENSION_BUFFER)
+        {
+            category = (desc.Flags & RT_DS_FLAGS) ? 2u : 1u;
+        }
+        return static_cast<uint32_t>(heapType - D3D12_HEAP_TYPE_DEFAULT) * CATEGORY_COUNT + category;
+    }
+
+    D3D12_RESOURCE_ALLOCATION_INFO ResourceAllocator::GetAllocationInfo(D3D12_RESOURCE_DESC& desc)
+    {
+        // small textures may use the small alignment, the device decides if they qualify
+        auto small = desc.Dimension != D3D12_RESOURCE_DIMENSION_BUFFER && desc.SampleDesc.Count <= 1 &&
+                     (desc.Flags & RT_DS_FLAGS) == 0 && desc.Alignment == 0;
+        if (small)
+        {
+            desc.Alignment = D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT;
+            auto info = device.GetResourceAllocationInfo(desc);
+            if (info.Alignment == D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT)
+            {
+                return info;
+            }
+            desc.Alignment = 0;
+        }
+        return device.GetResourceAllocationInfo(desc);
+    }
+
+    ResourceAllocator::Placement* ResourceAllocator::FindPlacement(uint32_t poolIndex, uint32_t heapIndex, uint32_t block, ID3D12Resource* resource)
+    {
+        auto& heaps = pools[poolIndex].heaps;
+        if (heapIndex >= heaps.size() || !heaps[heapIndex])
+        {
+            return nullptr;
+        }
+
+        auto placement = heaps[heapIndex]->placements.find(block);
+        if (placement == heaps[heapIndex]->placements.end() || placement->second.resource != resource)
+        {
+            return nullptr;
+        }
+        return &placement->second;
+    }
+
+    ResourceAllocation ResourceAllocator::Reserve(uint32_t poolIndex, const D3D12_RESOURCE_ALLOCATION_INFO& info)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto& pool = pools[poolIndex];
+
+        auto allocation = ResourceAllocation{};
+        allocation.pool = poolIndex;
+        allocation.size = info.SizeInBytes;
+
+        for (auto i = 0u; i < pool.heaps.size(); i++)
+        {
+            if (!pool.heaps[i])
+            {
+                continue;
+            }
+
+            auto block = pool.heaps[i]->allocator.Allocate(info.SizeInBytes, info.Alignment);
+            if (block)
+            {
+                allocation.heap      = pool.heaps[i]->heap.Get();
+                allocation.offset    = block.offset;
+                allocation.heapIndex = i;
+                allocation.block     = block;
+                return allocation;
+            }
+        }
+
+        auto desc = D3D12_HEAP_DESC{};
+        desc.SizeInBytes     = std::max(heapSize, AlignUp(info.SizeInBytes, D3D12_DEFAULT_MSAA_RESOURCE_PLACEMENT_ALIGNMENT));
+        desc.Properties.Type = pool.type;
+        desc.Alignment       = pool.flags == D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES ? D3D12_DEFAULT_MSAA_RESOURCE_PLACEMENT_ALIGNMENT : D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+        desc.Flags           = pool.flags;
+
+        auto heap = std::make_unique<Heap>(Heap{device.CreateHeap(desc), TlsfAllocator{desc.SizeInBytes}, {}});
+        auto block = heap->allocator.Allocate(info.SizeInBytes, info.Alignment);
+        D12W_ASSERT(block);
+
+        allocation.heap   = heap->heap.Get();
+        allocation.offset = block.offset;
+        allocation.block  = block;
+
+        // reuse the slot of a trimmed heap
+        auto slot = std::find(pool.heaps.begin(), pool.heaps.end(), nullptr);
+        allocation.heapIndex = static_cast<uint32_t>(slot - pool.heaps.begin());
+        if (slot != pool.heaps.end())
+        {
+            *slot = std::move(heap);
+        }
+        else
+        {
+            pool.heaps.push_back(std::move(heap));
+        }
+        return allocation;
+    }
+}
@@ -0,0 +1,261 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_RESOURCE_ALLOCATOR_H_
+#define _D12W_RESOURCE_ALLOCATOR_H_
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <d3d12.h>
+
+#include "../defines.h"
+#include "../ComPtr.h"
+#include "TlsfAllocator.h"
+#include "DefragmentationPlanner.h"
+
+namespace d12w::d3d
+{
+    class Device;
+    class CommandList;
+    class CommandQueue;
+
+    /*!
+     * Resource Allocation
+     */
+    struct ResourceAllocation
+    {
+        ComPtr<ID3D12Resource> resource;             //!< the placed resource
+        ID3D12Heap*            heap      = nullptr;  //!< the heap the resource is placed in
+        UINT64                 offset    = 0;        //!< the offset in the heap
+        UINT64                 size      = 0;        //!< the size of the memory of the resource
+        uint32_t               pool      = 0;        //!< the pool of the heap, used to free
+        uint32_t               heapIndex = 0;        //!< the heap in the pool, used to free
+        TlsfAllocation         block;                //!< the block in the heap, used to free
+
+        explicit operator bool () const
+        {
+            return static_cast<bool>(block);
+        }
+    };
+
+    /*!
+     * Resource Move
+     *
+     * A resource that is moved to another place by defragmentation.
+     */
+    struct ResourceMove
+    {
+        ID3D12Resource*    source          = nullptr;    //!< the resource to copy from
+        ResourceAllocation destination;                  //!< the resource to copy to, in the COPY_DEST state
+        uint32_t           sourceHeapIndex = 0;          //!< the heap of the source, used to cancel
+        uint32_t           sourceBlock     = UINT32_MAX; //!< the block of the source, used to cancel
+    };
+
+    /*!
+     * Resource Heap Statistics
+     */
+    struct ResourceHeapStats
+    {
+        D3D12_HEAP_TYPE  heapType;  //!< the heap type
+        D3D12_HEAP_FLAGS heapFlags; //!< the heap flags, they give the resource category
+        TlsfStats        allocator; //!< the usage of the heap
+    };
+
+    /*!
+     * Placed Resource Allocator
+     *
+     * Creating a committed resource per buffer or texture is slow and pads
+     * every resource to 64 KiB. The allocator reserves large heaps and
+     * places resources in them, the memory of each heap is managed by a
+     * TlsfAllocator.
+     *
+     * Heaps are kept per heap type and resource category: buffers, textures
+     * and render target or depth stencil textures. This is what resource
+     * heap tier 1 requires and works on every device. Textures that qualify
+     * use the 4 KiB small resource alignment.
+     *
+     * Resources larger than the heap size get a heap of their own. Heaps
+     * are kept when they become empty, to be reused, until Trim is called.
+     *
+     * Over time the heaps fragment. Defragmentation moves resources out of
+     * sparsely used heaps a few at a time, so that they become empty and
+     * can be trimmed.
+     *
+     * The allocator is thread safe.
+     */
+    class D12W_EXPORT ResourceAllocator
+    {
+    public:
+        /*!
+         * Create an allocator.
+         *
+         * @param device the device, must outlive the allocator
+         * @param heapSize the size of the heaps in bytes
+         */
+        explicit
+        ResourceAllocator(Device& device, UINT64 heapSize = DEFAULT_HEAP_SIZE);
+
+        ResourceAllocator(const ResourceAllocator&) = delete;
+
+        ResourceAllocator& operator = (const ResourceAllocator&) = delete;
+
+        /*!
+         * Create a placed resource.
+         *
+         * @param heapType the heap type, DEFAULT, UPLOAD or READBACK
+         * @param desc the description of the resource
+         * @param initialState the initial state of the resource
+         * @param clearValue the optimized clear value, may be null
+         * @return the allocation
+         */
+        ResourceAllocation CreateResource(D3D12_HEAP_TYPE heapType, const D3D12_RESOURCE_DESC& desc, D3D12_RESOURCE_STATES initialState, const D3D12_CLEAR_VALUE* clearValue = nullptr);
+
+        /*!
+         * Release a resource and free its memory.
+         *
+         * The GPU must be done with the resource.
+         *
+         * @param allocation the allocation, it is reset
+         */
+        void Free(ResourceAllocation& allocation);
+
+        /*!
+         * Start moving resources out of sparsely used heaps.
+         *
+         * Only resources in DEFAULT heaps are moved, mapped resources stay
+         * where they are. For each move, copy the source to the destination
+         * with CopyResource, for example on the copy queue. Once the GPU
+         * finished the copy, call CompleteMove. Until then neither the
+         * source nor the destination is moved again.
+         *
+         * @param budget the maximum number of bytes to move
+         * @return the moves
+         */
+        std::vector<ResourceMove> BeginDefragmentation(UINT64 budget);
+
+        /*!
+         * Finish a move.
+         *
+         * The old resource is released and the allocation is replaced by
+         * the moved one. Views of the old resource must be recreated. The GPU
+         * must be done with the old resource.
+         *
+         * @param allocation the allocation of the source
+         * @param move the move, it is reset
+         */
+        void CompleteMove(ResourceAllocation& allocation, ResourceMove& move);
+
+        /*!
+         * Abandon a move.
+         *
+         * @param move the move, the destination is released and the move reset
+         */
+        void CancelMove(ResourceMove& move);
+
+        /*!
+         * Copy the moves on a queue.
+         *
+         * A CopyResource from each source to its destination is recorded on
+         * the list, the list is closed and executed on the queue. The sources
+         * must be in the COMMON state, so that the copy promotes them, or in
+         * COPY_SOURCE. The destinations stay in COPY_DEST, which decays to
+         * COMMON once the queue is done.
+         *
+         * @param queue the queue, usually the copy queue
+         * @param list an open command list of the type of the queue
+         * @param moves the moves returned by BeginDefragmentation
+         * @return the fence value of the queue after which the moves can be completed
+         */
+        UINT64 SubmitMoves(CommandQueue& queue, CommandList& list, const std::vector<ResourceMove>& moves);
+
+        /*!
+         * Finish the moves submitted with SubmitMoves.
+         *
+         * If the queue did not yet reach the fence value, this blocks until
+         * it does. Check CommandQueue::IsComplete to avoid the stall.
+         *
+         * @param queue the queue the moves were submitted to
+         * @param fenceValue the fence value returned by SubmitMoves
+         * @param allocations the allocations of the sources, in the order of the moves
+         * @param moves the moves, the vector is cleared
+         */
+        void CompleteMoves(CommandQueue& queue, UINT64 fenceValue, const std::vector<ResourceAllocation*>& allocations, std::vector<ResourceMove>& moves);
+
+        /*!
+         * Release all empty heaps.
+         */
+        void Trim();
+
+        /*!
+         * Get the statistics of all heaps.
+         *
+         * @return the statistics, one entry per heap
+         */
+        std::vector<ResourceHeapStats> GetStats() const;
+
+        //! The default heap size, 64 MiB.
+        static constexpr UINT64 DEFAULT_HEAP_SIZE = UINT64{64} << 20;
+
+    private:
+        static constexpr uint32_t CATEGORY_COUNT = 3;
+        static constexpr uint32_t POOL_COUNT     = 3 * CATEGORY_COUNT;
+
+        struct Placement
+        {
+            ID3D12Resource*     resource  = nullptr;
+            D3D12_RESOURCE_DESC desc;
+            UINT64              offset    = 0;
+            UINT64              size      = 0;
+            UINT64              alignment = 0;
+            bool                moving    = false;
+        };
+
+        struct Heap
+        {
+            ComPtr<ID3D12Heap>                      heap;
+            TlsfAllocator                           allocator;
+            std::unordered_map<uint32_t, Placement> placements;
+        };
+
+        struct Pool
+        {
+            D3D12_HEAP_TYPE                    type  = D3D12_HEAP_TYPE_DEFAULT;
+            D3D12_HEAP_FLAGS                   flags = D3D12_HEAP_FLAG_NONE;
+            std::vector<std::unique_ptr<Heap>> heaps;
+        };
+
+        Device&                      device;
+        UINT64                       heapSize;
+        DefragmentationPlanner       planner;
+        mutable std::mutex           mutex;
+        std::array<Pool, POOL_COUNT> pools;
+
+        uint32_t GetPoolIndex(D3D12_HEAP_TYPE heapType, const D3D12_RESOURCE_DESC& desc) const;
+        D3D12_RESOURCE_ALLOCATION_INFO GetAllocationInfo(D3D12_RESOURCE_DESC& desc);
+        ResourceAllocation Reserve(uint32_t poolIndex, const D3D12_RESOURCE_ALLOCATION_INFO& info);
+        Placement* FindPlacement(uint32_t poolIndex, uint32_t heapIndex, uint32_t block, ID3D12Resource* resource);
+    };
+}
+
+#endif
@@ -0,0 +1,253 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "ResourceStateTracker.h"
+
+#include <algorithm>
+
+#include "../util.h"
+#include "Resource.h"
+
+namespace d12w::d3d
+{
+    namespace
+    {
+        // the state of a subresource the list did not use yet, write states can not be combined so it is never valid
+        constexpr auto UNKNOWN_STATE = D3D12_RESOURCE_STATE_RENDER_TARGET | D3D12_RESOURCE_STATE_DEPTH_WRITE;
+
+        constexpr auto READ_STATES = D3D12_RESOURCE_STATE_GENERIC_READ | D3D12_RESOURCE_STATE_DEPTH_READ | D3D12_RESOURCE_STATE_RESOLVE_SOURCE;
+
+        bool IsReadState(D3D12_RESOURCE_STATES state)
+        {
+            return state != D3D12_RESOURCE_STATE_COMMON && (state & ~READ_STATES) == 0;
+        }
+
+        D3D12_RESOURCE_BARRIER MakeTransition(ID3D12Resource* resource, UINT subresource, D3D12_RESOURCE_STATES before, D3D12_RESOURCE_STATES after)
+        {
+            auto barrier = D3D12_RESOURCE_BARRIER{};
+            barrier.Type                   = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+            barrier.Flags                  = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+            barrier.Transition.pResource   = resource;
+            barrier.Transition.Subresource = subresource;
+            barrier.Transition.StateBefore = before;
+            barrier.Transition.StateAfter  = after;
+            return barrier;
+        }
+    }
+
+    void ResourceStateTracker::Transition(Resource& resource, D3D12_RESOURCE_STATES state, UINT subresource)
+    {
+        auto& t     = Track(resource);
+        auto  count = resource.GetSubresourceCount();
+
+        if (subresource == D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES && t.states.empty())
+        {
+            t.state = TransitionSubresource(t, subresource, t.state, state);
+            return;
+        }
+
+        if (subresource == D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES)
+        {
+            for (auto i = 0u; i < count; i++)
+            {
+                t.states[i] = TransitionSubresource(t, i, t.states[i], state);
+            }
+        }
+        else
+        {
+            D12W_ASSERT(subresource < count);
+            if (t.states.empty())
+            {
+                t.states.assign(count, t.state);
+            }
+            t.states[subresource] = TransitionSubresource(t, subresource, t.states[subresource], state);
+        }
+
+        // back to one state for the whole resource, if possible
+        auto first = t.states.front();
+        if (std::all_of(t.states.begin(), t.states.end(), [first] (auto s) { return s == first; }))
+        {
+            t.state = first;
+            t.states.clear();
+        }
+    }
+
+    void ResourceStateTracker::UavBarrier(Resource* resource)
+    {
+        auto raw = resource ? resource->GetResource() : nullptr;
+        auto same = [raw] (const D3D12_RESOURCE_BARRIER& barrier) {
+            return barrier.Type == D3D12_RESOURCE_BARRIER_TYPE_UAV && barrier.UAV.pResource == raw;
+        };
+        if (std::any_of(barriers.begin(), barriers.end(), same))
+        {
+            return;
+        }
+
+        auto barrier = D3D12_RESOURCE_BARRIER{};
+        barrier.Type          = D3D12_RESOURCE_BARRIER_TYPE_UAV;
+        barrier.Flags         = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+        barrier.UAV.pResource = raw;
+        barriers.push_back(barrier);
+    }
+
+    void ResourceStateTracker::Flush(ID3D12GraphicsCommandList* list)
+    {
+        if (!barriers.empty())
+        {
+            list->ResourceBarrier(static_cast<UINT>(barriers.size()), barriers.data());
+            barriers.clear();
+        }
+    }
+
+    size_t ResourceStateTracker::GetPendingCount() const
+    {
+        return barriers.size();
+    }
+
+    void ResourceStateTracker::Resolve(std::vector<D3D12_RESOURCE_BARRIER>& result) const
+    {
+        for (const auto& t : tracked)
+        {
+            auto& resource = *t.resource;
+            auto  raw      = resource.GetResource();
+            auto  count    = resource.GetSubresourceCount();
+
+            std::lock_guard<std::mutex> lock(resource.mutex);
+
+            for (const auto& [subresource, state] : t.first)
+            {
+                if (subresource != D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES)
+                {
+                    auto current = resource.GetStateUnlocked(subresource);
+                    if (current != state)
+                    {
+                        result.push_back(MakeTransition(raw, subresource, current, state));
+                    }
+                }
+                else if (resource.states.empty())
+                {
+                    if (resource.state != state)
+                    {
+                        result.push_back(MakeTransition(raw, subresource, resource.state, state));
+                    }
+                }
+                else
+                {
+                    for (auto i = 0u; i < count; i++)
+                    {
+                        if (resource.states[i] != state)
+                        {
+                            result.push_back(MakeTransition(raw, i, resource.states[i], state));
+                        }
+                    }
+                }
+            }
+
+            if (t.states.empty())
+            {
+                if (t.state != UNKNOWN_STATE)
+                {
+                    resource.SetStateUnlocked(t.state, D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES);
+                }
+            }
+            else
+            {
+                for (auto i = 0u; i < count; i++)
+                {
+                    if (t.states[i] != UNKNOWN_STATE)
+                    {
+                        resource.SetStateUnlocked(t.states[i], i);
+                    }
+                }
+            }
+        }
+    }
+
+    void ResourceStateTracker::Reset()
+    {
+        tracked.clear();
+        index.clear();
+        barriers.clear();
+    }
+
+    ResourceStateTracker::Tracked& ResourceStateTracker::Track(Resource& resource)
+    {
+        auto [i, inserted] = index.try_emplace(&resource, tracked.size());
+        if (inserted)
+        {
+            tracked.push_back({&resource, UNKNOWN_STATE, {}, {}});
+        }
+        return tracked[i->second];
+    }
+
+    D3D12_RESOURCE_STATES ResourceStateTracker::TransitionSubresource(Tracked& t, UINT subresource, D3D12_RESOURCE_STATES current, D3D12_RESOURCE_STATES state)
+    {
+        if (current == UNKNOWN_STATE)
+        {
+            // resolved at submission
+            t.first.emplace_back(subresource, state);
+            return state;
+        }
+
+        if (current == state)
+        {
+            return current;
+        }
+
+        if (IsReadState(current) && IsReadState(state))
+        {
+            if ((current & state) == state)
+            {
+                return current;
+            }
+            state = current | state;
+        }
+
+        AddTransition(*t.resource, subresource, current, state);
+        return state;
+    }
+
+    void ResourceStateTracker::AddTransition(Resource& resource, UINT subresource, D3D12_RESOURCE_STATES before, D3D12_RESOURCE_STATES after)
+    {
+        auto raw = resource.GetResource();
+
+        // a transition of the same subresource that is not issued yet is extended
+        auto same = [raw, subresource] (const D3D12_RESOURCE_BARRIER& barrier) {
+            return barrier.Type == D3D12_RESOURCE_BARRIER_TYPE_TRANSITION && barrier.Transition.pResource == raw && barrier.Transition.Subresource == subresource;
+        };
+        auto i = std::find_if(barriers.rbegin(), barriers.rend(), same);
+        if (i != barriers.rend())
+        {
+            D12W_ASSERT(i->Transition.StateAfter == before);
+            if (i->Transition.StateBefore == after)
+            {
+                barriers.erase(std::next(i).base());
+            }
+            else
+            {
+                i->Transition.StateAfter = after;
+            }
+            return;
+        }
+
+        barriers.push_back(MakeTransition(raw, subresource, before, after));
+    }
+}
@@ -0,0 +1,131 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_RESOURCE_STATE_TRACKER_H_
+#define _D12W_RESOURCE_STATE_TRACKER_H_
+
+#include <unordered_map>
+#include <vector>
+#include <d3d12.h>
+
+#include "../defines.h"
+
+namespace d12w::d3d
+{
+    class Resource;
+
+    /*!
+     * Resource State Tracker
+     *
+     * Tracks the states of resources while a command list is recorded and
+     * turns the states the commands need into barriers.
+     *
+     * A list does not know the state a resource is in when the list starts
+     * executing. The first state a resource, or subresource, is needed in
+     * is remembered instead, and Resolve makes the barriers into these
+     * states against the state of the Resource when the list is submitted.
+     * Later states are known and become barriers right away.
+     *
+     * Barriers are collected until Flush, which issues them in one
+     * ResourceBarrier call. Barriers that are not needed are left out: a
+     * transition into the current state, a read state that is already
+     * part of a combined read state and a transition that is undone before
+     * the flush. Read states are combined, so that alternating reads do not
+     * cause barriers.
+     *
+     * The tracker must only be used by one thread at a time.
+     */
+    class D12W_EXPORT ResourceStateTracker
+    {
+    public:
+        ResourceStateTracker() = default;
+
+        ResourceStateTracker(const ResourceStateTracker&) = delete;
+
+        ResourceStateTracker& operator = (const ResourceStateTracker&) = delete;
+
+        /*!
+         * Require a resource to be in a state.
+         *
+         * @param resource the resource
+         * @param state the state the next commands need
+         * @param subresource the subresource index or D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES
+         */
+        void Transition(Resource& resource, D3D12_RESOURCE_STATES state, UINT subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES);
+
+        /*!
+         * Require unordered access writes to finish before the next commands.
+         *
+         * @param resource the resource, null for all resources
+         */
+        void UavBarrier(Resource* resource = nullptr);
+
+        /*!
+         * Issue the collected barriers.
+         *
+         * @param list the command list to record the barriers on
+         */
+        void Flush(ID3D12GraphicsCommandList* list);
+
+        /*!
+         * Get the number of barriers waiting for Flush.
+         *
+         * @return the number of collected barriers
+         */
+        size_t GetPendingCount() const;
+
+        /*!
+         * Resolve the first states against the state of the resources.
+         *
+         * The barriers that bring the resources into the first states the
+         * list needs are appended, then the states the list leaves the
+         * resources in are stored in the resources. This must be called in
+         * the order the lists execute, once for each execution.
+         *
+         * @param barriers receives the barriers to execute before the list
+         */
+        void Resolve(std::vector<D3D12_RESOURCE_BARRIER>& barriers) const;
+
+        /*!
+         * Forget all states, to record again.
+         */
+        void Reset();
+
+    private:
+        struct Tracked
+        {
+            Resource*                                           resource;
+            D3D12_RESOURCE_STATES                               state;
+            std::vector<D3D12_RESOURCE_STATES>                  states;
+            std::vector<std::pair<UINT, D3D12_RESOURCE_STATES>> first;
+        };
+
+        std::vector<Tracked>                  tracked;
+        std::unordered_map<Resource*, size_t> index;
+        std::vector<D3D12_RESOURCE_BARRIER>   barriers;
+
+        Tracked& Track(Resource& resource);
+        D3D12_RESOURCE_STATES TransitionSubresource(Tracked& t, UINT subresource, D3D12_RESOURCE_STATES current, D3D12_RESOURCE_STATES state);
+        void AddTransition(Resource& resource, UINT subresource, D3D12_RESOURCE_STATES before, D3D12_RESOURCE_STATES after);
+    };
+}
+
+#endif
@@ -0,0 +1,199 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "ShaderVisibleDescriptorHeap.h"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+#include "../util.h"
+
+namespace d12w::d3d
+{
+    ShaderVisibleDescriptorHeap::ShaderVisibleDescriptorHeap(ComPtr<ID3D12Device> device, D3D12_DESCRIPTOR_HEAP_TYPE type, uint32_t persistentSize, uint32_t ringSize)
+    : persistentSize(persistentSize), ringSize(ringSize)
+    {
+        D12W_ASSERT(device);
+        D12W_ASSERT(type == D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV || type == D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER);
+
+        auto desc = D3D12_DESCRIPTOR_HEAP_DESC{type, persistentSize + ringSize, D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE, 0};
+        auto hr = device->CreateDescriptorHeap(&desc, heap.UUID(), reinterpret_cast<void**>(&heap));
+        D12W_CHECK_SUCCESS(hr);
+
+        cpuStart      = heap->GetCPUDescriptorHandleForHeapStart();
+        gpuStart      = heap->GetGPUDescriptorHandleForHeapStart();
+        incrementSize = device->GetDescriptorHandleIncrementSize(type);
+
+        if (persistentSize > 0)
+        {
+            freeRanges[0] = persistentSize;
+        }
+    }
+
+    ShaderVisibleDescriptorHeap::~ShaderVisibleDescriptorHeap() = default;
+
+    ID3D12DescriptorHeap* ShaderVisibleDescriptorHeap::GetHeap() const
+    {
+        return heap.Get();
+    }
+
+    DescriptorRange ShaderVisibleDescriptorHeap::AllocatePersistent(uint32_t count)
+    {
+        D12W_ASSERT(count > 0);
+        std::lock_guard<std::mutex> lock(mutex);
+
+        // first fit, static tables are allocated rarely
+        for (auto i = freeRanges.begin(); i != freeRanges.end(); ++i)
+        {
+            if (i->second >= count)
+            {
+                auto index = i->first;
+                auto rest  = i->second - count;
+                freeRanges.erase(i);
+                if (rest > 0)
+                {
+                    freeRanges[index + count] = rest;
+                }
+                return MakeRange(index, count);
+            }
+        }
+
+        D12W_THROW(std::runtime_error, "The persistent descriptor region is full.");
+    }
+
+    void ShaderVisibleDescriptorHeap::FreePersistent(const DescriptorRange& range, UINT64 fenceValue)
+    {
+        D12W_ASSERT(range.index + range.count <= persistentSize);
+        std::lock_guard<std::mutex> lock(mutex);
+        pendingFrees.emplace_back(fenceValue, range);
+    }
+
+    DescriptorRange ShaderVisibleDescriptorHeap::AllocateTransient(uint32_t count)
+    {
+        D12W_ASSERT(count > 0);
+        if (count > ringSize)
+        {
+            D12W_THROW(std::invalid_argument, "The transient range is larger than the shader visible descriptor ring.");
+        }
+
+        auto current = head.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            // a range must be contiguous, skip the end of the ring if it does not fit
+            auto start  = current;
+            auto offset = start % ringSize;
+            if (offset + count > ringSize)
+            {
+                start += ringSize - offset;
+            }
+            auto end = start + count;
+
+            // current may be stale, when another thread allocated and retired
+            // in the meantime the tail can even be past it
+            auto oldest = tail.load(std::memory_order_acquire);
+            if (oldest > start || end - oldest > ringSize)
+            {
+                auto latest = head.load(std::memory_order_relaxed);
+                if (latest != current)
+                {
+                    current = latest;
+                    continue;
+                }
+                D12W_THROW(std::runtime_error, "The shader visible descriptor ring is full.");
+            }
+
+            if (head.compare_exchange_weak(current, end, std::memory_order_relaxed))
+            {
+                return MakeRange(persistentSize + static_cast<uint32_t>(start % ringSize), count);
+            }
+        }
+    }
+
+    void ShaderVisibleDescriptorHeap::FinishFrame(UINT64 fenceValue)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        D12W_ASSERT(frames.empty() || frames.back().first <= fenceValue);
+        frames.emplace_back(fenceValue, head.load(std::memory_order_relaxed));
+    }
+
+    void ShaderVisibleDescriptorHeap::Retire(UINT64 completedValue)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        while (!frames.empty() && frames.front().first <= completedValue)
+        {
+            tail.store(frames.front().second, std::memory_order_release);
+            frames.pop_front();
+        }
+
+        // frees are not necessarily in fence order, but usually are
+        for (auto i = pendingFrees.begin(); i != pendingFrees.end();)
+        {
+            if (i->first <= completedValue)
+            {
+                AddFreeRange(i->second.index, i->second.count);
+                i = pendingFrees.erase(i);
+            }
+            else
+            {
+                ++i;
+            }
+        }
+    }
+
+    uint32_t ShaderVisibleDescriptorHeap::GetTransientUsage() const
+    {
+        auto used = head.load(std::memory_order_relaxed) - tail.load(std::memory_order_relaxed);
+        return static_cast<uint32_t>(std::min<uint64_t>(used, ringSize));
+    }
+
+    DescriptorRange ShaderVisibleDescriptorHeap::MakeRange(uint32_t index, uint32_t count) const
+    {
+        auto range = DescriptorRange{};
+        range.cpu           = {cpuStart.ptr + SIZE_T{index} * incrementSize};
+        range.gpu           = {gpuStart.ptr + UINT64{index} * incrementSize};
+        range.index         = index;
+        range.count         = count;
+        range.incrementSize = incrementSize;
+        return range;
+    }
+
+    // mutex must be held
+    void ShaderVisibleDescriptorHeap::AddFreeRange(uint32_t index, uint32_t count)
+    {
+        auto next = freeRanges.lower_bound(index);
+        if (next != freeRanges.end() && index + count == next->first)
+        {
+            count += next->second;
+            next = freeRanges.erase(next);
+        }
+        if (next != freeRanges.begin())
+        {
+            auto prev = std::prev(next);
+            if (prev->first + prev->second == index)
+            {
+                prev->second += count;
+                return;
+            }
+        }
+        freeRanges[index] = count;
+    }
+}
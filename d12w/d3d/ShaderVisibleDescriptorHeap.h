@@ -0,0 +1,195 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_SHADER_VISIBLE_DESCRIPTOR_HEAP_H_
+#define _D12W_SHADER_VISIBLE_DESCRIPTOR_HEAP_H_
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <d3d12.h>
+
+#include "../defines.h"
+#include "../ComPtr.h"
+
+namespace d12w::d3d
+{
+    /*!
+     * Range of Shader Visible Descriptors
+     */
+    struct DescriptorRange
+    {
+        D3D12_CPU_DESCRIPTOR_HANDLE cpu           = {}; //!< the CPU handle of the first descriptor
+        D3D12_GPU_DESCRIPTOR_HANDLE gpu           = {}; //!< the GPU handle of the first descriptor
+        uint32_t                    index         = 0;  //!< the index of the first descriptor in the heap
+        uint32_t                    count         = 0;  //!< the number of descriptors
+        UINT                        incrementSize = 0;  //!< the size of one descriptor
+
+        explicit operator bool () const
+        {
+            return count != 0;
+        }
+
+        /*!
+         * Get the CPU handle of a descriptor in the range.
+         *
+         * @param i the descriptor in the range
+         * @return the CPU handle
+         */
+        D3D12_CPU_DESCRIPTOR_HANDLE GetCpuHandle(uint32_t i) const
+        {
+            return {cpu.ptr + SIZE_T{i} * incrementSize};
+        }
+
+        /*!
+         * Get the GPU handle of a descriptor in the range.
+         *
+         * @param i the descriptor in the range
+         * @return the GPU handle
+         */
+        D3D12_GPU_DESCRIPTOR_HANDLE GetGpuHandle(uint32_t i) const
+        {
+            return {gpu.ptr + UINT64{i} * incrementSize};
+        }
+    };
+
+    /*!
+     * Shader Visible Descriptor Heap
+     *
+     * One shader visible heap split into a persistent region for static
+     * descriptor tables and a ring for per draw tables. Since all tables
+     * live in the same heap, SetDescriptorHeaps is only needed once per
+     * command list.
+     *
+     * Ring ranges are handed out lock free. The ranges allocated before
+     * FinishFrame belong to that frame and are only reused once the fence
+     * value of the frame was passed to Retire. Freed persistent ranges
+     * are held back the same way.
+     */
+    class D12W_EXPORT ShaderVisibleDescriptorHeap
+    {
+    public:
+        /*!
+         * Create a shader visible descriptor heap.
+         *
+         * @param device the device to create the heap with
+         * @param type the heap type, CBV_SRV_UAV or SAMPLER
+         * @param persistentSize the number of descriptors in the persistent region
+         * @param ringSize the number of descriptors in the ring, 0 for a heap without transient ranges
+         */
+        ShaderVisibleDescriptorHeap(ComPtr<ID3D12Device> device, D3D12_DESCRIPTOR_HEAP_TYPE type, uint32_t persistentSize, uint32_t ringSize);
+
+        ShaderVisibleDescriptorHeap(const ShaderVisibleDescriptorHeap&) = delete;
+
+        ~ShaderVisibleDescriptorHeap();
+
+        ShaderVisibleDescriptorHeap& operator = (const ShaderVisibleDescriptorHeap&) = delete;
+
+        /*!
+         * Get the heap to bind with SetDescriptorHeaps.
+         *
+         * @return the descriptor heap
+         */
+        ID3D12DescriptorHeap* GetHeap() const;
+
+        /*!
+         * Allocate a range in the persistent region.
+         *
+         * @param count the number of descriptors
+         * @return the range
+         *
+         * @throws std::runtime_error if the persistent region is full
+         */
+        DescriptorRange AllocatePersistent(uint32_t count);
+
+        /*!
+         * Free a range of the persistent region.
+         *
+         * The range is reused once Retire reports that the fence value
+         * was reached.
+         *
+         * @param range the range to free
+         * @param fenceValue the fence value of the last frame that uses the range
+         */
+        void FreePersistent(const DescriptorRange& range, UINT64 fenceValue);
+
+        /*!
+         * Allocate a range in the ring for the current frame.
+         *
+         * This method is lock free and may be called from several threads.
+         *
+         * @param count the number of descriptors
+         * @return the range
+         *
+         * @throws std::invalid_argument if count is larger than the ring
+         * @throws std::runtime_error if the ring is full with ranges in flight
+         */
+        DescriptorRange AllocateTransient(uint32_t count);
+
+        /*!
+         * Close the current frame.
+         *
+         * All ring ranges allocated so far belong to the frame. Call this
+         * once recording for the frame is done.
+         *
+         * @param fenceValue the fence value that is signaled when the GPU finished the frame
+         */
+        void FinishFrame(UINT64 fenceValue);
+
+        /*!
+         * Release the ranges of all completed frames.
+         *
+         * @param completedValue the completed value of the frame fence
+         */
+        void Retire(UINT64 completedValue);
+
+        /*!
+         * Get the number of ring descriptors in flight.
+         *
+         * @return the number of descriptors not yet retired
+         */
+        uint32_t GetTransientUsage() const;
+
+    private:
+        ComPtr<ID3D12DescriptorHeap>                   heap;
+        D3D12_CPU_DESCRIPTOR_HANDLE                    cpuStart;
+        D3D12_GPU_DESCRIPTOR_HANDLE                    gpuStart;
+        UINT                                           incrementSize;
+        uint32_t                                       persistentSize;
+        uint32_t                                       ringSize;
+
+        // ring positions are virtual, they only grow and are mapped onto the ring by modulo
+        std::atomic<uint64_t>                          head = 0;
+        std::atomic<uint64_t>                          tail = 0;
+
+        std::mutex                                     mutex;
+        std::deque<std::pair<UINT64, uint64_t>>        frames;
+        std::map<uint32_t, uint32_t>                   freeRanges;
+        std::deque<std::pair<UINT64, DescriptorRange>> pendingFrees;
+
+        DescriptorRange MakeRange(uint32_t index, uint32_t count) const;
+        void AddFreeRange(uint32_t index, uint32_t count);
+    };
+}
+
+#endif
@@ -0,0 +1,235 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "SubmissionQueue.h"
+
+#include "../util.h"
+#include "CommandQueue.h"
+#include "CommandList.h"
+
+namespace d12w::d3d
+{
+    SubmissionQueue::SubmissionQueue(CommandQueue& queue)
+    : queue(queue), head(&stub), tail(&stub)
+    {
+        thread = std::thread([this] () { Run(); });
+    }
+
+    SubmissionQueue::~SubmissionQueue()
+    {
+        running = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+        }
+        wake.notify_all();
+        thread.join();
+    }
+
+    std::shared_future<UINT64> SubmissionQueue::Submit(UINT count, ID3D12CommandList* const* lists)
+    {
+        return Push(std::vector<ID3D12CommandList*>(lists, lists + count));
+    }
+
+    std::shared_future<UINT64> SubmissionQueue::Submit(UINT count, CommandList* const* lists)
+    {
+        return Push({}, std::vector<CommandList*>(lists, lists + count));
+    }
+
+    UINT64 SubmissionQueue::Flush()
+    {
+        // an empty submission is answered once everything before it is submitted
+        return Push({}).get();
+    }
+
+    SubmissionStats SubmissionQueue::GetStats() const
+    {
+        auto stats = SubmissionStats{};
+        stats.submissions = submissions.load(std::memory_order_relaxed);
+        stats.calls       = calls.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    std::shared_future<UINT64> SubmissionQueue::Push(std::vector<ID3D12CommandList*> lists, std::vector<CommandList*> tracked)
+    {
+        auto node = new Node;
+        node->lists   = std::move(lists);
+        node->tracked = std::move(tracked);
+        auto future = node->promise.get_future().share();
+
+        auto prev = head.exchange(node, std::memory_order_seq_cst);
+        prev->next.store(node, std::memory_order_release);
+        submissions.fetch_add(1, std::memory_order_relaxed);
+
+        // pairs with the store of sleeping and the check of head in Run
+        if (sleeping.load(std::memory_order_seq_cst))
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            wake.notify_one();
+        }
+        return future;
+    }
+
+    // returns null if the queue is empty or a push is not linked yet
+    SubmissionQueue::Node* SubmissionQueue::Pop()
+    {
+        auto node = tail;
+        auto next = node->next.load(std::memory_order_acquire);
+        if (node == &stub)
+        {
+            if (next == nullptr)
+            {
+                return nullptr;
+            }
+            tail = next;
+            node = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+
+        if (next != nullptr)
+        {
+            tail = next;
+            return node;
+        }
+
+        if (node != head.load(std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+
+        // node is the last one, the stub takes its place so it can be removed
+        stub.next.store(nullptr, std::memory_order_relaxed);
+        auto prev = head.exchange(&stub, std::memory_order_acq_rel);
+        prev->next.store(&stub, std::memory_order_release);
+
+        next = node->next.load(std::memory_order_acquire);
+        if (next != nullptr)
+        {
+            tail = next;
+            return node;
+        }
+        return nullptr;
+    }
+
+    void SubmissionQueue::Run()
+    {
+        auto batch   = std::vector<Node*>{};
+        auto lists   = std::vector<ID3D12CommandList*>{};
+        auto tracked = std::vector<CommandList*>{};
+        for (;;)
+        {
+            while (auto node = Pop())
+            {
+                batch.push_back(node);
+            }
+
+            if (!batch.empty())
+            {
+                SubmitBatch(batch, lists, tracked);
+                continue;
+            }
+
+            if (head.load(std::memory_order_acquire) != tail)
+            {
+                // a producer is between its exchange and linking the node
+                std::this_thread::yield();
+                continue;
+            }
+
+            if (!running.load())
+            {
+                return;
+            }
+
+            std::unique_lock<std::mutex> lock(mutex);
+            sleeping.store(true, std::memory_order_seq_cst);
+            wake.wait(lock, [this] () {
+                return head.load(std::memory_order_seq_cst) != tail || !running.load();
+            });
+            sleeping.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    void SubmissionQueue::SubmitBatch(std::vector<Node*>& batch, std::vector<ID3D12CommandList*>& lists, std::vector<CommandList*>& tracked)
+    {
+        try
+        {
+            auto fenceValue = queue.GetLastSignaledValue();
+            auto executed   = false;
+
+            // raw and tracked lists go through different calls, consecutive ones are combined
+            lists.clear();
+            tracked.clear();
+            for (auto node : batch)
+            {
+                if ((!node->lists.empty() && !tracked.empty()) || (!node->tracked.empty() && !lists.empty()))
+                {
+                    ExecuteLists(lists, tracked);
+                    executed = true;
+                }
+                lists.insert(lists.end(), node->lists.begin(), node->lists.end());
+                tracked.insert(tracked.end(), node->tracked.begin(), node->tracked.end());
+            }
+            if (!lists.empty() || !tracked.empty())
+            {
+                ExecuteLists(lists, tracked);
+                executed = true;
+            }
+
+            if (executed)
+            {
+                fenceValue = queue.Signal();
+            }
+
+            for (auto node : batch)
+            {
+                node->promise.set_value(fenceValue);
+            }
+        }
+        catch (...)
+        {
+            for (auto node : batch)
+            {
+                node->promise.set_exception(std::current_exception());
+            }
+        }
+
+        for (auto node : batch)
+        {
+            delete node;
+        }
+        batch.clear();
+    }
+
+    void SubmissionQueue::ExecuteLists(std::vector<ID3D12CommandList*>& lists, std::vector<CommandList*>& tracked)
+    {
+        if (!lists.empty())
+        {
+            queue.ExecuteCommandLists(static_cast<UINT>(lists.size()), lists.data());
+        }
+        else
+        {
+            queue.ExecuteCommandLists(static_cast<UINT>(tracked.size()), tracked.data());
+        }
+        calls.fetch_add(1, std::memory_order_relaxed);
+        lists.clear();
+        tracked.clear();
+    }
+}
@@ -0,0 +1,158 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_SUBMISSION_QUEUE_H_
+#define _D12W_SUBMISSION_QUEUE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <d3d12.h>
+
+#include "../defines.h"
+
+namespace d12w::d3d
+{
+    class CommandQueue;
+    class CommandList;
+
+    /*!
+     * Submission Statistics
+     */
+    struct SubmissionStats
+    {
+        uint64_t submissions = 0; //!< the number of Submit calls
+        uint64_t calls       = 0; //!< the number of ExecuteCommandLists calls made on the queue
+    };
+
+    /*!
+     * Submission Queue
+     *
+     * Each ExecuteCommandLists call has a fixed cost in the driver. When
+     * several systems submit on their own, the GPU gets many small
+     * submissions. The submission queue collects the command lists of all
+     * threads and a thread owned by the queue submits everything that is
+     * ready in one ExecuteCommandLists call, followed by one Signal. Raw
+     * command lists and CommandList objects need separate calls when they
+     * alternate.
+     *
+     * Submit does not wait for the submission thread. It allocates a node
+     * and the state of the future, links the node with one atomic
+     * exchange and only takes a lock to wake the thread when it sleeps.
+     * Submissions are executed in the order they were made, so the order
+     * of each thread is kept. The returned future gives the fence value
+     * that is reached once the submission's lists finished on the GPU.
+     *
+     * While a submission queue exists, no other thread may submit to its
+     * command queue.
+     */
+    class D12W_EXPORT SubmissionQueue
+    {
+    public:
+        /*!
+         * Create a submission queue.
+         *
+         * @param queue the command queue to submit to, must outlive the submission queue
+         */
+        explicit
+        SubmissionQueue(CommandQueue& queue);
+
+        SubmissionQueue(const SubmissionQueue&) = delete;
+
+        /*!
+         * Submit all pending command lists and stop the submission thread.
+         */
+        ~SubmissionQueue();
+
+        SubmissionQueue& operator = (const SubmissionQueue&) = delete;
+
+        /*!
+         * Submit command lists.
+         *
+         * @param count the number of lists
+         * @param lists the closed command lists, they must stay alive until submitted
+         * @return the fence value after which the lists finished
+         */
+        std::shared_future<UINT64> Submit(UINT count, ID3D12CommandList* const* lists);
+
+        /*!
+         * Submit command lists.
+         *
+         * The resource states of the lists are resolved by the command
+         * queue on the submission thread.
+         *
+         * @param count the number of lists
+         * @param lists the closed command lists, they must stay alive until submitted
+         * @return the fence value after which the lists finished
+         */
+        std::shared_future<UINT64> Submit(UINT count, CommandList* const* lists);
+
+        /*!
+         * Wait until everything submitted so far is handed to the command queue.
+         *
+         * @return the fence value after which all submitted lists finished
+         */
+        UINT64 Flush();
+
+        /*!
+         * Get the statistics since creation.
+         *
+         * @return the statistics
+         */
+        SubmissionStats GetStats() const;
+
+    private:
+        struct Node
+        {
+            std::atomic<Node*>              next = nullptr;
+            std::vector<ID3D12CommandList*> lists;
+            std::vector<CommandList*>       tracked;
+            std::promise<UINT64>            promise;
+        };
+
+        CommandQueue&           queue;
+
+        // intrusive multi producer, single consumer queue, head is the last node pushed
+        std::atomic<Node*>      head;
+        Node*                   tail;
+        Node                    stub;
+
+        std::atomic<bool>       sleeping    = false;
+        std::atomic<bool>       running     = true;
+        std::mutex              mutex;
+        std::condition_variable wake;
+        std::atomic<uint64_t>   submissions = 0;
+        std::atomic<uint64_t>   calls       = 0;
+        std::thread             thread;
+
+        std::shared_future<UINT64> Push(std::vector<ID3D12CommandList*> lists, std::vector<CommandList*> tracked = {});
+        Node* Pop();
+        void Run();
+        void SubmitBatch(std::vector<Node*>& batch, std::vector<ID3D12CommandList*>& lists, std::vector<CommandList*>& tracked);
+        void ExecuteLists(std::vector<ID3D12CommandList*>& lists, std::vector<CommandList*>& tracked);
+    };
+}
+
+#endif
@@ -0,0 +1,353 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "TlsfAllocator.h"
+
+#include <algorithm>
+#include <bit>
+
+#include "../util.h"
+
+namespace d12w::d3d
+{
+    namespace
+    {
+        // value must not be 0
+        uint32_t BitScanForward(uint64_t value)
+        {
+            return static_cast<uint32_t>(std::countr_zero(value));
+        }
+
+        // value must not be 0
+        uint32_t BitScanReverse(uint64_t value)
+        {
+            return static_cast<uint32_t>(std::bit_width(value) - 1);
+        }
+
+        uint64_t AlignUp(uint64_t value, uint64_t alignment)
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+    }
+
+    TlsfAllocator::TlsfAllocator(uint64_t size)
+    : size(size & ~(MIN_ALIGNMENT - 1))
+    {
+        for (auto& lists : freeLists)
+        {
+            lists.fill(NONE);
+        }
+
+        if (this->size > 0)
+        {
+            InsertFreeBlock(NewBlock(0, this->size));
+        }
+    }
+
+    TlsfAllocation TlsfAllocator::Allocate(uint64_t requestedSize, uint64_t alignment)
+    {
+        D12W_ASSERT(alignment != 0 && (alignment & (alignment - 1)) == 0);
+        alignment = std::max(alignment, MIN_ALIGNMENT);
+        auto blockSize = AlignUp(std::max<uint64_t>(requestedSize, 1), MIN_ALIGNMENT);
+
+        // every block offset is a multiple of MIN_ALIGNMENT, so this covers the worst padding
+        auto block = FindFreeBlock(blockSize + alignment - MIN_ALIGNMENT);
+        if (block == NONE)
+        {
+            block = FindFittingBlock(blockSize, alignment);
+        }
+        if (block == NONE)
+        {
+            return {};
+        }
+        RemoveFreeBlock(block);
+
+        auto padding = AlignUp(blocks[block].offset, alignment) - blocks[block].offset;
+        if (padding > 0)
+        {
+            // the block before is in use, else the two would have been merged,
+            // so the padding simply stays a free block of its own
+            auto rest = Split(block, padding);
+            InsertFreeBlock(block);
+            block = rest;
+        }
+
+        if (blocks[block].size > blockSize)
+        {
+            InsertFreeBlock(Split(block, blockSize));
+        }
+
+        usedSize += blocks[block].size;
+        allocationCount++;
+
+        auto allocation = TlsfAllocation{};
+        allocation.offset = blocks[block].offset;
+        allocation.size   = requestedSize;
+        allocation.block  = block;
+        return allocation;
+    }
+
+    void TlsfAllocator::Free(const TlsfAllocation& allocation)
+    {
+        if (!allocation)
+        {
+            return;
+        }
+
+        auto block = allocation.block;
+        D12W_ASSERT(block < blocks.size() && !blocks[block].free && blocks[block].offset == allocation.offset);
+
+        usedSize -= blocks[block].size;
+        allocationCount--;
+
+        auto prev = blocks[block].prevPhys;
+        if (prev != NONE && blocks[prev].free)
+        {
+            RemoveFreeBlock(prev);
+            blocks[prev].size += blocks[block].size;
+            blocks[prev].nextPhys = blocks[block].nextPhys;
+            if (blocks[prev].nextPhys != NONE)
+            {
+                blocks[blocks[prev].nextPhys].prevPhys = prev;
+            }
+            DeleteBlock(block);
+            block = prev;
+        }
+
+        auto next = blocks[block].nextPhys;
+        if (next != NONE && blocks[next].free)
+        {
+            RemoveFreeBlock(next);
+            blocks[block].size += blocks[next].size;
+            blocks[block].nextPhys = blocks[next].nextPhys;
+            if (blocks[block].nextPhys != NONE)
+            {
+                blocks[blocks[block].nextPhys].prevPhys = block;
+            }
+            DeleteBlock(next);
+        }
+
+        InsertFreeBlock(block);
+    }
+
+    bool TlsfAllocator::IsEmpty() const
+    {
+        return allocationCount == 0;
+    }
+
+    TlsfStats TlsfAllocator::GetStats() const
+    {
+        auto stats = TlsfStats{};
+        stats.size            = size;
+        stats.usedSize        = usedSize;
+        stats.allocationCount = allocationCount;
+        stats.freeBlockCount  = freeBlockCount;
+
+        // the largest block is in the highest non empty list
+        if (flBitmap != 0)
+        {
+            auto fl = BitScanReverse(flBitmap);
+            auto sl = BitScanReverse(slBitmaps[fl]);
+            for (auto block = freeLists[fl][sl]; block != NONE; block = blocks[block].nextFree)
+            {
+                stats.largestFreeBlock = std::max(stats.largestFreeBlock, blocks[block].size);
+            }
+        }
+
+        return stats;
+    }
+
+    void TlsfAllocator::Mapping(uint64_t size, uint32_t& fl, uint32_t& sl)
+    {
+        if (size < (uint64_t{1} << FL_SHIFT))
+        {
+            // small sizes are split linearly
+            fl = 0;
+            sl = static_cast<uint32_t>(size >> MIN_LOG2);
+        }
+        else
+        {
+            auto msb = BitScanReverse(size);
+            fl = msb - FL_SHIFT + 1;
+            sl = static_cast<uint32_t>(size >> (msb - SL_LOG2)) ^ SL_COUNT;
+        }
+    }
+
+    uint32_t TlsfAllocator::FindFreeBlock(uint64_t size) const
+    {
+        // round up to the next size class, so that any block in the list fits
+        if (size >= (uint64_t{1} << FL_SHIFT))
+        {
+            size += (uint64_t{1} << (BitScanReverse(size) - SL_LOG2)) - 1;
+        }
+
+        auto fl = 0u;
+        auto sl = 0u;
+        Mapping(size, fl, sl);
+        if (fl >= FL_COUNT)
+        {
+            return NONE;
+        }
+
+        auto slMap = slBitmaps[fl] & (~0u << sl);
+        if (slMap == 0)
+        {
+            auto flMap = fl + 1 < FL_COUNT ? flBitmap & (~uint64_t{0} << (fl + 1)) : 0;
+            if (flMap == 0)
+            {
+                return NONE;
+            }
+            fl = BitScanForward(flMap);
+            slMap = slBitmaps[fl];
+        }
+
+        return freeLists[fl][BitScanForward(slMap)];
+    }
+
+    // the good fit search skips the size classes that may or may not fit,
+    // when it fails those are checked block by block
+    uint32_t TlsfAllocator::FindFittingBlock(uint64_t size, uint64_t alignment) const
+    {
+        auto fl = 0u;
+        auto sl = 0u;
+        auto lastFl = 0u;
+        auto lastSl = 0u;
+        Mapping(size, fl, sl);
+        Mapping(std::min(size + alignment - MIN_ALIGNMENT, this->size), lastFl, lastSl);
+
+        while (fl < lastFl || (fl == lastFl && sl <= lastSl))
+        {
+            for (auto block = freeLists[fl][sl]; block != NONE; block = blocks[block].nextFree)
+            {
+                const auto& b = blocks[block];
+                if (AlignUp(b.offset, alignment) + size <= b.offset + b.size)
+                {
+                    return block;
+                }
+            }
+
+            if (++sl == SL_COUNT)
+            {
+                sl = 0;
+                fl++;
+            }
+        }
+        return NONE;
+    }
+
+    void TlsfAllocator::InsertFreeBlock(uint32_t block)
+    {
+        auto fl = 0u;
+        auto sl = 0u;
+        Mapping(blocks[block].size, fl, sl);
+
+        auto head = freeLists[fl][sl];
+        blocks[block].free     = true;
+        blocks[block].prevFree = NONE;
+        blocks[block].nextFree = head;
+        if (head != NONE)
+        {
+            blocks[head].prevFree = block;
+        }
+        freeLists[fl][sl] = block;
+
+        flBitmap      |= uint64_t{1} << fl;
+        slBitmaps[fl] |= 1u << sl;
+        freeBlockCount++;
+    }
+
+    void TlsfAllocator::RemoveFreeBlock(uint32_t block)
+    {
+        auto fl = 0u;
+        auto sl = 0u;
+        Mapping(blocks[block].size, fl, sl);
+
+        auto prev = blocks[block].prevFree;
+        auto next = blocks[block].nextFree;
+        if (prev != NONE)
+        {
+            blocks[prev].nextFree = next;
+        }
+        else
+        {
+            freeLists[fl][sl] = next;
+        }
+        if (next != NONE)
+        {
+            blocks[next].prevFree = prev;
+        }
+
+        if (freeLists[fl][sl] == NONE)
+        {
+            slBitmaps[fl] &= ~(1u << sl);
+            if (slBitmaps[fl] == 0)
+            {
+                flBitmap &= ~(uint64_t{1} << fl);
+            }
+        }
+
+        blocks[block].free     = false;
+        blocks[block].prevFree = NONE;
+        blocks[block].nextFree = NONE;
+        freeBlockCount--;
+    }
+
+    uint32_t TlsfAllocator::NewBlock(uint64_t offset, uint64_t size)
+    {
+        auto block = 0u;
+        if (unusedBlocks.empty())
+        {
+            block = static_cast<uint32_t>(blocks.size());
+            blocks.emplace_back();
+        }
+        else
+        {
+            block = unusedBlocks.back();
+            unusedBlocks.pop_back();
+            blocks[block] = Block{};
+        }
+
+        blocks[block].offset = offset;
+        blocks[block].size   = size;
+        return block;
+    }
+
+    void TlsfAllocator::DeleteBlock(uint32_t block)
+    {
+        blocks[block] = Block{};
+        unusedBlocks.push_back(block);
+    }
+
+    // splits the block after size bytes and returns the block of the rest
+    uint32_t TlsfAllocator::Split(uint32_t block, uint64_t size)
+    {
+        auto rest = NewBlock(blocks[block].offset + size, blocks[block].size - size);
+        blocks[rest].prevPhys = block;
+        blocks[rest].nextPhys = blocks[block].nextPhys;
+        if (blocks[rest].nextPhys != NONE)
+        {
+            blocks[blocks[rest].nextPhys].prevPhys = rest;
+        }
+        blocks[block].nextPhys = rest;
+        blocks[block].size     = size;
+        return rest;
+    }
+}
@@ -0,0 +1,175 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_TLSF_ALLOCATOR_H_
+#define _D12W_TLSF_ALLOCATOR_H_
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "../defines.h"
+
+namespace d12w::d3d
+{
+    /*!
+     * TLSF Allocation
+     */
+    struct TlsfAllocation
+    {
+        uint64_t offset = 0;          //!< the aligned offset of the allocation
+        uint64_t size   = 0;          //!< the requested size
+        uint32_t block  = UINT32_MAX; //!< the block of the allocation, used to free it
+
+        explicit operator bool () const
+        {
+            return block != UINT32_MAX;
+        }
+    };
+
+    /*!
+     * TLSF Statistics
+     */
+    struct TlsfStats
+    {
+        uint64_t size             = 0; //!< the size of the managed range
+        uint64_t usedSize         = 0; //!< the number of bytes in allocated blocks
+        uint64_t largestFreeBlock = 0; //!< the size of the largest free block
+        uint32_t allocationCount  = 0; //!< the number of allocations
+        uint32_t freeBlockCount   = 0; //!< the number of free blocks
+
+        /*!
+         * Get the fragmentation of the free space.
+         *
+         * @return 0 if all free space is one block, close to 1 if it is scattered
+         */
+        double GetFragmentation() const
+        {
+            auto freeSize = size - usedSize;
+            return freeSize == 0 ? 0.0 : 1.0 - static_cast<double>(largestFreeBlock) / static_cast<double>(freeSize);
+        }
+    };
+
+    /*!
+     * Two Level Segregated Fit Allocator
+     *
+     * Manages a range of offsets, for example a D3D12 heap, with O(1)
+     * allocate and free. Free blocks are kept in lists by size class: the
+     * first level is the power of two, the second level splits it into
+     * 16 linear steps. Bitmaps of the non empty lists make finding a fitting
+     * block two bit scans. Adjacent free blocks are merged on free.
+     *
+     * The bit scans find a block of the next larger size class. Only if
+     * there is none, the few lists that may hold a block that fits exactly
+     * are searched, so that a range can be filled completely.
+     *
+     * Offsets and sizes are multiples of 256 bytes. The allocator only does
+     * bookkeeping, it never touches the managed memory, and is not thread
+     * safe.
+     */
+    class D12W_EXPORT TlsfAllocator
+    {
+    public:
+        /*!
+         * Create an allocator.
+         *
+         * @param size the size of the managed range in bytes
+         */
+        explicit
+        TlsfAllocator(uint64_t size);
+
+        /*!
+         * Allocate a range.
+         *
+         * @param size the size in bytes
+         * @param alignment the alignment, a power of two
+         * @return the allocation, false if no free block fits
+         */
+        TlsfAllocation Allocate(uint64_t size, uint64_t alignment = MIN_ALIGNMENT);
+
+        /*!
+         * Free a range.
+         *
+         * @param allocation the allocation to free, empty allocations are ignored
+         */
+        void Free(const TlsfAllocation& allocation);
+
+        /*!
+         * Check if nothing is allocated.
+         *
+         * @return true if the whole range is free
+         */
+        bool IsEmpty() const;
+
+        /*!
+         * Get the statistics.
+         *
+         * The largest free block is found by walking one free list, the
+         * other values are kept up to date.
+         *
+         * @return the statistics
+         */
+        TlsfStats GetStats() const;
+
+        //! The smallest block size and alignment.
+        static constexpr uint64_t MIN_ALIGNMENT = 256;
+
+    private:
+        static constexpr uint32_t MIN_LOG2 = 8;
+        static constexpr uint32_t SL_LOG2  = 4;
+        static constexpr uint32_t SL_COUNT = 1u << SL_LOG2;
+        static constexpr uint32_t FL_SHIFT = MIN_LOG2 + SL_LOG2;
+        static constexpr uint32_t FL_COUNT = 64 - FL_SHIFT + 1;
+        static constexpr uint32_t NONE     = UINT32_MAX;
+
+        struct Block
+        {
+            uint64_t offset   = 0;
+            uint64_t size     = 0;
+            uint32_t prevPhys = NONE;
+            uint32_t nextPhys = NONE;
+            uint32_t prevFree = NONE;
+            uint32_t nextFree = NONE;
+            bool     free     = false;
+        };
+
+        uint64_t                                             size;
+        uint64_t                                             usedSize        = 0;
+        uint32_t                                             allocationCount = 0;
+        uint32_t                                             freeBlockCount  = 0;
+        std::vector<Block>                                   blocks;
+        std::vector<uint32_t>                                unusedBlocks;
+        uint64_t                                             flBitmap        = 0;
+        std::array<uint32_t, FL_COUNT>                       slBitmaps       = {};
+        std::array<std::array<uint32_t, SL_COUNT>, FL_COUNT> freeLists;
+
+        static void Mapping(uint64_t size, uint32_t& fl, uint32_t& sl);
+        uint32_t FindFreeBlock(uint64_t size) const;
+        uint32_t FindFittingBlock(uint64_t size, uint64_t alignment) const;
+        void InsertFreeBlock(uint32_t block);
+        void RemoveFreeBlock(uint32_t block);
+        uint32_t NewBlock(uint64_t offset, uint64_t size);
+        void DeleteBlock(uint32_t block);
+        uint32_t Split(uint32_t block, uint64_t size);
+    };
+}
+
+#endif
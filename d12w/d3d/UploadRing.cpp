@@ -0,0 +1,180 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "UploadRing.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "../util.h"
+#include "Device.h"
+
+namespace d12w::d3d
+{
+    namespace
+    {
+        constexpr auto GRANULARITY = UINT64{D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT};
+
+        UINT64 AlignUp(UINT64 value, UINT64 alignment)
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        ComPtr<ID3D12Resource> CreateUploadBuffer(Device& device, UINT64 size)
+        {
+            auto heapProperties = D3D12_HEAP_PROPERTIES{};
+            heapProperties.Type = D3D12_HEAP_TYPE_UPLOAD;
+
+            auto desc = D3D12_RESOURCE_DESC{};
+            desc.Dimension        = D3D12_RESOURCE_DIMENSION_BUFFER;
+            desc.Width            = AlignUp(size, GRANULARITY);
+            desc.Height           = 1;
+            desc.DepthOrArraySize = 1;
+            desc.MipLevels        = 1;
+            desc.SampleDesc.Count = 1;
+            desc.Layout           = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+            return device.CreateCommittedResource(heapProperties, D3D12_HEAP_FLAG_NONE, desc, D3D12_RESOURCE_STATE_GENERIC_READ);
+        }
+    }
+
+    UploadRing::UploadRing(Device& device, UINT64 size)
+    : UploadRing(CreateUploadBuffer(device, size)) {}
+
+    UploadRing::UploadRing(ComPtr<ID3D12Resource> b)
+    : buffer(std::move(b))
+    {
+        D12W_ASSERT(buffer);
+        auto desc = buffer->GetDesc();
+        D12W_ASSERT(desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER);
+
+        // a multiple of the granularity keeps positions aligned when the ring wraps
+        size = desc.Width & ~(GRANULARITY - 1);
+        if (size == 0)
+        {
+            D12W_THROW(std::invalid_argument, "The upload ring buffer must be at least 256 bytes.");
+        }
+
+        // the CPU never reads upload memory
+        auto readRange = D3D12_RANGE{0, 0};
+        auto data = static_cast<void*>(nullptr);
+        auto hr = buffer->Map(0, &readRange, &data);
+        D12W_CHECK_SUCCESS(hr);
+        cpuStart = static_cast<uint8_t*>(data);
+        gpuStart = buffer->GetGPUVirtualAddress();
+    }
+
+    UploadRing::~UploadRing()
+    {
+        buffer->Unmap(0, nullptr);
+    }
+
+    UploadAllocation UploadRing::Allocate(UINT64 allocationSize, UINT64 alignment)
+    {
+        D12W_ASSERT(alignment != 0 && (alignment & (alignment - 1)) == 0);
+        D12W_ASSERT(alignment <= D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT);
+
+        auto claim = AlignUp(std::max<UINT64>(allocationSize, 1), GRANULARITY);
+        if (claim > size)
+        {
+            D12W_THROW(std::runtime_error, "The allocation is larger than the upload ring.");
+        }
+
+        // the head is only moved once the claim fits, so a failed allocation
+        // leaves the ring as it was
+        auto current = head.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            auto ringStart = current - current % size;
+            auto offset    = AlignUp(current % size, alignment);
+            if (offset + allocationSize > size)
+            {
+                // an allocation never runs over the end, it starts at the
+                // beginning of the next lap instead
+                ringStart += size;
+                offset     = 0;
+            }
+            auto end = ringStart + offset + claim;
+
+            // current may be stale, when another thread allocated and retired
+            // in the meantime the tail can even be past it
+            auto oldest = tail.load(std::memory_order_acquire);
+            if (oldest > current || end - oldest > size)
+            {
+                auto latest = head.load(std::memory_order_relaxed);
+                if (latest != current)
+                {
+                    current = latest;
+                    continue;
+                }
+                D12W_THROW(std::runtime_error, "The upload ring is full.");
+            }
+
+            if (head.compare_exchange_weak(current, end, std::memory_order_relaxed))
+            {
+                auto allocation = UploadAllocation{};
+                allocation.cpu      = cpuStart + offset;
+                allocation.gpu      = gpuStart + offset;
+                allocation.resource = buffer.Get();
+                allocation.offset   = offset;
+                allocation.size     = allocationSize;
+                return allocation;
+            }
+        }
+    }
+
+    UploadAllocation UploadRing::Upload(const void* data, UINT64 dataSize, UINT64 alignment)
+    {
+        auto allocation = Allocate(dataSize, alignment);
+        std::memcpy(allocation.cpu, data, static_cast<size_t>(dataSize));
+        return allocation;
+    }
+
+    void UploadRing::FinishFrame(UINT64 fenceValue)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        D12W_ASSERT(frames.empty() || frames.back().first <= fenceValue);
+        frames.emplace_back(fenceValue, head.load(std::memory_order_relaxed));
+    }
+
+    void UploadRing::Retire(UINT64 completedValue)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        while (!frames.empty() && frames.front().first <= completedValue)
+        {
+            tail.store(frames.front().second, std::memory_order_release);
+            frames.pop_front();
+        }
+    }
+
+    UINT64 UploadRing::GetSize() const
+    {
+        return size;
+    }
+
+    UINT64 UploadRing::GetUsage() const
+    {
+        // the tail is a past head, loading it first keeps the difference positive
+        auto oldest = tail.load(std::memory_order_acquire);
+        return head.load(std::memory_order_relaxed) - oldest;
+    }
+}
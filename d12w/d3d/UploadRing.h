@@ -0,0 +1,171 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_UPLOAD_RING_H_
+#define _D12W_UPLOAD_RING_H_
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <d3d12.h>
+
+#include "../defines.h"
+#include "../ComPtr.h"
+
+namespace d12w::d3d
+{
+    class Device;
+
+    /*!
+     * Upload Allocation
+     */
+    struct UploadAllocation
+    {
+        void*                     cpu      = nullptr; //!< the mapped memory to write to
+        D3D12_GPU_VIRTUAL_ADDRESS gpu      = 0;       //!< the GPU address, for root views and buffer views
+        ID3D12Resource*           resource = nullptr; //!< the upload buffer, for copies
+        UINT64                    offset   = 0;       //!< the offset in the upload buffer
+        UINT64                    size     = 0;       //!< the size in bytes
+
+        explicit operator bool () const
+        {
+            return cpu != nullptr;
+        }
+    };
+
+    /*!
+     * Upload Ring
+     *
+     * A persistently mapped upload buffer for data that is written once per
+     * frame, like constants and dynamic vertex data. Allocations are taken
+     * from the ring with a compare and swap and belong to the current
+     * frame; they are reclaimed once the frame's fence value completed.
+     *
+     * The ring position advances in multiples of 256 bytes, so constant
+     * buffer alignment comes for free. Smaller allocations are rounded up.
+     *
+     * Allocate is thread safe and lock free. An allocation that does not
+     * fit throws and leaves the ring unchanged, so smaller allocations may
+     * still succeed in the same frame. FinishFrame and Retire may be
+     * called from any thread, but not while allocations for the finished
+     * frame are still being made.
+     */
+    class D12W_EXPORT UploadRing
+    {
+    public:
+        /*!
+         * Create an upload ring.
+         *
+         * @param device the device to create the upload buffer on
+         * @param size the size of the ring in bytes
+         *
+         * @throws std::invalid_argument if size is 0
+         */
+        UploadRing(Device& device, UINT64 size);
+
+        /*!
+         * Create an upload ring on an existing buffer.
+         *
+         * This allows to use an alternative implementation, like the null backend.
+         *
+         * @param buffer a buffer in an upload heap
+         *
+         * @throws std::invalid_argument if the buffer is smaller than 256 bytes
+         */
+        explicit
+        UploadRing(ComPtr<ID3D12Resource> buffer);
+
+        UploadRing(const UploadRing&) = delete;
+
+        ~UploadRing();
+
+        UploadRing& operator = (const UploadRing&) = delete;
+
+        /*!
+         * Allocate memory for the current frame.
+         *
+         * @param size the size in bytes
+         * @param alignment the alignment, a power of two
+         * @return the allocation
+         *
+         * @throws std::runtime_error if the ring is full
+         */
+        UploadAllocation Allocate(UINT64 size, UINT64 alignment = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
+
+        /*!
+         * Allocate memory for the current frame and copy data into it.
+         *
+         * @param data the data to copy
+         * @param size the size in bytes
+         * @param alignment the alignment, a power of two
+         * @return the allocation
+         *
+         * @throws std::runtime_error if the ring is full
+         */
+        UploadAllocation Upload(const void* data, UINT64 size, UINT64 alignment = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
+
+        /*!
+         * Finish the current frame.
+         *
+         * All allocations made so far belong to the frame.
+         *
+         * @param fenceValue the fence value that is signaled when the GPU finished the frame
+         */
+        void FinishFrame(UINT64 fenceValue);
+
+        /*!
+         * Reclaim the memory of all completed frames.
+         *
+         * @param completedValue the completed value of the frame fence
+         */
+        void Retire(UINT64 completedValue);
+
+        /*!
+         * Get the size of the ring.
+         *
+         * @return the size in bytes
+         */
+        UINT64 GetSize() const;
+
+        /*!
+         * Get the number of bytes in flight.
+         *
+         * @return the number of bytes not yet reclaimed
+         */
+        UINT64 GetUsage() const;
+
+    private:
+        ComPtr<ID3D12Resource>                  buffer;
+        uint8_t*                                cpuStart = nullptr;
+        D3D12_GPU_VIRTUAL_ADDRESS               gpuStart = 0;
+        UINT64                                  size     = 0;
+
+        // ring positions are virtual, they only grow and are mapped onto the ring by modulo
+        std::atomic<uint64_t>                   head = 0;
+        std::atomic<uint64_t>                   tail = 0;
+
+        std::mutex                              mutex;
+        std::deque<std::pair<UINT64, uint64_t>> frames;
+    };
+}
+
+#endif
@@ -24,5 +24,27 @@
 
 #include "Debug.h"
 #include "Device.h"
+#include "CpuDescriptorAllocator.h"
+#include "ShaderVisibleDescriptorHeap.h"
+#include "BindlessTable.h"
+#include "DescriptorCopyBatcher.h"
+#include "UploadRing.h"
+#include "DeferredReleaseQueue.h"
+#include "CommandAllocatorPool.h"
+#include "CommandList.h"
+#include "CommandQueue.h"
+#include "ParallelRecorder.h"
+#include "SubmissionQueue.h"
+#include "QueueGraph.h"
+#include "QueueScheduler.h"
+#include "FenceWaiter.h"
+#include "Fence.h"
+#include "Resource.h"
+#include "ResourceStateTracker.h"
+#include "FrameGraph.h"
+#include "FrameGraphExecutor.h"
+#include "TlsfAllocator.h"
+#include "DefragmentationPlanner.h"
+#include "ResourceAllocator.h"
 
 #endif
@@ -22,6 +22,18 @@
 #ifndef _D12W_DEFINES_H_
 #define _D12W_DEFINES_H_
 
+#ifdef _WIN32
 #define D12W_EXPORT __declspec(dllexport)
+#define D12W_NOINLINE __declspec(noinline)
+#else
+#define D12W_EXPORT __attribute__((visibility("default")))
+#define D12W_NOINLINE __attribute__((noinline))
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define D12W_COLD __attribute__((cold))
+#else
+#define D12W_COLD
+#endif
 
 #endif
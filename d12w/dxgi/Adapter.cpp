@@ -33,6 +33,13 @@ namespace d12w::dxgi
         return result;
     }
 
+    Result<DXGI_ADAPTER_DESC> Adapter::TryGetDesc() noexcept
+    {
+        auto result = DXGI_ADAPTER_DESC{0};
+        auto hr = adapter4->GetDesc(&result);
+        return {hr, result};
+    }
+
     DXGI_ADAPTER_DESC1 Adapter::GetDesc1()
     {
         auto result= DXGI_ADAPTER_DESC1{0};
@@ -41,6 +48,13 @@ namespace d12w::dxgi
         return result;
     }
 
+    Result<DXGI_ADAPTER_DESC1> Adapter::TryGetDesc1() noexcept
+    {
+        auto result = DXGI_ADAPTER_DESC1{0};
+        auto hr = adapter4->GetDesc1(&result);
+        return {hr, result};
+    }
+
     DXGI_ADAPTER_DESC2 Adapter::GetDesc2()
     {
         auto result = DXGI_ADAPTER_DESC2{0};
@@ -49,6 +63,13 @@ namespace d12w::dxgi
         return result;
     }
 
+    Result<DXGI_ADAPTER_DESC2> Adapter::TryGetDesc2() noexcept
+    {
+        auto result = DXGI_ADAPTER_DESC2{0};
+        auto hr = adapter4->GetDesc2(&result);
+        return {hr, result};
+    }
+
     DXGI_ADAPTER_DESC3 Adapter::GetDesc3()
     {
         auto result = DXGI_ADAPTER_DESC3{0};
@@ -57,6 +78,28 @@ namespace d12w::dxgi
         return result;
     }
 
+    Result<DXGI_ADAPTER_DESC3> Adapter::TryGetDesc3() noexcept
+    {
+        auto result = DXGI_ADAPTER_DESC3{0};
+        auto hr = adapter4->GetDesc3(&result);
+        return {hr, result};
+    }
+
+    const AdapterSnapshot& Adapter::GetSnapshot()
+    {
+        std::call_once(snapshotFlag, [this] () {
+            auto desc3 = GetDesc3();
+            // not all drivers report the version, the snapshot then holds 0
+            auto driverVersion = LARGE_INTEGER{};
+            if (FAILED(adapter4->CheckInterfaceSupport(__uuidof(IDXGIDevice), &driverVersion)))
+            {
+                driverVersion.QuadPart = 0;
+            }
+            snapshot = AdapterSnapshot{desc3, driverVersion};
+        });
+        return snapshot;
+    }
+
     Adapter::Adapter(ComPtr<IDXGIAdapter> adapter)
     : adapter4(adapter.As<IDXGIAdapter4>()) {}
 
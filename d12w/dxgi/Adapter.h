@@ -22,6 +22,7 @@
 #ifndef _D12W_DXGI_ADAPTER_H_
 #define _D12W_DXGI_ADAPTER_H_
 
+#include <mutex>
 #include <dxgi.h>
 #include <dxgi1_2.h>
 #include <dxgi1_3.h>
@@ -31,6 +32,13 @@
 
 #include "../defines.h"
 #include "../ComPtr.h"
+#include "../Result.h"
+#include "AdapterSnapshot.h"
+
+namespace d12w::d3d
+{
+    class Device;
+}
 
 namespace d12w::dxgi
 {
@@ -60,6 +68,13 @@ namespace d12w::dxgi
          */ 
         DXGI_ADAPTER_DESC GetDesc();
 
+        /*!
+         * Non-throwing variant of GetDesc.
+         *
+         * @return the DXGI_ADAPTER_DESC or the HRESULT of the failed call
+         */
+        Result<DXGI_ADAPTER_DESC> TryGetDesc() noexcept;
+
         /*!
          * Gets a DXGI 1.1 description of an adapter (or video card).
          *
@@ -71,6 +86,13 @@ namespace d12w::dxgi
          */ 
         DXGI_ADAPTER_DESC1 GetDesc1();
 
+        /*!
+         * Non-throwing variant of GetDesc1.
+         *
+         * @return the DXGI_ADAPTER_DESC1 or the HRESULT of the failed call
+         */
+        Result<DXGI_ADAPTER_DESC1> TryGetDesc1() noexcept;
+
         /*!
          * Gets a DXGI 1.1 description of an adapter (or video card).
          *
@@ -82,6 +104,13 @@ namespace d12w::dxgi
          */ 
         DXGI_ADAPTER_DESC2 GetDesc2();
 
+        /*!
+         * Non-throwing variant of GetDesc2.
+         *
+         * @return the DXGI_ADAPTER_DESC2 or the HRESULT of the failed call
+         */
+        Result<DXGI_ADAPTER_DESC2> TryGetDesc2() noexcept;
+
         /*!
          * Gets a Microsoft DirectX Graphics Infrastructure (DXGI) 1.6 description of an adapter or video card. This description includes information about ACG compatibility.
          *
@@ -94,8 +123,27 @@ namespace d12w::dxgi
          */ 
         DXGI_ADAPTER_DESC3 GetDesc3();
 
+        /*!
+         * Non-throwing variant of GetDesc3.
+         *
+         * @return the DXGI_ADAPTER_DESC3 or the HRESULT of the failed call
+         */
+        Result<DXGI_ADAPTER_DESC3> TryGetDesc3() noexcept;
+
+        /*!
+         * Get an immutable snapshot of the adapter description.
+         *
+         * The snapshot is taken on first use and then cached, further calls
+         * do not call into DXGI. Use GetDesc* to get the current values.
+         *
+         * @return the snapshot of the adapter
+         */
+        const AdapterSnapshot& GetSnapshot();
+
     private:
         ComPtr<IDXGIAdapter4> adapter4;
+        std::once_flag        snapshotFlag;
+        AdapterSnapshot       snapshot;
 
         explicit
         Adapter(ComPtr<IDXGIAdapter> adapter);
@@ -103,6 +151,7 @@ namespace d12w::dxgi
         Adapter(ComPtr<IDXGIAdapter1> adapter1);
 
     friend class Factory;
+    friend class d3d::Device;
     };
 }
 
@@ -0,0 +1,121 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "AdapterSnapshot.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "../util.h"
+
+namespace d12w::dxgi
+{
+    namespace
+    {
+        template <typename Desc>
+        Desc CopyCommonDesc(const DXGI_ADAPTER_DESC3& src)
+        {
+            auto dst = Desc{};
+            std::copy(std::begin(src.Description), std::end(src.Description), std::begin(dst.Description));
+            dst.VendorId              = src.VendorId;
+            dst.DeviceId              = src.DeviceId;
+            dst.SubSysId              = src.SubSysId;
+            dst.Revision              = src.Revision;
+            dst.DedicatedVideoMemory  = src.DedicatedVideoMemory;
+            dst.DedicatedSystemMemory = src.DedicatedSystemMemory;
+            dst.SharedSystemMemory    = src.SharedSystemMemory;
+            dst.AdapterLuid           = src.AdapterLuid;
+            return dst;
+        }
+
+        // DXGI_ADAPTER_FLAG3 extends DXGI_ADAPTER_FLAG with the same bits,
+        // the older descriptions only carry the bits that existed back then
+        UINT LegacyFlags(DXGI_ADAPTER_FLAG3 flags)
+        {
+            return static_cast<UINT>(flags) & static_cast<UINT>(DXGI_ADAPTER_FLAG_REMOTE | DXGI_ADAPTER_FLAG_SOFTWARE);
+        }
+    }
+
+    AdapterSnapshot::AdapterSnapshot(const DXGI_ADAPTER_DESC3& desc3, LARGE_INTEGER driverVersion)
+    : desc3(desc3), driverVersion(driverVersion) {}
+
+    DXGI_ADAPTER_DESC AdapterSnapshot::GetDesc() const
+    {
+        return CopyCommonDesc<DXGI_ADAPTER_DESC>(desc3);
+    }
+
+    DXGI_ADAPTER_DESC1 AdapterSnapshot::GetDesc1() const
+    {
+        auto result = CopyCommonDesc<DXGI_ADAPTER_DESC1>(desc3);
+        result.Flags = LegacyFlags(desc3.Flags);
+        return result;
+    }
+
+    DXGI_ADAPTER_DESC2 AdapterSnapshot::GetDesc2() const
+    {
+        auto result = CopyCommonDesc<DXGI_ADAPTER_DESC2>(desc3);
+        result.Flags                         = LegacyFlags(desc3.Flags);
+        result.GraphicsPreemptionGranularity = desc3.GraphicsPreemptionGranularity;
+        result.ComputePreemptionGranularity  = desc3.ComputePreemptionGranularity;
+        return result;
+    }
+
+    const DXGI_ADAPTER_DESC3& AdapterSnapshot::GetDesc3() const
+    {
+        return desc3;
+    }
+
+    std::string AdapterSnapshot::GetDescription() const
+    {
+        auto end = std::find(std::begin(desc3.Description), std::end(desc3.Description), L'\0');
+        return util::narrow(std::wstring_view(desc3.Description, end - std::begin(desc3.Description)));
+    }
+
+    LUID AdapterSnapshot::GetLuid() const
+    {
+        return desc3.AdapterLuid;
+    }
+
+    LARGE_INTEGER AdapterSnapshot::GetDriverVersion() const
+    {
+        return driverVersion;
+    }
+
+    SIZE_T AdapterSnapshot::GetDedicatedVideoMemory() const
+    {
+        return desc3.DedicatedVideoMemory;
+    }
+
+    SIZE_T AdapterSnapshot::GetDedicatedSystemMemory() const
+    {
+        return desc3.DedicatedSystemMemory;
+    }
+
+    SIZE_T AdapterSnapshot::GetSharedSystemMemory() const
+    {
+        return desc3.SharedSystemMemory;
+    }
+
+    bool AdapterSnapshot::IsSoftware() const
+    {
+        return (desc3.Flags & DXGI_ADAPTER_FLAG3_SOFTWARE) != 0;
+    }
+}
@@ -0,0 +1,137 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_DXGI_ADAPTER_SNAPSHOT_H_
+#define _D12W_DXGI_ADAPTER_SNAPSHOT_H_
+
+#include <string>
+#include <dxgi1_6.h>
+
+#include "../defines.h"
+
+namespace d12w::dxgi
+{
+    /*!
+     * Immutable Adapter Description
+     *
+     * The snapshot is taken with a single call to GetDesc3 and
+     * CheckInterfaceSupport. All older description levels are derived from
+     * it, so querying them does not re-enter DXGI.
+     */
+    class D12W_EXPORT AdapterSnapshot
+    {
+    public:
+        AdapterSnapshot() = default;
+
+        /*!
+         * Create a snapshot from a description.
+         *
+         * @param desc3 the DXGI 1.6 description of the adapter
+         * @param driverVersion the user mode driver version, 0 if unknown
+         */
+        AdapterSnapshot(const DXGI_ADAPTER_DESC3& desc3, LARGE_INTEGER driverVersion);
+
+        /*!
+         * Get the DXGI 1.0 description.
+         *
+         * @return the description
+         */
+        DXGI_ADAPTER_DESC GetDesc() const;
+
+        /*!
+         * Get the DXGI 1.1 description.
+         *
+         * @return the description
+         */
+        DXGI_ADAPTER_DESC1 GetDesc1() const;
+
+        /*!
+         * Get the DXGI 1.2 description.
+         *
+         * @return the description
+         */
+        DXGI_ADAPTER_DESC2 GetDesc2() const;
+
+        /*!
+         * Get the DXGI 1.6 description.
+         *
+         * @return the description
+         */
+        const DXGI_ADAPTER_DESC3& GetDesc3() const;
+
+        /*!
+         * Get the adapter description as UTF-8.
+         *
+         * @return the description string
+         */
+        std::string GetDescription() const;
+
+        /*!
+         * Get the locally unique identifier of the adapter.
+         *
+         * The LUID is only valid until the system restarts.
+         *
+         * @return the LUID
+         */
+        LUID GetLuid() const;
+
+        /*!
+         * Get the user mode driver version.
+         *
+         * @return the driver version, 0 if the adapter did not report it
+         */
+        LARGE_INTEGER GetDriverVersion() const;
+
+        /*!
+         * Get the dedicated video memory in bytes.
+         *
+         * @return the dedicated video memory
+         */
+        SIZE_T GetDedicatedVideoMemory() const;
+
+        /*!
+         * Get the dedicated system memory in bytes.
+         *
+         * @return the dedicated system memory
+         */
+        SIZE_T GetDedicatedSystemMemory() const;
+
+        /*!
+         * Get the shared system memory in bytes.
+         *
+         * @return the shared system memory
+         */
+        SIZE_T GetSharedSystemMemory() const;
+
+        /*!
+         * Check if the adapter is a software adapter, such as WARP.
+         *
+         * @return true for software adapters
+         */
+        bool IsSoftware() const;
+
+    private:
+        DXGI_ADAPTER_DESC3 desc3 = {};
+        LARGE_INTEGER      driverVersion = {};
+    };
+}
+
+#endif
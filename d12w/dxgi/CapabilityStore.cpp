@@ -0,0 +1,134 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "CapabilityStore.h"
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "../util.h"
+
+namespace d12w::dxgi
+{
+    namespace
+    {
+        constexpr auto FILE_HEADER = "d12w-capabilities 1";
+    }
+
+    CapabilityStore::CapabilityStore() = default;
+
+    CapabilityStore::CapabilityStore(const std::filesystem::path& file)
+    {
+        Load(file);
+    }
+
+    CapabilityStore::~CapabilityStore() = default;
+
+    std::optional<uint64_t> CapabilityStore::Get(const AdapterSnapshot& adapter, const std::string_view name) const
+    {
+        auto key = MakeKey(adapter, name);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto i = values.find(key);
+        if (i == values.end())
+        {
+            return std::nullopt;
+        }
+        return i->second;
+    }
+
+    void CapabilityStore::Set(const AdapterSnapshot& adapter, const std::string_view name, uint64_t value)
+    {
+        D12W_ASSERT(!name.empty());
+        D12W_ASSERT(name.find_first_of(" \t\r\n") == std::string_view::npos);
+        auto key = MakeKey(adapter, name);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        values[std::move(key)] = value;
+    }
+
+    bool CapabilityStore::Load(const std::filesystem::path& file)
+    {
+        auto input = std::ifstream{file};
+        if (!input)
+        {
+            return false;
+        }
+
+        auto loaded = std::map<Key, uint64_t>{};
+        auto line = std::string{};
+        // a file written by an other version is ignored and will be overwritten
+        auto current = std::getline(input, line) && line == FILE_HEADER;
+        while (current && std::getline(input, line))
+        {
+            auto entry = std::istringstream{line};
+            auto key = Key{};
+            auto value = uint64_t{0};
+            entry >> std::hex >> std::get<0>(key) >> std::get<1>(key) >> std::get<2>(key) >> std::get<3>(key) >> std::get<4>(key) >> std::get<5>(key) >> value;
+            if (entry.fail())
+            {
+                // a torn write or hand edited file, trust none of it
+                loaded.clear();
+                break;
+            }
+            loaded[std::move(key)] = value;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        values = std::move(loaded);
+        return true;
+    }
+
+    void CapabilityStore::Save(const std::filesystem::path& file) const
+    {
+        // write to a temporary and rename, so that a crash never leaves a partial file
+        auto temp = file;
+        temp += ".tmp";
+        {
+            auto output = std::ofstream{temp, std::ios::trunc};
+            if (!output)
+            {
+                D12W_THROW(std::runtime_error, "Failed to open " + util::narrow(temp.wstring()) + " for writing.");
+            }
+
+            output << FILE_HEADER << "\n" << std::hex;
+            std::lock_guard<std::mutex> lock(mutex);
+            for (const auto& [key, value] : values)
+            {
+                output << std::get<0>(key) << " " << std::get<1>(key) << " " << std::get<2>(key) << " " << std::get<3>(key) << " "
+                       << std::get<4>(key) << " " << std::get<5>(key) << " " << value << "\n";
+            }
+
+            if (!output.flush())
+            {
+                D12W_THROW(std::runtime_error, "Failed to write " + util::narrow(temp.wstring()) + ".");
+            }
+        }
+        std::filesystem::rename(temp, file);
+    }
+
+    CapabilityStore::Key CapabilityStore::MakeKey(const AdapterSnapshot& adapter, const std::string_view name)
+    {
+        const auto& desc = adapter.GetDesc3();
+        return {desc.VendorId, desc.DeviceId, desc.SubSysId, desc.Revision, adapter.GetDriverVersion().QuadPart, std::string{name}};
+    }
+}
@@ -0,0 +1,118 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_DXGI_CAPABILITY_STORE_H_
+#define _D12W_DXGI_CAPABILITY_STORE_H_
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+#include "../defines.h"
+#include "AdapterSnapshot.h"
+
+namespace d12w::dxgi
+{
+    /*!
+     * Persistent Adapter Capabilities
+     *
+     * The capability store remembers the results of expensive probes, such
+     * as trial device creation or feature support queries, between runs.
+     * Values are keyed by the PCI identity of the adapter and its driver
+     * version. The LUID is not used, since it changes with every restart;
+     * a driver update invalidates all values of the adapter.
+     *
+     * The store is only a cache. A missing, outdated or corrupt file
+     * results in an empty store and the probes are simply run again.
+     */
+    class D12W_EXPORT CapabilityStore
+    {
+    public:
+        /*!
+         * Create an empty capability store.
+         */
+        CapabilityStore();
+
+        /*!
+         * Create a capability store and load it from a file.
+         *
+         * @param file the file to load
+         */
+        explicit
+        CapabilityStore(const std::filesystem::path& file);
+
+        CapabilityStore(const CapabilityStore&) = delete;
+
+        ~CapabilityStore();
+
+        CapabilityStore& operator = (const CapabilityStore&) = delete;
+
+        /*!
+         * Get a stored value.
+         *
+         * @param adapter the adapter the value belongs to
+         * @param name the name of the value
+         * @return the value or nothing if it was not stored for this adapter and driver
+         */
+        std::optional<uint64_t> Get(const AdapterSnapshot& adapter, const std::string_view name) const;
+
+        /*!
+         * Store a value.
+         *
+         * @param adapter the adapter the value belongs to
+         * @param name the name of the value, must not contain whitespace
+         * @param value the value
+         */
+        void Set(const AdapterSnapshot& adapter, const std::string_view name, uint64_t value);
+
+        /*!
+         * Load the values from a file.
+         *
+         * The loaded values replace the values in the store.
+         *
+         * @param file the file to load
+         * @return false if the file is missing or not readable
+         */
+        bool Load(const std::filesystem::path& file);
+
+        /*!
+         * Save the values to a file.
+         *
+         * @param file the file to write
+         */
+        void Save(const std::filesystem::path& file) const;
+
+    private:
+        using Key = std::tuple<UINT, UINT, UINT, UINT, LONGLONG, std::string>;
+
+        mutable std::mutex      mutex;
+        std::map<Key, uint64_t> values;
+
+        static Key MakeKey(const AdapterSnapshot& adapter, const std::string_view name);
+    };
+}
+
+#endif
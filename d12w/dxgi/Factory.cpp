@@ -21,36 +21,90 @@
 
 #include "Factory.h"
 
+#include <algorithm>
+#include <future>
+#include <sstream>
+
 #include "Adapter.h"
+#include "CapabilityStore.h"
+#include "../d3d/Device.h"
 
+#ifdef _MSC_VER
 #pragma comment(lib, "DXGI.lib")
+#endif
 
 namespace d12w::dxgi
 {
-    Factory::Factory()
+    namespace
     {
-        auto createFactoryFlags = 0u;
-        #ifndef NDEBUG
-        createFactoryFlags = DXGI_CREATE_FACTORY_DEBUG;
-        #endif
+        ComPtr<IDXGIFactory4> CreateFactory()
+        {
+            auto createFactoryFlags = 0u;
+            #ifndef NDEBUG
+            createFactoryFlags = DXGI_CREATE_FACTORY_DEBUG;
+            #endif
+
+            auto factory4 = ComPtr<IDXGIFactory4>{};
+            auto hr = CreateDXGIFactory2(createFactoryFlags, factory4.UUID(), reinterpret_cast<void**>(&factory4));
+            D12W_CHECK_SUCCESS(hr);
+            return factory4;
+        }
+    }
 
-        auto hr = CreateDXGIFactory2(createFactoryFlags, factory4.UUID(), reinterpret_cast<void**>(&factory4));
-        D12W_CHECK_SUCCESS(hr);
+    Factory::Factory()
+    : factory4(CreateFactory()), ownsFactory(true) {}
+
+    Factory::Factory(ComPtr<IDXGIFactory4> factory)
+    : factory4(std::move(factory))
+    {
+        D12W_ASSERT(factory4);
     }
 
     Factory::~Factory() = default;
 
     std::shared_ptr<Adapter> Factory::EnumWarpAdapter()
     {
+        auto result = TryEnumWarpAdapter();
+        D12W_CHECK_SUCCESS(result.GetHr());
+        return std::move(result).Value();
+    }
+
+    Result<std::shared_ptr<Adapter>> Factory::TryEnumWarpAdapter()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        Refresh();
+        if (warpAdapter)
+        {
+            return {S_OK, warpAdapter};
+        }
+
         ComPtr<IDXGIAdapter1> adapter1;
         auto hr = factory4->EnumWarpAdapter(adapter1.UUID(), reinterpret_cast<void**>(&adapter1));
-        D12W_CHECK_SUCCESS(hr);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
 
-        return std::shared_ptr<Adapter>{new Adapter{adapter1}};
+        warpAdapter = std::shared_ptr<Adapter>{new Adapter{std::move(adapter1)}};
+        return {hr, warpAdapter};
     }
 
     std::vector<std::shared_ptr<Adapter>> Factory::EnumAdapters()
     {
+        auto result = TryEnumAdapters();
+        D12W_CHECK_SUCCESS(result.GetHr());
+        return std::move(result).Value();
+    }
+
+    Result<std::vector<std::shared_ptr<Adapter>>> Factory::TryEnumAdapters()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        Refresh();
+        if (adapters)
+        {
+            return {S_OK, *adapters};
+        }
+
         auto result = std::vector<std::shared_ptr<Adapter>>{};
         auto hr = HRESULT{0};
         auto i = 0u;
@@ -60,17 +114,35 @@ namespace d12w::dxgi
             hr = factory4->EnumAdapters(i, &adapter);
             if (hr != DXGI_ERROR_NOT_FOUND)
             {
-                D12W_CHECK_SUCCESS(hr);
-                result.push_back(std::shared_ptr<Adapter>{new Adapter{adapter}});
+                if (FAILED(hr))
+                {
+                    return hr;
+                }
+                result.push_back(std::shared_ptr<Adapter>{new Adapter{std::move(adapter)}});
             }
             i++;
         }
         while (hr != DXGI_ERROR_NOT_FOUND);
-        return result;
+        adapters = result;
+        return {S_OK, std::move(result)};
     }
 
     std::vector<std::shared_ptr<Adapter>> Factory::EnumAdapters1()
     {
+        auto result = TryEnumAdapters1();
+        D12W_CHECK_SUCCESS(result.GetHr());
+        return std::move(result).Value();
+    }
+
+    Result<std::vector<std::shared_ptr<Adapter>>> Factory::TryEnumAdapters1()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        Refresh();
+        if (adapters1)
+        {
+            return {S_OK, *adapters1};
+        }
+
         auto result = std::vector<std::shared_ptr<Adapter>>{};
         auto hr = HRESULT{0};
         auto i = 0u;
@@ -80,12 +152,181 @@ namespace d12w::dxgi
             hr = factory4->EnumAdapters1(i, &adapter1);
             if (hr != DXGI_ERROR_NOT_FOUND)
             {
-                D12W_CHECK_SUCCESS(hr);
-                result.push_back(std::shared_ptr<Adapter>{new Adapter{adapter1}});
+                if (FAILED(hr))
+                {
+                    return hr;
+                }
+                result.push_back(std::shared_ptr<Adapter>{new Adapter{std::move(adapter1)}});
+            }
+            i++;
+        }
+        while (hr != DXGI_ERROR_NOT_FOUND);
+        adapters1 = result;
+        return {S_OK, std::move(result)};
+    }
+
+    std::vector<std::shared_ptr<Adapter>> Factory::EnumAdapterByGpuPreference(DXGI_GPU_PREFERENCE preference)
+    {
+        auto result = TryEnumAdapterByGpuPreference(preference);
+        D12W_CHECK_SUCCESS(result.GetHr());
+        return std::move(result).Value();
+    }
+
+    Result<std::vector<std::shared_ptr<Adapter>>> Factory::TryEnumAdapterByGpuPreference(DXGI_GPU_PREFERENCE preference)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        Refresh();
+        auto cached = preferredAdapters.find(preference);
+        if (cached != preferredAdapters.end())
+        {
+            return {S_OK, cached->second};
+        }
+
+        auto factory6 = factory4.TryAs<IDXGIFactory6>();
+        if (!factory6)
+        {
+            // IDXGIFactory6 needs Windows 10 1803, rank like DXGI does:
+            // hardware before software and by dedicated video memory.
+            lock.unlock();
+            auto enumeration = TryEnumAdapters1();
+            if (!enumeration)
+            {
+                return enumeration;
+            }
+            const auto& enumerated = enumeration.Value();
+            auto result = enumerated;
+            if (preference != DXGI_GPU_PREFERENCE_UNSPECIFIED)
+            {
+                auto highPerformance = preference == DXGI_GPU_PREFERENCE_HIGH_PERFORMANCE;
+                std::stable_sort(result.begin(), result.end(), [highPerformance] (const std::shared_ptr<Adapter>& a, const std::shared_ptr<Adapter>& b) {
+                    const auto& aSnapshot = a->GetSnapshot();
+                    const auto& bSnapshot = b->GetSnapshot();
+                    if (aSnapshot.IsSoftware() != bSnapshot.IsSoftware())
+                    {
+                        return bSnapshot.IsSoftware();
+                    }
+                    return highPerformance
+                        ? aSnapshot.GetDedicatedVideoMemory() > bSnapshot.GetDedicatedVideoMemory()
+                        : aSnapshot.GetDedicatedVideoMemory() < bSnapshot.GetDedicatedVideoMemory();
+                });
+            }
+
+            // cache the ranking, unless the adapters changed in the meantime
+            lock.lock();
+            if (adapters1 && *adapters1 == enumerated)
+            {
+                preferredAdapters[preference] = result;
+            }
+            return {S_OK, std::move(result)};
+        }
+
+        auto result = std::vector<std::shared_ptr<Adapter>>{};
+        auto hr = HRESULT{0};
+        auto i = 0u;
+        do
+        {
+            auto adapter1 = ComPtr<IDXGIAdapter1>{};
+            hr = factory6->EnumAdapterByGpuPreference(i, preference, adapter1.UUID(), reinterpret_cast<void**>(&adapter1));
+            if (hr != DXGI_ERROR_NOT_FOUND)
+            {
+                if (FAILED(hr))
+                {
+                    return hr;
+                }
+                result.push_back(std::shared_ptr<Adapter>{new Adapter{std::move(adapter1)}});
             }
             i++;
         }
         while (hr != DXGI_ERROR_NOT_FOUND);
+        preferredAdapters[preference] = result;
+        return {S_OK, std::move(result)};
+    }
+
+    std::vector<std::shared_ptr<Adapter>> Factory::SelectAdapter(const AdapterPolicy& policy)
+    {
+        auto candidates = EnumAdapterByGpuPreference(policy.gpuPreference);
+
+        auto qualify = policy.qualify;
+        if (!qualify)
+        {
+            qualify = [] (Adapter& adapter, D3D_FEATURE_LEVEL minFeatureLevel) {
+                return d3d::Device::TryCreate(adapter, minFeatureLevel);
+            };
+        }
+
+        auto name = std::stringstream{};
+        name << "qualified." << std::hex << policy.minFeatureLevel;
+        auto capability = name.str();
+
+        // Trial device creation can take hundreds of milliseconds per
+        // adapter, so all candidates are probed concurrently.
+        auto qualified = std::vector<std::future<bool>>{};
+        qualified.reserve(candidates.size());
+        for (const auto& adapter : candidates)
+        {
+            qualified.push_back(std::async(std::launch::async, [&policy, &qualify, &capability, adapter] () {
+                const auto& snapshot = adapter->GetSnapshot();
+                if (snapshot.IsSoftware() && !policy.allowSoftware)
+                {
+                    return false;
+                }
+
+                if (policy.capabilities)
+                {
+                    if (auto known = policy.capabilities->Get(snapshot, capability))
+                    {
+                        return *known != 0;
+                    }
+                }
+
+                auto result = qualify(*adapter, policy.minFeatureLevel);
+
+                if (policy.capabilities)
+                {
+                    policy.capabilities->Set(snapshot, capability, result ? 1 : 0);
+                }
+                return result;
+            }));
+        }
+
+        auto result = std::vector<std::shared_ptr<Adapter>>{};
+        for (auto i = 0u; i < candidates.size(); i++)
+        {
+            if (qualified[i].get())
+            {
+                result.push_back(candidates[i]);
+            }
+        }
         return result;
     }
+
+    // mutex must be held
+    void Factory::Refresh()
+    {
+        if (factory4->IsCurrent())
+        {
+            return;
+        }
+
+        // A factory stays out of date once an adapter was added or removed,
+        // only a new factory enumerates the new configuration. A wrapped
+        // factory can not be replaced, it is enumerated once more and then
+        // cached again.
+        if (ownsFactory)
+        {
+            factory4 = CreateFactory();
+        }
+        else if (staleFactory)
+        {
+            return;
+        }
+        else
+        {
+            staleFactory = true;
+        }
+        warpAdapter.reset();
+        adapters.reset();
+        adapters1.reset();
+        preferredAdapters.clear();
+    }
 }
\ No newline at end of file
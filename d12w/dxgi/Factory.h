@@ -22,24 +22,64 @@
 #ifndef _D12W_DXGI_FACTORY_H_
 #define _D12W_DXGI_FACTORY_H_
 
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
 #include <dxgi.h>
 #include <dxgi1_2.h>
 #include <dxgi1_3.h>
 #include <dxgi1_4.h>
 #include <dxgi1_5.h>
 #include <dxgi1_6.h>
+#include <d3dcommon.h>
 
 #include "../defines.h"
 #include "../ComPtr.h"
+#include "../Result.h"
 
 namespace d12w::dxgi
 {
     class Adapter;
+    class CapabilityStore;
+
+    /*!
+     * Adapter Selection Policy
+     */
+    struct AdapterPolicy
+    {
+        DXGI_GPU_PREFERENCE gpuPreference   = DXGI_GPU_PREFERENCE_HIGH_PERFORMANCE; //!< the preference used to rank the adapters
+        D3D_FEATURE_LEVEL   minFeatureLevel = D3D_FEATURE_LEVEL_11_0;               //!< the feature level a device must support
+        bool                allowSoftware   = false;                                //!< also select software adapters, such as WARP
+
+        /*!
+         * The qualification test of an adapter.
+         *
+         * If empty, d3d::Device::TryCreate is used. The test is called
+         * concurrently from several threads.
+         */
+        std::function<bool (Adapter& adapter, D3D_FEATURE_LEVEL minFeatureLevel)> qualify;
+
+        /*!
+         * Optional store for the qualification results.
+         *
+         * Results are stored as "qualified.<feature level>", so a custom
+         * qualification test should not share the store with the default one.
+         */
+        CapabilityStore* capabilities = nullptr;
+    };
 
     /*!
      * DirectX Graphic Interface Factory
      *
      * This wrapper implements IDXGIFactory4
+     *
+     * The enumerated adapters are cached, until DXGI reports that the
+     * adapter configuration changed. The factory is then recreated, a
+     * wrapped factory is only enumerated once more, since it stays out
+     * of date.
      */
     class D12W_EXPORT Factory
     {
@@ -50,6 +90,16 @@ namespace d12w::dxgi
          */
         Factory();
 
+        /*!
+         * Wrap an existing DXGI factory.
+         *
+         * This allows to use an alternative implementation, like the null backend.
+         *
+         * @param factory the factory to wrap
+         */
+        explicit
+        Factory(ComPtr<IDXGIFactory4> factory);
+
         Factory(const Factory&) = delete;
 
         ~Factory();
@@ -63,18 +113,79 @@ namespace d12w::dxgi
          */
         std::shared_ptr<Adapter> EnumWarpAdapter();
 
+        /*!
+         * Non-throwing variant of EnumWarpAdapter.
+         *
+         * @return the WARP adapter or the HRESULT of the failed call
+         */
+        Result<std::shared_ptr<Adapter>> TryEnumWarpAdapter();
+
         /*!
          * Enumerates the adapters (video cards).
          */
         std::vector<std::shared_ptr<Adapter>> EnumAdapters();
 
+        /*!
+         * Non-throwing variant of EnumAdapters.
+         *
+         * @return the adapters or the HRESULT of the failed call
+         */
+        Result<std::vector<std::shared_ptr<Adapter>>> TryEnumAdapters();
+
         /*!
          * Enumerates both adapters (video cards) with or without outputs.
          */
         std::vector<std::shared_ptr<Adapter>> EnumAdapters1();
 
+        /*!
+         * Non-throwing variant of EnumAdapters1.
+         *
+         * @return the adapters or the HRESULT of the failed call
+         */
+        Result<std::vector<std::shared_ptr<Adapter>>> TryEnumAdapters1();
+
+        /*!
+         * Enumerates the adapters ranked by a GPU preference.
+         *
+         * On systems without IDXGIFactory6 the adapters are ranked by
+         * their dedicated video memory, with software adapters last. In both
+         * cases the result is cached per preference.
+         *
+         * @param preference the GPU preference
+         * @return the adapters, most preferred first
+         */
+        std::vector<std::shared_ptr<Adapter>> EnumAdapterByGpuPreference(DXGI_GPU_PREFERENCE preference);
+
+        /*!
+         * Non-throwing variant of EnumAdapterByGpuPreference.
+         *
+         * @param preference the GPU preference
+         * @return the adapters, most preferred first, or the HRESULT of the failed call
+         */
+        Result<std::vector<std::shared_ptr<Adapter>>> TryEnumAdapterByGpuPreference(DXGI_GPU_PREFERENCE preference);
+
+        /*!
+         * Select the adapters that fit a policy.
+         *
+         * The candidates from EnumAdapterByGpuPreference are qualified in
+         * parallel, so that probing several adapters does not add up.
+         *
+         * @param policy the selection policy
+         * @return the qualified adapters, best first
+         */
+        std::vector<std::shared_ptr<Adapter>> SelectAdapter(const AdapterPolicy& policy = {});
+
     private:
-        ComPtr<IDXGIFactory4> factory4;
+        ComPtr<IDXGIFactory4>                                                factory4;
+        bool                                                                 ownsFactory = false;
+        bool                                                                 staleFactory = false;
+        std::mutex                                                           mutex;
+        std::shared_ptr<Adapter>                                             warpAdapter;
+        std::optional<std::vector<std::shared_ptr<Adapter>>>                 adapters;
+        std::optional<std::vector<std::shared_ptr<Adapter>>>                 adapters1;
+        std::map<DXGI_GPU_PREFERENCE, std::vector<std::shared_ptr<Adapter>>> preferredAdapters;
+
+        void Refresh();
     };
 }
 
@@ -24,5 +24,7 @@
 
 #include "Factory.h"
 #include "Adapter.h"
+#include "AdapterSnapshot.h"
+#include "CapabilityStore.h"
 
 #endif
@@ -0,0 +1,175 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "util.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace d12w::util
+{
+    namespace
+    {
+        struct ErrorInfo
+        {
+            uint32_t         code;
+            std::string_view name;
+            std::string_view message;
+        };
+
+        // Must be sorted by code, this is checked at compile time.
+        constexpr ErrorInfo errorTable[] = {
+            {0x00000000, "S_OK",                                     "The operation completed successfully."},
+            {0x00000001, "S_FALSE",                                  "The operation completed successfully, but with a nonstandard result."},
+            {0x00000002, "ERROR_FILE_NOT_FOUND",                     "The system cannot find the file specified."},
+            {0x00000003, "ERROR_PATH_NOT_FOUND",                     "The system cannot find the path specified."},
+            {0x00000005, "ERROR_ACCESS_DENIED",                      "Access is denied."},
+            {0x00000006, "ERROR_INVALID_HANDLE",                     "The handle is invalid."},
+            {0x00000008, "ERROR_NOT_ENOUGH_MEMORY",                  "Not enough memory resources are available to process this command."},
+            {0x00000057, "ERROR_INVALID_PARAMETER",                  "The parameter is incorrect."},
+            {0x00000578, "ERROR_INVALID_WINDOW_HANDLE",              "Invalid window handle."},
+            {0x00000582, "ERROR_CLASS_ALREADY_EXISTS",               "Class already exists."},
+            {0x00000583, "ERROR_CLASS_DOES_NOT_EXIST",               "Class does not exist."},
+            {0x087A0001, "DXGI_STATUS_OCCLUDED",                     "The window content is not visible."},
+            {0x087A0002, "DXGI_STATUS_CLIPPED",                      "The target surface is clipped."},
+            {0x087A0007, "DXGI_STATUS_MODE_CHANGED",                 "The desktop display mode has been changed."},
+            {0x087A0008, "DXGI_STATUS_MODE_CHANGE_IN_PROGRESS",      "The desktop display mode is being changed."},
+            {0x80004001, "E_NOTIMPL",                                "Not implemented."},
+            {0x80004002, "E_NOINTERFACE",                            "No such interface supported."},
+            {0x80004003, "E_POINTER",                                "Invalid pointer."},
+            {0x80004004, "E_ABORT",                                  "Operation aborted."},
+            {0x80004005, "E_FAIL",                                   "Unspecified error."},
+            {0x8000FFFF, "E_UNEXPECTED",                             "Catastrophic failure."},
+            {0x80070002, "ERROR_FILE_NOT_FOUND",                     "The system cannot find the file specified."},
+            {0x80070003, "ERROR_PATH_NOT_FOUND",                     "The system cannot find the path specified."},
+            {0x80070005, "E_ACCESSDENIED",                           "Access is denied."},
+            {0x80070006, "E_HANDLE",                                 "The handle is invalid."},
+            {0x8007000E, "E_OUTOFMEMORY",                            "Not enough memory resources are available to complete this operation."},
+            {0x80070057, "E_INVALIDARG",                             "The parameter is incorrect."},
+            {0x887A0001, "DXGI_ERROR_INVALID_CALL",                  "The application provided invalid parameter data."},
+            {0x887A0002, "DXGI_ERROR_NOT_FOUND",                     "The requested object was not found or the enumerated ordinal is out of range."},
+            {0x887A0003, "DXGI_ERROR_MORE_DATA",                     "The buffer supplied by the application is not big enough to hold the requested data."},
+            {0x887A0004, "DXGI_ERROR_UNSUPPORTED",                   "The requested functionality is not supported by the device or the driver."},
+            {0x887A0005, "DXGI_ERROR_DEVICE_REMOVED",                "The GPU device instance has been suspended. Use GetDeviceRemovedReason to determine the appropriate action."},
+            {0x887A0006, "DXGI_ERROR_DEVICE_HUNG",                   "The GPU will not respond to more commands, most likely because of an invalid command passed by the calling application."},
+            {0x887A0007, "DXGI_ERROR_DEVICE_RESET",                  "The GPU will not respond to more commands, most likely because some other application submitted invalid commands."},
+            {0x887A000A, "DXGI_ERROR_WAS_STILL_DRAWING",             "The GPU was busy at the moment when the call was made, and the call was neither executed nor scheduled."},
+            {0x887A000B, "DXGI_ERROR_FRAME_STATISTICS_DISJOINT",     "An event (such as power cycle) interrupted the gathering of presentation statistics."},
+            {0x887A000C, "DXGI_ERROR_GRAPHICS_VIDPN_SOURCE_IN_USE",  "Fullscreen mode could not be achieved because the specified output was already in use."},
+            {0x887A0020, "DXGI_ERROR_DRIVER_INTERNAL_ERROR",         "An internal issue prevented the driver from carrying out the specified operation."},
+            {0x887A0021, "DXGI_ERROR_NONEXCLUSIVE",                  "A global counter resource was in use, and the specified counter cannot be used by this device at this time."},
+            {0x887A0022, "DXGI_ERROR_NOT_CURRENTLY_AVAILABLE",       "A resource is not available at the time of the call, but may become available later."},
+            {0x887A0023, "DXGI_ERROR_REMOTE_CLIENT_DISCONNECTED",    "The application's remote device has been removed due to session disconnect or network disconnect."},
+            {0x887A0024, "DXGI_ERROR_REMOTE_OUTOFMEMORY",            "The device has been removed during a remote session because the remote computer ran out of memory."},
+            {0x887A0025, "DXGI_ERROR_MODE_CHANGE_IN_PROGRESS",       "The requested operation could not be completed because a mode change was in progress."},
+            {0x887A0026, "DXGI_ERROR_ACCESS_LOST",                   "The keyed mutex was abandoned or the desktop duplication interface became invalid."},
+            {0x887A0027, "DXGI_ERROR_WAIT_TIMEOUT",                  "The time-out interval elapsed before the next desktop frame was available."},
+            {0x887A0028, "DXGI_ERROR_SESSION_DISCONNECTED",          "The Remote Desktop Services session is currently disconnected."},
+            {0x887A0029, "DXGI_ERROR_RESTRICT_TO_OUTPUT_STALE",      "The output to which the swap chain content was restricted is now disconnected or changed."},
+            {0x887A002A, "DXGI_ERROR_CANNOT_PROTECT_CONTENT",        "DXGI is unable to provide content protection on the swap chain."},
+            {0x887A002B, "DXGI_ERROR_ACCESS_DENIED",                 "The application is trying to use a resource to which it does not have the required access privileges."},
+            {0x887A002C, "DXGI_ERROR_NAME_ALREADY_EXISTS",           "The application is trying to create a shared handle using a name that is already associated with some other resource."},
+            {0x887A002D, "DXGI_ERROR_SDK_COMPONENT_MISSING",         "The application requested an operation that depends on an SDK component that is missing or mismatched."},
+            {0x887A002E, "DXGI_ERROR_NOT_CURRENT",                   "The DXGI objects that the application has created are no longer current and need to be recreated."},
+            {0x887A0030, "DXGI_ERROR_HW_PROTECTION_OUTOFMEMORY",     "Insufficient hardware protected memory exits for proper function."},
+            {0x887A0031, "DXGI_ERROR_DYNAMIC_CODE_POLICY_VIOLATION", "Creating this device would violate the process's dynamic code policy."},
+            {0x887A0032, "DXGI_ERROR_NON_COMPOSITED_UI",             "The operation failed because the compositor is not in control of the output."},
+            {0x887E0001, "D3D12_ERROR_ADAPTER_NOT_FOUND",            "The specified cached PSO was created on a different adapter and cannot be reused on the current adapter."},
+            {0x887E0002, "D3D12_ERROR_DRIVER_VERSION_MISMATCH",      "The specified cached PSO was created on a different driver version and cannot be reused on the current adapter."},
+            {0x887E0003, "D3D12_ERROR_INVALID_REDIST",               "The D3D12 SDK version configuration of the host executable is invalid."},
+        };
+
+        constexpr bool IsSorted()
+        {
+            for (auto i = size_t{1}; i < std::size(errorTable); i++)
+            {
+                if (errorTable[i - 1].code >= errorTable[i].code)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+        static_assert(IsSorted(), "errorTable must be sorted by code");
+
+        const ErrorInfo* FindError(int32_t errorid) noexcept
+        {
+            auto code = static_cast<uint32_t>(errorid);
+            auto end = std::end(errorTable);
+            auto i = std::lower_bound(std::begin(errorTable), end, code, [] (const ErrorInfo& info, uint32_t c) {
+                return info.code < c;
+            });
+            return (i != end && i->code == code) ? i : nullptr;
+        }
+
+        // Append text to buffer, as far as it fits with the terminator.
+        size_t Append(char* buffer, size_t size, size_t length, std::string_view text) noexcept
+        {
+            auto count = std::min(text.size(), size - 1 - length);
+            std::copy_n(text.data(), count, buffer + length);
+            return length + count;
+        }
+    }
+
+    std::string_view GetErrorName(int32_t errorid) noexcept
+    {
+        auto info = FindError(errorid);
+        return info ? info->name : std::string_view{};
+    }
+
+    std::string_view LookupErrorMessage(int32_t errorid) noexcept
+    {
+        auto info = FindError(errorid);
+        return info ? info->message : std::string_view{};
+    }
+
+    size_t FormatErrorMessage(int32_t errorid, char* buffer, size_t size) noexcept
+    {
+        if (buffer == nullptr || size == 0)
+        {
+            return 0;
+        }
+
+        auto length = size_t{0};
+        auto info = FindError(errorid);
+        if (info)
+        {
+            length = Append(buffer, size, length, info->name);
+            length = Append(buffer, size, length, ": ");
+            length = Append(buffer, size, length, info->message);
+        }
+        else
+        {
+            constexpr auto digits = std::string_view{"0123456789ABCDEF"};
+            auto code = static_cast<uint32_t>(errorid);
+            char hex[8];
+            for (auto i = 0; i < 8; i++)
+            {
+                hex[i] = digits[(code >> (28 - 4 * i)) & 0xF];
+            }
+            length = Append(buffer, size, length, "Unknown error 0x");
+            length = Append(buffer, size, length, std::string_view{hex, 8});
+            length = Append(buffer, size, length, ".");
+        }
+        buffer[length] = 0;
+        return length;
+    }
+}
@@ -0,0 +1,389 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "util.h"
+
+#include <cstring>
+#include <stdexcept>
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define D12W_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace d12w::util
+{
+    namespace
+    {
+        constexpr char32_t REPLACEMENT_CHARACTER = 0xFFFD;
+
+        bool IsContinuation(unsigned char c)
+        {
+            return (c & 0xC0) == 0x80;
+        }
+
+        bool IsHighSurrogate(char32_t c)
+        {
+            return c >= 0xD800 && c <= 0xDBFF;
+        }
+
+        bool IsLowSurrogate(char32_t c)
+        {
+            return c >= 0xDC00 && c <= 0xDFFF;
+        }
+
+        /*
+         * Decode one UTF-8 sequence starting at i.
+         *
+         * Overlong encodings, surrogates and code points above U+10FFFF are
+         * rejected, like MultiByteToWideChar with MB_ERR_INVALID_CHARS.
+         *
+         * Returns the number of bytes consumed or 0 if the sequence is invalid.
+         */
+        size_t DecodeUtf8(const unsigned char* data, size_t i, size_t size, char32_t& cp)
+        {
+            auto c = data[i];
+            if (c < 0x80)
+            {
+                cp = c;
+                return 1;
+            }
+            if (c >= 0xC2 && c <= 0xDF)
+            {
+                if (i + 1 < size && IsContinuation(data[i + 1]))
+                {
+                    cp = ((c & 0x1Fu) << 6) | (data[i + 1] & 0x3Fu);
+                    return 2;
+                }
+                return 0;
+            }
+            if (c >= 0xE0 && c <= 0xEF)
+            {
+                if (i + 2 < size && IsContinuation(data[i + 1]) && IsContinuation(data[i + 2]))
+                {
+                    cp = ((c & 0x0Fu) << 12) | ((data[i + 1] & 0x3Fu) << 6) | (data[i + 2] & 0x3Fu);
+                    if (cp >= 0x800 && !IsHighSurrogate(cp) && !IsLowSurrogate(cp))
+                    {
+                        return 3;
+                    }
+                }
+                return 0;
+            }
+            if (c >= 0xF0 && c <= 0xF4)
+            {
+                if (i + 3 < size && IsContinuation(data[i + 1]) && IsContinuation(data[i + 2]) && IsContinuation(data[i + 3]))
+                {
+                    cp = ((c & 0x07u) << 18) | ((data[i + 1] & 0x3Fu) << 12) | ((data[i + 2] & 0x3Fu) << 6) | (data[i + 3] & 0x3Fu);
+                    if (cp >= 0x10000 && cp <= 0x10FFFF)
+                    {
+                        return 4;
+                    }
+                }
+                return 0;
+            }
+            return 0;
+        }
+
+        /*
+         * Decode one UTF-16 (or UTF-32 where wchar_t is 32 bit) code point
+         * starting at i. Unpaired surrogates decode to U+FFFD, like
+         * WideCharToMultiByte without WC_ERR_INVALID_CHARS.
+         *
+         * Returns the number of code units consumed.
+         */
+        size_t DecodeWide(const wchar_t* data, size_t i, size_t size, char32_t& cp)
+        {
+            auto c = static_cast<char32_t>(data[i]);
+            if constexpr (sizeof(wchar_t) == 2)
+            {
+                if (IsHighSurrogate(c) && i + 1 < size && IsLowSurrogate(static_cast<char32_t>(data[i + 1])))
+                {
+                    cp = 0x10000 + ((c - 0xD800) << 10) + (static_cast<char32_t>(data[i + 1]) - 0xDC00);
+                    return 2;
+                }
+            }
+            if (IsHighSurrogate(c) || IsLowSurrogate(c) || c > 0x10FFFF)
+            {
+                cp = REPLACEMENT_CHARACTER;
+            }
+            else
+            {
+                cp = c;
+            }
+            return 1;
+        }
+
+        size_t WideLength(char32_t cp)
+        {
+            return (sizeof(wchar_t) == 2 && cp >= 0x10000) ? 2 : 1;
+        }
+
+        size_t Utf8Length(char32_t cp)
+        {
+            if (cp < 0x80)
+            {
+                return 1;
+            }
+            if (cp < 0x800)
+            {
+                return 2;
+            }
+            if (cp < 0x10000)
+            {
+                return 3;
+            }
+            return 4;
+        }
+
+        // Number of leading bytes that are ASCII, checked 16 at a time.
+        size_t AsciiPrefix(const unsigned char* data, size_t size)
+        {
+            auto i = size_t{0};
+            #ifdef D12W_SSE2
+            for (; i + 16 <= size; i += 16)
+            {
+                auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                if (_mm_movemask_epi8(chunk) != 0)
+                {
+                    break;
+                }
+            }
+            #endif
+            while (i < size && data[i] < 0x80)
+            {
+                i++;
+            }
+            return i;
+        }
+
+        // Number of leading wide characters that are ASCII, checked 8 at a time.
+        size_t AsciiPrefix(const wchar_t* data, size_t size)
+        {
+            auto i = size_t{0};
+            #ifdef D12W_SSE2
+            if constexpr (sizeof(wchar_t) == 2)
+            {
+                auto mask = _mm_set1_epi16(static_cast<short>(0xFF80));
+                auto zero = _mm_setzero_si128();
+                for (; i + 8 <= size; i += 8)
+                {
+                    auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                    if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(chunk, mask), zero)) != 0xFFFF)
+                    {
+                        break;
+                    }
+                }
+            }
+            #endif
+            while (i < size && static_cast<char32_t>(data[i]) < 0x80)
+            {
+                i++;
+            }
+            return i;
+        }
+
+        void CopyAscii(const unsigned char* src, size_t count, wchar_t* dst)
+        {
+            auto i = size_t{0};
+            #ifdef D12W_SSE2
+            if constexpr (sizeof(wchar_t) == 2)
+            {
+                auto zero = _mm_setzero_si128();
+                for (; i + 16 <= count; i += 16)
+                {
+                    auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_unpacklo_epi8(chunk, zero));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 8), _mm_unpackhi_epi8(chunk, zero));
+                }
+            }
+            #endif
+            for (; i < count; i++)
+            {
+                dst[i] = static_cast<wchar_t>(src[i]);
+            }
+        }
+
+        void CopyAscii(const wchar_t* src, size_t count, char* dst)
+        {
+            auto i = size_t{0};
+            #ifdef D12W_SSE2
+            if constexpr (sizeof(wchar_t) == 2)
+            {
+                for (; i + 8 <= count; i += 8)
+                {
+                    auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(chunk, chunk));
+                }
+            }
+            #endif
+            for (; i < count; i++)
+            {
+                dst[i] = static_cast<char>(src[i]);
+            }
+        }
+
+        size_t CountWide(const std::string_view value)
+        {
+            auto data = reinterpret_cast<const unsigned char*>(value.data());
+            auto size = value.size();
+            auto count = size_t{0};
+            auto i = size_t{0};
+            while (i < size)
+            {
+                auto ascii = AsciiPrefix(data + i, size - i);
+                i += ascii;
+                count += ascii;
+                if (i < size)
+                {
+                    auto cp = char32_t{0};
+                    auto n = DecodeUtf8(data, i, size, cp);
+                    if (n == 0)
+                    {
+                        D12W_THROW(std::logic_error, "Invalid UTF-8 sequence.");
+                    }
+                    i += n;
+                    count += WideLength(cp);
+                }
+            }
+            return count;
+        }
+
+        // value must be valid, as checked by CountWide
+        void WriteWide(const std::string_view value, wchar_t* out)
+        {
+            auto data = reinterpret_cast<const unsigned char*>(value.data());
+            auto size = value.size();
+            auto i = size_t{0};
+            while (i < size)
+            {
+                auto ascii = AsciiPrefix(data + i, size - i);
+                CopyAscii(data + i, ascii, out);
+                i += ascii;
+                out += ascii;
+                if (i < size)
+                {
+                    auto cp = char32_t{0};
+                    i += DecodeUtf8(data, i, size, cp);
+                    if (sizeof(wchar_t) == 2 && cp >= 0x10000)
+                    {
+                        *out++ = static_cast<wchar_t>(0xD800 + ((cp - 0x10000) >> 10));
+                        *out++ = static_cast<wchar_t>(0xDC00 + ((cp - 0x10000) & 0x3FF));
+                    }
+                    else
+                    {
+                        *out++ = static_cast<wchar_t>(cp);
+                    }
+                }
+            }
+        }
+
+        size_t CountUtf8(const std::wstring_view value)
+        {
+            auto data = value.data();
+            auto size = value.size();
+            auto count = size_t{0};
+            auto i = size_t{0};
+            while (i < size)
+            {
+                auto ascii = AsciiPrefix(data + i, size - i);
+                i += ascii;
+                count += ascii;
+                if (i < size)
+                {
+                    auto cp = char32_t{0};
+                    i += DecodeWide(data, i, size, cp);
+                    count += Utf8Length(cp);
+                }
+            }
+            return count;
+        }
+
+        void WriteUtf8(const std::wstring_view value, char* out)
+        {
+            auto data = value.data();
+            auto size = value.size();
+            auto i = size_t{0};
+            while (i < size)
+            {
+                auto ascii = AsciiPrefix(data + i, size - i);
+                CopyAscii(data + i, ascii, out);
+                i += ascii;
+                out += ascii;
+                if (i < size)
+                {
+                    auto cp = char32_t{0};
+                    i += DecodeWide(data, i, size, cp);
+                    switch (Utf8Length(cp))
+                    {
+                        case 1:
+                            *out++ = static_cast<char>(cp);
+                            break;
+                        case 2:
+                            *out++ = static_cast<char>(0xC0 | (cp >> 6));
+                            *out++ = static_cast<char>(0x80 | (cp & 0x3F));
+                            break;
+                        case 3:
+                            *out++ = static_cast<char>(0xE0 | (cp >> 12));
+                            *out++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                            *out++ = static_cast<char>(0x80 | (cp & 0x3F));
+                            break;
+                        default:
+                            *out++ = static_cast<char>(0xF0 | (cp >> 18));
+                            *out++ = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+                            *out++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                            *out++ = static_cast<char>(0x80 | (cp & 0x3F));
+                            break;
+                    }
+                }
+            }
+        }
+    }
+
+    std::wstring widen(const std::string_view value)
+    {
+        auto result = std::wstring{};
+        widen(value, result);
+        return result;
+    }
+
+    void widen(const std::string_view value, std::wstring& result)
+    {
+        auto count = CountWide(value);
+        auto offset = result.size();
+        result.resize(offset + count);
+        WriteWide(value, result.data() + offset);
+    }
+
+    std::string narrow(const std::wstring_view value)
+    {
+        auto result = std::string{};
+        narrow(value, result);
+        return result;
+    }
+
+    void narrow(const std::wstring_view value, std::string& result)
+    {
+        auto count = CountUtf8(value);
+        auto offset = result.size();
+        result.resize(offset + count);
+        WriteUtf8(value, result.data() + offset);
+    }
+}
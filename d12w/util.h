@@ -22,9 +22,13 @@
 #ifndef _D12W_DBG_H_
 #define _D12W_DBG_H_
 
+#include <array>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <sstream>
+#include <stdexcept>
 #include <winerror.h>
 
 #include "defines.h"
@@ -51,20 +55,24 @@
  */
 #define D12W_ASSERT(COND) if (static_cast<bool>(COND) == false) { ::d12w::util::HandleAssert(__FUNCTION__, #COND); }
 
+#else
+#define D12W_THROW(EX, MSG) throw EX(MSG)
+#define D12W_ASSERT(COND)
+#endif
+
 /*!
  * Check if a HRESULT is a success state.
  *
  * This macro will check if a given HRESULT is FAILED and if that is the case throw and exception.
  * In debug builds this will be an exception with full callstack. 
  *
+ * The exception is built out of line in HandleHrFailed, so that the success
+ * path only costs a single branch. The branch is marked unlikely and the
+ * handler cold, so that the compiler moves the failure path out of the way.
+ *
  * @param HR the HRESULT to check
  */
-#define D12W_CHECK_SUCCESS(HR) if (FAILED(HR)) { ::d12w::util::HandleHrFailed(__FUNCTION__, HR); }
-#else
-#define D12W_THROW(EX, MSG) throw EX(MSG)
-#define D12W_ASSERT(COND)
-#define D12W_CHECK_SUCCESS(HR) if (FAILED(HR)) { throw std::runtime_error(::d12w::util::GetErrorMessage(HR)); }
-#endif
+#define D12W_CHECK_SUCCESS(HR) if (FAILED(HR)) [[unlikely]] { ::d12w::util::HandleHrFailed(__FUNCTION__, HR); }
 
 namespace d12w::util
 {   
@@ -81,6 +89,44 @@ namespace d12w::util
         std::string file;       //!< file of the function
     };
 
+    /*!
+     * Raw call stack
+     *
+     * Only the return addresses are recorded, which is cheap and does 
+     * not allocate. Use Symbolize to resolve them into StackFrames.
+     */
+    struct CallStack
+    {
+        std::array<void*, 62> addresses = {}; //!< return addresses, innermost first
+        unsigned int size = 0;                //!< number of valid addresses
+    };
+
+    /*!
+     * Capture the call stack.
+     *
+     * @param skip number of frames to skip, the frame of CaptureCallStack itself is always skipped
+     * @return the raw call stack of the calling function
+     *
+     * @note This function is only available in debug builds.
+     */
+    D12W_EXPORT
+    CallStack CaptureCallStack(unsigned int skip = 0);
+
+    /*!
+     * Resolve a raw call stack into readable frames.
+     *
+     * The symbol engine is initialized once on first use and shared by 
+     * the whole process. To get a readable callstack you need to have 
+     * all PDBs next to the program.
+     *
+     * @param stack the call stack to resolve
+     * @return the resolved callstack
+     *
+     * @note This function is only available in debug builds.
+     */
+    D12W_EXPORT
+    std::vector<StackFrame> Symbolize(const CallStack& stack);
+
     /*!
      * Pull call stack
      *
@@ -94,6 +140,73 @@ namespace d12w::util
     D12W_EXPORT
     std::vector<StackFrame> StackTrace();
 
+    /*!
+     * Exception with callstack.
+     *
+     * The callstack is captured when the exception is thrown, but only
+     * symbolized when what is called for the first time. This keeps throwing
+     * cheap for code that catches and handles the exception.
+     */
+    template <typename Exception>
+    class ExceptionWithCallstack : public Exception
+    {
+    public:
+        /*!
+         * Create exception with callstack.
+         *
+         * @param msg the message of the exception
+         * @param stack the callstack where the exception was thrown
+         */
+        ExceptionWithCallstack(const std::string& msg, const CallStack& stack)
+        : Exception(msg), details(std::make_shared<Details>())
+        {
+            details->stack = stack;
+        }
+
+        /*!
+         * Get the raw callstack.
+         */
+        const CallStack& GetCallStack() const noexcept
+        {
+            return details->stack;
+        }
+
+        /*!
+         * Get the message with the symbolized callstack.
+         */
+        const char* what() const noexcept override
+        {
+            try
+            {
+                std::call_once(details->once, [this] () {
+                    std::stringstream buff;
+                    buff << Exception::what() << "\n";
+                    buff << "Callstack: \n";
+                    for (const auto& frame : Symbolize(details->stack))
+                    {
+                        buff << "0x" << std::hex << frame.address << ": " << frame.name << "(" << std::dec << frame.line << ") in " << frame.module << "\n";
+                    }
+                    details->text = buff.str();
+                });
+                return details->text.c_str();
+            }
+            catch (...)
+            {
+                return Exception::what();
+            }
+        }
+
+    private:
+        struct Details
+        {
+            CallStack      stack;
+            std::once_flag once;
+            std::string    text;
+        };
+        // shared, since exceptions are copied when thrown
+        std::shared_ptr<Details> details;
+    };
+
     /*!
      * Handle asset failure.
      *
@@ -108,63 +221,99 @@ namespace d12w::util
      *
      * @see D12W_ASSERT
      */
-    [[noreturn]] D12W_EXPORT
+    [[noreturn]] D12W_EXPORT D12W_COLD
     void HandleAssert(const std::string_view func, const std::string_view cond);
 
+    /*!
+     * Throw exception with callstack.
+     *
+     * This debug utility function will capture the callstack and throw an 
+     * ExceptionWithCallstack, that appends it to the given error message. 
+     * You should use D12W_THROW macro instead of this function.
+     *
+     * @param func the calling function
+     * @param msg the message to print
+     *
+     * @note This function is only available in debug builds.
+     *
+     * @see D12W_THROW 
+     */
+    template <typename Exception> [[noreturn]]
+    void ThrowWithCallstack(const std::string_view func, const std::string_view msg) 
+    {
+        std::stringstream buff;
+        buff << func << ": " << msg << "\n";
+
+        throw ExceptionWithCallstack<Exception>(buff.str(), CaptureCallStack());
+    }
+ #endif
+
     /*!
      * Handle HRESULT failure.
      *
-     * This debug utility function is used to convert a HRESULT failure
-     * into an exception with call stack. You should use the D12W_CHECK_SUCCESS
-     * to check a HRESULT and invoke this function in the case of an error.
+     * This utility function is used to convert a HRESULT failure into an 
+     * exception. In debug builds the exception has a call stack. You should 
+     * use the D12W_CHECK_SUCCESS to check a HRESULT and invoke this function 
+     * in the case of an error.
      *
      * @param func the calling function
      * @param hr the HRESULT that failed
      *
-     * @note This function is only available in debug builds.
+     * @throws std::logic_error with callstack in debug builds
+     * @throws std::runtime_error in release builds
      *
      * @see D12W_CHECK_SUCCESS
      */
-    [[noreturn]] D12W_EXPORT
+    [[noreturn]] D12W_EXPORT D12W_NOINLINE D12W_COLD
     void HandleHrFailed(const std::string_view func, HRESULT hr);
 
     /*!
-     * Throw exception with callstack.
+     * Get the symbolic name of an error code.
      *
-     * This debug utility function will pull a full callstack and append it to 
-     * the given error message. You should use D12W_THROW macro instead of this 
-     * function.
+     * The name is looked up in a built-in table of the common Win32, 
+     * DXGI and D3D12 error codes. This function does not allocate.
      *
-     * @param func the calling function
-     * @param msg the message to print
+     * @param errorid either HRESULT or DWORD Win32 error code.
+     * @return the name, for example "DXGI_ERROR_DEVICE_REMOVED" or an empty string if the code is unknown
+     */
+    D12W_EXPORT
+    std::string_view GetErrorName(int32_t errorid) noexcept;
+
+    /*!
+     * Get the description of an error code.
      *
-     * @note This function is only available in debug builds.
+     * The description is looked up in a built-in table of the common Win32, 
+     * DXGI and D3D12 error codes. This function does not allocate.
      *
-     * @see D12W_THROW 
+     * @param errorid either HRESULT or DWORD Win32 error code.
+     * @return the description or an empty string if the code is unknown
      */
-    template <typename Exception> [[noreturn]]
-	void ThrowWithCallstack(const std::string_view func, const std::string_view msg) 
-	{
-		std::stringstream buff;
-		buff << func << ": msg \n";
-		buff << "\n";
-
-		std::vector<StackFrame> stack = StackTrace();
-		buff << "Callstack: \n";
-		for (unsigned int i = 0; i < stack.size(); i++)
-		{
-			buff << "0x" << std::hex << stack[i].address << ": " << stack[i].name << "(" << std::dec << stack[i].line << ") in " << stack[i].module << "\n";
-		}
-
-		throw Exception(buff.str());
-	}
- #endif
+    D12W_EXPORT
+    std::string_view LookupErrorMessage(int32_t errorid) noexcept;
+
+    /*!
+     * Format an error code into a buffer.
+     *
+     * Known codes are written as "NAME: description", all others as
+     * "Unknown error 0x887A0005.". The text is truncated to fit and always
+     * null terminated. This function does not allocate and does not call
+     * into the system, so it is safe to use on the throw path.
+     *
+     * @param errorid either HRESULT or DWORD Win32 error code.
+     * @param buffer the buffer to write to
+     * @param size the size of buffer in characters
+     * @return the length of the text, without the terminator
+     */
+    D12W_EXPORT
+    size_t FormatErrorMessage(int32_t errorid, char* buffer, size_t size) noexcept;
 
     /*!
      * Convert Win32's error code to a string.
      *
      * This utilir function converts a HRESULT or DWORD error code
-     * to a string with the help of FormatMessageA. 
+     * to a string. Known codes are taken from the built-in table and 
+     * prefixed with their name, for all others FormatMessageA is used.
+     * This is too slow for the throw path, use FormatErrorMessage there.
      *
      * @param errorid either HRESULT or DWORD Win32 error code.
      * @return the given error code as human readable string.
@@ -189,21 +338,47 @@ namespace d12w::util
      * @param value the UTF-8 narow string to convert 
      * @return UTF-16 / UCS-2 wide string
      *
-     * @throws std::logic_error if the conversion failed
+     * @throws std::logic_error if value is not valid UTF-8
      */
     D12W_EXPORT
     std::wstring widen(const std::string_view value);
 
+    /*!
+     * Converts UTF-8 narow string to wide UTF-16 / UCS-2 string and appends it.
+     *
+     * The result is sized exactly, if result has sufficient capacity
+     * no memory is allocated.
+     *
+     * @param value the UTF-8 narow string to convert 
+     * @param result the wide string to append to
+     *
+     * @throws std::logic_error if value is not valid UTF-8, result is unchanged
+     */
+    D12W_EXPORT
+    void widen(const std::string_view value, std::wstring& result);
+
     /*!
      * Converts wide UTF-16 / UCS-2 string to UTF-8 narow string.
      *
+     * Unpaired surrogates are replaced with U+FFFD.
+     *
      * @param value the UTF-16 / UCS-2 wide string to convert 
      * @return UTF-8 narow string
-     *
-     * @throws std::logic_error if the conversion failed
      */
     D12W_EXPORT
     std::string narrow(const std::wstring_view value);
+
+    /*!
+     * Converts wide UTF-16 / UCS-2 string to UTF-8 narow string and appends it.
+     *
+     * The result is sized exactly, if result has sufficient capacity
+     * no memory is allocated. Unpaired surrogates are replaced with U+FFFD.
+     *
+     * @param value the UTF-16 / UCS-2 wide string to convert 
+     * @param result the narow string to append to
+     */
+    D12W_EXPORT
+    void narrow(const std::wstring_view value, std::string& result);
 }
 
 #endif
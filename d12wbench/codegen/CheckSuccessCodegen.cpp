@@ -0,0 +1,73 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "CheckSuccessCodegen.h"
+
+#include <d12w/Result.h>
+
+namespace d12w::bench
+{
+    constexpr auto CALLS = 16;
+
+    int CallUnchecked(Call call)
+    {
+        auto sum = 0;
+        for (auto i = 0; i < CALLS; i++)
+        {
+            sum += call(i);
+        }
+        return sum;
+    }
+
+    int CallCheckSuccess(Call call)
+    {
+        auto sum = 0;
+        for (auto i = 0; i < CALLS; i++)
+        {
+            auto hr = call(i);
+            D12W_CHECK_SUCCESS(hr);
+            sum += hr;
+        }
+        return sum;
+    }
+
+    int CallResultValue(Call call)
+    {
+        auto sum = 0;
+        for (auto i = 0; i < CALLS; i++)
+        {
+            auto result = Result<int>{call(i), i};
+            sum += result.Value();
+        }
+        return sum;
+    }
+
+    int CallResultValueOr(Call call)
+    {
+        auto sum = 0;
+        for (auto i = 0; i < CALLS; i++)
+        {
+            auto result = Result<int>{call(i), i};
+            sum += result.ValueOr(0);
+        }
+        return sum;
+    }
+}
@@ -0,0 +1,43 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_BENCH_CHECK_SUCCESS_CODEGEN_H_
+#define _D12W_BENCH_CHECK_SUCCESS_CODEGEN_H_
+
+#include <d12w/defines.h>
+#include <winerror.h>
+
+namespace d12w::bench
+{
+    using Call = HRESULT (*)(int);
+
+    /*
+     * The same sequence of 16 calls with different error handling. They are
+     * compiled into their own object, so that their size can be compared
+     * with the d12wcodegen_size target.
+     */
+    D12W_NOINLINE int CallUnchecked(Call call);
+    D12W_NOINLINE int CallCheckSuccess(Call call);
+    D12W_NOINLINE int CallResultValue(Call call);
+    D12W_NOINLINE int CallResultValueOr(Call call);
+}
+
+#endif
@@ -0,0 +1,82 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+
+#include <mutex>
+
+#include <d12w/AtomicComPtr.h>
+#include <d12wnull/null.h>
+
+using namespace d12w;
+
+namespace
+{
+    AtomicComPtr<ID3D12Fence> atomicFence{null::CreateFence(0).As<ID3D12Fence>()};
+
+    std::mutex          fenceMutex;
+    ComPtr<ID3D12Fence>  lockedFence = null::CreateFence(0).As<ID3D12Fence>();
+}
+
+// all threads load, the reference count is the contended cache line
+static void BM_AtomicComPtrLoad(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        auto fence = atomicFence.Load();
+        benchmark::DoNotOptimize(fence.Get());
+    }
+}
+BENCHMARK(BM_AtomicComPtrLoad)->ThreadRange(1, 8)->UseRealTime();
+
+// the same with a mutex guarded ComPtr, the baseline
+static void BM_MutexComPtrLoad(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        auto fence = ComPtr<ID3D12Fence>{};
+        {
+            std::lock_guard<std::mutex> lock(fenceMutex);
+            fence = lockedFence;
+        }
+        benchmark::DoNotOptimize(fence.Get());
+    }
+}
+BENCHMARK(BM_MutexComPtrLoad)->ThreadRange(1, 8)->UseRealTime();
+
+// thread 0 replaces the value, the others load it
+static void BM_AtomicComPtrLoadWithWriter(benchmark::State& state)
+{
+    auto replacement = null::CreateFence(1).As<ID3D12Fence>();
+    for (auto _ : state)
+    {
+        if (state.thread_index() == 0)
+        {
+            replacement = atomicFence.Exchange(std::move(replacement));
+        }
+        else
+        {
+            auto fence = atomicFence.Load();
+            benchmark::DoNotOptimize(fence.Get());
+        }
+    }
+}
+BENCHMARK(BM_AtomicComPtrLoadWithWriter)->ThreadRange(2, 8)->UseRealTime();
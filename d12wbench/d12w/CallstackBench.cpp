@@ -0,0 +1,110 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+
+#include <stdexcept>
+
+#include <d12w/util.h>
+
+using namespace d12w;
+
+// the baseline, a plain exception from throw to catch
+static void BM_ThrowPlain(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        try
+        {
+            throw std::logic_error("Something went wrong.");
+        }
+        catch (const std::logic_error& ex)
+        {
+            benchmark::DoNotOptimize(&ex);
+        }
+    }
+}
+BENCHMARK(BM_ThrowPlain);
+
+#ifndef NDEBUG
+// throw to catch with the raw callstack, the exception is handled and never symbolized
+static void BM_ThrowWithCallstack(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        try
+        {
+            D12W_THROW(std::logic_error, "Something went wrong.");
+        }
+        catch (const std::logic_error& ex)
+        {
+            benchmark::DoNotOptimize(&ex);
+        }
+    }
+}
+BENCHMARK(BM_ThrowWithCallstack);
+
+// the same when the handler also reads the message, which symbolizes the callstack
+static void BM_ThrowWithCallstackAndWhat(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        try
+        {
+            D12W_THROW(std::logic_error, "Something went wrong.");
+        }
+        catch (const std::logic_error& ex)
+        {
+            benchmark::DoNotOptimize(ex.what());
+        }
+    }
+}
+BENCHMARK(BM_ThrowWithCallstackAndWhat);
+
+static void BM_CaptureCallStack(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        auto stack = util::CaptureCallStack();
+        benchmark::DoNotOptimize(stack.size);
+    }
+}
+BENCHMARK(BM_CaptureCallStack);
+#endif
+
+// a failed HRESULT from D12W_CHECK_SUCCESS to the handler
+static void BM_CheckSuccessFailed(benchmark::State& state)
+{
+    auto hr = E_INVALIDARG;
+    benchmark::DoNotOptimize(hr);
+    for (auto _ : state)
+    {
+        try
+        {
+            D12W_CHECK_SUCCESS(hr);
+        }
+        catch (const std::exception& ex)
+        {
+            benchmark::DoNotOptimize(&ex);
+        }
+    }
+}
+BENCHMARK(BM_CheckSuccessFailed);
@@ -0,0 +1,81 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+
+#include <d12w/dxgi/Adapter.h>
+#include <d12w/dxgi/Factory.h>
+#include <d12wnull/null.h>
+
+#include "../codegen/CheckSuccessCodegen.h"
+
+using namespace d12w;
+
+namespace
+{
+    // out of line, so that the compiler can not prove the HRESULT
+    D12W_NOINLINE HRESULT Succeed(int)
+    {
+        return S_OK;
+    }
+
+    std::shared_ptr<dxgi::Adapter> MakeAdapter()
+    {
+        auto factory = dxgi::Factory{null::CreateFactory({null::MakeAdapterConfig(L"First", 1 << 30, 1)}).As<IDXGIFactory4>()};
+        return factory.EnumAdapters1().front();
+    }
+}
+
+// the success path of 16 calls with different error handling
+template <int (*Function)(bench::Call)>
+static void BM_CheckSuccessPath(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(Function(&Succeed));
+    }
+}
+BENCHMARK_TEMPLATE(BM_CheckSuccessPath, bench::CallUnchecked);
+BENCHMARK_TEMPLATE(BM_CheckSuccessPath, bench::CallCheckSuccess);
+BENCHMARK_TEMPLATE(BM_CheckSuccessPath, bench::CallResultValue);
+BENCHMARK_TEMPLATE(BM_CheckSuccessPath, bench::CallResultValueOr);
+
+static void BM_AdapterGetDesc1(benchmark::State& state)
+{
+    auto adapter = MakeAdapter();
+    for (auto _ : state)
+    {
+        auto desc = adapter->GetDesc1();
+        benchmark::DoNotOptimize(desc.DedicatedVideoMemory);
+    }
+}
+BENCHMARK(BM_AdapterGetDesc1);
+
+static void BM_AdapterTryGetDesc1(benchmark::State& state)
+{
+    auto adapter = MakeAdapter();
+    for (auto _ : state)
+    {
+        auto desc = adapter->TryGetDesc1();
+        benchmark::DoNotOptimize(desc.Succeeded());
+    }
+}
+BENCHMARK(BM_AdapterTryGetDesc1);
@@ -0,0 +1,184 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <d12w/ComPtr.h>
+#include <d12wnull/null.h>
+
+using namespace d12w;
+
+namespace
+{
+    // AddRef and Release are counted by the null backend
+    class RefCounted : public null::Unknown<IUnknown> {};
+
+    ComPtr<RefCounted> MakeObject()
+    {
+        auto result = ComPtr<RefCounted>{};
+        result.Attach(new RefCounted);
+        return result;
+    }
+
+    // a wrapper class that keeps the object it is given
+    class Holder
+    {
+    public:
+        explicit
+        Holder(ComPtr<RefCounted> o)
+        : object(std::move(o)) {}
+
+        ComPtr<RefCounted> Take()
+        {
+            return std::move(object);
+        }
+
+    private:
+        ComPtr<RefCounted> object;
+    };
+
+    void ResetInterlockedOps()
+    {
+        null::ResetCallCounts();
+    }
+
+    void ReportInterlockedOps(benchmark::State& state)
+    {
+        auto ops = null::GetCallCount(null::Call::AddRef) + null::GetCallCount(null::Call::Release);
+        state.counters["interlocked_ops"] = benchmark::Counter(static_cast<double>(ops), benchmark::Counter::kAvgIterations);
+    }
+}
+
+// a hand-off between wrappers by copy, the way it worked before moves
+static void BM_ComPtrHandOffCopy(benchmark::State& state)
+{
+    auto object = MakeObject();
+    ResetInterlockedOps();
+    for (auto _ : state)
+    {
+        const auto& source = object;
+        auto holder = Holder{source};
+        auto taken  = ComPtr<RefCounted>{holder.Take()};
+        object = taken;
+        benchmark::DoNotOptimize(object.Get());
+    }
+    ReportInterlockedOps(state);
+}
+BENCHMARK(BM_ComPtrHandOffCopy);
+
+// the same hand-off with moves, no reference count is touched
+static void BM_ComPtrHandOffMove(benchmark::State& state)
+{
+    auto object = MakeObject();
+    ResetInterlockedOps();
+    for (auto _ : state)
+    {
+        auto holder = Holder{std::move(object)};
+        object = holder.Take();
+        benchmark::DoNotOptimize(object.Get());
+    }
+    ReportInterlockedOps(state);
+}
+BENCHMARK(BM_ComPtrHandOffMove);
+
+// collecting the objects of a frame in a vector that grows, the
+// relocations and hand-offs move, no reference count is touched
+static void BM_ComPtrVectorGrowth(benchmark::State& state)
+{
+    auto objects = std::vector<ComPtr<RefCounted>>{};
+    for (auto i = 0; i < 256; i++)
+    {
+        objects.push_back(MakeObject());
+    }
+
+    ResetInterlockedOps();
+    for (auto _ : state)
+    {
+        auto frame = std::vector<ComPtr<RefCounted>>{};
+        for (auto& object : objects)
+        {
+            frame.push_back(std::move(object));
+        }
+        for (auto i = 0u; i < objects.size(); i++)
+        {
+            objects[i] = std::move(frame[i]);
+        }
+        benchmark::DoNotOptimize(frame.data());
+    }
+    ReportInterlockedOps(state);
+    state.SetItemsProcessed(state.iterations() * objects.size());
+}
+BENCHMARK(BM_ComPtrVectorGrowth);
+
+// returning a freshly wrapped object by value, only the wrap counts
+static void BM_ComPtrReturnByValue(benchmark::State& state)
+{
+    auto object = MakeObject();
+    auto wrap = [&object] () {
+        auto result = ComPtr<RefCounted>{object.Get()};
+        return result;
+    };
+    ResetInterlockedOps();
+    for (auto _ : state)
+    {
+        auto result = wrap();
+        benchmark::DoNotOptimize(result.Get());
+    }
+    ReportInterlockedOps(state);
+}
+BENCHMARK(BM_ComPtrReturnByValue);
+
+// probing for a missing interface with As, the failure is an exception
+static void BM_ComPtrAsProbeThrowing(benchmark::State& state)
+{
+    auto fence = null::CreateFence();
+    for (auto _ : state)
+    {
+        try
+        {
+            auto device = fence.As<ID3D12Device>();
+            benchmark::DoNotOptimize(device.Get());
+        }
+        catch (const std::exception& ex)
+        {
+            benchmark::DoNotOptimize(&ex);
+        }
+    }
+}
+BENCHMARK(BM_ComPtrAsProbeThrowing);
+
+// the same probe with TryAs, the failure is an HRESULT
+static void BM_ComPtrTryAsProbe(benchmark::State& state)
+{
+    auto fence = null::CreateFence();
+    for (auto _ : state)
+    {
+        auto hr = HRESULT{S_OK};
+        auto device = fence.TryAs<ID3D12Device>(&hr);
+        benchmark::DoNotOptimize(device.Get());
+        benchmark::DoNotOptimize(hr);
+    }
+}
+BENCHMARK(BM_ComPtrTryAsProbe);
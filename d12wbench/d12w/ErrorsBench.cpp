@@ -0,0 +1,50 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+
+#include <d12w/util.h>
+
+using namespace d12w;
+
+static void BM_FormatErrorMessage(benchmark::State& state)
+{
+    auto hr = static_cast<HRESULT>(state.range(0));
+    auto buffer = std::array<char, 256>{};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(util::FormatErrorMessage(hr, buffer.data(), buffer.size()));
+    }
+}
+BENCHMARK(BM_FormatErrorMessage)->Arg(DXGI_ERROR_DEVICE_REMOVED)->Arg(0x12345678);
+
+static void BM_GetErrorMessage(benchmark::State& state)
+{
+    auto hr = static_cast<HRESULT>(state.range(0));
+    for (auto _ : state)
+    {
+        auto message = util::GetErrorMessage(hr);
+        benchmark::DoNotOptimize(message.data());
+    }
+}
+BENCHMARK(BM_GetErrorMessage)->Arg(DXGI_ERROR_DEVICE_REMOVED)->Arg(0x12345678);
@@ -0,0 +1,67 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <chrono>
+
+#include <d12w/JobPool.h>
+
+using namespace d12w;
+
+namespace
+{
+    void Spin(std::chrono::nanoseconds duration)
+    {
+        auto end = std::chrono::steady_clock::now() + duration;
+        while (std::chrono::steady_clock::now() < end) {}
+    }
+}
+
+// the overhead of a loop of empty jobs
+static void BM_JobPoolEmptyJobs(benchmark::State& state)
+{
+    auto pool = JobPool{static_cast<unsigned int>(state.range(0))};
+    auto sum  = std::atomic<size_t>{0};
+    for (auto _ : state)
+    {
+        pool.Run(64, [&] (size_t i) {
+            sum.fetch_add(i, std::memory_order_relaxed);
+        });
+    }
+    state.SetItemsProcessed(state.iterations() * 64);
+}
+BENCHMARK(BM_JobPoolEmptyJobs)->Arg(0)->Arg(1)->Arg(4)->Arg(8)->UseRealTime();
+
+// every eighth job takes ten times longer, stealing keeps the workers busy
+static void BM_JobPoolUnevenJobs(benchmark::State& state)
+{
+    auto pool = JobPool{static_cast<unsigned int>(state.range(0))};
+    for (auto _ : state)
+    {
+        pool.Run(64, [] (size_t i) {
+            Spin(std::chrono::microseconds(i % 8 == 0 ? 50 : 5));
+        });
+    }
+    state.SetItemsProcessed(state.iterations() * 64);
+}
+BENCHMARK(BM_JobPoolUnevenJobs)->Arg(0)->Arg(1)->Arg(4)->Arg(8)->UseRealTime();
@@ -0,0 +1,69 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+
+#include <d12w/util.h>
+
+using namespace d12w;
+
+namespace
+{
+    // typical adapter and debug names are ASCII, the mixed case has a non ASCII character every 8
+    std::string MakeUtf8(size_t length, bool mixed)
+    {
+        auto result = std::string{};
+        while (result.size() < length)
+        {
+            result += "Adapter";
+            result += mixed ? "\xC3\xBC" : "_";
+        }
+        return result;
+    }
+}
+
+static void BM_Widen(benchmark::State& state)
+{
+    auto value = MakeUtf8(static_cast<size_t>(state.range(0)), state.range(1) != 0);
+    auto result = std::wstring{};
+    for (auto _ : state)
+    {
+        result.clear();
+        util::widen(value, result);
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * value.size()));
+}
+BENCHMARK(BM_Widen)->ArgsProduct({{16, 128, 4096}, {0, 1}});
+
+static void BM_Narrow(benchmark::State& state)
+{
+    auto value = util::widen(MakeUtf8(static_cast<size_t>(state.range(0)), state.range(1) != 0));
+    auto result = std::string{};
+    for (auto _ : state)
+    {
+        result.clear();
+        util::narrow(value, result);
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * value.size() * sizeof(wchar_t)));
+}
+BENCHMARK(BM_Narrow)->ArgsProduct({{16, 128, 4096}, {0, 1}});
@@ -0,0 +1,63 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+
+#include <d12w/d3d/CommandAllocatorPool.h>
+#include <d12w/d3d/Device.h>
+#include <d12wnull/null.h>
+
+using namespace d12w;
+
+namespace
+{
+    d3d::Device& GetDevice()
+    {
+        static auto device = d3d::Device{null::CreateDevice()};
+        return device;
+    }
+}
+
+// the baseline, a new allocator per command list
+static void BM_CreateCommandAllocator(benchmark::State& state)
+{
+    auto& device = GetDevice();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(device.CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT));
+    }
+}
+BENCHMARK(BM_CreateCommandAllocator);
+
+// every recording thread acquires and releases an allocator per frame
+static void BM_AcquireRelease(benchmark::State& state)
+{
+    static auto pool = d3d::CommandAllocatorPool{GetDevice(), D3D12_COMMAND_LIST_TYPE_DIRECT};
+    auto fenceValue = UINT64{0};
+    for (auto _ : state)
+    {
+        auto allocator = pool.Acquire();
+        benchmark::DoNotOptimize(allocator.Get());
+        pool.Release(std::move(allocator), ++fenceValue);
+        pool.Retire(fenceValue);
+    }
+}
+BENCHMARK(BM_AcquireRelease)->ThreadRange(1, 8)->UseRealTime();
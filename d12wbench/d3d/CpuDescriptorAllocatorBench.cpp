@@ -0,0 +1,111 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+
+#include <mutex>
+#include <vector>
+
+#include <d12w/d3d/CpuDescriptorAllocator.h>
+#include <d12wnull/null.h>
+
+using namespace d12w;
+
+namespace
+{
+    d3d::CpuDescriptorAllocator& GetAllocator()
+    {
+        static auto allocator = d3d::CpuDescriptorAllocator{null::CreateDevice().As<ID3D12Device>(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV};
+        return allocator;
+    }
+
+    // the baseline, a free list behind a mutex
+    struct LockedFreeList
+    {
+        std::mutex            mutex;
+        std::vector<uint32_t> free;
+        uint32_t              next = 0;
+
+        uint32_t Allocate()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (free.empty())
+            {
+                return next++;
+            }
+            auto index = free.back();
+            free.pop_back();
+            return index;
+        }
+
+        void Free(uint32_t index)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            free.push_back(index);
+        }
+    };
+
+    LockedFreeList lockedFreeList;
+}
+
+// views created and destroyed on every thread, mostly served by the thread cache
+static void BM_CpuDescriptorAllocateFree(benchmark::State& state)
+{
+    auto& allocator = GetAllocator();
+    for (auto _ : state)
+    {
+        auto descriptor = allocator.Allocate();
+        benchmark::DoNotOptimize(descriptor.handle.ptr);
+        allocator.Free(descriptor);
+    }
+}
+BENCHMARK(BM_CpuDescriptorAllocateFree)->ThreadRange(1, 8)->UseRealTime();
+
+// bursts larger than the thread cache, which go through the shared free list
+static void BM_CpuDescriptorAllocateBurst(benchmark::State& state)
+{
+    auto& allocator = GetAllocator();
+    auto descriptors = std::vector<d3d::CpuDescriptor>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        for (auto& descriptor : descriptors)
+        {
+            descriptor = allocator.Allocate();
+        }
+        for (const auto& descriptor : descriptors)
+        {
+            allocator.Free(descriptor);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CpuDescriptorAllocateBurst)->Arg(256)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_LockedFreeListAllocateFree(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        auto index = lockedFreeList.Allocate();
+        benchmark::DoNotOptimize(index);
+        lockedFreeList.Free(index);
+    }
+}
+BENCHMARK(BM_LockedFreeListAllocateFree)->ThreadRange(1, 8)->UseRealTime();
@@ -0,0 +1,91 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+
+#include <d12w/d3d/DeferredReleaseQueue.h>
+#include <d12wnull/Unknown.h>
+
+using namespace d12w;
+
+namespace
+{
+    // an object whose final release takes as long as freeing driver memory
+    class Heavy : public null::Unknown<IUnknown>
+    {
+    public:
+        ~Heavy()
+        {
+            auto end = std::chrono::steady_clock::now() + std::chrono::microseconds(2);
+            while (std::chrono::steady_clock::now() < end) {}
+        }
+    };
+
+    class Light : public null::Unknown<IUnknown> {};
+
+    ComPtr<Heavy> MakeHeavy()
+    {
+        auto result = ComPtr<Heavy>{};
+        result.Attach(new Heavy);
+        return result;
+    }
+}
+
+// the time a frame that releases 100 objects spends on the render thread,
+// argument 1 releases them on the queue's thread
+static void BM_DeferredReleaseFrame(benchmark::State& state)
+{
+    auto queue = d3d::DeferredReleaseQueue{state.range(0) != 0};
+    auto fenceValue = UINT64{0};
+    for (auto _ : state)
+    {
+        fenceValue++;
+        for (auto i = 0; i < 100; i++)
+        {
+            state.PauseTiming();
+            auto object = MakeHeavy();
+            state.ResumeTiming();
+            queue.Release(std::move(object), fenceValue);
+        }
+        queue.Retire(fenceValue - 1);
+    }
+    queue.Flush();
+    state.SetItemsProcessed(state.iterations() * 100);
+}
+BENCHMARK(BM_DeferredReleaseFrame)->Arg(0)->Arg(1);
+
+static void BM_DeferredReleasePush(benchmark::State& state)
+{
+    static auto queue = d3d::DeferredReleaseQueue{};
+    auto object = ComPtr<Light>{};
+    object.Attach(new Light);
+    for (auto _ : state)
+    {
+        queue.Release(object, 0);
+    }
+    if (state.thread_index() == 0)
+    {
+        queue.Retire(0);
+    }
+}
+BENCHMARK(BM_DeferredReleasePush)->ThreadRange(1, 8)->UseRealTime();
@@ -0,0 +1,137 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include <d12w/d3d/DescriptorCopyBatcher.h>
+#include <d12w/d3d/Device.h>
+#include <d12wnull/null.h>
+
+using namespace d12w;
+
+namespace
+{
+    constexpr auto TYPE = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+
+    // descriptors per material, per draw constants and draws per frame
+    constexpr auto TEXTURES  = 6u;
+    constexpr auto CONSTANTS = 2u;
+    constexpr auto DRAWS     = 1000u;
+    constexpr auto MATERIALS = 200u;
+
+    struct Copy
+    {
+        D3D12_CPU_DESCRIPTOR_HANDLE dest;
+        D3D12_CPU_DESCRIPTOR_HANDLE src;
+    };
+
+    // one table per draw, the textures of the material are next to each
+    // other in the staging heap, the constants are scattered
+    struct Frame
+    {
+        d3d::Device                  device{null::CreateDevice()};
+        ComPtr<ID3D12DescriptorHeap> src;
+        ComPtr<ID3D12DescriptorHeap> dest;
+        std::vector<Copy>            copies;
+
+        Frame()
+        {
+            auto count = MATERIALS * TEXTURES + DRAWS * CONSTANTS;
+            auto desc = D3D12_DESCRIPTOR_HEAP_DESC{};
+            desc.Type           = TYPE;
+            desc.NumDescriptors = count;
+            src  = device.CreateDescriptorHeap(desc);
+            desc.NumDescriptors = DRAWS * (TEXTURES + CONSTANTS);
+            dest = device.CreateDescriptorHeap(desc);
+
+            auto increment = SIZE_T{device.GetDescriptorHandleIncrementSize(TYPE)};
+            auto srcStart  = src->GetCPUDescriptorHandleForHeapStart().ptr;
+            auto destStart = dest->GetCPUDescriptorHandleForHeapStart().ptr;
+
+            auto rng = std::mt19937{7};
+            auto slot = SIZE_T{0};
+            for (auto draw = 0u; draw < DRAWS; draw++)
+            {
+                auto material = rng() % MATERIALS;
+                for (auto i = 0u; i < TEXTURES; i++)
+                {
+                    copies.push_back({{destStart + slot++ * increment}, {srcStart + (material * TEXTURES + i) * increment}});
+                }
+                for (auto i = 0u; i < CONSTANTS; i++)
+                {
+                    auto constant = MATERIALS * TEXTURES + rng() % (DRAWS * CONSTANTS);
+                    copies.push_back({{destStart + slot++ * increment}, {srcStart + constant * increment}});
+                }
+            }
+        }
+    };
+
+    Frame& GetFrame()
+    {
+        static auto frame = Frame{};
+        return frame;
+    }
+}
+
+// the baseline, one CopyDescriptorsSimple per descriptor
+static void BM_CopyDescriptorsSimple(benchmark::State& state)
+{
+    auto& frame = GetFrame();
+    null::ResetCallCounts();
+    for (auto _ : state)
+    {
+        for (const auto& copy : frame.copies)
+        {
+            frame.device.CopyDescriptorsSimple(1, copy.dest, copy.src, TYPE);
+        }
+    }
+    auto calls = null::GetCallCount(null::Call::CopyDescriptors);
+    state.counters["calls_per_frame"] = static_cast<double>(calls) / state.iterations();
+    state.counters["calls_saved"]     = 0;
+    state.SetItemsProcessed(state.iterations() * frame.copies.size());
+}
+BENCHMARK(BM_CopyDescriptorsSimple);
+
+// the same copies through the batcher, flushed once per frame; the null
+// device calls cost next to nothing, so the time is the overhead of the
+// batcher and calls_saved is what a driver would not have to process
+static void BM_DescriptorCopyBatcher(benchmark::State& state)
+{
+    auto& frame = GetFrame();
+    auto batcher = d3d::DescriptorCopyBatcher{frame.device, TYPE};
+    null::ResetCallCounts();
+    for (auto _ : state)
+    {
+        for (const auto& copy : frame.copies)
+        {
+            batcher.Add(copy.dest, copy.src);
+        }
+        batcher.Flush();
+    }
+    auto calls = null::GetCallCount(null::Call::CopyDescriptors);
+    state.counters["calls_per_frame"] = static_cast<double>(calls) / state.iterations();
+    state.counters["calls_saved"]     = static_cast<double>(frame.copies.size()) - static_cast<double>(calls) / state.iterations();
+    state.SetItemsProcessed(state.iterations() * frame.copies.size());
+}
+BENCHMARK(BM_DescriptorCopyBatcher);
@@ -0,0 +1,75 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+
+#include <d12w/d3d/FrameGraph.h>
+
+using namespace d12w;
+
+// a frame with half as many transient resources as passes, each pass
+// reads up to three recent resources and writes one new or recent one
+static void BM_FrameGraphCompile(benchmark::State& state)
+{
+    constexpr D3D12_RESOURCE_STATES READS[] = {
+        D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_COPY_SOURCE
+    };
+    constexpr D3D12_RESOURCE_STATES WRITES[] = {
+        D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_DEST
+    };
+
+    auto rng       = std::mt19937{7};
+    auto passes    = static_cast<uint32_t>(state.range(0));
+    auto resources = passes / 2;
+    auto graph     = d3d::FrameGraph{};
+    for (auto r = 0u; r < resources; r++)
+    {
+        auto size = (1 + rng() % 64) * 65536;
+        graph.CreateResource(size, 65536, static_cast<uint32_t>(rng() % 3));
+    }
+    auto output = graph.ImportResource(D3D12_RESOURCE_STATE_PRESENT);
+
+    for (auto p = 0u; p < passes; p++)
+    {
+        auto center   = p * resources / passes;
+        auto accesses = std::vector<d3d::FrameGraphAccess>{};
+        for (auto i = 0u; i < 3 && i < center; i++)
+        {
+            accesses.push_back({center - 1 - static_cast<uint32_t>(rng() % std::min(center, 16u)), READS[rng() % 3], false});
+        }
+        accesses.push_back({center, WRITES[rng() % 3], true});
+        if (p % 64 == 63)
+        {
+            accesses.push_back({output, D3D12_RESOURCE_STATE_RENDER_TARGET, true});
+        }
+        graph.AddPass(std::move(accesses));
+    }
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(graph.Compile());
+    }
+    state.SetItemsProcessed(state.iterations() * passes);
+}
+BENCHMARK(BM_FrameGraphCompile)->Arg(1000)->Arg(5000)->Arg(10000);
@@ -0,0 +1,52 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+
+#include <d12w/d3d/Device.h>
+#include <d12w/d3d/ParallelRecorder.h>
+#include <d12wnull/null.h>
+
+using namespace d12w;
+
+// a frame of 10000 draws in chunks of 256, the argument is the number of workers
+static void BM_ParallelRecordFrame(benchmark::State& state)
+{
+    auto device     = d3d::Device{null::CreateDevice()};
+    auto queue      = d3d::CommandQueue{device, D3D12_COMMAND_LIST_TYPE_DIRECT};
+    auto allocators = d3d::CommandAllocatorPool{device, D3D12_COMMAND_LIST_TYPE_DIRECT};
+    auto jobs       = JobPool{static_cast<unsigned int>(state.range(0))};
+    auto recorder   = d3d::ParallelRecorder{device, allocators, jobs};
+
+    auto record = [] (d3d::CommandList& list, size_t begin, size_t end) {
+        for (auto i = begin; i < end; i++)
+        {
+            list.DrawInstanced(3, 1, 0, static_cast<UINT>(i));
+        }
+    };
+    for (auto _ : state)
+    {
+        recorder.Record(queue, 10000, 256, record);
+        allocators.Retire(queue.GetCompletedValue());
+    }
+    state.SetItemsProcessed(state.iterations() * 10000);
+}
+BENCHMARK(BM_ParallelRecordFrame)->Arg(0)->Arg(1)->Arg(4)->Arg(8)->UseRealTime();
@@ -0,0 +1,54 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+
+#include <d12w/d3d/QueueGraph.h>
+
+using namespace d12w;
+
+// a frame graph sized workload on three queues, each item depends on up
+// to three of the 50 items before it
+static void BM_QueueGraphCompile(benchmark::State& state)
+{
+    auto rng   = std::mt19937{7};
+    auto count = static_cast<uint32_t>(state.range(0));
+    auto graph = d3d::QueueGraph{3};
+    for (auto i = 0u; i < count; i++)
+    {
+        auto dependencies = std::vector<uint32_t>{};
+        for (auto k = 1u; k <= 3 && k <= i; k++)
+        {
+            dependencies.push_back(i - 1 - rng() % std::min(i, 50u));
+        }
+        graph.Add(rng() % 3, dependencies);
+    }
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(graph.Compile());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_QueueGraphCompile)->Arg(100)->Arg(1000)->Arg(10000);
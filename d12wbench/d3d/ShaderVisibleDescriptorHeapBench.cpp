@@ -0,0 +1,98 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+
+#include <d12w/d3d/ShaderVisibleDescriptorHeap.h>
+#include <d12wnull/null.h>
+
+using namespace d12w;
+
+namespace
+{
+    constexpr auto RING_SIZE = 1u << 20;
+
+    d3d::ShaderVisibleDescriptorHeap& GetHeap()
+    {
+        static auto heap = d3d::ShaderVisibleDescriptorHeap{null::CreateDevice().As<ID3D12Device>(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, 1024, RING_SIZE};
+        return heap;
+    }
+}
+
+// per draw tables allocated from all recording threads
+static void BM_AllocateTransient(benchmark::State& state)
+{
+    auto& heap = GetHeap();
+    if (state.thread_index() == 0)
+    {
+        heap.FinishFrame(0);
+        heap.Retire(0);
+    }
+
+    auto allocated = 0u;
+    for (auto _ : state)
+    {
+        auto range = heap.AllocateTransient(4);
+        benchmark::DoNotOptimize(range.gpu.ptr);
+
+        // every thread closes and retires its frames, so that the shared ring never fills up
+        if (++allocated == RING_SIZE / 4 / 64)
+        {
+            state.PauseTiming();
+            allocated = 0;
+            heap.FinishFrame(0);
+            heap.Retire(0);
+            state.ResumeTiming();
+        }
+    }
+}
+BENCHMARK(BM_AllocateTransient)->ThreadRange(1, 8)->UseRealTime();
+
+// a frame of 1000 draws, closed and retired
+static void BM_TransientFrame(benchmark::State& state)
+{
+    auto heap = d3d::ShaderVisibleDescriptorHeap{null::CreateDevice().As<ID3D12Device>(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, 0, 65536};
+    auto fenceValue = UINT64{0};
+    for (auto _ : state)
+    {
+        for (auto i = 0; i < 1000; i++)
+        {
+            benchmark::DoNotOptimize(heap.AllocateTransient(8).index);
+        }
+        heap.FinishFrame(++fenceValue);
+        heap.Retire(fenceValue);
+    }
+    state.SetItemsProcessed(state.iterations() * 1000);
+}
+BENCHMARK(BM_TransientFrame);
+
+static void BM_PersistentAllocateFree(benchmark::State& state)
+{
+    auto heap = d3d::ShaderVisibleDescriptorHeap{null::CreateDevice().As<ID3D12Device>(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, 65536, 0};
+    auto fenceValue = UINT64{0};
+    for (auto _ : state)
+    {
+        auto range = heap.AllocatePersistent(16);
+        heap.FreePersistent(range, ++fenceValue);
+        heap.Retire(fenceValue);
+    }
+}
+BENCHMARK(BM_PersistentAllocateFree);
@@ -0,0 +1,119 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+
+#include <d12w/d3d/CommandQueue.h>
+#include <d12w/d3d/Device.h>
+#include <d12w/d3d/SubmissionQueue.h>
+#include <d12wnull/null.h>
+
+using namespace d12w;
+
+namespace
+{
+    // the fixed driver cost of an ExecuteCommandLists call
+    constexpr auto EXECUTE_COST = std::chrono::microseconds(20);
+
+    class FixedCostQueue : public null::CommandQueue
+    {
+    public:
+        FixedCostQueue(ComPtr<ID3D12Device> device, const D3D12_COMMAND_QUEUE_DESC& desc)
+        : null::CommandQueue(std::move(device), desc) {}
+
+        void STDMETHODCALLTYPE ExecuteCommandLists(UINT NumCommandLists, ID3D12CommandList* const* ppCommandLists) override
+        {
+            auto end = std::chrono::steady_clock::now() + EXECUTE_COST;
+            while (std::chrono::steady_clock::now() < end) {}
+            null::CommandQueue::ExecuteCommandLists(NumCommandLists, ppCommandLists);
+        }
+    };
+
+    struct Setup
+    {
+        ComPtr<ID3D12Device2>             nullDevice = null::CreateDevice();
+        d3d::Device                       device{nullDevice};
+        d3d::CommandQueue                 queue{MakeQueue(nullDevice), null::CreateFence()};
+        ComPtr<ID3D12GraphicsCommandList> list;
+
+        Setup()
+        {
+            auto allocator = device.CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT);
+            list = device.CreateCommandList(D3D12_COMMAND_LIST_TYPE_DIRECT, allocator.Get());
+            list->Close();
+        }
+
+        static ComPtr<ID3D12CommandQueue> MakeQueue(ComPtr<ID3D12Device2> device)
+        {
+            auto desc = D3D12_COMMAND_QUEUE_DESC{};
+            desc.Type = D3D12_COMMAND_LIST_TYPE_DIRECT;
+            auto queue = ComPtr<ID3D12CommandQueue>{};
+            queue.Attach(new FixedCostQueue(device, desc));
+            return queue;
+        }
+    };
+
+    Setup& GetSetup()
+    {
+        static auto setup = Setup{};
+        return setup;
+    }
+}
+
+// the baseline, every thread submits on its own and pays the fixed cost
+static void BM_SubmitDirect(benchmark::State& state)
+{
+    auto& setup = GetSetup();
+    auto list = static_cast<ID3D12CommandList*>(setup.list.Get());
+    for (auto _ : state)
+    {
+        setup.queue.ExecuteCommandLists(1, &list);
+        benchmark::DoNotOptimize(setup.queue.Signal());
+    }
+}
+BENCHMARK(BM_SubmitDirect)->ThreadRange(1, 8)->UseRealTime();
+
+// the submissions of all threads are combined into one call, each thread waits for its fence value
+static void BM_SubmitBatched(benchmark::State& state)
+{
+    static auto submissions = static_cast<d3d::SubmissionQueue*>(nullptr);
+    auto& setup = GetSetup();
+    if (state.thread_index() == 0)
+    {
+        submissions = new d3d::SubmissionQueue{setup.queue};
+    }
+
+    auto list = static_cast<ID3D12CommandList*>(setup.list.Get());
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(submissions->Submit(1, &list).get());
+    }
+
+    if (state.thread_index() == 0)
+    {
+        auto stats = submissions->GetStats();
+        state.counters["lists_per_call"] = static_cast<double>(stats.submissions) / static_cast<double>(stats.calls);
+        delete submissions;
+    }
+}
+BENCHMARK(BM_SubmitBatched)->ThreadRange(1, 8)->UseRealTime();
@@ -0,0 +1,99 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include <d12w/d3d/TlsfAllocator.h>
+
+using namespace d12w;
+
+namespace
+{
+    constexpr auto HEAP_SIZE = uint64_t{256} << 20;
+}
+
+// the best case, the block is split and merged again
+static void BM_TlsfAllocateFree(benchmark::State& state)
+{
+    auto allocator = d3d::TlsfAllocator{HEAP_SIZE};
+    for (auto _ : state)
+    {
+        auto allocation = allocator.Allocate(65536, 65536);
+        benchmark::DoNotOptimize(allocation.offset);
+        allocator.Free(allocation);
+    }
+}
+BENCHMARK(BM_TlsfAllocateFree);
+
+// texture sized allocations in random order, the heap is fragmented
+static void BM_TlsfMixedSizes(benchmark::State& state)
+{
+    auto allocator = d3d::TlsfAllocator{HEAP_SIZE};
+    auto rng       = std::mt19937{42};
+    auto sizes     = std::vector<uint64_t>(1000);
+    for (auto& size : sizes)
+    {
+        size = 4096 + (rng() % 64) * 4096;
+    }
+
+    auto allocations = std::vector<d3d::TlsfAllocation>(sizes.size());
+    for (auto _ : state)
+    {
+        for (auto i = 0u; i < sizes.size(); i++)
+        {
+            allocations[i] = allocator.Allocate(sizes[i], 4096);
+        }
+        // free every other first, so that merging happens in both directions
+        for (auto i = 0u; i < allocations.size(); i += 2)
+        {
+            allocator.Free(allocations[i]);
+        }
+        for (auto i = 1u; i < allocations.size(); i += 2)
+        {
+            allocator.Free(allocations[i]);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * sizes.size());
+}
+BENCHMARK(BM_TlsfMixedSizes);
+
+static void BM_TlsfGetStats(benchmark::State& state)
+{
+    auto allocator = d3d::TlsfAllocator{HEAP_SIZE};
+    auto allocations = std::vector<d3d::TlsfAllocation>{};
+    for (auto i = 0; i < 1000; i++)
+    {
+        allocations.push_back(allocator.Allocate(65536));
+    }
+    for (auto i = 0u; i < allocations.size(); i += 2)
+    {
+        allocator.Free(allocations[i]);
+    }
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(allocator.GetStats());
+    }
+}
+BENCHMARK(BM_TlsfGetStats);
@@ -0,0 +1,91 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+
+#include <d12w/d3d/Device.h>
+#include <d12w/d3d/UploadRing.h>
+#include <d12wnull/null.h>
+
+using namespace d12w;
+
+namespace
+{
+    constexpr auto RING_SIZE = UINT64{64} << 20;
+
+    d3d::UploadRing& GetRing()
+    {
+        static auto device = d3d::Device{null::CreateDevice()};
+        static auto ring   = d3d::UploadRing{device, RING_SIZE};
+        return ring;
+    }
+}
+
+// per draw constants allocated from all recording threads
+static void BM_UploadAllocate(benchmark::State& state)
+{
+    auto& ring = GetRing();
+    if (state.thread_index() == 0)
+    {
+        ring.FinishFrame(0);
+        ring.Retire(0);
+    }
+
+    auto allocated = 0u;
+    for (auto _ : state)
+    {
+        auto allocation = ring.Allocate(256);
+        benchmark::DoNotOptimize(allocation.gpu);
+
+        // every thread closes and retires its frames, so that the shared ring never fills up
+        if (++allocated == RING_SIZE / 256 / 64)
+        {
+            state.PauseTiming();
+            allocated = 0;
+            ring.FinishFrame(0);
+            ring.Retire(0);
+            state.ResumeTiming();
+        }
+    }
+}
+BENCHMARK(BM_UploadAllocate)->ThreadRange(1, 8)->UseRealTime();
+
+// a frame of 1000 draws with a 4x4 matrix each, closed and retired
+static void BM_UploadFrame(benchmark::State& state)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    auto ring   = d3d::UploadRing{device, 1024 * 1024};
+    auto matrix = std::array<float, 16>{};
+    auto fenceValue = UINT64{0};
+    for (auto _ : state)
+    {
+        for (auto i = 0; i < 1000; i++)
+        {
+            benchmark::DoNotOptimize(ring.Upload(matrix.data(), sizeof(matrix)).gpu);
+        }
+        ring.FinishFrame(++fenceValue);
+        ring.Retire(fenceValue);
+    }
+    state.SetItemsProcessed(state.iterations() * 1000);
+}
+BENCHMARK(BM_UploadFrame);
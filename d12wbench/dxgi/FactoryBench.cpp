@@ -0,0 +1,74 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+
+#include <d12w/dxgi/Factory.h>
+#include <d12wnull/null.h>
+
+using namespace d12w;
+
+namespace
+{
+    std::vector<null::AdapterConfig> MakeAdapters()
+    {
+        return {
+            null::MakeAdapterConfig(L"Integrated", 512 << 20, 1),
+            null::MakeAdapterConfig(L"Discrete", 8u << 30, 2),
+            null::MakeAdapterConfig(L"Software", 0, 3, true)
+        };
+    }
+}
+
+// repeated ranking without IDXGIFactory6, with a driver that takes 100us per adapter
+static void BM_FactoryEnumAdapterByGpuPreferenceFallback(benchmark::State& state)
+{
+    auto factory = dxgi::Factory{null::CreateFactory4(MakeAdapters(), std::chrono::microseconds(100))};
+    for (auto _ : state)
+    {
+        auto adapters = factory.EnumAdapterByGpuPreference(DXGI_GPU_PREFERENCE_HIGH_PERFORMANCE);
+        benchmark::DoNotOptimize(adapters.data());
+    }
+}
+BENCHMARK(BM_FactoryEnumAdapterByGpuPreferenceFallback);
+
+static void BM_FactoryEnumAdapterByGpuPreference(benchmark::State& state)
+{
+    auto factory = dxgi::Factory{null::CreateFactory(MakeAdapters(), std::chrono::microseconds(100)).As<IDXGIFactory4>()};
+    for (auto _ : state)
+    {
+        auto adapters = factory.EnumAdapterByGpuPreference(DXGI_GPU_PREFERENCE_HIGH_PERFORMANCE);
+        benchmark::DoNotOptimize(adapters.data());
+    }
+}
+BENCHMARK(BM_FactoryEnumAdapterByGpuPreference);
+
+// the first call of a fresh factory, which has to enumerate and rank
+static void BM_FactoryEnumAdapterByGpuPreferenceCold(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        auto factory = dxgi::Factory{null::CreateFactory4(MakeAdapters(), std::chrono::microseconds(100))};
+        auto adapters = factory.EnumAdapterByGpuPreference(DXGI_GPU_PREFERENCE_HIGH_PERFORMANCE);
+        benchmark::DoNotOptimize(adapters.data());
+    }
+}
+BENCHMARK(BM_FactoryEnumAdapterByGpuPreferenceCold);
@@ -0,0 +1,70 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+
+#include <d12w/dxgi/Factory.h>
+#include <d12wnull/null.h>
+
+using namespace d12w;
+
+namespace
+{
+    std::vector<null::AdapterConfig> MakeAdapters()
+    {
+        return {null::MakeAdapterConfig(L"First", 1 << 30, 1), null::MakeAdapterConfig(L"Second", 2 << 30, 2)};
+    }
+}
+
+// the cost of a raw call into the backend, the baseline for the wrapper overhead
+static void BM_NullEnumAdapters1(benchmark::State& state)
+{
+    auto factory = null::CreateFactory(MakeAdapters());
+    for (auto _ : state)
+    {
+        auto adapter = ComPtr<IDXGIAdapter1>{};
+        factory->EnumAdapters1(0, adapter.GetAddressOf());
+        benchmark::DoNotOptimize(adapter.Get());
+    }
+}
+BENCHMARK(BM_NullEnumAdapters1);
+
+static void BM_FactoryEnumAdapters1(benchmark::State& state)
+{
+    auto factory = dxgi::Factory{null::CreateFactory(MakeAdapters()).As<IDXGIFactory4>()};
+    for (auto _ : state)
+    {
+        auto adapters = factory.EnumAdapters1();
+        benchmark::DoNotOptimize(adapters.data());
+    }
+    state.counters["calls"] = benchmark::Counter(static_cast<double>(null::GetTotalCallCount()), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_FactoryEnumAdapters1);
+
+static void BM_NullFenceGetCompletedValue(benchmark::State& state)
+{
+    auto fence = null::CreateFence(1);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(fence->GetCompletedValue());
+    }
+}
+BENCHMARK(BM_NullFenceGetCompletedValue);
@@ -19,6 +19,7 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <stdexcept>
 #include <Windows.h>
 
 #include <d12w/d12w.h>
@@ -36,21 +37,12 @@ auto GetAdapter(bool useWarp)
     }
     else
     {
-        auto maxMem = 0u;
-        auto bestAdapter = 0;
-        auto adapters = dxgiFactory.EnumAdapters1();
-        for (auto i = 0u; i < adapters.size(); i++)
+        auto adapters = dxgiFactory.SelectAdapter();
+        if (adapters.empty())
         {
-            auto desc = adapters[i]->GetDesc1();
-            if (desc.Flags & DXGI_ADAPTER_FLAG_SOFTWARE == 0 && 
-                maxMem < desc.DedicatedVideoMemory /*&&
-                d3d::Device::TryCreate(adapters[i])*/)
-            {
-                bestAdapter = i;
-                maxMem = desc.DedicatedVideoMemory;
-            }
+            throw std::runtime_error("No adapter supports Direct3D 12.");
         }
-        return adapters[bestAdapter];
+        return adapters.front();
     }
 }
 
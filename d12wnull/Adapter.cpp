@@ -0,0 +1,163 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Adapter.h"
+
+#include <d12w/dxgi/AdapterSnapshot.h>
+
+namespace d12w::null
+{
+    Adapter::Adapter(ComPtr<IDXGIFactory> parent, const AdapterConfig& config)
+    : parent(std::move(parent)), config(config) {}
+
+    HRESULT Adapter::SetPrivateData(REFGUID Name, UINT DataSize, const void* pData)
+    {
+        return privateData.Set(Name, DataSize, pData);
+    }
+
+    HRESULT Adapter::SetPrivateDataInterface(REFGUID Name, const IUnknown* pUnknown)
+    {
+        Count(Call::SetPrivateData);
+        return E_NOTIMPL;
+    }
+
+    HRESULT Adapter::GetPrivateData(REFGUID Name, UINT* pDataSize, void* pData)
+    {
+        return privateData.Get(Name, pDataSize, pData);
+    }
+
+    HRESULT Adapter::GetParent(REFIID riid, void** ppParent)
+    {
+        Count(Call::GetParent);
+        return parent->QueryInterface(riid, ppParent);
+    }
+
+    HRESULT Adapter::EnumOutputs(UINT Output, IDXGIOutput** ppOutput)
+    {
+        if (ppOutput)
+        {
+            *ppOutput = nullptr;
+        }
+        return DXGI_ERROR_NOT_FOUND;
+    }
+
+    HRESULT Adapter::GetDesc(DXGI_ADAPTER_DESC* pDesc)
+    {
+        Count(Call::GetAdapterDesc);
+        if (pDesc == nullptr)
+        {
+            return E_INVALIDARG;
+        }
+        *pDesc = dxgi::AdapterSnapshot{config.desc, config.driverVersion}.GetDesc();
+        return S_OK;
+    }
+
+    HRESULT Adapter::CheckInterfaceSupport(REFGUID InterfaceName, LARGE_INTEGER* pUMDVersion)
+    {
+        Count(Call::CheckInterfaceSupport);
+        if (InterfaceName != __uuidof(IDXGIDevice))
+        {
+            return DXGI_ERROR_UNSUPPORTED;
+        }
+        if (pUMDVersion)
+        {
+            *pUMDVersion = config.driverVersion;
+        }
+        return S_OK;
+    }
+
+    HRESULT Adapter::GetDesc1(DXGI_ADAPTER_DESC1* pDesc)
+    {
+        Count(Call::GetAdapterDesc);
+        if (pDesc == nullptr)
+        {
+            return E_INVALIDARG;
+        }
+        *pDesc = dxgi::AdapterSnapshot{config.desc, config.driverVersion}.GetDesc1();
+        return S_OK;
+    }
+
+    HRESULT Adapter::GetDesc2(DXGI_ADAPTER_DESC2* pDesc)
+    {
+        Count(Call::GetAdapterDesc);
+        if (pDesc == nullptr)
+        {
+            return E_INVALIDARG;
+        }
+        *pDesc = dxgi::AdapterSnapshot{config.desc, config.driverVersion}.GetDesc2();
+        return S_OK;
+    }
+
+    HRESULT Adapter::RegisterHardwareContentProtectionTeardownStatusEvent(HANDLE hEvent, DWORD* pdwCookie)
+    {
+        return DXGI_ERROR_UNSUPPORTED;
+    }
+
+    void Adapter::UnregisterHardwareContentProtectionTeardownStatus(DWORD dwCookie) {}
+
+    HRESULT Adapter::QueryVideoMemoryInfo(UINT NodeIndex, DXGI_MEMORY_SEGMENT_GROUP MemorySegmentGroup, DXGI_QUERY_VIDEO_MEMORY_INFO* pVideoMemoryInfo)
+    {
+        Count(Call::QueryVideoMemoryInfo);
+        if (NodeIndex != 0 || pVideoMemoryInfo == nullptr)
+        {
+            return DXGI_ERROR_INVALID_CALL;
+        }
+
+        auto local = MemorySegmentGroup == DXGI_MEMORY_SEGMENT_GROUP_LOCAL;
+        *pVideoMemoryInfo = {};
+        pVideoMemoryInfo->Budget = local ? config.desc.DedicatedVideoMemory : config.desc.SharedSystemMemory;
+        pVideoMemoryInfo->AvailableForReservation = pVideoMemoryInfo->Budget / 2;
+        pVideoMemoryInfo->CurrentReservation = reservation[local ? 0 : 1];
+        return S_OK;
+    }
+
+    HRESULT Adapter::SetVideoMemoryReservation(UINT NodeIndex, DXGI_MEMORY_SEGMENT_GROUP MemorySegmentGroup, UINT64 Reservation)
+    {
+        if (NodeIndex != 0)
+        {
+            return DXGI_ERROR_INVALID_CALL;
+        }
+        reservation[MemorySegmentGroup == DXGI_MEMORY_SEGMENT_GROUP_LOCAL ? 0 : 1] = Reservation;
+        return S_OK;
+    }
+
+    HRESULT Adapter::RegisterVideoMemoryBudgetChangeNotificationEvent(HANDLE hEvent, DWORD* pdwCookie)
+    {
+        if (pdwCookie)
+        {
+            *pdwCookie = 0;
+        }
+        return S_OK;
+    }
+
+    void Adapter::UnregisterVideoMemoryBudgetChangeNotification(DWORD dwCookie) {}
+
+    HRESULT Adapter::GetDesc3(DXGI_ADAPTER_DESC3* pDesc)
+    {
+        Count(Call::GetAdapterDesc);
+        if (pDesc == nullptr)
+        {
+            return E_INVALIDARG;
+        }
+        *pDesc = config.desc;
+        return S_OK;
+    }
+}
@@ -0,0 +1,73 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "CommandAllocator.h"
+
+namespace d12w::null
+{
+    CommandAllocator::CommandAllocator(ComPtr<ID3D12Device> device, D3D12_COMMAND_LIST_TYPE type)
+    : device(std::move(device)), type(type) {}
+
+    HRESULT CommandAllocator::GetPrivateData(REFGUID guid, UINT* pDataSize, void* pData)
+    {
+        return privateData.Get(guid, pDataSize, pData);
+    }
+
+    HRESULT CommandAllocator::SetPrivateData(REFGUID guid, UINT DataSize, const void* pData)
+    {
+        return privateData.Set(guid, DataSize, pData);
+    }
+
+    HRESULT CommandAllocator::SetPrivateDataInterface(REFGUID guid, const IUnknown* pData)
+    {
+        Count(Call::SetPrivateData);
+        return E_NOTIMPL;
+    }
+
+    HRESULT CommandAllocator::SetName(LPCWSTR Name)
+    {
+        Count(Call::SetName);
+        auto size = Name ? static_cast<UINT>((wcslen(Name) + 1) * sizeof(wchar_t)) : 0u;
+        return privateData.Set(WKPDID_D3DDebugObjectNameW, size, Name);
+    }
+
+    HRESULT CommandAllocator::GetDevice(REFIID riid, void** ppvDevice)
+    {
+        return device->QueryInterface(riid, ppvDevice);
+    }
+
+    HRESULT CommandAllocator::Reset()
+    {
+        Count(Call::Reset);
+        resetCount.fetch_add(1, std::memory_order_relaxed);
+        return S_OK;
+    }
+
+    D3D12_COMMAND_LIST_TYPE CommandAllocator::GetType() const
+    {
+        return type;
+    }
+
+    UINT64 CommandAllocator::GetResetCount() const
+    {
+        return resetCount.load(std::memory_order_relaxed);
+    }
+}
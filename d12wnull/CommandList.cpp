@@ -0,0 +1,360 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "CommandList.h"
+
+namespace d12w::null
+{
+    CommandList::CommandList(ComPtr<ID3D12Device> device, D3D12_COMMAND_LIST_TYPE type)
+    : device(std::move(device)), type(type) {}
+
+    HRESULT CommandList::GetPrivateData(REFGUID guid, UINT* pDataSize, void* pData)
+    {
+        return privateData.Get(guid, pDataSize, pData);
+    }
+
+    HRESULT CommandList::SetPrivateData(REFGUID guid, UINT DataSize, const void* pData)
+    {
+        return privateData.Set(guid, DataSize, pData);
+    }
+
+    HRESULT CommandList::SetPrivateDataInterface(REFGUID guid, const IUnknown* pData)
+    {
+        Count(Call::SetPrivateData);
+        return E_NOTIMPL;
+    }
+
+    HRESULT CommandList::SetName(LPCWSTR Name)
+    {
+        Count(Call::SetName);
+        auto size = Name ? static_cast<UINT>((wcslen(Name) + 1) * sizeof(wchar_t)) : 0u;
+        return privateData.Set(WKPDID_D3DDebugObjectNameW, size, Name);
+    }
+
+    HRESULT CommandList::GetDevice(REFIID riid, void** ppvDevice)
+    {
+        return device->QueryInterface(riid, ppvDevice);
+    }
+
+    D3D12_COMMAND_LIST_TYPE CommandList::GetType()
+    {
+        return type;
+    }
+
+    HRESULT CommandList::Close()
+    {
+        Count(Call::Close);
+        if (closed)
+        {
+            return E_FAIL;
+        }
+        closed = true;
+        return S_OK;
+    }
+
+    HRESULT CommandList::Reset(ID3D12CommandAllocator* pAllocator, ID3D12PipelineState* pInitialState)
+    {
+        Count(Call::Reset);
+        if (!closed || pAllocator == nullptr)
+        {
+            return E_FAIL;
+        }
+        closed           = false;
+        commandCount     = 0;
+        barrierCallCount = 0;
+        barriers.clear();
+        return S_OK;
+    }
+
+    void CommandList::ClearState(ID3D12PipelineState* pPipelineState)
+    {
+        Record();
+    }
+
+    void CommandList::DrawInstanced(UINT VertexCountPerInstance, UINT InstanceCount, UINT StartVertexLocation, UINT StartInstanceLocation)
+    {
+        Record();
+    }
+
+    void CommandList::DrawIndexedInstanced(UINT IndexCountPerInstance, UINT InstanceCount, UINT StartIndexLocation, INT BaseVertexLocation, UINT StartInstanceLocation)
+    {
+        Record();
+    }
+
+    void CommandList::Dispatch(UINT ThreadGroupCountX, UINT ThreadGroupCountY, UINT ThreadGroupCountZ)
+    {
+        Record();
+    }
+
+    void CommandList::CopyBufferRegion(ID3D12Resource* pDstBuffer, UINT64 DstOffset, ID3D12Resource* pSrcBuffer, UINT64 SrcOffset, UINT64 NumBytes)
+    {
+        Record();
+    }
+
+    void CommandList::CopyTextureRegion(const D3D12_TEXTURE_COPY_LOCATION* pDst, UINT DstX, UINT DstY, UINT DstZ, const D3D12_TEXTURE_COPY_LOCATION* pSrc, const D3D12_BOX* pSrcBox)
+    {
+        Record();
+    }
+
+    void CommandList::CopyResource(ID3D12Resource* pDstResource, ID3D12Resource* pSrcResource)
+    {
+        Record();
+    }
+
+    void CommandList::CopyTiles(ID3D12Resource* pTiledResource, const D3D12_TILED_RESOURCE_COORDINATE* pTileRegionStartCoordinate, const D3D12_TILE_REGION_SIZE* pTileRegionSize, ID3D12Resource* pBuffer, UINT64 BufferStartOffsetInBytes, D3D12_TILE_COPY_FLAGS Flags)
+    {
+        Record();
+    }
+
+    void CommandList::ResolveSubresource(ID3D12Resource* pDstResource, UINT DstSubresource, ID3D12Resource* pSrcResource, UINT SrcSubresource, DXGI_FORMAT Format)
+    {
+        Record();
+    }
+
+    void CommandList::IASetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY PrimitiveTopology)
+    {
+        Record();
+    }
+
+    void CommandList::RSSetViewports(UINT NumViewports, const D3D12_VIEWPORT* pViewports)
+    {
+        Record();
+    }
+
+    void CommandList::RSSetScissorRects(UINT NumRects, const D3D12_RECT* pRects)
+    {
+        Record();
+    }
+
+    void CommandList::OMSetBlendFactor(const FLOAT BlendFactor[4])
+    {
+        Record();
+    }
+
+    void CommandList::OMSetStencilRef(UINT StencilRef)
+    {
+        Record();
+    }
+
+    void CommandList::SetPipelineState(ID3D12PipelineState* pPipelineState)
+    {
+        Record();
+    }
+
+    void CommandList::ResourceBarrier(UINT NumBarriers, const D3D12_RESOURCE_BARRIER* pBarriers)
+    {
+        Count(Call::ResourceBarrier);
+        Record();
+        barrierCallCount++;
+        barriers.insert(barriers.end(), pBarriers, pBarriers + NumBarriers);
+    }
+
+    void CommandList::ExecuteBundle(ID3D12GraphicsCommandList* pCommandList)
+    {
+        Record();
+    }
+
+    void CommandList::SetDescriptorHeaps(UINT NumDescriptorHeaps, ID3D12DescriptorHeap* const* ppDescriptorHeaps)
+    {
+        Record();
+    }
+
+    void CommandList::SetComputeRootSignature(ID3D12RootSignature* pRootSignature)
+    {
+        Record();
+    }
+
+    void CommandList::SetGraphicsRootSignature(ID3D12RootSignature* pRootSignature)
+    {
+        Record();
+    }
+
+    void CommandList::SetComputeRootDescriptorTable(UINT RootParameterIndex, D3D12_GPU_DESCRIPTOR_HANDLE BaseDescriptor)
+    {
+        Record();
+    }
+
+    void CommandList::SetGraphicsRootDescriptorTable(UINT RootParameterIndex, D3D12_GPU_DESCRIPTOR_HANDLE BaseDescriptor)
+    {
+        Record();
+    }
+
+    void CommandList::SetComputeRoot32BitConstant(UINT RootParameterIndex, UINT SrcData, UINT DestOffsetIn32BitValues)
+    {
+        Record();
+    }
+
+    void CommandList::SetGraphicsRoot32BitConstant(UINT RootParameterIndex, UINT SrcData, UINT DestOffsetIn32BitValues)
+    {
+        Record();
+    }
+
+    void CommandList::SetComputeRoot32BitConstants(UINT RootParameterIndex, UINT Num32BitValuesToSet, const void* pSrcData, UINT DestOffsetIn32BitValues)
+    {
+        Record();
+    }
+
+    void CommandList::SetGraphicsRoot32BitConstants(UINT RootParameterIndex, UINT Num32BitValuesToSet, const void* pSrcData, UINT DestOffsetIn32BitValues)
+    {
+        Record();
+    }
+
+    void CommandList::SetComputeRootConstantBufferView(UINT RootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS BufferLocation)
+    {
+        Record();
+    }
+
+    void CommandList::SetGraphicsRootConstantBufferView(UINT RootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS BufferLocation)
+    {
+        Record();
+    }
+
+    void CommandList::SetComputeRootShaderResourceView(UINT RootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS BufferLocation)
+    {
+        Record();
+    }
+
+    void CommandList::SetGraphicsRootShaderResourceView(UINT RootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS BufferLocation)
+    {
+        Record();
+    }
+
+    void CommandList::SetComputeRootUnorderedAccessView(UINT RootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS BufferLocation)
+    {
+        Record();
+    }
+
+    void CommandList::SetGraphicsRootUnorderedAccessView(UINT RootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS BufferLocation)
+    {
+        Record();
+    }
+
+    void CommandList::IASetIndexBuffer(const D3D12_INDEX_BUFFER_VIEW* pView)
+    {
+        Record();
+    }
+
+    void CommandList::IASetVertexBuffers(UINT StartSlot, UINT NumViews, const D3D12_VERTEX_BUFFER_VIEW* pViews)
+    {
+        Record();
+    }
+
+    void CommandList::SOSetTargets(UINT StartSlot, UINT NumViews, const D3D12_STREAM_OUTPUT_BUFFER_VIEW* pViews)
+    {
+        Record();
+    }
+
+    void CommandList::OMSetRenderTargets(UINT NumRenderTargetDescriptors, const D3D12_CPU_DESCRIPTOR_HANDLE* pRenderTargetDescriptors, BOOL RTsSingleHandleToDescriptorRange, const D3D12_CPU_DESCRIPTOR_HANDLE* pDepthStencilDescriptor)
+    {
+        Record();
+    }
+
+    void CommandList::ClearDepthStencilView(D3D12_CPU_DESCRIPTOR_HANDLE DepthStencilView, D3D12_CLEAR_FLAGS ClearFlags, FLOAT Depth, UINT8 Stencil, UINT NumRects, const D3D12_RECT* pRects)
+    {
+        Record();
+    }
+
+    void CommandList::ClearRenderTargetView(D3D12_CPU_DESCRIPTOR_HANDLE RenderTargetView, const FLOAT ColorRGBA[4], UINT NumRects, const D3D12_RECT* pRects)
+    {
+        Record();
+    }
+
+    void CommandList::ClearUnorderedAccessViewUint(D3D12_GPU_DESCRIPTOR_HANDLE ViewGPUHandleInCurrentHeap, D3D12_CPU_DESCRIPTOR_HANDLE ViewCPUHandle, ID3D12Resource* pResource, const UINT Values[4], UINT NumRects, const D3D12_RECT* pRects)
+    {
+        Record();
+    }
+
+    void CommandList::ClearUnorderedAccessViewFloat(D3D12_GPU_DESCRIPTOR_HANDLE ViewGPUHandleInCurrentHeap, D3D12_CPU_DESCRIPTOR_HANDLE ViewCPUHandle, ID3D12Resource* pResource, const FLOAT Values[4], UINT NumRects, const D3D12_RECT* pRects)
+    {
+        Record();
+    }
+
+    void CommandList::DiscardResource(ID3D12Resource* pResource, const D3D12_DISCARD_REGION* pRegion)
+    {
+        Record();
+    }
+
+    void CommandList::BeginQuery(ID3D12QueryHeap* pQueryHeap, D3D12_QUERY_TYPE Type, UINT Index)
+    {
+        Record();
+    }
+
+    void CommandList::EndQuery(ID3D12QueryHeap* pQueryHeap, D3D12_QUERY_TYPE Type, UINT Index)
+    {
+        Record();
+    }
+
+    void CommandList::ResolveQueryData(ID3D12QueryHeap* pQueryHeap, D3D12_QUERY_TYPE Type, UINT StartIndex, UINT NumQueries, ID3D12Resource* pDestinationBuffer, UINT64 AlignedDestinationBufferOffset)
+    {
+        Record();
+    }
+
+    void CommandList::SetPredication(ID3D12Resource* pBuffer, UINT64 AlignedBufferOffset, D3D12_PREDICATION_OP Operation)
+    {
+        Record();
+    }
+
+    void CommandList::SetMarker(UINT Metadata, const void* pData, UINT Size)
+    {
+        Record();
+    }
+
+    void CommandList::BeginEvent(UINT Metadata, const void* pData, UINT Size)
+    {
+        Record();
+    }
+
+    void CommandList::EndEvent()
+    {
+        Record();
+    }
+
+    void CommandList::ExecuteIndirect(ID3D12CommandSignature* pCommandSignature, UINT MaxCommandCount, ID3D12Resource* pArgumentBuffer, UINT64 ArgumentBufferOffset, ID3D12Resource* pCountBuffer, UINT64 CountBufferOffset)
+    {
+        Record();
+    }
+
+    bool CommandList::IsClosed() const
+    {
+        return closed;
+    }
+
+    UINT64 CommandList::GetCommandCount() const
+    {
+        return commandCount;
+    }
+
+    const std::vector<D3D12_RESOURCE_BARRIER>& CommandList::GetBarriers() const
+    {
+        return barriers;
+    }
+
+    UINT64 CommandList::GetBarrierCallCount() const
+    {
+        return barrierCallCount;
+    }
+
+    void CommandList::Record()
+    {
+        Count(Call::RecordCommand);
+        commandCount++;
+    }
+}
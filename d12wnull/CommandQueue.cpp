@@ -0,0 +1,118 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "CommandQueue.h"
+
+#include "Fence.h"
+
+namespace d12w::null
+{
+    CommandQueue::CommandQueue(ComPtr<ID3D12Device> device, const D3D12_COMMAND_QUEUE_DESC& desc, std::chrono::nanoseconds latency)
+    : device(std::move(device)), desc(desc), latency(latency) {}
+
+    HRESULT CommandQueue::GetPrivateData(REFGUID guid, UINT* pDataSize, void* pData)
+    {
+        return privateData.Get(guid, pDataSize, pData);
+    }
+
+    HRESULT CommandQueue::SetPrivateData(REFGUID guid, UINT DataSize, const void* pData)
+    {
+        return privateData.Set(guid, DataSize, pData);
+    }
+
+    HRESULT CommandQueue::SetPrivateDataInterface(REFGUID guid, const IUnknown* pData)
+    {
+        Count(Call::SetPrivateData);
+        return E_NOTIMPL;
+    }
+
+    HRESULT CommandQueue::SetName(LPCWSTR Name)
+    {
+        Count(Call::SetName);
+        auto size = Name ? static_cast<UINT>((wcslen(Name) + 1) * sizeof(wchar_t)) : 0u;
+        return privateData.Set(WKPDID_D3DDebugObjectNameW, size, Name);
+    }
+
+    HRESULT CommandQueue::GetDevice(REFIID riid, void** ppvDevice)
+    {
+        return device->QueryInterface(riid, ppvDevice);
+    }
+
+    void CommandQueue::UpdateTileMappings(ID3D12Resource* pResource, UINT NumResourceRegions, const D3D12_TILED_RESOURCE_COORDINATE* pResourceRegionStartCoordinates, const D3D12_TILE_REGION_SIZE* pResourceRegionSizes, ID3D12Heap* pHeap, UINT NumRanges, const D3D12_TILE_RANGE_FLAGS* pRangeFlags, const UINT* pHeapRangeStartOffsets, const UINT* pRangeTileCounts, D3D12_TILE_MAPPING_FLAGS Flags) {}
+
+    void CommandQueue::CopyTileMappings(ID3D12Resource* pDstResource, const D3D12_TILED_RESOURCE_COORDINATE* pDstRegionStartCoordinate, ID3D12Resource* pSrcResource, const D3D12_TILED_RESOURCE_COORDINATE* pSrcRegionStartCoordinate, const D3D12_TILE_REGION_SIZE* pRegionSize, D3D12_TILE_MAPPING_FLAGS Flags) {}
+
+    void CommandQueue::ExecuteCommandLists(UINT NumCommandLists, ID3D12CommandList* const* ppCommandLists)
+    {
+        Count(Call::ExecuteCommandLists);
+    }
+
+    void CommandQueue::SetMarker(UINT Metadata, const void* pData, UINT Size) {}
+
+    void CommandQueue::BeginEvent(UINT Metadata, const void* pData, UINT Size) {}
+
+    void CommandQueue::EndEvent() {}
+
+    HRESULT CommandQueue::Signal(ID3D12Fence* pFence, UINT64 Value)
+    {
+        // only null fences can be signaled from the null queue
+        auto fence = dynamic_cast<Fence*>(pFence);
+        if (fence == nullptr)
+        {
+            return E_INVALIDARG;
+        }
+
+        if (latency.count() == 0)
+        {
+            return fence->Signal(Value);
+        }
+        Count(Call::Signal);
+        fence->SignalAfter(Value, latency);
+        return S_OK;
+    }
+
+    HRESULT CommandQueue::Wait(ID3D12Fence* pFence, UINT64 Value)
+    {
+        Count(Call::Wait);
+        return pFence != nullptr ? S_OK : E_INVALIDARG;
+    }
+
+    HRESULT CommandQueue::GetTimestampFrequency(UINT64* pFrequency)
+    {
+        if (pFrequency == nullptr)
+        {
+            return E_INVALIDARG;
+        }
+        // timestamps are in nanoseconds
+        *pFrequency = 1000000000;
+        return S_OK;
+    }
+
+    HRESULT CommandQueue::GetClockCalibration(UINT64* pGpuTimestamp, UINT64* pCpuTimestamp)
+    {
+        return E_NOTIMPL;
+    }
+
+    D3D12_COMMAND_QUEUE_DESC CommandQueue::GetDesc()
+    {
+        return desc;
+    }
+}
@@ -0,0 +1,82 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_NULL_COMMAND_QUEUE_H_
+#define _D12W_NULL_COMMAND_QUEUE_H_
+
+#include <chrono>
+#include <d3d12.h>
+
+#include <d12w/ComPtr.h>
+#include "Unknown.h"
+
+namespace d12w::null
+{
+    /*!
+     * Null ID3D12CommandQueue
+     *
+     * Command lists are counted and complete at once. A Signal on a null
+     * fence completes after the latency of the queue, so that code
+     * waiting on fences can be exercised. Wait does not stall the queue.
+     */
+    class CommandQueue : public Unknown<ID3D12CommandQueue, ID3D12Pageable, ID3D12DeviceChild, ID3D12Object>
+    {
+    public:
+        /*!
+         * Create a null command queue.
+         *
+         * @param device the device that created the queue
+         * @param desc the queue description
+         * @param latency the simulated time until a signal is reached, 0 completes signals at once
+         */
+        CommandQueue(ComPtr<ID3D12Device> device, const D3D12_COMMAND_QUEUE_DESC& desc, std::chrono::nanoseconds latency = {});
+
+        // ID3D12Object
+        HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID guid, UINT* pDataSize, void* pData) override;
+        HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID guid, UINT DataSize, const void* pData) override;
+        HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID guid, const IUnknown* pData) override;
+        HRESULT STDMETHODCALLTYPE SetName(LPCWSTR Name) override;
+
+        // ID3D12DeviceChild
+        HRESULT STDMETHODCALLTYPE GetDevice(REFIID riid, void** ppvDevice) override;
+
+        // ID3D12CommandQueue
+        void STDMETHODCALLTYPE UpdateTileMappings(ID3D12Resource* pResource, UINT NumResourceRegions, const D3D12_TILED_RESOURCE_COORDINATE* pResourceRegionStartCoordinates, const D3D12_TILE_REGION_SIZE* pResourceRegionSizes, ID3D12Heap* pHeap, UINT NumRanges, const D3D12_TILE_RANGE_FLAGS* pRangeFlags, const UINT* pHeapRangeStartOffsets, const UINT* pRangeTileCounts, D3D12_TILE_MAPPING_FLAGS Flags) override;
+        void STDMETHODCALLTYPE CopyTileMappings(ID3D12Resource* pDstResource, const D3D12_TILED_RESOURCE_COORDINATE* pDstRegionStartCoordinate, ID3D12Resource* pSrcResource, const D3D12_TILED_RESOURCE_COORDINATE* pSrcRegionStartCoordinate, const D3D12_TILE_REGION_SIZE* pRegionSize, D3D12_TILE_MAPPING_FLAGS Flags) override;
+        void STDMETHODCALLTYPE ExecuteCommandLists(UINT NumCommandLists, ID3D12CommandList* const* ppCommandLists) override;
+        void STDMETHODCALLTYPE SetMarker(UINT Metadata, const void* pData, UINT Size) override;
+        void STDMETHODCALLTYPE BeginEvent(UINT Metadata, const void* pData, UINT Size) override;
+        void STDMETHODCALLTYPE EndEvent() override;
+        HRESULT STDMETHODCALLTYPE Signal(ID3D12Fence* pFence, UINT64 Value) override;
+        HRESULT STDMETHODCALLTYPE Wait(ID3D12Fence* pFence, UINT64 Value) override;
+        HRESULT STDMETHODCALLTYPE GetTimestampFrequency(UINT64* pFrequency) override;
+        HRESULT STDMETHODCALLTYPE GetClockCalibration(UINT64* pGpuTimestamp, UINT64* pCpuTimestamp) override;
+        D3D12_COMMAND_QUEUE_DESC STDMETHODCALLTYPE GetDesc() override;
+
+    private:
+        ComPtr<ID3D12Device>     device;
+        D3D12_COMMAND_QUEUE_DESC desc;
+        std::chrono::nanoseconds latency;
+        PrivateData              privateData;
+    };
+}
+
+#endif
@@ -0,0 +1,112 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Debug.h"
+
+namespace d12w::null
+{
+    HRESULT Debug::QueryInterface(REFIID riid, void** object)
+    {
+        Count(Call::QueryInterface);
+        if (object == nullptr)
+        {
+            return E_POINTER;
+        }
+
+        if (riid == __uuidof(IUnknown) || riid == __uuidof(ID3D12Debug1))
+        {
+            *object = static_cast<ID3D12Debug1*>(this);
+        }
+        else if (riid == __uuidof(ID3D12Debug2))
+        {
+            *object = static_cast<ID3D12Debug2*>(this);
+        }
+        else
+        {
+            *object = nullptr;
+            return E_NOINTERFACE;
+        }
+
+        AddRef();
+        return S_OK;
+    }
+
+    ULONG Debug::AddRef()
+    {
+        Count(Call::AddRef);
+        return ++refCount;
+    }
+
+    ULONG Debug::Release()
+    {
+        Count(Call::Release);
+        auto count = --refCount;
+        if (count == 0)
+        {
+            delete this;
+        }
+        return count;
+    }
+
+    void Debug::EnableDebugLayer()
+    {
+        Count(Call::EnableDebugLayer);
+        debugLayer = true;
+    }
+
+    void Debug::SetEnableGPUBasedValidation(BOOL Enable)
+    {
+        Count(Call::SetDebugSetting);
+        gpuBasedValidation = Enable != FALSE;
+    }
+
+    void Debug::SetEnableSynchronizedCommandQueueValidation(BOOL Enable)
+    {
+        Count(Call::SetDebugSetting);
+        synchronizedCommandQueueValidation = Enable != FALSE;
+    }
+
+    void Debug::SetGPUBasedValidationFlags(D3D12_GPU_BASED_VALIDATION_FLAGS Flags)
+    {
+        Count(Call::SetDebugSetting);
+        gpuBasedValidationFlags = Flags;
+    }
+
+    bool Debug::IsDebugLayerEnabled() const
+    {
+        return debugLayer;
+    }
+
+    bool Debug::IsGPUBasedValidationEnabled() const
+    {
+        return gpuBasedValidation;
+    }
+
+    bool Debug::IsSynchronizedCommandQueueValidationEnabled() const
+    {
+        return synchronizedCommandQueueValidation;
+    }
+
+    D3D12_GPU_BASED_VALIDATION_FLAGS Debug::GetGPUBasedValidationFlags() const
+    {
+        return gpuBasedValidationFlags;
+    }
+}
@@ -0,0 +1,71 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_NULL_DEBUG_H_
+#define _D12W_NULL_DEBUG_H_
+
+#include <atomic>
+#include <d3d12.h>
+
+#include "Unknown.h"
+
+namespace d12w::null
+{
+    /*!
+     * Null ID3D12Debug1 and ID3D12Debug2
+     *
+     * The debug settings are only recorded, so that they can be inspected.
+     */
+    class Debug : public ID3D12Debug1, public ID3D12Debug2
+    {
+    public:
+        Debug() = default;
+
+        // IUnknown
+        HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** object) override;
+        ULONG STDMETHODCALLTYPE AddRef() override;
+        ULONG STDMETHODCALLTYPE Release() override;
+
+        // ID3D12Debug1
+        void STDMETHODCALLTYPE EnableDebugLayer() override;
+        void STDMETHODCALLTYPE SetEnableGPUBasedValidation(BOOL Enable) override;
+        void STDMETHODCALLTYPE SetEnableSynchronizedCommandQueueValidation(BOOL Enable) override;
+
+        // ID3D12Debug2
+        void STDMETHODCALLTYPE SetGPUBasedValidationFlags(D3D12_GPU_BASED_VALIDATION_FLAGS Flags) override;
+
+        bool IsDebugLayerEnabled() const;
+        bool IsGPUBasedValidationEnabled() const;
+        bool IsSynchronizedCommandQueueValidationEnabled() const;
+        D3D12_GPU_BASED_VALIDATION_FLAGS GetGPUBasedValidationFlags() const;
+
+    private:
+        std::atomic<ULONG>               refCount = 1;
+        bool                             debugLayer = false;
+        bool                             gpuBasedValidation = false;
+        bool                             synchronizedCommandQueueValidation = true;
+        D3D12_GPU_BASED_VALIDATION_FLAGS gpuBasedValidationFlags = D3D12_GPU_BASED_VALIDATION_FLAGS_NONE;
+
+        virtual ~Debug() = default;
+    };
+}
+
+#endif
@@ -0,0 +1,82 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "DescriptorHeap.h"
+
+#include "GpuAddress.h"
+
+namespace d12w::null
+{
+    DescriptorHeap::DescriptorHeap(ComPtr<ID3D12Device> device, const D3D12_DESCRIPTOR_HEAP_DESC& desc, UINT incrementSize)
+    : device(std::move(device)), desc(desc)
+    {
+        auto size = static_cast<size_t>(desc.NumDescriptors) * incrementSize;
+        memory = std::make_unique<uint8_t[]>(size);
+        if (desc.Flags & D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE)
+        {
+            gpuStart = AllocateGpuAddress(size);
+        }
+    }
+
+    HRESULT DescriptorHeap::GetPrivateData(REFGUID guid, UINT* pDataSize, void* pData)
+    {
+        return privateData.Get(guid, pDataSize, pData);
+    }
+
+    HRESULT DescriptorHeap::SetPrivateData(REFGUID guid, UINT DataSize, const void* pData)
+    {
+        return privateData.Set(guid, DataSize, pData);
+    }
+
+    HRESULT DescriptorHeap::SetPrivateDataInterface(REFGUID guid, const IUnknown* pData)
+    {
+        Count(Call::SetPrivateData);
+        return E_NOTIMPL;
+    }
+
+    HRESULT DescriptorHeap::SetName(LPCWSTR Name)
+    {
+        Count(Call::SetName);
+        auto size = Name ? static_cast<UINT>((wcslen(Name) + 1) * sizeof(wchar_t)) : 0u;
+        return privateData.Set(WKPDID_D3DDebugObjectNameW, size, Name);
+    }
+
+    HRESULT DescriptorHeap::GetDevice(REFIID riid, void** ppvDevice)
+    {
+        return device->QueryInterface(riid, ppvDevice);
+    }
+
+    D3D12_DESCRIPTOR_HEAP_DESC DescriptorHeap::GetDesc()
+    {
+        return desc;
+    }
+
+    D3D12_CPU_DESCRIPTOR_HANDLE DescriptorHeap::GetCPUDescriptorHandleForHeapStart()
+    {
+        return {reinterpret_cast<SIZE_T>(memory.get())};
+    }
+
+    D3D12_GPU_DESCRIPTOR_HANDLE DescriptorHeap::GetGPUDescriptorHandleForHeapStart()
+    {
+        // like D3D12, non shader visible heaps have no GPU handle
+        return {gpuStart};
+    }
+}
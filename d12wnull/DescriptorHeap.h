@@ -0,0 +1,75 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_NULL_DESCRIPTOR_HEAP_H_
+#define _D12W_NULL_DESCRIPTOR_HEAP_H_
+
+#include <memory>
+#include <d3d12.h>
+
+#include <d12w/ComPtr.h>
+#include "Unknown.h"
+
+namespace d12w::null
+{
+    /*!
+     * Null ID3D12DescriptorHeap
+     *
+     * The descriptors live in host memory, so CPU handles point to real
+     * memory and copies between heaps can be verified. Shader visible
+     * heaps get a unique range of simulated GPU addresses.
+     */
+    class DescriptorHeap : public Unknown<ID3D12DescriptorHeap, ID3D12Pageable, ID3D12DeviceChild, ID3D12Object>
+    {
+    public:
+        /*!
+         * Create a null descriptor heap.
+         *
+         * @param device the device that created the heap
+         * @param desc the heap description
+         * @param incrementSize the size of a descriptor in bytes
+         */
+        DescriptorHeap(ComPtr<ID3D12Device> device, const D3D12_DESCRIPTOR_HEAP_DESC& desc, UINT incrementSize);
+
+        // ID3D12Object
+        HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID guid, UINT* pDataSize, void* pData) override;
+        HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID guid, UINT DataSize, const void* pData) override;
+        HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID guid, const IUnknown* pData) override;
+        HRESULT STDMETHODCALLTYPE SetName(LPCWSTR Name) override;
+
+        // ID3D12DeviceChild
+        HRESULT STDMETHODCALLTYPE GetDevice(REFIID riid, void** ppvDevice) override;
+
+        // ID3D12DescriptorHeap
+        D3D12_DESCRIPTOR_HEAP_DESC STDMETHODCALLTYPE GetDesc() override;
+        D3D12_CPU_DESCRIPTOR_HANDLE STDMETHODCALLTYPE GetCPUDescriptorHandleForHeapStart() override;
+        D3D12_GPU_DESCRIPTOR_HANDLE STDMETHODCALLTYPE GetGPUDescriptorHandleForHeapStart() override;
+
+    private:
+        ComPtr<ID3D12Device>       device;
+        D3D12_DESCRIPTOR_HEAP_DESC desc;
+        std::unique_ptr<uint8_t[]> memory;
+        UINT64                     gpuStart = 0;
+        PrivateData                privateData;
+    };
+}
+
+#endif
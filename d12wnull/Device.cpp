@@ -0,0 +1,547 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Device.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "DescriptorHeap.h"
+#include "Fence.h"
+#include "CommandAllocator.h"
+#include "CommandList.h"
+#include "CommandQueue.h"
+#include "Heap.h"
+#include "Resource.h"
+
+namespace d12w::null
+{
+    namespace
+    {
+        // all heap types use the same descriptor size, large enough for a tag
+        constexpr auto DESCRIPTOR_SIZE = UINT{32};
+
+        HRESULT NotImplemented(void** object)
+        {
+            if (object)
+            {
+                *object = nullptr;
+            }
+            return E_NOTIMPL;
+        }
+
+        UINT64 Align(UINT64 value, UINT64 alignment)
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        UINT GetMipLevels(const D3D12_RESOURCE_DESC& desc)
+        {
+            if (desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+            {
+                return 1;
+            }
+            if (desc.MipLevels != 0)
+            {
+                return desc.MipLevels;
+            }
+            auto size = std::max<UINT64>({desc.Width, desc.Height, desc.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D ? desc.DepthOrArraySize : 1u});
+            auto levels = UINT{1};
+            while (size > 1)
+            {
+                size >>= 1;
+                levels++;
+            }
+            return levels;
+        }
+    }
+
+    Device::Device(LUID adapterLuid)
+    : adapterLuid(adapterLuid) {}
+
+    HRESULT Device::GetPrivateData(REFGUID guid, UINT* pDataSize, void* pData)
+    {
+        return privateData.Get(guid, pDataSize, pData);
+    }
+
+    HRESULT Device::SetPrivateData(REFGUID guid, UINT DataSize, const void* pData)
+    {
+        return privateData.Set(guid, DataSize, pData);
+    }
+
+    HRESULT Device::SetPrivateDataInterface(REFGUID guid, const IUnknown* pData)
+    {
+        Count(Call::SetPrivateData);
+        return E_NOTIMPL;
+    }
+
+    HRESULT Device::SetName(LPCWSTR Name)
+    {
+        Count(Call::SetName);
+        auto size = Name ? static_cast<UINT>((wcslen(Name) + 1) * sizeof(wchar_t)) : 0u;
+        return privateData.Set(WKPDID_D3DDebugObjectNameW, size, Name);
+    }
+
+    UINT Device::GetNodeCount()
+    {
+        return 1;
+    }
+
+    HRESULT Device::CreateCommandQueue(const D3D12_COMMAND_QUEUE_DESC* pDesc, REFIID riid, void** ppCommandQueue)
+    {
+        Count(Call::CreateCommandQueue);
+        if (pDesc == nullptr || ppCommandQueue == nullptr)
+        {
+            return E_INVALIDARG;
+        }
+        *ppCommandQueue = nullptr;
+
+        auto self = ComPtr<ID3D12Device>{this};
+        auto queue = ComPtr<ID3D12CommandQueue>{};
+        queue.Attach(new CommandQueue{self, *pDesc});
+        return queue->QueryInterface(riid, ppCommandQueue);
+    }
+
+    HRESULT Device::CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE type, REFIID riid, void** ppCommandAllocator)
+    {
+        Count(Call::CreateCommandAllocator);
+        if (ppCommandAllocator == nullptr)
+        {
+            return E_INVALIDARG;
+        }
+        *ppCommandAllocator = nullptr;
+
+        auto self = ComPtr<ID3D12Device>{this};
+        auto allocator = ComPtr<ID3D12CommandAllocator>{};
+        allocator.Attach(new CommandAllocator{self, type});
+        return allocator->QueryInterface(riid, ppCommandAllocator);
+    }
+
+    HRESULT Device::CreateGraphicsPipelineState(const D3D12_GRAPHICS_PIPELINE_STATE_DESC* pDesc, REFIID riid, void** ppPipelineState)
+    {
+        return NotImplemented(ppPipelineState);
+    }
+
+    HRESULT Device::CreateComputePipelineState(const D3D12_COMPUTE_PIPELINE_STATE_DESC* pDesc, REFIID riid, void** ppPipelineState)
+    {
+        return NotImplemented(ppPipelineState);
+    }
+
+    HRESULT Device::CreateCommandList(UINT nodeMask, D3D12_COMMAND_LIST_TYPE type, ID3D12CommandAllocator* pCommandAllocator, ID3D12PipelineState* pInitialState, REFIID riid, void** ppCommandList)
+    {
+        Count(Call::CreateCommandList);
+        if (pCommandAllocator == nullptr || ppCommandList == nullptr)
+        {
+            return E_INVALIDARG;
+        }
+        *ppCommandList = nullptr;
+
+        auto self = ComPtr<ID3D12Device>{this};
+        auto list = ComPtr<ID3D12GraphicsCommandList>{};
+        list.Attach(new CommandList{self, type});
+        return list->QueryInterface(riid, ppCommandList);
+    }
+
+    HRESULT Device::CheckFeatureSupport(D3D12_FEATURE Feature, void* pFeatureSupportData, UINT FeatureSupportDataSize)
+    {
+        Count(Call::CheckFeatureSupport);
+        if (pFeatureSupportData == nullptr)
+        {
+            return E_INVALIDARG;
+        }
+
+        switch (Feature)
+        {
+            case D3D12_FEATURE_D3D12_OPTIONS:
+            {
+                if (FeatureSupportDataSize != sizeof(D3D12_FEATURE_DATA_D3D12_OPTIONS))
+                {
+                    return E_INVALIDARG;
+                }
+                auto options = static_cast<D3D12_FEATURE_DATA_D3D12_OPTIONS*>(pFeatureSupportData);
+                *options = {};
+                options->ResourceBindingTier = D3D12_RESOURCE_BINDING_TIER_3;
+                options->ResourceHeapTier    = D3D12_RESOURCE_HEAP_TIER_2;
+                return S_OK;
+            }
+            case D3D12_FEATURE_FEATURE_LEVELS:
+            {
+                if (FeatureSupportDataSize != sizeof(D3D12_FEATURE_DATA_FEATURE_LEVELS))
+                {
+                    return E_INVALIDARG;
+                }
+                auto levels = static_cast<D3D12_FEATURE_DATA_FEATURE_LEVELS*>(pFeatureSupportData);
+                levels->MaxSupportedFeatureLevel = D3D_FEATURE_LEVEL_11_0;
+                for (auto i = 0u; i < levels->NumFeatureLevels; i++)
+                {
+                    if (levels->pFeatureLevelsRequested[i] <= D3D_FEATURE_LEVEL_12_1)
+                    {
+                        levels->MaxSupportedFeatureLevel = std::max(levels->MaxSupportedFeatureLevel, levels->pFeatureLevelsRequested[i]);
+                    }
+                }
+                return S_OK;
+            }
+            default:
+                return E_INVALIDARG;
+        }
+    }
+
+    HRESULT Device::CreateDescriptorHeap(const D3D12_DESCRIPTOR_HEAP_DESC* pDescriptorHeapDesc, REFIID riid, void** ppvHeap)
+    {
+        Count(Call::CreateDescriptorHeap);
+        if (pDescriptorHeapDesc == nullptr || ppvHeap == nullptr)
+        {
+            return E_INVALIDARG;
+        }
+        *ppvHeap = nullptr;
+
+        auto self = ComPtr<ID3D12Device>{this};
+        auto heap = ComPtr<ID3D12DescriptorHeap>{};
+        heap.Attach(new DescriptorHeap{self, *pDescriptorHeapDesc, DESCRIPTOR_SIZE});
+        return heap->QueryInterface(riid, ppvHeap);
+    }
+
+    UINT Device::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE DescriptorHeapType)
+    {
+        return DESCRIPTOR_SIZE;
+    }
+
+    HRESULT Device::CreateRootSignature(UINT nodeMask, const void* pBlobWithRootSignature, SIZE_T blobLengthInBytes, REFIID riid, void** ppvRootSignature)
+    {
+        return NotImplemented(ppvRootSignature);
+    }
+
+    void Device::CreateConstantBufferView(const D3D12_CONSTANT_BUFFER_VIEW_DESC* pDesc, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor)
+    {
+        WriteDescriptor(DestDescriptor, pDesc ? pDesc->BufferLocation : 0);
+    }
+
+    void Device::CreateShaderResourceView(ID3D12Resource* pResource, const D3D12_SHADER_RESOURCE_VIEW_DESC* pDesc, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor)
+    {
+        WriteDescriptor(DestDescriptor, reinterpret_cast<UINT64>(pResource));
+    }
+
+    void Device::CreateUnorderedAccessView(ID3D12Resource* pResource, ID3D12Resource* pCounterResource, const D3D12_UNORDERED_ACCESS_VIEW_DESC* pDesc, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor)
+    {
+        WriteDescriptor(DestDescriptor, reinterpret_cast<UINT64>(pResource));
+    }
+
+    void Device::CreateRenderTargetView(ID3D12Resource* pResource, const D3D12_RENDER_TARGET_VIEW_DESC* pDesc, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor)
+    {
+        WriteDescriptor(DestDescriptor, reinterpret_cast<UINT64>(pResource));
+    }
+
+    void Device::CreateDepthStencilView(ID3D12Resource* pResource, const D3D12_DEPTH_STENCIL_VIEW_DESC* pDesc, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor)
+    {
+        WriteDescriptor(DestDescriptor, reinterpret_cast<UINT64>(pResource));
+    }
+
+    void Device::CreateSampler(const D3D12_SAMPLER_DESC* pDesc, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor)
+    {
+        WriteDescriptor(DestDescriptor, pDesc ? static_cast<UINT64>(pDesc->Filter) : 0);
+    }
+
+    void Device::CopyDescriptors(UINT NumDestDescriptorRanges, const D3D12_CPU_DESCRIPTOR_HANDLE* pDestDescriptorRangeStarts, const UINT* pDestDescriptorRangeSizes, UINT NumSrcDescriptorRanges, const D3D12_CPU_DESCRIPTOR_HANDLE* pSrcDescriptorRangeStarts, const UINT* pSrcDescriptorRangeSizes, D3D12_DESCRIPTOR_HEAP_TYPE DescriptorHeapsType)
+    {
+        Count(Call::CopyDescriptors);
+
+        // like D3D12, missing range sizes mean ranges of one descriptor
+        auto destRange = 0u;
+        auto destOffset = 0u;
+        for (auto srcRange = 0u; srcRange < NumSrcDescriptorRanges; srcRange++)
+        {
+            auto srcSize = pSrcDescriptorRangeSizes ? pSrcDescriptorRangeSizes[srcRange] : 1u;
+            for (auto srcOffset = 0u; srcOffset < srcSize; srcOffset++)
+            {
+                while (destRange < NumDestDescriptorRanges && destOffset == (pDestDescriptorRangeSizes ? pDestDescriptorRangeSizes[destRange] : 1u))
+                {
+                    destRange++;
+                    destOffset = 0;
+                }
+                if (destRange == NumDestDescriptorRanges)
+                {
+                    return;
+                }
+
+                auto src  = reinterpret_cast<const void*>(pSrcDescriptorRangeStarts[srcRange].ptr + srcOffset * DESCRIPTOR_SIZE);
+                auto dest = reinterpret_cast<void*>(pDestDescriptorRangeStarts[destRange].ptr + destOffset * DESCRIPTOR_SIZE);
+                std::memcpy(dest, src, DESCRIPTOR_SIZE);
+                destOffset++;
+            }
+        }
+    }
+
+    void Device::CopyDescriptorsSimple(UINT NumDescriptors, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptorRangeStart, D3D12_CPU_DESCRIPTOR_HANDLE SrcDescriptorRangeStart, D3D12_DESCRIPTOR_HEAP_TYPE DescriptorHeapsType)
+    {
+        Count(Call::CopyDescriptors);
+        std::memmove(reinterpret_cast<void*>(DestDescriptorRangeStart.ptr), reinterpret_cast<const void*>(SrcDescriptorRangeStart.ptr), NumDescriptors * DESCRIPTOR_SIZE);
+    }
+
+    D3D12_RESOURCE_ALLOCATION_INFO Device::GetResourceAllocationInfo(UINT visibleMask, UINT numResourceDescs, const D3D12_RESOURCE_DESC* pResourceDescs)
+    {
+        // assume 4 bytes per texel, the exact layout is driver specific anyway
+        auto info = D3D12_RESOURCE_ALLOCATION_INFO{0, D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT};
+        for (auto i = 0u; i < numResourceDescs; i++)
+        {
+            const auto& desc = pResourceDescs[i];
+            auto alignment = desc.Alignment != 0 ? desc.Alignment
+                           : desc.SampleDesc.Count > 1 ? D3D12_DEFAULT_MSAA_RESOURCE_PLACEMENT_ALIGNMENT
+                           : D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+            auto size = desc.Width;
+            if (desc.Dimension != D3D12_RESOURCE_DIMENSION_BUFFER)
+            {
+                auto texels = desc.Width * desc.Height * desc.DepthOrArraySize * std::max(desc.SampleDesc.Count, 1u);
+                size = GetMipLevels(desc) > 1 ? texels * 4 * 4 / 3 : texels * 4;
+            }
+            info.Alignment = std::max(info.Alignment, alignment);
+            info.SizeInBytes = Align(info.SizeInBytes, alignment) + Align(size, alignment);
+        }
+        return info;
+    }
+
+    D3D12_HEAP_PROPERTIES Device::GetCustomHeapProperties(UINT nodeMask, D3D12_HEAP_TYPE heapType)
+    {
+        auto properties = D3D12_HEAP_PROPERTIES{D3D12_HEAP_TYPE_CUSTOM, D3D12_CPU_PAGE_PROPERTY_NOT_AVAILABLE, D3D12_MEMORY_POOL_L1, 1, 1};
+        if (heapType == D3D12_HEAP_TYPE_UPLOAD)
+        {
+            properties.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_WRITE_COMBINE;
+            properties.MemoryPoolPreference = D3D12_MEMORY_POOL_L0;
+        }
+        else if (heapType == D3D12_HEAP_TYPE_READBACK)
+        {
+            properties.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_WRITE_BACK;
+            properties.MemoryPoolPreference = D3D12_MEMORY_POOL_L0;
+        }
+        return properties;
+    }
+
+    HRESULT Device::CreateCommittedResource(const D3D12_HEAP_PROPERTIES* pHeapProperties, D3D12_HEAP_FLAGS HeapFlags, const D3D12_RESOURCE_DESC* pDesc, D3D12_RESOURCE_STATES InitialResourceState, const D3D12_CLEAR_VALUE* pOptimizedClearValue, REFIID riidResource, void** ppvResource)
+    {
+        Count(Call::CreateResource);
+        if (pHeapProperties == nullptr || pDesc == nullptr || ppvResource == nullptr)
+        {
+            return E_INVALIDARG;
+        }
+        *ppvResource = nullptr;
+
+        auto self = ComPtr<ID3D12Device>{this};
+        auto resource = ComPtr<ID3D12Resource>{};
+        resource.Attach(new Resource{self, *pDesc, *pHeapProperties, HeapFlags});
+        return resource->QueryInterface(riidResource, ppvResource);
+    }
+
+    HRESULT Device::CreateHeap(const D3D12_HEAP_DESC* pDesc, REFIID riid, void** ppvHeap)
+    {
+        Count(Call::CreateHeap);
+        if (pDesc == nullptr || ppvHeap == nullptr)
+        {
+            return E_INVALIDARG;
+        }
+        *ppvHeap = nullptr;
+
+        auto self = ComPtr<ID3D12Device>{this};
+        auto heap = ComPtr<ID3D12Heap>{};
+        heap.Attach(new Heap{self, *pDesc});
+        return heap->QueryInterface(riid, ppvHeap);
+    }
+
+    HRESULT Device::CreatePlacedResource(ID3D12Heap* pHeap, UINT64 HeapOffset, const D3D12_RESOURCE_DESC* pDesc, D3D12_RESOURCE_STATES InitialState, const D3D12_CLEAR_VALUE* pOptimizedClearValue, REFIID riid, void** ppvResource)
+    {
+        Count(Call::CreateResource);
+        if (pDesc == nullptr || ppvResource == nullptr)
+        {
+            return E_INVALIDARG;
+        }
+        *ppvResource = nullptr;
+
+        // only heaps of the null device can hold null resources
+        auto heap = dynamic_cast<Heap*>(pHeap);
+        if (heap == nullptr)
+        {
+            return E_INVALIDARG;
+        }
+
+        auto info = GetResourceAllocationInfo(0, 1, pDesc);
+        if (HeapOffset % info.Alignment != 0 || HeapOffset + info.SizeInBytes > heap->GetDesc().SizeInBytes)
+        {
+            return E_INVALIDARG;
+        }
+
+        auto self = ComPtr<ID3D12Device>{this};
+        auto resource = ComPtr<ID3D12Resource>{};
+        resource.Attach(new Resource{self, *pDesc, ComPtr<Heap>{heap}, HeapOffset});
+        return resource->QueryInterface(riid, ppvResource);
+    }
+
+    HRESULT Device::CreateReservedResource(const D3D12_RESOURCE_DESC* pDesc, D3D12_RESOURCE_STATES InitialState, const D3D12_CLEAR_VALUE* pOptimizedClearValue, REFIID riid, void** ppvResource)
+    {
+        return NotImplemented(ppvResource);
+    }
+
+    HRESULT Device::CreateSharedHandle(ID3D12DeviceChild* pObject, const SECURITY_ATTRIBUTES* pAttributes, DWORD Access, LPCWSTR Name, HANDLE* pHandle)
+    {
+        return E_NOTIMPL;
+    }
+
+    HRESULT Device::OpenSharedHandle(HANDLE NTHandle, REFIID riid, void** ppvObj)
+    {
+        return NotImplemented(ppvObj);
+    }
+
+    HRESULT Device::OpenSharedHandleByName(LPCWSTR Name, DWORD Access, HANDLE* pNTHandle)
+    {
+        return E_NOTIMPL;
+    }
+
+    HRESULT Device::MakeResident(UINT NumObjects, ID3D12Pageable* const* ppObjects)
+    {
+        return S_OK;
+    }
+
+    HRESULT Device::Evict(UINT NumObjects, ID3D12Pageable* const* ppObjects)
+    {
+        return S_OK;
+    }
+
+    HRESULT Device::CreateFence(UINT64 InitialValue, D3D12_FENCE_FLAGS Flags, REFIID riid, void** ppFence)
+    {
+        if (ppFence == nullptr)
+        {
+            return E_INVALIDARG;
+        }
+        *ppFence = nullptr;
+
+        auto fence = ComPtr<ID3D12Fence1>{};
+        fence.Attach(new Fence{InitialValue, Flags});
+        return fence->QueryInterface(riid, ppFence);
+    }
+
+    HRESULT Device::GetDeviceRemovedReason()
+    {
+        return S_OK;
+    }
+
+    void Device::GetCopyableFootprints(const D3D12_RESOURCE_DESC* pResourceDesc, UINT FirstSubresource, UINT NumSubresources, UINT64 BaseOffset, D3D12_PLACED_SUBRESOURCE_FOOTPRINT* pLayouts, UINT* pNumRows, UINT64* pRowSizeInBytes, UINT64* pTotalBytes)
+    {
+        // assume 4 bytes per texel, but honor the D3D12 pitch and placement alignment
+        const auto& desc = *pResourceDesc;
+        auto buffer = desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER;
+        auto mipLevels = GetMipLevels(desc);
+        auto offset = BaseOffset;
+        for (auto i = 0u; i < NumSubresources; i++)
+        {
+            auto mip = (FirstSubresource + i) % mipLevels;
+            auto width = buffer ? desc.Width : std::max<UINT64>(desc.Width >> mip, 1);
+            auto height = buffer ? 1u : std::max(desc.Height >> mip, 1u);
+            auto depth = desc.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D ? std::max<UINT>(desc.DepthOrArraySize >> mip, 1u) : 1u;
+            auto rowSize = buffer ? width : width * 4;
+            auto pitch = Align(rowSize, D3D12_TEXTURE_DATA_PITCH_ALIGNMENT);
+
+            offset = Align(offset, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+            if (pLayouts)
+            {
+                pLayouts[i].Offset = offset;
+                pLayouts[i].Footprint = {desc.Format, static_cast<UINT>(width), height, depth, static_cast<UINT>(pitch)};
+            }
+            if (pNumRows)
+            {
+                pNumRows[i] = height;
+            }
+            if (pRowSizeInBytes)
+            {
+                pRowSizeInBytes[i] = rowSize;
+            }
+            offset += pitch * (height * depth - 1) + rowSize;
+        }
+        if (pTotalBytes)
+        {
+            *pTotalBytes = offset - BaseOffset;
+        }
+    }
+
+    HRESULT Device::CreateQueryHeap(const D3D12_QUERY_HEAP_DESC* pDesc, REFIID riid, void** ppvHeap)
+    {
+        return NotImplemented(ppvHeap);
+    }
+
+    HRESULT Device::SetStablePowerState(BOOL Enable)
+    {
+        return S_OK;
+    }
+
+    HRESULT Device::CreateCommandSignature(const D3D12_COMMAND_SIGNATURE_DESC* pDesc, ID3D12RootSignature* pRootSignature, REFIID riid, void** ppvCommandSignature)
+    {
+        return NotImplemented(ppvCommandSignature);
+    }
+
+    void Device::GetResourceTiling(ID3D12Resource* pTiledResource, UINT* pNumTilesForEntireResource, D3D12_PACKED_MIP_INFO* pPackedMipDesc, D3D12_TILE_SHAPE* pStandardTileShapeForNonPackedMips, UINT* pNumSubresourceTilings, UINT FirstSubresourceTilingToGet, D3D12_SUBRESOURCE_TILING* pSubresourceTilingsForNonPackedMips)
+    {
+        if (pNumTilesForEntireResource)
+        {
+            *pNumTilesForEntireResource = 0;
+        }
+        if (pPackedMipDesc)
+        {
+            *pPackedMipDesc = {};
+        }
+        if (pStandardTileShapeForNonPackedMips)
+        {
+            *pStandardTileShapeForNonPackedMips = {};
+        }
+        if (pNumSubresourceTilings)
+        {
+            *pNumSubresourceTilings = 0;
+        }
+    }
+
+    LUID Device::GetAdapterLuid()
+    {
+        return adapterLuid;
+    }
+
+    HRESULT Device::CreatePipelineLibrary(const void* pLibraryBlob, SIZE_T BlobLength, REFIID riid, void** ppPipelineLibrary)
+    {
+        return NotImplemented(ppPipelineLibrary);
+    }
+
+    HRESULT Device::SetEventOnMultipleFenceCompletion(ID3D12Fence* const* ppFences, const UINT64* pFenceValues, UINT NumFences, D3D12_MULTIPLE_FENCE_WAIT_FLAGS Flags, HANDLE hEvent)
+    {
+        return E_NOTIMPL;
+    }
+
+    HRESULT Device::SetResidencyPriority(UINT NumObjects, ID3D12Pageable* const* ppObjects, const D3D12_RESIDENCY_PRIORITY* pPriorities)
+    {
+        return S_OK;
+    }
+
+    HRESULT Device::CreatePipelineState(const D3D12_PIPELINE_STATE_STREAM_DESC* pDesc, REFIID riid, void** ppPipelineState)
+    {
+        return NotImplemented(ppPipelineState);
+    }
+
+    void Device::WriteDescriptor(D3D12_CPU_DESCRIPTOR_HANDLE handle, UINT64 value)
+    {
+        Count(Call::CreateDescriptor);
+        auto descriptor = reinterpret_cast<uint8_t*>(handle.ptr);
+        std::memset(descriptor, 0, DESCRIPTOR_SIZE);
+        std::memcpy(descriptor, &value, sizeof(value));
+    }
+}
@@ -0,0 +1,282 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Factory.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace d12w::null
+{
+    Factory::Factory(const std::vector<AdapterConfig>& adapters, const AdapterConfig& warp, UINT flags, std::chrono::nanoseconds enumerationLatency, bool gpuPreference)
+    : adapters(adapters), warp(warp), flags(flags), enumerationLatency(enumerationLatency), gpuPreference(gpuPreference) {}
+
+    HRESULT Factory::QueryInterface(REFIID riid, void** object)
+    {
+        if (!gpuPreference && riid == __uuidof(IDXGIFactory6))
+        {
+            Count(Call::QueryInterface);
+            if (object == nullptr)
+            {
+                return E_POINTER;
+            }
+            *object = nullptr;
+            return E_NOINTERFACE;
+        }
+        return Unknown::QueryInterface(riid, object);
+    }
+
+    HRESULT Factory::SetPrivateData(REFGUID Name, UINT DataSize, const void* pData)
+    {
+        return privateData.Set(Name, DataSize, pData);
+    }
+
+    HRESULT Factory::SetPrivateDataInterface(REFGUID Name, const IUnknown* pUnknown)
+    {
+        Count(Call::SetPrivateData);
+        return E_NOTIMPL;
+    }
+
+    HRESULT Factory::GetPrivateData(REFGUID Name, UINT* pDataSize, void* pData)
+    {
+        return privateData.Get(Name, pDataSize, pData);
+    }
+
+    HRESULT Factory::GetParent(REFIID riid, void** ppParent)
+    {
+        Count(Call::GetParent);
+        if (ppParent)
+        {
+            *ppParent = nullptr;
+        }
+        return E_NOINTERFACE;
+    }
+
+    HRESULT Factory::EnumAdapters(UINT Adapter, IDXGIAdapter** ppAdapter)
+    {
+        Count(Call::EnumAdapters);
+        if (ppAdapter == nullptr)
+        {
+            return DXGI_ERROR_INVALID_CALL;
+        }
+        *ppAdapter = nullptr;
+        if (Adapter >= adapters.size())
+        {
+            return DXGI_ERROR_NOT_FOUND;
+        }
+        return CreateAdapter(adapters[Adapter], __uuidof(IDXGIAdapter), reinterpret_cast<void**>(ppAdapter));
+    }
+
+    HRESULT Factory::MakeWindowAssociation(HWND WindowHandle, UINT Flags)
+    {
+        window = WindowHandle;
+        return S_OK;
+    }
+
+    HRESULT Factory::GetWindowAssociation(HWND* pWindowHandle)
+    {
+        if (pWindowHandle == nullptr)
+        {
+            return DXGI_ERROR_INVALID_CALL;
+        }
+        *pWindowHandle = window;
+        return S_OK;
+    }
+
+    HRESULT Factory::CreateSwapChain(IUnknown* pDevice, DXGI_SWAP_CHAIN_DESC* pDesc, IDXGISwapChain** ppSwapChain)
+    {
+        Count(Call::CreateSwapChain);
+        return DXGI_ERROR_UNSUPPORTED;
+    }
+
+    HRESULT Factory::CreateSoftwareAdapter(HMODULE Module, IDXGIAdapter** ppAdapter)
+    {
+        return DXGI_ERROR_UNSUPPORTED;
+    }
+
+    HRESULT Factory::EnumAdapters1(UINT Adapter, IDXGIAdapter1** ppAdapter)
+    {
+        Count(Call::EnumAdapters1);
+        if (ppAdapter == nullptr)
+        {
+            return DXGI_ERROR_INVALID_CALL;
+        }
+        *ppAdapter = nullptr;
+        if (Adapter >= adapters.size())
+        {
+            return DXGI_ERROR_NOT_FOUND;
+        }
+        return CreateAdapter(adapters[Adapter], __uuidof(IDXGIAdapter1), reinterpret_cast<void**>(ppAdapter));
+    }
+
+    BOOL Factory::IsCurrent()
+    {
+        Count(Call::IsCurrent);
+        return TRUE;
+    }
+
+    BOOL Factory::IsWindowedStereoEnabled()
+    {
+        return FALSE;
+    }
+
+    HRESULT Factory::CreateSwapChainForHwnd(IUnknown* pDevice, HWND hWnd, const DXGI_SWAP_CHAIN_DESC1* pDesc, const DXGI_SWAP_CHAIN_FULLSCREEN_DESC* pFullscreenDesc, IDXGIOutput* pRestrictToOutput, IDXGISwapChain1** ppSwapChain)
+    {
+        Count(Call::CreateSwapChain);
+        return DXGI_ERROR_UNSUPPORTED;
+    }
+
+    HRESULT Factory::CreateSwapChainForCoreWindow(IUnknown* pDevice, IUnknown* pWindow, const DXGI_SWAP_CHAIN_DESC1* pDesc, IDXGIOutput* pRestrictToOutput, IDXGISwapChain1** ppSwapChain)
+    {
+        Count(Call::CreateSwapChain);
+        return DXGI_ERROR_UNSUPPORTED;
+    }
+
+    HRESULT Factory::GetSharedResourceAdapterLuid(HANDLE hResource, LUID* pLuid)
+    {
+        return DXGI_ERROR_UNSUPPORTED;
+    }
+
+    HRESULT Factory::RegisterStereoStatusWindow(HWND WindowHandle, UINT wMsg, DWORD* pdwCookie)
+    {
+        return DXGI_ERROR_UNSUPPORTED;
+    }
+
+    HRESULT Factory::RegisterStereoStatusEvent(HANDLE hEvent, DWORD* pdwCookie)
+    {
+        return DXGI_ERROR_UNSUPPORTED;
+    }
+
+    void Factory::UnregisterStereoStatus(DWORD dwCookie) {}
+
+    HRESULT Factory::RegisterOcclusionStatusWindow(HWND WindowHandle, UINT wMsg, DWORD* pdwCookie)
+    {
+        return DXGI_ERROR_UNSUPPORTED;
+    }
+
+    HRESULT Factory::RegisterOcclusionStatusEvent(HANDLE hEvent, DWORD* pdwCookie)
+    {
+        return DXGI_ERROR_UNSUPPORTED;
+    }
+
+    void Factory::UnregisterOcclusionStatus(DWORD dwCookie) {}
+
+    HRESULT Factory::CreateSwapChainForComposition(IUnknown* pDevice, const DXGI_SWAP_CHAIN_DESC1* pDesc, IDXGIOutput* pRestrictToOutput, IDXGISwapChain1** ppSwapChain)
+    {
+        Count(Call::CreateSwapChain);
+        return DXGI_ERROR_UNSUPPORTED;
+    }
+
+    UINT Factory::GetCreationFlags()
+    {
+        return flags;
+    }
+
+    HRESULT Factory::EnumAdapterByLuid(LUID AdapterLuid, REFIID riid, void** ppvAdapter)
+    {
+        Count(Call::EnumAdapterByLuid);
+        auto matches = [&] (const AdapterConfig& config) {
+            return config.desc.AdapterLuid.LowPart == AdapterLuid.LowPart && config.desc.AdapterLuid.HighPart == AdapterLuid.HighPart;
+        };
+
+        auto i = std::find_if(adapters.begin(), adapters.end(), matches);
+        if (i != adapters.end())
+        {
+            return CreateAdapter(*i, riid, ppvAdapter);
+        }
+        if (matches(warp))
+        {
+            return CreateAdapter(warp, riid, ppvAdapter);
+        }
+        return DXGI_ERROR_NOT_FOUND;
+    }
+
+    HRESULT Factory::EnumWarpAdapter(REFIID riid, void** ppvAdapter)
+    {
+        Count(Call::EnumWarpAdapter);
+        return CreateAdapter(warp, riid, ppvAdapter);
+    }
+
+    HRESULT Factory::CheckFeatureSupport(DXGI_FEATURE Feature, void* pFeatureSupportData, UINT FeatureSupportDataSize)
+    {
+        Count(Call::CheckFeatureSupport);
+        if (Feature != DXGI_FEATURE_PRESENT_ALLOW_TEARING || pFeatureSupportData == nullptr || FeatureSupportDataSize != sizeof(BOOL))
+        {
+            return DXGI_ERROR_INVALID_CALL;
+        }
+        *static_cast<BOOL*>(pFeatureSupportData) = FALSE;
+        return S_OK;
+    }
+
+    HRESULT Factory::EnumAdapterByGpuPreference(UINT Adapter, DXGI_GPU_PREFERENCE GpuPreference, REFIID riid, void** ppvAdapter)
+    {
+        Count(Call::EnumAdapterByGpuPreference);
+        if (ppvAdapter == nullptr)
+        {
+            return DXGI_ERROR_INVALID_CALL;
+        }
+        *ppvAdapter = nullptr;
+        if (Adapter >= adapters.size())
+        {
+            return DXGI_ERROR_NOT_FOUND;
+        }
+
+        // Like DXGI, rank by dedicated video memory as a stand-in for
+        // performance and keep software adapters last.
+        auto ranked = adapters;
+        if (GpuPreference != DXGI_GPU_PREFERENCE_UNSPECIFIED)
+        {
+            auto highPerformance = GpuPreference == DXGI_GPU_PREFERENCE_HIGH_PERFORMANCE;
+            std::stable_sort(ranked.begin(), ranked.end(), [highPerformance] (const AdapterConfig& a, const AdapterConfig& b) {
+                auto aSoftware = (a.desc.Flags & DXGI_ADAPTER_FLAG3_SOFTWARE) != 0;
+                auto bSoftware = (b.desc.Flags & DXGI_ADAPTER_FLAG3_SOFTWARE) != 0;
+                if (aSoftware != bSoftware)
+                {
+                    return bSoftware;
+                }
+                return highPerformance
+                    ? a.desc.DedicatedVideoMemory > b.desc.DedicatedVideoMemory
+                    : a.desc.DedicatedVideoMemory < b.desc.DedicatedVideoMemory;
+            });
+        }
+        return CreateAdapter(ranked[Adapter], riid, ppvAdapter);
+    }
+
+    HRESULT Factory::CreateAdapter(const AdapterConfig& config, REFIID riid, void** ppvAdapter)
+    {
+        if (ppvAdapter == nullptr)
+        {
+            return DXGI_ERROR_INVALID_CALL;
+        }
+        *ppvAdapter = nullptr;
+
+        // real drivers may take milliseconds to enumerate an adapter
+        if (enumerationLatency.count() > 0)
+        {
+            std::this_thread::sleep_for(enumerationLatency);
+        }
+
+        auto self = ComPtr<IDXGIFactory>{this};
+        auto adapter = ComPtr<IDXGIAdapter4>{};
+        adapter.Attach(new Adapter{self, config});
+        return adapter->QueryInterface(riid, ppvAdapter);
+    }
+}
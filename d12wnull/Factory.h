@@ -0,0 +1,115 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_NULL_FACTORY_H_
+#define _D12W_NULL_FACTORY_H_
+
+#include <chrono>
+#include <vector>
+#include <dxgi1_6.h>
+
+#include <d12w/ComPtr.h>
+#include "Unknown.h"
+#include "Adapter.h"
+
+namespace d12w::null
+{
+    /*!
+     * Null IDXGIFactory6
+     *
+     * The factory enumerates the configured adapters and a WARP adapter.
+     * Swap chains are not supported. Without gpuPreference the factory
+     * does not expose IDXGIFactory6, like DXGI before Windows 10 1803.
+     */
+    class Factory : public Unknown<IDXGIFactory6, IDXGIFactory5, IDXGIFactory4, IDXGIFactory3, IDXGIFactory2, IDXGIFactory1, IDXGIFactory, IDXGIObject>
+    {
+    public:
+        /*!
+         * Create a null factory.
+         *
+         * @param adapters the simulated hardware adapters in enumeration order
+         * @param warp the simulated WARP adapter
+         * @param flags the creation flags reported by GetCreationFlags
+         * @param enumerationLatency the simulated time each adapter enumeration takes
+         * @param gpuPreference whether IDXGIFactory6 is exposed
+         */
+        Factory(const std::vector<AdapterConfig>& adapters, const AdapterConfig& warp, UINT flags = 0, std::chrono::nanoseconds enumerationLatency = {}, bool gpuPreference = true);
+
+        // IUnknown
+        HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** object) override;
+
+        // IDXGIObject
+        HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID Name, UINT DataSize, const void* pData) override;
+        HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID Name, const IUnknown* pUnknown) override;
+        HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID Name, UINT* pDataSize, void* pData) override;
+        HRESULT STDMETHODCALLTYPE GetParent(REFIID riid, void** ppParent) override;
+
+        // IDXGIFactory
+        HRESULT STDMETHODCALLTYPE EnumAdapters(UINT Adapter, IDXGIAdapter** ppAdapter) override;
+        HRESULT STDMETHODCALLTYPE MakeWindowAssociation(HWND WindowHandle, UINT Flags) override;
+        HRESULT STDMETHODCALLTYPE GetWindowAssociation(HWND* pWindowHandle) override;
+        HRESULT STDMETHODCALLTYPE CreateSwapChain(IUnknown* pDevice, DXGI_SWAP_CHAIN_DESC* pDesc, IDXGISwapChain** ppSwapChain) override;
+        HRESULT STDMETHODCALLTYPE CreateSoftwareAdapter(HMODULE Module, IDXGIAdapter** ppAdapter) override;
+
+        // IDXGIFactory1
+        HRESULT STDMETHODCALLTYPE EnumAdapters1(UINT Adapter, IDXGIAdapter1** ppAdapter) override;
+        BOOL STDMETHODCALLTYPE IsCurrent() override;
+
+        // IDXGIFactory2
+        BOOL STDMETHODCALLTYPE IsWindowedStereoEnabled() override;
+        HRESULT STDMETHODCALLTYPE CreateSwapChainForHwnd(IUnknown* pDevice, HWND hWnd, const DXGI_SWAP_CHAIN_DESC1* pDesc, const DXGI_SWAP_CHAIN_FULLSCREEN_DESC* pFullscreenDesc, IDXGIOutput* pRestrictToOutput, IDXGISwapChain1** ppSwapChain) override;
+        HRESULT STDMETHODCALLTYPE CreateSwapChainForCoreWindow(IUnknown* pDevice, IUnknown* pWindow, const DXGI_SWAP_CHAIN_DESC1* pDesc, IDXGIOutput* pRestrictToOutput, IDXGISwapChain1** ppSwapChain) override;
+        HRESULT STDMETHODCALLTYPE GetSharedResourceAdapterLuid(HANDLE hResource, LUID* pLuid) override;
+        HRESULT STDMETHODCALLTYPE RegisterStereoStatusWindow(HWND WindowHandle, UINT wMsg, DWORD* pdwCookie) override;
+        HRESULT STDMETHODCALLTYPE RegisterStereoStatusEvent(HANDLE hEvent, DWORD* pdwCookie) override;
+        void STDMETHODCALLTYPE UnregisterStereoStatus(DWORD dwCookie) override;
+        HRESULT STDMETHODCALLTYPE RegisterOcclusionStatusWindow(HWND WindowHandle, UINT wMsg, DWORD* pdwCookie) override;
+        HRESULT STDMETHODCALLTYPE RegisterOcclusionStatusEvent(HANDLE hEvent, DWORD* pdwCookie) override;
+        void STDMETHODCALLTYPE UnregisterOcclusionStatus(DWORD dwCookie) override;
+        HRESULT STDMETHODCALLTYPE CreateSwapChainForComposition(IUnknown* pDevice, const DXGI_SWAP_CHAIN_DESC1* pDesc, IDXGIOutput* pRestrictToOutput, IDXGISwapChain1** ppSwapChain) override;
+
+        // IDXGIFactory3
+        UINT STDMETHODCALLTYPE GetCreationFlags() override;
+
+        // IDXGIFactory4
+        HRESULT STDMETHODCALLTYPE EnumAdapterByLuid(LUID AdapterLuid, REFIID riid, void** ppvAdapter) override;
+        HRESULT STDMETHODCALLTYPE EnumWarpAdapter(REFIID riid, void** ppvAdapter) override;
+
+        // IDXGIFactory5
+        HRESULT STDMETHODCALLTYPE CheckFeatureSupport(DXGI_FEATURE Feature, void* pFeatureSupportData, UINT FeatureSupportDataSize) override;
+
+        // IDXGIFactory6
+        HRESULT STDMETHODCALLTYPE EnumAdapterByGpuPreference(UINT Adapter, DXGI_GPU_PREFERENCE GpuPreference, REFIID riid, void** ppvAdapter) override;
+
+    private:
+        std::vector<AdapterConfig> adapters;
+        AdapterConfig              warp;
+        UINT                       flags;
+        std::chrono::nanoseconds   enumerationLatency;
+        bool                       gpuPreference;
+        HWND                       window = nullptr;
+        PrivateData                privateData;
+
+        HRESULT CreateAdapter(const AdapterConfig& config, REFIID riid, void** ppvAdapter);
+    };
+}
+
+#endif
@@ -0,0 +1,169 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Fence.h"
+
+#include <algorithm>
+
+namespace d12w::null
+{
+    Fence::Fence(UINT64 initialValue, D3D12_FENCE_FLAGS flags)
+    : completed(initialValue), flags(flags)
+    {
+        thread = std::thread([this] () { Run(); });
+    }
+
+    Fence::~Fence()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            running = false;
+        }
+        cond.notify_all();
+        thread.join();
+    }
+
+    HRESULT Fence::GetPrivateData(REFGUID guid, UINT* pDataSize, void* pData)
+    {
+        return privateData.Get(guid, pDataSize, pData);
+    }
+
+    HRESULT Fence::SetPrivateData(REFGUID guid, UINT DataSize, const void* pData)
+    {
+        return privateData.Set(guid, DataSize, pData);
+    }
+
+    HRESULT Fence::SetPrivateDataInterface(REFGUID guid, const IUnknown* pData)
+    {
+        Count(Call::SetPrivateData);
+        return E_NOTIMPL;
+    }
+
+    HRESULT Fence::SetName(LPCWSTR Name)
+    {
+        Count(Call::SetName);
+        auto size = Name ? static_cast<UINT>((wcslen(Name) + 1) * sizeof(wchar_t)) : 0u;
+        return privateData.Set(WKPDID_D3DDebugObjectNameW, size, Name);
+    }
+
+    HRESULT Fence::GetDevice(REFIID riid, void** ppvDevice)
+    {
+        if (ppvDevice)
+        {
+            *ppvDevice = nullptr;
+        }
+        return E_NOINTERFACE;
+    }
+
+    UINT64 Fence::GetCompletedValue()
+    {
+        Count(Call::GetCompletedValue);
+        return completed.load(std::memory_order_acquire);
+    }
+
+    HRESULT Fence::SetEventOnCompletion(UINT64 Value, HANDLE hEvent)
+    {
+        Count(Call::SetEventOnCompletion);
+        std::unique_lock<std::mutex> lock(mutex);
+        if (hEvent == nullptr)
+        {
+            // like D3D12, a null event blocks until the value is reached
+            cond.wait(lock, [&] () { return completed.load() >= Value; });
+            return S_OK;
+        }
+
+        if (completed.load() >= Value)
+        {
+            SetEvent(hEvent);
+        }
+        else
+        {
+            events.emplace_back(Value, hEvent);
+        }
+        return S_OK;
+    }
+
+    HRESULT Fence::Signal(UINT64 Value)
+    {
+        Count(Call::Signal);
+        std::lock_guard<std::mutex> lock(mutex);
+        Complete(Value);
+        return S_OK;
+    }
+
+    D3D12_FENCE_FLAGS Fence::GetCreationFlags()
+    {
+        return flags;
+    }
+
+    void Fence::SignalAfter(UINT64 value, std::chrono::nanoseconds latency)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending.emplace(Clock::now() + latency, value);
+        }
+        cond.notify_all();
+    }
+
+    void Fence::Run()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (running)
+        {
+            if (pending.empty())
+            {
+                cond.wait(lock);
+                continue;
+            }
+
+            auto next = pending.begin();
+            if (Clock::now() < next->first)
+            {
+                cond.wait_until(lock, next->first);
+                continue;
+            }
+
+            auto value = next->second;
+            pending.erase(next);
+            Complete(value);
+        }
+    }
+
+    // mutex must be held
+    void Fence::Complete(UINT64 value)
+    {
+        completed.store(value, std::memory_order_release);
+
+        auto reached = [value] (const std::pair<UINT64, HANDLE>& event) {
+            return event.first <= value;
+        };
+        for (const auto& event : events)
+        {
+            if (reached(event))
+            {
+                SetEvent(event.second);
+            }
+        }
+        events.erase(std::remove_if(events.begin(), events.end(), reached), events.end());
+
+        cond.notify_all();
+    }
+}
@@ -0,0 +1,106 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_NULL_FENCE_H_
+#define _D12W_NULL_FENCE_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <d3d12.h>
+
+#include "Unknown.h"
+
+namespace d12w::null
+{
+    /*!
+     * Null ID3D12Fence1
+     *
+     * Besides the CPU side Signal, the fence can simulate GPU side signals
+     * that complete after a given latency. Completion events are set by a
+     * timer thread owned by the fence.
+     */
+    class Fence : public Unknown<ID3D12Fence1, ID3D12Fence, ID3D12Pageable, ID3D12DeviceChild, ID3D12Object>
+    {
+    public:
+        /*!
+         * Create a null fence.
+         *
+         * @param initialValue the initial completed value
+         * @param flags the creation flags reported by GetCreationFlags
+         */
+        explicit
+        Fence(UINT64 initialValue = 0, D3D12_FENCE_FLAGS flags = D3D12_FENCE_FLAG_NONE);
+
+        ~Fence();
+
+        // ID3D12Object
+        HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID guid, UINT* pDataSize, void* pData) override;
+        HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID guid, UINT DataSize, const void* pData) override;
+        HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID guid, const IUnknown* pData) override;
+        HRESULT STDMETHODCALLTYPE SetName(LPCWSTR Name) override;
+
+        // ID3D12DeviceChild
+        HRESULT STDMETHODCALLTYPE GetDevice(REFIID riid, void** ppvDevice) override;
+
+        // ID3D12Fence
+        UINT64 STDMETHODCALLTYPE GetCompletedValue() override;
+        HRESULT STDMETHODCALLTYPE SetEventOnCompletion(UINT64 Value, HANDLE hEvent) override;
+        HRESULT STDMETHODCALLTYPE Signal(UINT64 Value) override;
+
+        // ID3D12Fence1
+        D3D12_FENCE_FLAGS STDMETHODCALLTYPE GetCreationFlags() override;
+
+        /*!
+         * Simulate a signal from a command queue.
+         *
+         * The value is reached once the latency has passed. Simulated
+         * signals complete in the order of their completion time.
+         *
+         * @param value the value to signal
+         * @param latency the simulated time until the GPU reaches the signal
+         */
+        void SignalAfter(UINT64 value, std::chrono::nanoseconds latency);
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        std::atomic<UINT64>                      completed;
+        D3D12_FENCE_FLAGS                        flags;
+        PrivateData                              privateData;
+
+        std::mutex                               mutex;
+        std::condition_variable                  cond;
+        std::multimap<Clock::time_point, UINT64> pending;
+        std::vector<std::pair<UINT64, HANDLE>>   events;
+        bool                                     running = true;
+        std::thread                              thread;
+
+        void Run();
+        void Complete(UINT64 value);
+    };
+}
+
+#endif
@@ -0,0 +1,83 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Heap.h"
+
+#include "GpuAddress.h"
+
+namespace d12w::null
+{
+    Heap::Heap(ComPtr<ID3D12Device> device, const D3D12_HEAP_DESC& desc)
+    : device(std::move(device)), desc(desc)
+    {
+        auto type = desc.Properties.Type;
+        auto cpuAccess = type == D3D12_HEAP_TYPE_UPLOAD || type == D3D12_HEAP_TYPE_READBACK ||
+                         (type == D3D12_HEAP_TYPE_CUSTOM && desc.Properties.CPUPageProperty != D3D12_CPU_PAGE_PROPERTY_NOT_AVAILABLE);
+        if (cpuAccess)
+        {
+            memory = std::make_unique<uint8_t[]>(static_cast<size_t>(desc.SizeInBytes));
+        }
+        gpuAddress = AllocateGpuAddress(desc.SizeInBytes);
+    }
+
+    HRESULT Heap::GetPrivateData(REFGUID guid, UINT* pDataSize, void* pData)
+    {
+        return privateData.Get(guid, pDataSize, pData);
+    }
+
+    HRESULT Heap::SetPrivateData(REFGUID guid, UINT DataSize, const void* pData)
+    {
+        return privateData.Set(guid, DataSize, pData);
+    }
+
+    HRESULT Heap::SetPrivateDataInterface(REFGUID guid, const IUnknown* pData)
+    {
+        Count(Call::SetPrivateData);
+        return E_NOTIMPL;
+    }
+
+    HRESULT Heap::SetName(LPCWSTR Name)
+    {
+        Count(Call::SetName);
+        auto size = Name ? static_cast<UINT>((wcslen(Name) + 1) * sizeof(wchar_t)) : 0u;
+        return privateData.Set(WKPDID_D3DDebugObjectNameW, size, Name);
+    }
+
+    HRESULT Heap::GetDevice(REFIID riid, void** ppvDevice)
+    {
+        return device->QueryInterface(riid, ppvDevice);
+    }
+
+    D3D12_HEAP_DESC Heap::GetDesc()
+    {
+        return desc;
+    }
+
+    uint8_t* Heap::GetMemory() const
+    {
+        return memory.get();
+    }
+
+    D3D12_GPU_VIRTUAL_ADDRESS Heap::GetGpuAddress() const
+    {
+        return gpuAddress;
+    }
+}
@@ -0,0 +1,152 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Resource.h"
+
+#include "GpuAddress.h"
+
+namespace d12w::null
+{
+    Resource::Resource(ComPtr<ID3D12Device> device, const D3D12_RESOURCE_DESC& desc, const D3D12_HEAP_PROPERTIES& heapProperties, D3D12_HEAP_FLAGS heapFlags)
+    : device(std::move(device)), desc(desc), heapProperties(heapProperties), heapFlags(heapFlags)
+    {
+        if (desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+        {
+            memory = std::make_unique<uint8_t[]>(static_cast<size_t>(desc.Width));
+            data = memory.get();
+            gpuAddress = AllocateGpuAddress(desc.Width);
+        }
+    }
+
+    Resource::Resource(ComPtr<ID3D12Device> device, const D3D12_RESOURCE_DESC& desc, ComPtr<Heap> heap, UINT64 heapOffset)
+    : device(std::move(device)), desc(desc), heap(std::move(heap))
+    {
+        auto heapDesc = this->heap->GetDesc();
+        heapProperties = heapDesc.Properties;
+        heapFlags      = heapDesc.Flags;
+
+        if (desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+        {
+            auto heapMemory = this->heap->GetMemory();
+            data = heapMemory ? heapMemory + heapOffset : nullptr;
+            gpuAddress = this->heap->GetGpuAddress() + heapOffset;
+        }
+    }
+
+    HRESULT Resource::GetPrivateData(REFGUID guid, UINT* pDataSize, void* pData)
+    {
+        return privateData.Get(guid, pDataSize, pData);
+    }
+
+    HRESULT Resource::SetPrivateData(REFGUID guid, UINT DataSize, const void* pData)
+    {
+        return privateData.Set(guid, DataSize, pData);
+    }
+
+    HRESULT Resource::SetPrivateDataInterface(REFGUID guid, const IUnknown* pData)
+    {
+        Count(Call::SetPrivateData);
+        return E_NOTIMPL;
+    }
+
+    HRESULT Resource::SetName(LPCWSTR Name)
+    {
+        Count(Call::SetName);
+        auto size = Name ? static_cast<UINT>((wcslen(Name) + 1) * sizeof(wchar_t)) : 0u;
+        return privateData.Set(WKPDID_D3DDebugObjectNameW, size, Name);
+    }
+
+    HRESULT Resource::GetDevice(REFIID riid, void** ppvDevice)
+    {
+        return device->QueryInterface(riid, ppvDevice);
+    }
+
+    HRESULT Resource::Map(UINT Subresource, const D3D12_RANGE* pReadRange, void** ppData)
+    {
+        Count(Call::Map);
+        if (ppData)
+        {
+            *ppData = nullptr;
+        }
+
+        auto cpuAccess = heapProperties.Type == D3D12_HEAP_TYPE_UPLOAD ||
+                         heapProperties.Type == D3D12_HEAP_TYPE_READBACK ||
+                         (heapProperties.Type == D3D12_HEAP_TYPE_CUSTOM && heapProperties.CPUPageProperty != D3D12_CPU_PAGE_PROPERTY_NOT_AVAILABLE);
+        if (!data || !cpuAccess || Subresource != 0)
+        {
+            return E_INVALIDARG;
+        }
+
+        mapCount++;
+        if (ppData)
+        {
+            *ppData = data;
+        }
+        return S_OK;
+    }
+
+    void Resource::Unmap(UINT Subresource, const D3D12_RANGE* pWrittenRange)
+    {
+        if (mapCount > 0)
+        {
+            mapCount--;
+        }
+    }
+
+    D3D12_RESOURCE_DESC Resource::GetDesc()
+    {
+        return desc;
+    }
+
+    D3D12_GPU_VIRTUAL_ADDRESS Resource::GetGPUVirtualAddress()
+    {
+        // like D3D12, textures have no GPU address
+        return gpuAddress;
+    }
+
+    HRESULT Resource::WriteToSubresource(UINT DstSubresource, const D3D12_BOX* pDstBox, const void* pSrcData, UINT SrcRowPitch, UINT SrcDepthPitch)
+    {
+        return E_NOTIMPL;
+    }
+
+    HRESULT Resource::ReadFromSubresource(void* pDstData, UINT DstRowPitch, UINT DstDepthPitch, UINT SrcSubresource, const D3D12_BOX* pSrcBox)
+    {
+        return E_NOTIMPL;
+    }
+
+    HRESULT Resource::GetHeapProperties(D3D12_HEAP_PROPERTIES* pHeapProperties, D3D12_HEAP_FLAGS* pHeapFlags)
+    {
+        if (pHeapProperties)
+        {
+            *pHeapProperties = heapProperties;
+        }
+        if (pHeapFlags)
+        {
+            *pHeapFlags = heapFlags;
+        }
+        return S_OK;
+    }
+
+    UINT Resource::GetMapCount() const
+    {
+        return mapCount;
+    }
+}
@@ -0,0 +1,106 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_NULL_RESOURCE_H_
+#define _D12W_NULL_RESOURCE_H_
+
+#include <atomic>
+#include <memory>
+#include <d3d12.h>
+
+#include <d12w/ComPtr.h>
+#include "Unknown.h"
+#include "Heap.h"
+
+namespace d12w::null
+{
+    /*!
+     * Null ID3D12Resource
+     *
+     * Committed buffers are backed by host memory and get a unique
+     * simulated GPU address, so data written through Map can be checked.
+     * Textures have no memory, like on D3D12 they can not be mapped.
+     */
+    class Resource : public Unknown<ID3D12Resource, ID3D12Pageable, ID3D12DeviceChild, ID3D12Object>
+    {
+    public:
+        /*!
+         * Create a null committed resource.
+         *
+         * @param device the device that created the resource
+         * @param desc the resource description
+         * @param heapProperties the properties of the implicit heap
+         * @param heapFlags the flags of the implicit heap
+         */
+        Resource(ComPtr<ID3D12Device> device, const D3D12_RESOURCE_DESC& desc, const D3D12_HEAP_PROPERTIES& heapProperties, D3D12_HEAP_FLAGS heapFlags);
+
+        /*!
+         * Create a null placed resource.
+         *
+         * Placed buffers use the memory and addresses of the heap.
+         *
+         * @param device the device that created the resource
+         * @param desc the resource description
+         * @param heap the heap the resource is placed in
+         * @param heapOffset the offset in the heap
+         */
+        Resource(ComPtr<ID3D12Device> device, const D3D12_RESOURCE_DESC& desc, ComPtr<Heap> heap, UINT64 heapOffset);
+
+        // ID3D12Object
+        HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID guid, UINT* pDataSize, void* pData) override;
+        HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID guid, UINT DataSize, const void* pData) override;
+        HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID guid, const IUnknown* pData) override;
+        HRESULT STDMETHODCALLTYPE SetName(LPCWSTR Name) override;
+
+        // ID3D12DeviceChild
+        HRESULT STDMETHODCALLTYPE GetDevice(REFIID riid, void** ppvDevice) override;
+
+        // ID3D12Resource
+        HRESULT STDMETHODCALLTYPE Map(UINT Subresource, const D3D12_RANGE* pReadRange, void** ppData) override;
+        void STDMETHODCALLTYPE Unmap(UINT Subresource, const D3D12_RANGE* pWrittenRange) override;
+        D3D12_RESOURCE_DESC STDMETHODCALLTYPE GetDesc() override;
+        D3D12_GPU_VIRTUAL_ADDRESS STDMETHODCALLTYPE GetGPUVirtualAddress() override;
+        HRESULT STDMETHODCALLTYPE WriteToSubresource(UINT DstSubresource, const D3D12_BOX* pDstBox, const void* pSrcData, UINT SrcRowPitch, UINT SrcDepthPitch) override;
+        HRESULT STDMETHODCALLTYPE ReadFromSubresource(void* pDstData, UINT DstRowPitch, UINT DstDepthPitch, UINT SrcSubresource, const D3D12_BOX* pSrcBox) override;
+        HRESULT STDMETHODCALLTYPE GetHeapProperties(D3D12_HEAP_PROPERTIES* pHeapProperties, D3D12_HEAP_FLAGS* pHeapFlags) override;
+
+        /*!
+         * Get the number of outstanding Map calls.
+         *
+         * @return the number of Map calls without matching Unmap
+         */
+        UINT GetMapCount() const;
+
+    private:
+        ComPtr<ID3D12Device>       device;
+        D3D12_RESOURCE_DESC        desc;
+        D3D12_HEAP_PROPERTIES      heapProperties;
+        D3D12_HEAP_FLAGS           heapFlags;
+        ComPtr<Heap>               heap;
+        std::unique_ptr<uint8_t[]> memory;
+        uint8_t*                   data       = nullptr;
+        D3D12_GPU_VIRTUAL_ADDRESS  gpuAddress = 0;
+        std::atomic<UINT>          mapCount   = 0;
+        PrivateData                privateData;
+    };
+}
+
+#endif
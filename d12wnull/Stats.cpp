@@ -0,0 +1,61 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Stats.h"
+
+#include <array>
+#include <atomic>
+
+namespace d12w::null
+{
+    namespace
+    {
+        std::array<std::atomic<uint64_t>, static_cast<size_t>(Call::LAST_CALL)> counters = {};
+    }
+
+    void Count(Call call) noexcept
+    {
+        counters[static_cast<size_t>(call)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64_t GetCallCount(Call call) noexcept
+    {
+        return counters[static_cast<size_t>(call)].load(std::memory_order_relaxed);
+    }
+
+    uint64_t GetTotalCallCount() noexcept
+    {
+        auto total = uint64_t{0};
+        for (const auto& counter : counters)
+        {
+            total += counter.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    void ResetCallCounts() noexcept
+    {
+        for (auto& counter : counters)
+        {
+            counter.store(0, std::memory_order_relaxed);
+        }
+    }
+}
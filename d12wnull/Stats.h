@@ -0,0 +1,106 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_NULL_STATS_H_
+#define _D12W_NULL_STATS_H_
+
+#include <cstdint>
+
+namespace d12w::null
+{
+    /*!
+     * Calls counted by the null backend.
+     */
+    enum class Call
+    {
+        QueryInterface,
+        AddRef,
+        Release,
+        SetPrivateData,
+        GetPrivateData,
+        SetName,
+        GetParent,
+        EnumAdapters,
+        EnumAdapters1,
+        EnumAdapterByLuid,
+        EnumWarpAdapter,
+        EnumAdapterByGpuPreference,
+        IsCurrent,
+        CheckFeatureSupport,
+        CreateSwapChain,
+        GetAdapterDesc,
+        CheckInterfaceSupport,
+        QueryVideoMemoryInfo,
+        EnableDebugLayer,
+        SetDebugSetting,
+        GetCompletedValue,
+        SetEventOnCompletion,
+        Signal,
+        CreateDescriptorHeap,
+        CreateDescriptor,
+        CopyDescriptors,
+        CreateResource,
+        CreateHeap,
+        Map,
+        CreateCommandAllocator,
+        Reset,
+        CreateCommandQueue,
+        CreateCommandList,
+        Close,
+        RecordCommand,
+        ResourceBarrier,
+        ExecuteCommandLists,
+        Wait,
+        LAST_CALL
+    };
+
+    /*!
+     * Count a call.
+     *
+     * The counters are process wide and relaxed atomics, so they are cheap
+     * enough to not distort the measured wrapper overhead.
+     *
+     * @param call the call to count
+     */
+    void Count(Call call) noexcept;
+
+    /*!
+     * Get the number of calls since the last reset.
+     *
+     * @param call the call to query
+     * @return the number of calls
+     */
+    uint64_t GetCallCount(Call call) noexcept;
+
+    /*!
+     * Get the number of all calls since the last reset.
+     *
+     * @return the number of calls
+     */
+    uint64_t GetTotalCallCount() noexcept;
+
+    /*!
+     * Reset all call counters to zero.
+     */
+    void ResetCallCounts() noexcept;
+}
+
+#endif
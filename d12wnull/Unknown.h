@@ -0,0 +1,158 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_NULL_UNKNOWN_H_
+#define _D12W_NULL_UNKNOWN_H_
+
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <vector>
+#include <unknwn.h>
+
+#include "Stats.h"
+
+namespace d12w::null
+{
+    /*!
+     * IUnknown implementation for the null backend.
+     *
+     * Interface is the most derived COM interface implemented, Bases are
+     * the interfaces it derives from, so that QueryInterface succeeds
+     * for all of them. Objects are created with a reference count of one
+     * and delete themselves when it drops to zero.
+     */
+    template <typename Interface, typename... Bases>
+    class Unknown : public Interface
+    {
+    public:
+        HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** object) override
+        {
+            Count(Call::QueryInterface);
+            if (object == nullptr)
+            {
+                return E_POINTER;
+            }
+
+            if (riid == __uuidof(IUnknown) || riid == __uuidof(Interface) || ((riid == __uuidof(Bases)) || ...))
+            {
+                AddRef();
+                *object = static_cast<Interface*>(this);
+                return S_OK;
+            }
+
+            *object = nullptr;
+            return E_NOINTERFACE;
+        }
+
+        ULONG STDMETHODCALLTYPE AddRef() override
+        {
+            Count(Call::AddRef);
+            return ++refCount;
+        }
+
+        ULONG STDMETHODCALLTYPE Release() override
+        {
+            Count(Call::Release);
+            auto count = --refCount;
+            if (count == 0)
+            {
+                delete this;
+            }
+            return count;
+        }
+
+    protected:
+        Unknown() = default;
+        virtual ~Unknown() = default;
+
+    private:
+        std::atomic<ULONG> refCount = 1;
+    };
+
+    /*!
+     * Storage for Get/SetPrivateData of DXGI and D3D12 objects.
+     */
+    class PrivateData
+    {
+    public:
+        HRESULT Set(REFGUID guid, UINT size, const void* data)
+        {
+            Count(Call::SetPrivateData);
+            std::lock_guard<std::mutex> lock(mutex);
+            if (data == nullptr)
+            {
+                entries.erase(guid);
+                return S_OK;
+            }
+            auto bytes = static_cast<const uint8_t*>(data);
+            entries[guid] = std::vector<uint8_t>(bytes, bytes + size);
+            return S_OK;
+        }
+
+        HRESULT Get(REFGUID guid, UINT* size, void* data)
+        {
+            Count(Call::GetPrivateData);
+            if (size == nullptr)
+            {
+                return E_INVALIDARG;
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            auto i = entries.find(guid);
+            if (i == entries.end())
+            {
+                *size = 0;
+                return DXGI_ERROR_NOT_FOUND;
+            }
+
+            auto required = static_cast<UINT>(i->second.size());
+            if (data == nullptr)
+            {
+                *size = required;
+                return S_OK;
+            }
+            if (*size < required)
+            {
+                *size = required;
+                return DXGI_ERROR_MORE_DATA;
+            }
+            std::memcpy(data, i->second.data(), required);
+            *size = required;
+            return S_OK;
+        }
+
+    private:
+        struct GuidLess
+        {
+            bool operator () (const GUID& a, const GUID& b) const
+            {
+                return std::memcmp(&a, &b, sizeof(GUID)) < 0;
+            }
+        };
+
+        std::mutex mutex;
+        std::map<GUID, std::vector<uint8_t>, GuidLess> entries;
+    };
+}
+
+#endif
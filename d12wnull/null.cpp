@@ -0,0 +1,84 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "null.h"
+
+#include <algorithm>
+#include <iterator>
+
+#ifdef _MSC_VER
+#pragma comment(lib, "dxguid.lib")
+#endif
+
+namespace d12w::null
+{
+    AdapterConfig MakeAdapterConfig(const std::wstring_view description, SIZE_T dedicatedVideoMemory, DWORD luid, bool software)
+    {
+        auto config = AdapterConfig{};
+        auto length = std::min(description.size(), std::size(config.desc.Description) - 1);
+        std::copy_n(description.begin(), length, config.desc.Description);
+        config.desc.VendorId              = software ? 0x1414 : 0x10DE;
+        config.desc.DeviceId              = software ? 0x008C : 0x1000 + luid;
+        config.desc.DedicatedVideoMemory  = dedicatedVideoMemory;
+        config.desc.SharedSystemMemory    = SIZE_T{1} << 30;
+        config.desc.AdapterLuid.LowPart   = luid;
+        config.desc.Flags                 = software ? DXGI_ADAPTER_FLAG3_SOFTWARE : DXGI_ADAPTER_FLAG3_NONE;
+        config.driverVersion.QuadPart     = 0x001F000000010000;
+        return config;
+    }
+
+    ComPtr<IDXGIFactory6> CreateFactory(const std::vector<AdapterConfig>& adapters, std::chrono::nanoseconds enumerationLatency)
+    {
+        auto warp = MakeAdapterConfig(L"Microsoft Basic Render Driver", 0, 0xFFFF, true);
+        auto factory = ComPtr<IDXGIFactory6>{};
+        factory.Attach(new Factory{adapters, warp, 0, enumerationLatency});
+        return factory;
+    }
+
+    ComPtr<IDXGIFactory4> CreateFactory4(const std::vector<AdapterConfig>& adapters, std::chrono::nanoseconds enumerationLatency)
+    {
+        auto warp = MakeAdapterConfig(L"Microsoft Basic Render Driver", 0, 0xFFFF, true);
+        auto factory = ComPtr<IDXGIFactory4>{};
+        factory.Attach(new Factory{adapters, warp, 0, enumerationLatency, false});
+        return factory;
+    }
+
+    ComPtr<ID3D12Debug1> CreateDebug()
+    {
+        auto debug = ComPtr<ID3D12Debug1>{};
+        debug.Attach(new Debug{});
+        return debug;
+    }
+
+    ComPtr<ID3D12Device2> CreateDevice(LUID adapterLuid)
+    {
+        auto device = ComPtr<ID3D12Device2>{};
+        device.Attach(new Device{adapterLuid});
+        return device;
+    }
+
+    ComPtr<Fence> CreateFence(UINT64 initialValue)
+    {
+        auto fence = ComPtr<Fence>{};
+        fence.Attach(new Fence{initialValue});
+        return fence;
+    }
+}
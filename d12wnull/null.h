@@ -0,0 +1,110 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _D12W_NULL_H_
+#define _D12W_NULL_H_
+
+#include <chrono>
+#include <string_view>
+#include <vector>
+
+#include <d12w/ComPtr.h>
+#include "Stats.h"
+#include "Adapter.h"
+#include "Factory.h"
+#include "Debug.h"
+#include "Fence.h"
+#include "DescriptorHeap.h"
+#include "Heap.h"
+#include "Resource.h"
+#include "CommandAllocator.h"
+#include "CommandList.h"
+#include "CommandQueue.h"
+#include "Device.h"
+
+/*!
+ * Null Backend
+ *
+ * The null backend implements the DXGI and D3D12 interfaces used by the
+ * wrapper without a GPU. The objects count their calls (see Stats.h),
+ * so that the CPU overhead of the wrapper can be measured and tracked
+ * on headless build machines. Inject them with the wrapper constructors
+ * that take a COM object, for example dxgi::Factory(null::CreateFactory()).
+ */
+namespace d12w::null
+{
+    /*!
+     * Describe a simulated adapter.
+     *
+     * @param description the adapter description
+     * @param dedicatedVideoMemory the dedicated video memory in bytes
+     * @param luid the low part of the adapter LUID, must be unique
+     * @param software true for a software adapter
+     * @return the adapter configuration
+     */
+    AdapterConfig MakeAdapterConfig(const std::wstring_view description, SIZE_T dedicatedVideoMemory, DWORD luid, bool software = false);
+
+    /*!
+     * Create a null DXGI factory.
+     *
+     * @param adapters the simulated hardware adapters in enumeration order
+     * @param enumerationLatency the simulated time each adapter enumeration takes
+     * @return the factory
+     */
+    ComPtr<IDXGIFactory6> CreateFactory(const std::vector<AdapterConfig>& adapters, std::chrono::nanoseconds enumerationLatency = {});
+
+    /*!
+     * Create a null DXGI factory without IDXGIFactory6.
+     *
+     * This simulates DXGI before Windows 10 1803, where adapters can not
+     * be enumerated by GPU preference.
+     *
+     * @param adapters the simulated hardware adapters in enumeration order
+     * @param enumerationLatency the simulated time each adapter enumeration takes
+     * @return the factory
+     */
+    ComPtr<IDXGIFactory4> CreateFactory4(const std::vector<AdapterConfig>& adapters, std::chrono::nanoseconds enumerationLatency = {});
+
+    /*!
+     * Create a null D3D12 debug interface.
+     *
+     * @return the debug interface
+     */
+    ComPtr<ID3D12Debug1> CreateDebug();
+
+    /*!
+     * Create a null D3D12 device.
+     *
+     * @param adapterLuid the LUID reported by GetAdapterLuid
+     * @return the device
+     */
+    ComPtr<ID3D12Device2> CreateDevice(LUID adapterLuid = {});
+
+    /*!
+     * Create a null D3D12 fence.
+     *
+     * @param initialValue the initial completed value
+     * @return the fence
+     */
+    ComPtr<Fence> CreateFence(UINT64 initialValue = 0);
+}
+
+#endif
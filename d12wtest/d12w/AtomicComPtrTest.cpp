@@ -0,0 +1,171 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <d12w/AtomicComPtr.h>
+#include <d12wnull/Unknown.h>
+
+using namespace d12w;
+
+namespace
+{
+    std::atomic<int> liveObjects = 0;
+
+    // a COM object that counts the live instances and detects use after release
+    class Tracked : public null::Unknown<IUnknown>
+    {
+    public:
+        static constexpr uint32_t ALIVE = 0xA11CE;
+        static constexpr uint32_t DEAD  = 0xDEAD;
+
+        uint32_t magic = ALIVE;
+        uint32_t value;
+
+        explicit
+        Tracked(uint32_t v)
+        : value(v)
+        {
+            liveObjects++;
+        }
+
+        ~Tracked()
+        {
+            magic = DEAD;
+            liveObjects--;
+        }
+    };
+
+    ComPtr<Tracked> MakeTracked(uint32_t value)
+    {
+        auto result = ComPtr<Tracked>{};
+        result.Attach(new Tracked(value));
+        return result;
+    }
+}
+
+TEST(AtomicComPtr, LoadReturnsTheStoredValue)
+{
+    {
+        auto ptr = AtomicComPtr<Tracked>{MakeTracked(1)};
+        EXPECT_TRUE(ptr.IsLockFree());
+        EXPECT_EQ(1u, ptr.Load()->value);
+
+        ptr.Store(MakeTracked(2));
+        EXPECT_EQ(2u, ptr.Load()->value);
+        EXPECT_EQ(1, liveObjects);
+
+        ptr.Store(nullptr);
+        EXPECT_FALSE(ptr.Load());
+        EXPECT_EQ(0, liveObjects);
+
+        ptr.Store(MakeTracked(3));
+    }
+    EXPECT_EQ(0, liveObjects);
+}
+
+TEST(AtomicComPtr, ExchangeReturnsThePreviousValue)
+{
+    {
+        auto ptr = AtomicComPtr<Tracked>{MakeTracked(1)};
+        auto old = ptr.Exchange(MakeTracked(2));
+        ASSERT_TRUE(old);
+        EXPECT_EQ(1u, old->value);
+        EXPECT_EQ(2u, ptr.Load()->value);
+    }
+    EXPECT_EQ(0, liveObjects);
+}
+
+TEST(AtomicComPtr, CompareExchangeUpdatesExpectedOnFailure)
+{
+    {
+        auto ptr = AtomicComPtr<Tracked>{MakeTracked(1)};
+
+        auto expected = MakeTracked(7);
+        EXPECT_FALSE(ptr.CompareExchange(expected, MakeTracked(2)));
+        ASSERT_TRUE(expected);
+        EXPECT_EQ(1u, expected->value);
+
+        EXPECT_TRUE(ptr.CompareExchange(expected, MakeTracked(3)));
+        EXPECT_EQ(3u, ptr.Load()->value);
+    }
+    EXPECT_EQ(0, liveObjects);
+}
+
+// Readers load the value while writers keep replacing it. A reader must never
+// see a released object and no reference may leak.
+TEST(AtomicComPtr, StressConcurrentLoadAndStore)
+{
+    constexpr auto READERS = 6u;
+    constexpr auto WRITERS = 2u;
+    constexpr auto STORES  = 20000u;
+
+    {
+        auto ptr     = AtomicComPtr<Tracked>{MakeTracked(0)};
+        auto done    = std::atomic<unsigned int>{0};
+        auto corrupt = std::atomic<unsigned int>{0};
+
+        auto threads = std::vector<std::thread>{};
+        for (auto i = 0u; i < READERS; i++)
+        {
+            threads.emplace_back([&] () {
+                while (done.load() < WRITERS)
+                {
+                    auto value = ptr.Load();
+                    if (!value || value->magic != Tracked::ALIVE)
+                    {
+                        corrupt++;
+                    }
+                }
+            });
+        }
+        for (auto i = 0u; i < WRITERS; i++)
+        {
+            threads.emplace_back([&, i] () {
+                for (auto j = 0u; j < STORES; j++)
+                {
+                    if (j % 2 == 0)
+                    {
+                        ptr.Store(MakeTracked(i * STORES + j));
+                    }
+                    else
+                    {
+                        auto expected = ptr.Load();
+                        ptr.CompareExchange(expected, MakeTracked(i * STORES + j));
+                    }
+                }
+                done++;
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        EXPECT_EQ(0u, corrupt);
+        EXPECT_EQ(1, liveObjects);
+    }
+    EXPECT_EQ(0, liveObjects);
+}
@@ -0,0 +1,71 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include <d12w/util.h>
+
+using namespace d12w;
+
+#ifndef NDEBUG
+TEST(Callstack, ThrowCapturesTheRawCallstack)
+{
+    try
+    {
+        D12W_THROW(std::logic_error, "Something went wrong.");
+        FAIL();
+    }
+    catch (const util::ExceptionWithCallstack<std::logic_error>& ex)
+    {
+        EXPECT_GT(ex.GetCallStack().size, 0u);
+        auto what = std::string{ex.what()};
+        EXPECT_NE(std::string::npos, what.find("Something went wrong."));
+        EXPECT_NE(std::string::npos, what.find("Callstack:"));
+    }
+}
+
+TEST(Callstack, CopiesShareTheSymbolizedMessage)
+{
+    try
+    {
+        D12W_THROW(std::logic_error, "Something went wrong.");
+    }
+    catch (const util::ExceptionWithCallstack<std::logic_error>& ex)
+    {
+        auto copy = ex;
+        EXPECT_EQ(ex.what(), copy.what());
+    }
+}
+
+TEST(Callstack, SymbolizeResolvesEveryFrame)
+{
+    auto stack = util::CaptureCallStack();
+    auto frames = util::Symbolize(stack);
+    ASSERT_EQ(stack.size, frames.size());
+    for (auto i = 0u; i < stack.size; i++)
+    {
+        EXPECT_EQ(reinterpret_cast<uint64_t>(stack.addresses[i]), frames[i].address);
+        EXPECT_FALSE(frames[i].module.empty());
+    }
+}
+#endif
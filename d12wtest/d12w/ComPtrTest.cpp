@@ -0,0 +1,261 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <exception>
+#include <utility>
+#include <vector>
+
+#include <d12w/ComPtr.h>
+#include <d12wnull/null.h>
+
+using namespace d12w;
+
+namespace
+{
+    class RefCounted : public null::Unknown<IUnknown> {};
+
+    // the reference count without changing it
+    ULONG GetRefCount(IUnknown* object)
+    {
+        object->AddRef();
+        return object->Release();
+    }
+
+    // the creating reference is released by the test
+    RefCounted* MakeObject()
+    {
+        return new RefCounted;
+    }
+}
+
+TEST(ComPtr, WrappingConstructorAddsAReference)
+{
+    auto object = MakeObject();
+    {
+        auto ptr = ComPtr<RefCounted>{object};
+        EXPECT_EQ(object, ptr.Get());
+        EXPECT_EQ(2u, GetRefCount(object));
+    }
+    EXPECT_EQ(1u, GetRefCount(object));
+    object->Release();
+}
+
+TEST(ComPtr, CopyAddsAReference)
+{
+    auto object = MakeObject();
+    auto a = ComPtr<RefCounted>{object};
+    auto b = a;
+    EXPECT_EQ(3u, GetRefCount(object));
+
+    auto c = ComPtr<RefCounted>{};
+    c = b;
+    EXPECT_EQ(4u, GetRefCount(object));
+
+    c = ComPtr<RefCounted>{};
+    EXPECT_EQ(3u, GetRefCount(object));
+    object->Release();
+}
+
+TEST(ComPtr, MoveKeepsTheReferenceCount)
+{
+    auto object = MakeObject();
+    auto a = ComPtr<RefCounted>{object};
+    EXPECT_EQ(2u, GetRefCount(object));
+
+    auto b = std::move(a);
+    EXPECT_FALSE(a);
+    EXPECT_EQ(object, b.Get());
+    EXPECT_EQ(2u, GetRefCount(object));
+
+    auto c = ComPtr<RefCounted>{};
+    c = std::move(b);
+    EXPECT_FALSE(b);
+    EXPECT_EQ(object, c.Get());
+    EXPECT_EQ(2u, GetRefCount(object));
+
+    auto base = ComPtr<IUnknown>{std::move(c)};
+    EXPECT_FALSE(c);
+    EXPECT_EQ(2u, GetRefCount(object));
+
+    base = ComPtr<IUnknown>{};
+    EXPECT_EQ(1u, GetRefCount(object));
+    object->Release();
+}
+
+TEST(ComPtr, MoveAssignmentReleasesThePreviousObject)
+{
+    auto first  = MakeObject();
+    auto second = MakeObject();
+    auto a = ComPtr<RefCounted>{first};
+    auto b = ComPtr<RefCounted>{second};
+
+    a = std::move(b);
+    EXPECT_EQ(1u, GetRefCount(first));
+    EXPECT_EQ(2u, GetRefCount(second));
+
+    first->Release();
+    second->Release();
+}
+
+TEST(ComPtr, VectorGrowthMovesTheElements)
+{
+    auto object = MakeObject();
+    auto ptrs = std::vector<ComPtr<RefCounted>>{};
+    for (auto i = 0; i < 100; i++)
+    {
+        ptrs.emplace_back(object);
+    }
+    EXPECT_EQ(101u, GetRefCount(object));
+
+    ptrs.clear();
+    EXPECT_EQ(1u, GetRefCount(object));
+    object->Release();
+}
+
+TEST(ComPtr, AttachTakesOverTheReference)
+{
+    auto first  = MakeObject();
+    auto second = MakeObject();
+    first->AddRef();
+    second->AddRef();
+
+    auto ptr = ComPtr<RefCounted>{};
+    ptr.Attach(first);
+    EXPECT_EQ(2u, GetRefCount(first));
+
+    // the previous object is released
+    ptr.Attach(second);
+    EXPECT_EQ(1u, GetRefCount(first));
+    EXPECT_EQ(2u, GetRefCount(second));
+
+    ptr = ComPtr<RefCounted>{};
+    EXPECT_EQ(1u, GetRefCount(second));
+    first->Release();
+    second->Release();
+}
+
+TEST(ComPtr, DetachGivesUpTheReference)
+{
+    auto object = MakeObject();
+    auto ptr = ComPtr<RefCounted>{object};
+
+    auto raw = ptr.Detach();
+    EXPECT_EQ(object, raw);
+    EXPECT_FALSE(ptr);
+    EXPECT_EQ(2u, GetRefCount(object));
+
+    raw->Release();
+    object->Release();
+}
+
+TEST(ComPtr, ReleaseAndGetAddressOfReleasesTheObject)
+{
+    auto first  = MakeObject();
+    auto second = MakeObject();
+    auto ptr = ComPtr<RefCounted>{first};
+
+    auto address = ptr.ReleaseAndGetAddressOf();
+    EXPECT_EQ(nullptr, *address);
+    EXPECT_EQ(1u, GetRefCount(first));
+
+    // like an out-parameter of a COM function
+    second->AddRef();
+    *address = second;
+    EXPECT_EQ(second, ptr.Get());
+    EXPECT_EQ(2u, GetRefCount(second));
+
+    ptr = ComPtr<RefCounted>{};
+    first->Release();
+    second->Release();
+}
+
+TEST(ComPtr, GetAddressOfKeepsTheObject)
+{
+    auto object = MakeObject();
+    auto ptr = ComPtr<RefCounted>{object};
+
+    EXPECT_EQ(object, *ptr.GetAddressOf());
+    EXPECT_EQ(2u, GetRefCount(object));
+
+    ptr = ComPtr<RefCounted>{};
+    object->Release();
+}
+
+TEST(ComPtr, TryAsReportsSuccess)
+{
+    auto fence = null::CreateFence();
+    auto unknown = ComPtr<IUnknown>{fence.Get()};
+
+    auto hr = HRESULT{E_FAIL};
+    auto result = unknown.TryAs<ID3D12Fence>(&hr);
+    EXPECT_EQ(S_OK, hr);
+    EXPECT_EQ(static_cast<ID3D12Fence*>(fence.Get()), result.Get());
+}
+
+TEST(ComPtr, TryAsReportsAMissingInterface)
+{
+    auto fence = null::CreateFence();
+
+    auto hr = HRESULT{S_OK};
+    auto result = fence.TryAs<ID3D12Device>(&hr);
+    EXPECT_EQ(E_NOINTERFACE, hr);
+    EXPECT_FALSE(result);
+}
+
+TEST(ComPtr, TryAsReportsANullObject)
+{
+    auto empty = ComPtr<IUnknown>{};
+
+    auto hr = HRESULT{S_OK};
+    auto result = empty.TryAs<ID3D12Fence>(&hr);
+    EXPECT_EQ(E_POINTER, hr);
+    EXPECT_FALSE(result);
+
+    // the compile time path reports the same
+    hr = S_OK;
+    auto base = ComPtr<null::Fence>{}.TryAs<ID3D12Pageable>(&hr);
+    EXPECT_EQ(E_POINTER, hr);
+    EXPECT_FALSE(base);
+}
+
+TEST(ComPtr, TryAsToABaseDoesNotQueryInterface)
+{
+    auto fence = null::CreateFence();
+    null::ResetCallCounts();
+
+    auto hr = HRESULT{E_FAIL};
+    auto base = fence.TryAs<ID3D12Pageable>(&hr);
+    EXPECT_EQ(S_OK, hr);
+    EXPECT_EQ(static_cast<ID3D12Pageable*>(fence.Get()), base.Get());
+    EXPECT_EQ(0u, null::GetCallCount(null::Call::QueryInterface));
+
+    auto unknown = fence.As<IUnknown>();
+    EXPECT_TRUE(unknown);
+    EXPECT_EQ(0u, null::GetCallCount(null::Call::QueryInterface));
+}
+
+TEST(ComPtr, AsThrowsOnAMissingInterface)
+{
+    auto fence = null::CreateFence();
+    EXPECT_THROW(fence.As<ID3D12Device>(), std::exception);
+}
@@ -0,0 +1,157 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+#include <d12w/util.h>
+
+using namespace d12w;
+
+namespace
+{
+    struct KnownError
+    {
+        HRESULT          code;
+        std::string_view name;
+    };
+
+    #define KNOWN_ERROR(CODE) KnownError{static_cast<HRESULT>(CODE), #CODE}
+
+    // every entry of the built-in table, the lookup is a binary search and
+    // only finds all of them if the table is sorted
+    constexpr KnownError knownErrors[] = {
+        KNOWN_ERROR(S_OK),
+        KNOWN_ERROR(S_FALSE),
+        KNOWN_ERROR(ERROR_FILE_NOT_FOUND),
+        KNOWN_ERROR(ERROR_PATH_NOT_FOUND),
+        KNOWN_ERROR(ERROR_ACCESS_DENIED),
+        KNOWN_ERROR(ERROR_INVALID_HANDLE),
+        KNOWN_ERROR(ERROR_NOT_ENOUGH_MEMORY),
+        KNOWN_ERROR(ERROR_INVALID_PARAMETER),
+        KNOWN_ERROR(ERROR_INVALID_WINDOW_HANDLE),
+        KNOWN_ERROR(ERROR_CLASS_ALREADY_EXISTS),
+        KNOWN_ERROR(ERROR_CLASS_DOES_NOT_EXIST),
+        KNOWN_ERROR(DXGI_STATUS_OCCLUDED),
+        KNOWN_ERROR(DXGI_STATUS_CLIPPED),
+        KNOWN_ERROR(DXGI_STATUS_MODE_CHANGED),
+        KNOWN_ERROR(DXGI_STATUS_MODE_CHANGE_IN_PROGRESS),
+        KNOWN_ERROR(E_NOTIMPL),
+        KNOWN_ERROR(E_NOINTERFACE),
+        KNOWN_ERROR(E_POINTER),
+        KNOWN_ERROR(E_ABORT),
+        KNOWN_ERROR(E_FAIL),
+        KNOWN_ERROR(E_UNEXPECTED),
+        KNOWN_ERROR(E_ACCESSDENIED),
+        KNOWN_ERROR(E_HANDLE),
+        KNOWN_ERROR(E_OUTOFMEMORY),
+        KNOWN_ERROR(E_INVALIDARG),
+        KNOWN_ERROR(DXGI_ERROR_INVALID_CALL),
+        KNOWN_ERROR(DXGI_ERROR_NOT_FOUND),
+        KNOWN_ERROR(DXGI_ERROR_MORE_DATA),
+        KNOWN_ERROR(DXGI_ERROR_UNSUPPORTED),
+        KNOWN_ERROR(DXGI_ERROR_DEVICE_REMOVED),
+        KNOWN_ERROR(DXGI_ERROR_DEVICE_HUNG),
+        KNOWN_ERROR(DXGI_ERROR_DEVICE_RESET),
+        KNOWN_ERROR(DXGI_ERROR_WAS_STILL_DRAWING),
+        KNOWN_ERROR(DXGI_ERROR_FRAME_STATISTICS_DISJOINT),
+        KNOWN_ERROR(DXGI_ERROR_GRAPHICS_VIDPN_SOURCE_IN_USE),
+        KNOWN_ERROR(DXGI_ERROR_DRIVER_INTERNAL_ERROR),
+        KNOWN_ERROR(DXGI_ERROR_NONEXCLUSIVE),
+        KNOWN_ERROR(DXGI_ERROR_NOT_CURRENTLY_AVAILABLE),
+        KNOWN_ERROR(DXGI_ERROR_REMOTE_CLIENT_DISCONNECTED),
+        KNOWN_ERROR(DXGI_ERROR_REMOTE_OUTOFMEMORY),
+        KNOWN_ERROR(DXGI_ERROR_MODE_CHANGE_IN_PROGRESS),
+        KNOWN_ERROR(DXGI_ERROR_ACCESS_LOST),
+        KNOWN_ERROR(DXGI_ERROR_WAIT_TIMEOUT),
+        KNOWN_ERROR(DXGI_ERROR_SESSION_DISCONNECTED),
+        KNOWN_ERROR(DXGI_ERROR_RESTRICT_TO_OUTPUT_STALE),
+        KNOWN_ERROR(DXGI_ERROR_CANNOT_PROTECT_CONTENT),
+        KNOWN_ERROR(DXGI_ERROR_ACCESS_DENIED),
+        KNOWN_ERROR(DXGI_ERROR_NAME_ALREADY_EXISTS),
+        KNOWN_ERROR(DXGI_ERROR_SDK_COMPONENT_MISSING),
+        KNOWN_ERROR(DXGI_ERROR_NOT_CURRENT),
+        KNOWN_ERROR(DXGI_ERROR_HW_PROTECTION_OUTOFMEMORY),
+        KNOWN_ERROR(DXGI_ERROR_DYNAMIC_CODE_POLICY_VIOLATION),
+        KNOWN_ERROR(DXGI_ERROR_NON_COMPOSITED_UI),
+        KNOWN_ERROR(D3D12_ERROR_ADAPTER_NOT_FOUND),
+        KNOWN_ERROR(D3D12_ERROR_DRIVER_VERSION_MISMATCH),
+        KNOWN_ERROR(D3D12_ERROR_INVALID_REDIST),
+    };
+}
+
+TEST(Errors, KnownCodesAreFound)
+{
+    for (const auto& error : knownErrors)
+    {
+        EXPECT_EQ(error.name, util::GetErrorName(error.code));
+        EXPECT_FALSE(util::LookupErrorMessage(error.code).empty()) << error.name;
+    }
+}
+
+TEST(Errors, UnknownCodesFallBack)
+{
+    for (auto code : {HRESULT(0x12345678), HRESULT(0x887A0008), HRESULT(0x887A00FF), HRESULT(0xFFFFFFFF)})
+    {
+        EXPECT_TRUE(util::GetErrorName(code).empty());
+        EXPECT_TRUE(util::LookupErrorMessage(code).empty());
+    }
+
+    auto buffer = std::array<char, 64>{};
+    auto length = util::FormatErrorMessage(HRESULT(0x887A00FF), buffer.data(), buffer.size());
+    EXPECT_EQ("Unknown error 0x887A00FF.", std::string_view(buffer.data(), length));
+    EXPECT_EQ(0, buffer[length]);
+}
+
+TEST(Errors, FormatErrorMessageWritesNameAndDescription)
+{
+    auto buffer = std::array<char, 256>{};
+    auto length = util::FormatErrorMessage(DXGI_ERROR_DEVICE_REMOVED, buffer.data(), buffer.size());
+    auto text = std::string_view(buffer.data(), length);
+    EXPECT_EQ(0u, text.find("DXGI_ERROR_DEVICE_REMOVED: "));
+    EXPECT_EQ(std::string{text}, util::GetErrorMessage(DXGI_ERROR_DEVICE_REMOVED));
+}
+
+TEST(Errors, FormatErrorMessageTruncates)
+{
+    auto buffer = std::array<char, 8>{};
+    auto length = util::FormatErrorMessage(E_INVALIDARG, buffer.data(), buffer.size());
+    EXPECT_EQ(7u, length);
+    EXPECT_EQ("E_INVAL", std::string_view(buffer.data()));
+
+    EXPECT_EQ(0u, util::FormatErrorMessage(E_INVALIDARG, buffer.data(), 0));
+}
+
+TEST(Errors, CheckSuccessThrowsWithTheErrorName)
+{
+    try
+    {
+        D12W_CHECK_SUCCESS(DXGI_ERROR_DEVICE_HUNG);
+        FAIL();
+    }
+    catch (const std::exception& ex)
+    {
+        EXPECT_NE(nullptr, std::strstr(ex.what(), "DXGI_ERROR_DEVICE_HUNG"));
+    }
+}
@@ -0,0 +1,136 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <d12w/JobPool.h>
+
+using namespace d12w;
+
+TEST(JobPool, EveryJobRunsOnce)
+{
+    auto pool = JobPool{4};
+    EXPECT_EQ(4u, pool.GetThreadCount());
+
+    auto runs = std::vector<std::atomic<int>>(1000);
+    pool.Run(runs.size(), [&] (size_t i) {
+        runs[i]++;
+    });
+    for (const auto& count : runs)
+    {
+        EXPECT_EQ(1, count.load());
+    }
+}
+
+TEST(JobPool, WithoutThreadsJobsRunOnTheCaller)
+{
+    auto pool = JobPool{0};
+    auto caller = std::this_thread::get_id();
+    auto others = 0;
+    pool.Run(100, [&] (size_t) {
+        others += std::this_thread::get_id() != caller ? 1 : 0;
+    });
+    EXPECT_EQ(0, others);
+}
+
+TEST(JobPool, UnevenJobsAreStolen)
+{
+    auto pool = JobPool{4};
+
+    // consecutive jobs share a queue, the slow first four must be taken by others
+    auto threads = std::vector<std::thread::id>(16);
+    pool.Run(threads.size(), [&] (size_t i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(i < 4 ? 20 : 1));
+        threads[i] = std::this_thread::get_id();
+    });
+    threads.resize(4);
+
+    auto distinct = std::vector<std::thread::id>{};
+    for (auto id : threads)
+    {
+        if (std::find(distinct.begin(), distinct.end(), id) == distinct.end())
+        {
+            distinct.push_back(id);
+        }
+    }
+    EXPECT_GT(distinct.size(), 1u);
+}
+
+TEST(JobPool, TheFirstExceptionIsRethrown)
+{
+    auto pool = JobPool{4};
+
+    auto runs = std::atomic<int>{0};
+    EXPECT_THROW(pool.Run(100, [&] (size_t i) {
+        runs++;
+        if (i % 10 == 0)
+        {
+            throw std::runtime_error("job failed");
+        }
+    }), std::runtime_error);
+
+    // the other jobs still ran
+    EXPECT_EQ(100, runs.load());
+}
+
+TEST(JobPool, RunCanBeNested)
+{
+    auto pool = JobPool{4};
+
+    auto runs = std::atomic<int>{0};
+    pool.Run(8, [&] (size_t) {
+        pool.Run(8, [&] (size_t) {
+            runs++;
+        });
+    });
+    EXPECT_EQ(64, runs.load());
+}
+
+TEST(JobPool, RunFromSeveralThreads)
+{
+    auto pool = JobPool{4};
+
+    auto runs = std::atomic<int>{0};
+    auto callers = std::vector<std::thread>{};
+    for (auto t = 0; t < 4; t++)
+    {
+        callers.emplace_back([&] () {
+            for (auto i = 0; i < 50; i++)
+            {
+                pool.Run(16, [&] (size_t) {
+                    runs++;
+                });
+            }
+        });
+    }
+    for (auto& caller : callers)
+    {
+        caller.join();
+    }
+    EXPECT_EQ(4 * 50 * 16, runs.load());
+}
@@ -0,0 +1,178 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <stdexcept>
+
+#include <d12w/util.h>
+
+using namespace d12w;
+
+namespace
+{
+    // straightforward reference encoders to check the transcoder against
+
+    void AppendUtf8(std::string& out, char32_t cp)
+    {
+        if (cp < 0x80)
+        {
+            out.push_back(static_cast<char>(cp));
+        }
+        else if (cp < 0x800)
+        {
+            out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        }
+        else if (cp < 0x10000)
+        {
+            out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        }
+        else
+        {
+            out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        }
+    }
+
+    void AppendWide(std::wstring& out, char32_t cp)
+    {
+        if (sizeof(wchar_t) == 2 && cp >= 0x10000)
+        {
+            out.push_back(static_cast<wchar_t>(0xD800 + ((cp - 0x10000) >> 10)));
+            out.push_back(static_cast<wchar_t>(0xDC00 + ((cp - 0x10000) & 0x3FF)));
+        }
+        else
+        {
+            out.push_back(static_cast<wchar_t>(cp));
+        }
+    }
+
+    // mostly ASCII runs, so that the vectorized paths are hit, mixed with all other lengths
+    char32_t RandomCodePoint(std::mt19937& rng)
+    {
+        switch (rng() % 6)
+        {
+            case 0:
+                return 0x80 + rng() % (0x800 - 0x80);
+            case 1:
+            {
+                auto cp = 0x800 + rng() % (0x10000 - 0x800);
+                return (cp >= 0xD800 && cp <= 0xDFFF) ? 0xFFFD : cp;
+            }
+            case 2:
+                return 0x10000 + rng() % (0x110000 - 0x10000);
+            default:
+                return rng() % 0x80;
+        }
+    }
+}
+
+TEST(Unicode, WidenAndNarrowKnownStrings)
+{
+    EXPECT_EQ(L"", util::widen(""));
+    EXPECT_EQ(L"Hello World", util::widen("Hello World"));
+    EXPECT_EQ(L"Grüße € \U0001F600", util::widen("Gr\xC3\xBC\xC3\x9F" "e \xE2\x82\xAC \xF0\x9F\x98\x80"));
+
+    EXPECT_EQ("", util::narrow(L""));
+    EXPECT_EQ("Hello World", util::narrow(L"Hello World"));
+    EXPECT_EQ("Gr\xC3\xBC\xC3\x9F" "e \xE2\x82\xAC \xF0\x9F\x98\x80", util::narrow(L"Grüße € \U0001F600"));
+}
+
+TEST(Unicode, WidenRejectsInvalidUtf8)
+{
+    // truncated, lone continuation, overlong, surrogate, above U+10FFFF, invalid lead byte
+    for (auto invalid : {"\xC3", "abc\x80", "\xC0\xAF", "\xE0\x80\xAF", "\xED\xA0\x80", "\xF4\x90\x80\x80", "\xFF"})
+    {
+        EXPECT_THROW(util::widen(invalid), std::logic_error) << invalid;
+    }
+}
+
+TEST(Unicode, WidenLeavesResultUnchangedOnError)
+{
+    auto result = std::wstring{L"prefix"};
+    EXPECT_THROW(util::widen("ab\xC3", result), std::logic_error);
+    EXPECT_EQ(L"prefix", result);
+
+    util::widen("abc", result);
+    EXPECT_EQ(L"prefixabc", result);
+}
+
+TEST(Unicode, NarrowReplacesUnpairedSurrogates)
+{
+    auto value = std::wstring{L"a"};
+    value.push_back(static_cast<wchar_t>(0xD800));
+    value.push_back(L'b');
+    EXPECT_EQ("a\xEF\xBF\xBD" "b", util::narrow(value));
+}
+
+// random strings of valid code points must round-trip and match the reference encoders
+TEST(Unicode, FuzzRoundTripValidStrings)
+{
+    auto rng = std::mt19937{42};
+    for (auto i = 0; i < 2000; i++)
+    {
+        auto utf8 = std::string{};
+        auto wide = std::wstring{};
+        auto length = rng() % 100;
+        for (auto j = 0u; j < length; j++)
+        {
+            auto cp = RandomCodePoint(rng);
+            AppendUtf8(utf8, cp);
+            AppendWide(wide, cp);
+        }
+
+        ASSERT_EQ(wide, util::widen(utf8));
+        ASSERT_EQ(utf8, util::narrow(wide));
+    }
+}
+
+// random bytes either fail to widen or round-trip exactly
+TEST(Unicode, FuzzRandomBytes)
+{
+    auto rng = std::mt19937{7};
+    auto accepted = 0;
+    for (auto i = 0; i < 20000; i++)
+    {
+        auto bytes = std::string(rng() % 24, '\0');
+        for (auto& c : bytes)
+        {
+            // bias towards ASCII, or nearly everything is invalid
+            c = static_cast<char>(rng() % 3 == 0 ? rng() : rng() % 0x80);
+        }
+
+        try
+        {
+            auto wide = util::widen(bytes);
+            ASSERT_EQ(bytes, util::narrow(wide));
+            accepted++;
+        }
+        catch (const std::logic_error&)
+        {
+        }
+    }
+    EXPECT_GT(accepted, 0);
+}
@@ -0,0 +1,161 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include <d12w/d3d/BindlessTable.h>
+#include <d12w/d3d/Device.h>
+#include <d12wnull/null.h>
+
+using namespace d12w;
+
+TEST(BindlessTable, HandlesAreValidUntilFreed)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    auto table  = d3d::BindlessTable{device, 4};
+
+    auto a = table.Allocate();
+    auto b = table.Allocate();
+    EXPECT_EQ(0u, a.index);
+    EXPECT_EQ(1u, b.index);
+    EXPECT_TRUE(table.IsValid(a));
+    EXPECT_TRUE(table.IsValid(b));
+
+    table.Free(a, 1);
+    EXPECT_FALSE(table.IsValid(a));
+    EXPECT_TRUE(table.IsValid(b));
+
+    table.Release(1);
+}
+
+TEST(BindlessTable, FreeingAStaleHandleThrows)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    auto table  = d3d::BindlessTable{device, 4};
+
+    auto handle = table.Allocate();
+    auto copy   = handle;
+    table.Free(handle, 1);
+    EXPECT_THROW(table.Free(copy, 2), std::logic_error);
+    EXPECT_THROW(table.Free(d3d::BindlessHandle{}, 2), std::logic_error);
+
+    table.Release(2);
+}
+
+TEST(BindlessTable, SlotsAreReusedAfterRetire)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    auto table  = d3d::BindlessTable{device, 2};
+
+    auto a = table.Allocate();
+    auto b = table.Allocate();
+    EXPECT_THROW(table.Allocate(), std::runtime_error);
+
+    table.Free(a, 1);
+    table.Retire(0);
+    EXPECT_THROW(table.Allocate(), std::runtime_error);
+
+    table.Retire(1);
+    auto c = table.Allocate();
+    EXPECT_EQ(a.index, c.index);
+    EXPECT_NE(a.generation, c.generation);
+    EXPECT_FALSE(table.IsValid(a));
+    EXPECT_TRUE(table.IsValid(b));
+    EXPECT_TRUE(table.IsValid(c));
+
+    table.Release(1);
+}
+
+TEST(BindlessTable, SlotsAreRetiredOutOfOrder)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    auto table  = d3d::BindlessTable{device, 2};
+
+    auto a = table.Allocate();
+    auto b = table.Allocate();
+    table.Free(a, 2);
+    table.Free(b, 1);
+
+    table.Retire(1);
+    EXPECT_EQ(b.index, table.Allocate().index);
+    EXPECT_THROW(table.Allocate(), std::runtime_error);
+
+    table.Release(2);
+}
+
+TEST(BindlessTable, HeapIndicesAreOffsetByTheRange)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    auto first  = d3d::BindlessTable{device, 4};
+    auto second = d3d::BindlessTable{device, 4};
+
+    auto a = first.Allocate();
+    auto b = second.Allocate();
+    EXPECT_EQ(first.GetHeapIndex(a) + 4, second.GetHeapIndex(b));
+    EXPECT_NE(first.GetGpuHandle().ptr, second.GetGpuHandle().ptr);
+    EXPECT_EQ(4u, first.GetCapacity());
+
+    first.Release(1);
+    second.Release(1);
+}
+
+TEST(BindlessTable, ReleaseWaitsForTheFence)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    auto& heap  = device.GetShaderVisibleDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+
+    // a table that covers the whole persistent region
+    auto table = d3d::BindlessTable{device, 65536};
+    table.Allocate();
+    table.Release(5);
+
+    heap.Retire(4);
+    EXPECT_THROW(heap.AllocatePersistent(1), std::runtime_error);
+
+    heap.Retire(5);
+    EXPECT_EQ(0u, heap.AllocatePersistent(65536).index);
+}
+
+TEST(BindlessTable, DestroyingAnUnreleasedTableLeaksTheRange)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    auto& heap  = device.GetShaderVisibleDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+
+    {
+        auto table = d3d::BindlessTable{device, 65536};
+        table.Allocate();
+    }
+
+    heap.Retire(UINT64_MAX - 1);
+    EXPECT_THROW(heap.AllocatePersistent(1), std::runtime_error);
+}
+
+TEST(BindlessTable, UnwindingPastAnUnreleasedTableDoesNotTerminate)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    auto setup = [&device] () {
+        auto table = d3d::BindlessTable{device, 16};
+        throw std::runtime_error("frame setup failed");
+    };
+    EXPECT_THROW(setup(), std::runtime_error);
+}
@@ -0,0 +1,141 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include <d12w/d3d/CommandAllocatorPool.h>
+#include <d12w/d3d/Device.h>
+#include <d12wnull/null.h>
+
+using namespace d12w;
+
+TEST(CommandAllocatorPool, AllocatorsAreReusedOnceTheFenceCompleted)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    auto pool   = d3d::CommandAllocatorPool{device, D3D12_COMMAND_LIST_TYPE_DIRECT};
+    EXPECT_EQ(D3D12_COMMAND_LIST_TYPE_DIRECT, pool.GetType());
+
+    auto first = pool.Acquire();
+    auto raw   = first.Get();
+    pool.Release(std::move(first), 1);
+
+    // still in flight, a new allocator is created
+    pool.Retire(0);
+    auto second = pool.Acquire();
+    EXPECT_NE(raw, second.Get());
+    pool.Release(std::move(second), 2);
+
+    pool.Retire(1);
+    auto reused = pool.Acquire();
+    EXPECT_EQ(raw, reused.Get());
+    EXPECT_EQ(1u, static_cast<null::CommandAllocator*>(reused.Get())->GetResetCount());
+    EXPECT_EQ(D3D12_COMMAND_LIST_TYPE_DIRECT, static_cast<null::CommandAllocator*>(reused.Get())->GetType());
+
+    auto stats = pool.GetStats();
+    EXPECT_EQ(3u, stats.acquired);
+    EXPECT_EQ(2u, stats.created);
+}
+
+TEST(CommandAllocatorPool, AllocatorsAreReusedLateNeverEarly)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    auto pool   = d3d::CommandAllocatorPool{device, D3D12_COMMAND_LIST_TYPE_COPY};
+
+    auto a = pool.Acquire();
+    auto b = pool.Acquire();
+    pool.Release(std::move(a), 3);
+    pool.Release(std::move(b), 2);
+
+    // b waits behind a
+    pool.Retire(2);
+    pool.Acquire();
+    EXPECT_EQ(3u, pool.GetStats().created);
+}
+
+TEST(CommandAllocatorPool, TrimReleasesIdleAllocators)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    auto pool   = d3d::CommandAllocatorPool{device, D3D12_COMMAND_LIST_TYPE_DIRECT};
+
+    // a peak of four allocators
+    auto allocators = std::vector<ComPtr<ID3D12CommandAllocator>>{};
+    for (auto i = 0; i < 4; i++)
+    {
+        allocators.push_back(pool.Acquire());
+    }
+    for (auto& allocator : allocators)
+    {
+        pool.Release(std::move(allocator), 1);
+    }
+    pool.Retire(1);
+
+    // the first trim only marks the allocators as idle
+    pool.Trim();
+    EXPECT_EQ(0u, pool.GetStats().trimmed);
+
+    // one allocator is used in the meantime, the other three are released
+    pool.Release(pool.Acquire(), 2);
+    pool.Retire(2);
+    pool.Trim();
+    EXPECT_EQ(3u, pool.GetStats().trimmed);
+
+    pool.Acquire();
+    EXPECT_EQ(4u, pool.GetStats().created);
+    pool.Acquire();
+    EXPECT_EQ(5u, pool.GetStats().created);
+}
+
+TEST(CommandAllocatorPool, StressConcurrentRecording)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    auto pool   = d3d::CommandAllocatorPool{device, D3D12_COMMAND_LIST_TYPE_DIRECT};
+
+    constexpr auto THREADS = 8u;
+    constexpr auto FRAMES  = 100u;
+
+    for (auto frame = UINT64{1}; frame <= FRAMES; frame++)
+    {
+        auto threads = std::vector<std::thread>{};
+        for (auto t = 0u; t < THREADS; t++)
+        {
+            threads.emplace_back([&] () {
+                pool.Release(pool.Acquire(), frame);
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        // two frames in flight
+        if (frame > 2)
+        {
+            pool.Retire(frame - 2);
+        }
+    }
+
+    auto stats = pool.GetStats();
+    EXPECT_EQ(THREADS * FRAMES, stats.acquired);
+    EXPECT_LE(stats.created, 3 * THREADS);
+}
@@ -0,0 +1,208 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include <d12w/d3d/CommandList.h>
+#include <d12w/d3d/Device.h>
+#include <d12w/d3d/Resource.h>
+#include <d12wnull/null.h>
+
+using namespace d12w;
+
+namespace
+{
+    std::unique_ptr<d3d::Resource> CreateBuffer(d3d::Device& device, D3D12_RESOURCE_STATES state)
+    {
+        auto heap = D3D12_HEAP_PROPERTIES{};
+        heap.Type = D3D12_HEAP_TYPE_DEFAULT;
+
+        auto desc = D3D12_RESOURCE_DESC{};
+        desc.Dimension        = D3D12_RESOURCE_DIMENSION_BUFFER;
+        desc.Width            = 256;
+        desc.Height           = 1;
+        desc.DepthOrArraySize = 1;
+        desc.MipLevels        = 1;
+        desc.SampleDesc.Count = 1;
+        desc.Layout           = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+        return std::make_unique<d3d::Resource>(device.CreateCommittedResource(heap, D3D12_HEAP_FLAG_NONE, desc, state), state);
+    }
+
+    std::unique_ptr<d3d::Resource> CreateTexture(d3d::Device& device, UINT16 mips, UINT16 slices, D3D12_RESOURCE_STATES state)
+    {
+        auto heap = D3D12_HEAP_PROPERTIES{};
+        heap.Type = D3D12_HEAP_TYPE_DEFAULT;
+
+        auto desc = D3D12_RESOURCE_DESC{};
+        desc.Dimension        = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+        desc.Width            = 256;
+        desc.Height           = 256;
+        desc.DepthOrArraySize = slices;
+        desc.MipLevels        = mips;
+        desc.Format           = DXGI_FORMAT_R8G8B8A8_UNORM;
+        desc.SampleDesc.Count = 1;
+        return std::make_unique<d3d::Resource>(device.CreateCommittedResource(heap, D3D12_HEAP_FLAG_NONE, desc, state), state);
+    }
+
+    struct Recording
+    {
+        d3d::Device                            device{null::CreateDevice()};
+        ComPtr<ID3D12CommandAllocator>         allocator = device.CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT);
+        d3d::CommandList                       list{device, D3D12_COMMAND_LIST_TYPE_DIRECT, allocator.Get()};
+
+        null::CommandList& GetNull()
+        {
+            return *static_cast<null::CommandList*>(list.GetCommandList());
+        }
+    };
+}
+
+TEST(CommandList, FirstUseNeedsNoBarrier)
+{
+    auto r      = Recording{};
+    auto buffer = CreateBuffer(r.device, D3D12_RESOURCE_STATE_COPY_DEST);
+
+    r.list.Transition(*buffer, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER);
+    r.list.DrawInstanced(3);
+
+    // the state the list starts in is resolved by the queue
+    EXPECT_EQ(0u, r.GetNull().GetBarrierCallCount());
+}
+
+TEST(CommandList, BarriersAreBatchedPerDraw)
+{
+    auto r = Recording{};
+    auto buffers = std::vector<std::unique_ptr<d3d::Resource>>{};
+    for (auto i = 0; i < 5; i++)
+    {
+        buffers.push_back(CreateBuffer(r.device, D3D12_RESOURCE_STATE_COMMON));
+    }
+
+    for (auto& buffer : buffers)
+    {
+        r.list.Transition(*buffer, D3D12_RESOURCE_STATE_COPY_DEST);
+    }
+    r.list.CopyBufferRegion(buffers[0]->GetResource(), 0, buffers[1]->GetResource(), 0, 256);
+    for (auto& buffer : buffers)
+    {
+        r.list.Transition(*buffer, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    }
+    EXPECT_EQ(0u, r.GetNull().GetBarrierCallCount());
+
+    r.list.DrawInstanced(3);
+
+    ASSERT_EQ(1u, r.GetNull().GetBarrierCallCount());
+    ASSERT_EQ(5u, r.GetNull().GetBarriers().size());
+    for (auto i = 0u; i < buffers.size(); i++)
+    {
+        auto& barrier = r.GetNull().GetBarriers()[i];
+        EXPECT_EQ(D3D12_RESOURCE_BARRIER_TYPE_TRANSITION, barrier.Type);
+        EXPECT_EQ(buffers[i]->GetResource(), barrier.Transition.pResource);
+        EXPECT_EQ(D3D12_RESOURCE_STATE_COPY_DEST, barrier.Transition.StateBefore);
+        EXPECT_EQ(D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, barrier.Transition.StateAfter);
+    }
+}
+
+TEST(CommandList, ReadStatesAreCombined)
+{
+    auto r      = Recording{};
+    auto buffer = CreateBuffer(r.device, D3D12_RESOURCE_STATE_COMMON);
+
+    r.list.Transition(*buffer, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    r.list.DrawInstanced(3);
+    r.list.Transition(*buffer, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+    r.list.Dispatch(1);
+    r.list.Transition(*buffer, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    r.list.DrawInstanced(3);
+
+    ASSERT_EQ(1u, r.GetNull().GetBarrierCallCount());
+    auto& barrier = r.GetNull().GetBarriers().front();
+    EXPECT_EQ(D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, barrier.Transition.StateBefore);
+    EXPECT_EQ(D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE, barrier.Transition.StateAfter);
+}
+
+TEST(CommandList, UndoneTransitionIsDropped)
+{
+    auto r      = Recording{};
+    auto buffer = CreateBuffer(r.device, D3D12_RESOURCE_STATE_COMMON);
+
+    r.list.Transition(*buffer, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    r.list.DrawInstanced(3);
+    r.list.Transition(*buffer, D3D12_RESOURCE_STATE_RENDER_TARGET);
+    r.list.Transition(*buffer, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    r.list.DrawInstanced(3);
+
+    EXPECT_EQ(0u, r.GetNull().GetBarrierCallCount());
+}
+
+TEST(CommandList, UavBarriersAreIssuedOnce)
+{
+    auto r      = Recording{};
+    auto buffer = CreateBuffer(r.device, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+    r.list.Transition(*buffer, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+    r.list.Dispatch(1);
+    r.list.UavBarrier(buffer.get());
+    r.list.UavBarrier(buffer.get());
+    r.list.Dispatch(1);
+
+    ASSERT_EQ(1u, r.GetNull().GetBarrierCallCount());
+    ASSERT_EQ(1u, r.GetNull().GetBarriers().size());
+    EXPECT_EQ(D3D12_RESOURCE_BARRIER_TYPE_UAV, r.GetNull().GetBarriers().front().Type);
+    EXPECT_EQ(buffer->GetResource(), r.GetNull().GetBarriers().front().UAV.pResource);
+}
+
+TEST(CommandList, SubresourcesAreTrackedSeparately)
+{
+    auto r       = Recording{};
+    auto texture = CreateTexture(r.device, 4, 2, D3D12_RESOURCE_STATE_COMMON);
+    ASSERT_EQ(8u, texture->GetSubresourceCount());
+
+    r.list.Transition(*texture, D3D12_RESOURCE_STATE_RENDER_TARGET, 1);
+    r.list.DrawInstanced(3);
+    r.list.Transition(*texture, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    r.list.DrawInstanced(3);
+
+    // only the subresource with a known state needs a barrier, the others start in the shader state
+    ASSERT_EQ(1u, r.GetNull().GetBarrierCallCount());
+    ASSERT_EQ(1u, r.GetNull().GetBarriers().size());
+    auto& barrier = r.GetNull().GetBarriers().front();
+    EXPECT_EQ(1u, barrier.Transition.Subresource);
+    EXPECT_EQ(D3D12_RESOURCE_STATE_RENDER_TARGET, barrier.Transition.StateBefore);
+    EXPECT_EQ(D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, barrier.Transition.StateAfter);
+}
+
+TEST(CommandList, CloseIssuesPendingBarriers)
+{
+    auto r      = Recording{};
+    auto buffer = CreateBuffer(r.device, D3D12_RESOURCE_STATE_COMMON);
+
+    r.list.Transition(*buffer, D3D12_RESOURCE_STATE_COPY_DEST);
+    r.list.CopyBufferRegion(buffer->GetResource(), 0, buffer->GetResource(), 128, 128);
+    r.list.Transition(*buffer, D3D12_RESOURCE_STATE_COPY_SOURCE);
+    r.list.Close();
+
+    EXPECT_EQ(1u, r.GetNull().GetBarrierCallCount());
+    EXPECT_TRUE(r.GetNull().IsClosed());
+}
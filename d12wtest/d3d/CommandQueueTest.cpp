@@ -0,0 +1,222 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <d12w/d3d/CommandList.h>
+#include <d12w/d3d/CommandQueue.h>
+#include <d12w/d3d/Device.h>
+#include <d12w/d3d/Resource.h>
+#include <d12wnull/null.h>
+
+using namespace d12w;
+
+namespace
+{
+    // remembers the lists in the order they were submitted
+    class RecordingQueue : public null::CommandQueue
+    {
+    public:
+        std::vector<ID3D12CommandList*> executed;
+
+        RecordingQueue(ComPtr<ID3D12Device> device, const D3D12_COMMAND_QUEUE_DESC& desc)
+        : null::CommandQueue(std::move(device), desc) {}
+
+        void STDMETHODCALLTYPE ExecuteCommandLists(UINT NumCommandLists, ID3D12CommandList* const* ppCommandLists) override
+        {
+            executed.insert(executed.end(), ppCommandLists, ppCommandLists + NumCommandLists);
+            null::CommandQueue::ExecuteCommandLists(NumCommandLists, ppCommandLists);
+        }
+    };
+
+    std::unique_ptr<d3d::Resource> CreateBuffer(d3d::Device& device, D3D12_RESOURCE_STATES state)
+    {
+        auto heap = D3D12_HEAP_PROPERTIES{};
+        heap.Type = D3D12_HEAP_TYPE_DEFAULT;
+
+        auto desc = D3D12_RESOURCE_DESC{};
+        desc.Dimension        = D3D12_RESOURCE_DIMENSION_BUFFER;
+        desc.Width            = 256;
+        desc.Height           = 1;
+        desc.DepthOrArraySize = 1;
+        desc.MipLevels        = 1;
+        desc.SampleDesc.Count = 1;
+        desc.Layout           = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+        return std::make_unique<d3d::Resource>(device.CreateCommittedResource(heap, D3D12_HEAP_FLAG_NONE, desc, state), state);
+    }
+
+    struct Submission
+    {
+        ComPtr<ID3D12Device2>          nullDevice = null::CreateDevice();
+        d3d::Device                    device{nullDevice};
+        RecordingQueue*                recording  = nullptr;
+        d3d::CommandQueue              queue{MakeQueue(), device.CreateFence(), &device};
+        ComPtr<ID3D12CommandAllocator> allocator  = device.CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT);
+
+        ComPtr<ID3D12CommandQueue> MakeQueue()
+        {
+            auto desc = D3D12_COMMAND_QUEUE_DESC{};
+            desc.Type = D3D12_COMMAND_LIST_TYPE_DIRECT;
+            recording = new RecordingQueue(nullDevice, desc);
+            auto result = ComPtr<ID3D12CommandQueue>{};
+            result.Attach(recording);
+            return result;
+        }
+
+        const std::vector<D3D12_RESOURCE_BARRIER>& GetBarriers(size_t executed)
+        {
+            return static_cast<null::CommandList*>(recording->executed[executed])->GetBarriers();
+        }
+    };
+}
+
+TEST(CommandQueue, FixupExecutesBeforeTheList)
+{
+    auto s      = Submission{};
+    auto buffer = CreateBuffer(s.device, D3D12_RESOURCE_STATE_COPY_DEST);
+
+    auto list = d3d::CommandList{s.device, D3D12_COMMAND_LIST_TYPE_DIRECT, s.allocator.Get()};
+    list.Transition(*buffer, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER);
+    list.DrawInstanced(3);
+    list.Transition(*buffer, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+    list.Close();
+
+    auto lists = std::vector<d3d::CommandList*>{&list};
+    s.queue.ExecuteCommandLists(1, lists.data());
+
+    ASSERT_EQ(2u, s.recording->executed.size());
+    EXPECT_EQ(list.GetCommandList(), s.recording->executed[1]);
+    ASSERT_EQ(1u, s.GetBarriers(0).size());
+    EXPECT_EQ(buffer->GetResource(), s.GetBarriers(0)[0].Transition.pResource);
+    EXPECT_EQ(D3D12_RESOURCE_STATE_COPY_DEST, s.GetBarriers(0)[0].Transition.StateBefore);
+    EXPECT_EQ(D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER, s.GetBarriers(0)[0].Transition.StateAfter);
+    EXPECT_EQ(D3D12_RESOURCE_STATE_UNORDERED_ACCESS, buffer->GetState());
+}
+
+TEST(CommandQueue, NoFixupWhenTheStateMatches)
+{
+    auto s      = Submission{};
+    auto buffer = CreateBuffer(s.device, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER);
+
+    auto list = d3d::CommandList{s.device, D3D12_COMMAND_LIST_TYPE_DIRECT, s.allocator.Get()};
+    list.Transition(*buffer, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER);
+    list.DrawInstanced(3);
+    list.Close();
+
+    auto value = s.queue.GetLastSignaledValue();
+    auto lists = std::vector<d3d::CommandList*>{&list};
+    s.queue.ExecuteCommandLists(1, lists.data());
+
+    ASSERT_EQ(1u, s.recording->executed.size());
+    EXPECT_EQ(list.GetCommandList(), s.recording->executed[0]);
+    EXPECT_EQ(value, s.queue.GetLastSignaledValue());
+}
+
+TEST(CommandQueue, FixupBetweenLists)
+{
+    auto s      = Submission{};
+    auto buffer = CreateBuffer(s.device, D3D12_RESOURCE_STATE_RENDER_TARGET);
+
+    auto first = d3d::CommandList{s.device, D3D12_COMMAND_LIST_TYPE_DIRECT, s.allocator.Get()};
+    first.Transition(*buffer, D3D12_RESOURCE_STATE_RENDER_TARGET);
+    first.DrawInstanced(3);
+    first.Close();
+
+    auto second = d3d::CommandList{s.device, D3D12_COMMAND_LIST_TYPE_DIRECT, s.allocator.Get()};
+    second.Transition(*buffer, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    second.DrawInstanced(3);
+    second.Close();
+
+    auto lists = std::vector<d3d::CommandList*>{&first, &second};
+    s.queue.ExecuteCommandLists(2, lists.data());
+
+    // the first list needs no fixup, the second starts after the first
+    ASSERT_EQ(3u, s.recording->executed.size());
+    EXPECT_EQ(first.GetCommandList(), s.recording->executed[0]);
+    EXPECT_EQ(second.GetCommandList(), s.recording->executed[2]);
+    ASSERT_EQ(1u, s.GetBarriers(1).size());
+    EXPECT_EQ(D3D12_RESOURCE_STATE_RENDER_TARGET, s.GetBarriers(1)[0].Transition.StateBefore);
+    EXPECT_EQ(D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, s.GetBarriers(1)[0].Transition.StateAfter);
+}
+
+TEST(CommandQueue, FixupIsFollowedByASignal)
+{
+    auto s      = Submission{};
+    auto buffer = CreateBuffer(s.device, D3D12_RESOURCE_STATE_COPY_DEST);
+
+    auto list = d3d::CommandList{s.device, D3D12_COMMAND_LIST_TYPE_DIRECT, s.allocator.Get()};
+    list.Transition(*buffer, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    list.DrawInstanced(3);
+    list.Close();
+
+    auto value = s.queue.GetLastSignaledValue();
+    auto lists = std::vector<d3d::CommandList*>{&list};
+    s.queue.ExecuteCommandLists(1, lists.data());
+
+    EXPECT_EQ(value + 1, s.queue.GetLastSignaledValue());
+    s.queue.WaitForValue(value + 1);
+}
+
+TEST(CommandQueue, FixupAllocatorsAreRecycled)
+{
+    auto s      = Submission{};
+    auto buffer = CreateBuffer(s.device, D3D12_RESOURCE_STATE_COPY_DEST);
+
+    auto list = d3d::CommandList{s.device, D3D12_COMMAND_LIST_TYPE_DIRECT, s.allocator.Get()};
+    list.Transition(*buffer, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    list.DrawInstanced(3);
+    list.Close();
+
+    // no Signal by the caller, the queue must still recycle the allocators
+    null::ResetCallCounts();
+    auto lists = std::vector<d3d::CommandList*>{&list};
+    for (auto i = 0; i < 100; i++)
+    {
+        buffer->SetState(D3D12_RESOURCE_STATE_COPY_DEST);
+        s.queue.ExecuteCommandLists(1, lists.data());
+        s.queue.WaitForValue(s.queue.GetLastSignaledValue());
+    }
+
+    EXPECT_EQ(200u, s.recording->executed.size());
+    EXPECT_GE(2u, null::GetCallCount(null::Call::CreateCommandAllocator));
+    EXPECT_GE(1u, null::GetCallCount(null::Call::CreateCommandList));
+}
+
+TEST(CommandQueue, FixupWithoutDeviceThrows)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    auto desc   = D3D12_COMMAND_QUEUE_DESC{};
+    desc.Type   = D3D12_COMMAND_LIST_TYPE_DIRECT;
+    auto queue  = d3d::CommandQueue{device.CreateCommandQueue(desc), device.CreateFence()};
+    auto buffer = CreateBuffer(device, D3D12_RESOURCE_STATE_COMMON);
+
+    auto allocator = device.CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT);
+    auto list = d3d::CommandList{device, D3D12_COMMAND_LIST_TYPE_DIRECT, allocator.Get()};
+    list.Transition(*buffer, D3D12_RESOURCE_STATE_RENDER_TARGET);
+    list.Close();
+
+    auto lists = std::vector<d3d::CommandList*>{&list};
+    EXPECT_THROW(queue.ExecuteCommandLists(1, lists.data()), std::logic_error);
+}
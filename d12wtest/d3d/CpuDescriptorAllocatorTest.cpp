@@ -0,0 +1,174 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <d12w/d3d/CpuDescriptorAllocator.h>
+#include <d12w/d3d/Device.h>
+#include <d12wnull/null.h>
+
+using namespace d12w;
+
+namespace
+{
+    d3d::CpuDescriptorAllocator MakeAllocator(uint32_t pageSize)
+    {
+        return d3d::CpuDescriptorAllocator{null::CreateDevice().As<ID3D12Device>(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, pageSize};
+    }
+}
+
+TEST(CpuDescriptorAllocator, AllocateReturnsDistinctDescriptors)
+{
+    auto allocator = d3d::CpuDescriptorAllocator{null::CreateDevice().As<ID3D12Device>(), D3D12_DESCRIPTOR_HEAP_TYPE_RTV, 64};
+
+    auto indices = std::set<uint32_t>{};
+    auto handles = std::set<SIZE_T>{};
+    for (auto i = 0; i < 1000; i++)
+    {
+        auto descriptor = allocator.Allocate();
+        ASSERT_TRUE(descriptor);
+        indices.insert(descriptor.index);
+        handles.insert(descriptor.handle.ptr);
+    }
+
+    EXPECT_EQ(1000u, indices.size());
+    EXPECT_EQ(1000u, handles.size());
+    EXPECT_EQ(16u, allocator.GetPageCount());
+    EXPECT_EQ(16u * 64u, allocator.GetCapacity());
+    EXPECT_EQ(D3D12_DESCRIPTOR_HEAP_TYPE_RTV, allocator.GetType());
+}
+
+TEST(CpuDescriptorAllocator, FreedDescriptorsAreReused)
+{
+    auto device = null::CreateDevice();
+    auto allocator = d3d::CpuDescriptorAllocator{device.As<ID3D12Device>(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, 64};
+
+    for (auto round = 0; round < 100; round++)
+    {
+        auto descriptors = std::vector<d3d::CpuDescriptor>{};
+        for (auto i = 0; i < 50; i++)
+        {
+            descriptors.push_back(allocator.Allocate());
+        }
+        for (const auto& descriptor : descriptors)
+        {
+            allocator.Free(descriptor);
+        }
+    }
+    EXPECT_EQ(1u, allocator.GetPageCount());
+
+    auto first = allocator.Allocate();
+    allocator.Free(first);
+    auto second = allocator.Allocate();
+    EXPECT_EQ(first.index, second.index);
+    EXPECT_EQ(first.handle.ptr, second.handle.ptr);
+}
+
+// descriptors cross threads: allocated on one, freed on another
+TEST(CpuDescriptorAllocator, StressConcurrentAllocateAndFree)
+{
+    constexpr auto THREADS = 8u;
+    constexpr auto ROUNDS  = 200u;
+    constexpr auto BATCH   = 100u;
+
+    auto allocator = MakeAllocator(256);
+    auto owners    = std::vector<std::atomic<uint32_t>>(THREADS * BATCH * 4);
+    auto duplicate = std::atomic<unsigned int>{0};
+    auto exchange  = std::vector<std::vector<d3d::CpuDescriptor>>(THREADS);
+    auto mutex     = std::mutex{};
+
+    auto threads = std::vector<std::thread>{};
+    for (auto t = 0u; t < THREADS; t++)
+    {
+        threads.emplace_back([&, t] () {
+            for (auto round = 0u; round < ROUNDS; round++)
+            {
+                auto descriptors = std::vector<d3d::CpuDescriptor>{};
+                for (auto i = 0u; i < BATCH; i++)
+                {
+                    auto descriptor = allocator.Allocate();
+                    if (descriptor.index >= owners.size() || owners[descriptor.index].exchange(t + 1) != 0)
+                    {
+                        duplicate++;
+                    }
+                    descriptors.push_back(descriptor);
+                }
+
+                // hand the batch to the next thread and free the one handed to this
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    std::swap(exchange[(t + 1) % THREADS], descriptors);
+                }
+                for (const auto& descriptor : descriptors)
+                {
+                    owners[descriptor.index].store(0);
+                    allocator.Free(descriptor);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(0u, duplicate);
+    // at most two batches per thread are live, plus the thread caches
+    EXPECT_LE(allocator.GetCapacity(), owners.size());
+}
+
+TEST(CpuDescriptorAllocator, ThreadCacheOutlivesTheAllocator)
+{
+    for (auto i = 0; i < 4; i++)
+    {
+        auto allocator = MakeAllocator(64);
+        auto descriptor = allocator.Allocate();
+        allocator.Free(descriptor);
+        EXPECT_EQ(1u, allocator.GetPageCount());
+    }
+}
+
+TEST(Device, CpuDescriptorAllocatorsArePerType)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+
+    auto& rtv = device.GetCpuDescriptorAllocator(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
+    auto& dsv = device.GetCpuDescriptorAllocator(D3D12_DESCRIPTOR_HEAP_TYPE_DSV);
+    EXPECT_NE(&rtv, &dsv);
+    EXPECT_EQ(&rtv, &device.GetCpuDescriptorAllocator(D3D12_DESCRIPTOR_HEAP_TYPE_RTV));
+    EXPECT_EQ(D3D12_DESCRIPTOR_HEAP_TYPE_DSV, dsv.GetType());
+}
+
+TEST(Device, DescriptorIncrementSizesAreCached)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+
+    null::ResetCallCounts();
+    auto size = device.GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    EXPECT_GT(size, 0u);
+    EXPECT_EQ(0u, null::GetTotalCallCount());
+}
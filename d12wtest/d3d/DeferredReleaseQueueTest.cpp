@@ -0,0 +1,179 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <d12w/d3d/DeferredReleaseQueue.h>
+#include <d12wnull/Unknown.h>
+
+using namespace d12w;
+
+namespace
+{
+    std::mutex                   releaseMutex;
+    std::vector<uint32_t>        releaseOrder;
+    std::vector<std::thread::id> releaseThreads;
+
+    // a COM object that records when and where it was destroyed
+    class Tracked : public null::Unknown<IUnknown>
+    {
+    public:
+        uint32_t value;
+
+        explicit
+        Tracked(uint32_t v)
+        : value(v) {}
+
+        ~Tracked()
+        {
+            std::lock_guard<std::mutex> lock(releaseMutex);
+            releaseOrder.push_back(value);
+            releaseThreads.push_back(std::this_thread::get_id());
+        }
+    };
+
+    ComPtr<Tracked> MakeTracked(uint32_t value)
+    {
+        auto result = ComPtr<Tracked>{};
+        result.Attach(new Tracked(value));
+        return result;
+    }
+
+    std::vector<uint32_t> TakeReleaseOrder()
+    {
+        std::lock_guard<std::mutex> lock(releaseMutex);
+        auto result = std::move(releaseOrder);
+        releaseOrder.clear();
+        releaseThreads.clear();
+        return result;
+    }
+}
+
+TEST(DeferredReleaseQueue, ObjectsAreReleasedOnceTheFenceCompleted)
+{
+    TakeReleaseOrder();
+    auto queue = d3d::DeferredReleaseQueue{};
+
+    queue.Release(MakeTracked(1), 1);
+    queue.Release(MakeTracked(2), 2);
+    queue.Release(ComPtr<Tracked>{}, 2);
+    EXPECT_EQ(2u, queue.GetPendingCount());
+
+    queue.Retire(0);
+    EXPECT_TRUE(TakeReleaseOrder().empty());
+
+    queue.Retire(1);
+    EXPECT_EQ(std::vector<uint32_t>{1}, TakeReleaseOrder());
+    EXPECT_EQ(1u, queue.GetPendingCount());
+
+    queue.Retire(5);
+    EXPECT_EQ(std::vector<uint32_t>{2}, TakeReleaseOrder());
+    EXPECT_EQ(0u, queue.GetPendingCount());
+}
+
+TEST(DeferredReleaseQueue, ObjectsAreReleasedLateNeverEarly)
+{
+    TakeReleaseOrder();
+    auto queue = d3d::DeferredReleaseQueue{};
+
+    queue.Release(MakeTracked(1), 1);
+    queue.Release(MakeTracked(3), 3);
+    queue.Release(MakeTracked(2), 2);
+
+    // the object of fence value 2 waits behind the one of 3
+    queue.Retire(2);
+    EXPECT_EQ(std::vector<uint32_t>{1}, TakeReleaseOrder());
+
+    queue.Retire(3);
+    EXPECT_EQ((std::vector<uint32_t>{3, 2}), TakeReleaseOrder());
+}
+
+TEST(DeferredReleaseQueue, TheDestructorReleasesAllObjects)
+{
+    TakeReleaseOrder();
+    {
+        auto queue = d3d::DeferredReleaseQueue{};
+        queue.Release(MakeTracked(1), 10);
+        queue.Release(MakeTracked(2), 20);
+    }
+    EXPECT_EQ((std::vector<uint32_t>{1, 2}), TakeReleaseOrder());
+}
+
+TEST(DeferredReleaseQueue, BackgroundReleasesOnTheQueueThread)
+{
+    TakeReleaseOrder();
+    auto queue = d3d::DeferredReleaseQueue{true};
+
+    for (auto i = 0u; i < 100; i++)
+    {
+        queue.Release(MakeTracked(i), i);
+    }
+    queue.Retire(49);
+    queue.Flush();
+    EXPECT_EQ(50u, queue.GetPendingCount());
+
+    std::lock_guard<std::mutex> lock(releaseMutex);
+    ASSERT_EQ(50u, releaseOrder.size());
+    for (auto i = 0u; i < releaseOrder.size(); i++)
+    {
+        EXPECT_EQ(i, releaseOrder[i]);
+        EXPECT_NE(std::this_thread::get_id(), releaseThreads[i]);
+    }
+}
+
+TEST(DeferredReleaseQueue, StressConcurrentReleases)
+{
+    TakeReleaseOrder();
+    auto queue = d3d::DeferredReleaseQueue{true};
+
+    constexpr auto THREADS = 4u;
+    constexpr auto OBJECTS = 1000u;
+
+    auto completed = std::atomic<UINT64>{0};
+    auto threads = std::vector<std::thread>{};
+    for (auto t = 0u; t < THREADS; t++)
+    {
+        threads.emplace_back([&, t] () {
+            for (auto i = 0u; i < OBJECTS; i++)
+            {
+                queue.Release(MakeTracked(t * OBJECTS + i), completed.load() + 1);
+            }
+        });
+    }
+    for (auto i = 0; i < 100; i++)
+    {
+        queue.Retire(completed++);
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    queue.Retire(UINT64_MAX);
+    queue.Flush();
+    EXPECT_EQ(0u, queue.GetPendingCount());
+    EXPECT_EQ(THREADS * OBJECTS, TakeReleaseOrder().size());
+}
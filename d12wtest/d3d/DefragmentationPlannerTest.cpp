@@ -0,0 +1,149 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <d12w/d3d/DefragmentationPlanner.h>
+
+using namespace d12w;
+
+namespace
+{
+    constexpr auto KB = uint64_t{1024};
+
+    d3d::DefragmentationHeap MakeHeap(uint32_t id, uint64_t size, std::vector<d3d::DefragmentationBlock> blocks)
+    {
+        auto heap = d3d::DefragmentationHeap{};
+        heap.id     = id;
+        heap.size   = size;
+        heap.blocks = std::move(blocks);
+        return heap;
+    }
+}
+
+TEST(DefragmentationPlanner, SparseHeapsAreEvacuatedIntoDenseOnes)
+{
+    auto planner = d3d::DefragmentationPlanner{};
+    auto heaps = std::vector<d3d::DefragmentationHeap>{
+        MakeHeap(0, 1024 * KB, {{0, 0, 64 * KB, 64 * KB}, {1, 512 * KB, 128 * KB, 64 * KB}}),
+        MakeHeap(1, 1024 * KB, {{0, 0, 768 * KB, 64 * KB}})
+    };
+
+    auto moves = planner.Plan(heaps, UINT64_MAX);
+    ASSERT_EQ(2u, moves.size());
+
+    // the largest block goes first
+    EXPECT_EQ(0u, moves[0].srcHeap);
+    EXPECT_EQ(1u, moves[0].block);
+    EXPECT_EQ(1u, moves[0].dstHeap);
+    EXPECT_EQ(128 * KB, moves[0].size);
+    EXPECT_EQ(0u, moves[1].block);
+    EXPECT_EQ(1u, moves[1].dstHeap);
+}
+
+TEST(DefragmentationPlanner, DenseHeapsAreLeftAlone)
+{
+    auto planner = d3d::DefragmentationPlanner{};
+    auto heaps = std::vector<d3d::DefragmentationHeap>{
+        MakeHeap(0, 1024 * KB, {{0, 0, 640 * KB, 64 * KB}}),
+        MakeHeap(1, 1024 * KB, {{0, 0, 768 * KB, 64 * KB}})
+    };
+
+    EXPECT_TRUE(planner.Plan(heaps, UINT64_MAX).empty());
+}
+
+TEST(DefragmentationPlanner, TheDensestHeapIsFilledFirst)
+{
+    auto planner = d3d::DefragmentationPlanner{};
+    auto heaps = std::vector<d3d::DefragmentationHeap>{
+        MakeHeap(0, 1024 * KB, {{0, 0, 640 * KB, 64 * KB}}),
+        MakeHeap(1, 1024 * KB, {{0, 0, 64 * KB, 64 * KB}}),
+        MakeHeap(2, 1024 * KB, {{0, 0, 832 * KB, 64 * KB}})
+    };
+
+    auto moves = planner.Plan(heaps, UINT64_MAX);
+    ASSERT_EQ(1u, moves.size());
+    EXPECT_EQ(1u, moves[0].srcHeap);
+    EXPECT_EQ(2u, moves[0].dstHeap);
+}
+
+TEST(DefragmentationPlanner, TheBudgetLimitsTheMoves)
+{
+    auto planner = d3d::DefragmentationPlanner{};
+    auto heaps = std::vector<d3d::DefragmentationHeap>{
+        MakeHeap(0, 1024 * KB, {{0, 0, 64 * KB, 64 * KB}, {1, 64 * KB, 64 * KB, 64 * KB}, {2, 128 * KB, 64 * KB, 64 * KB}}),
+        MakeHeap(1, 1024 * KB, {{0, 0, 768 * KB, 64 * KB}})
+    };
+
+    EXPECT_EQ(2u, planner.Plan(heaps, 128 * KB).size());
+    EXPECT_EQ(1u, planner.Plan(heaps, 100 * KB).size());
+    EXPECT_TRUE(planner.Plan(heaps, 32 * KB).empty());
+}
+
+TEST(DefragmentationPlanner, UnmovableBlocksStay)
+{
+    auto planner = d3d::DefragmentationPlanner{};
+    auto heaps = std::vector<d3d::DefragmentationHeap>{
+        MakeHeap(0, 1024 * KB, {{0, 0, 64 * KB, 64 * KB, false}, {1, 64 * KB, 64 * KB, 64 * KB}}),
+        MakeHeap(1, 1024 * KB, {{0, 0, 768 * KB, 64 * KB}})
+    };
+
+    auto moves = planner.Plan(heaps, UINT64_MAX);
+    ASSERT_EQ(1u, moves.size());
+    EXPECT_EQ(1u, moves[0].block);
+}
+
+TEST(DefragmentationPlanner, SourcesAreOnlyEvacuatedIfTheRestHasRoom)
+{
+    auto planner = d3d::DefragmentationPlanner{};
+    auto heaps = std::vector<d3d::DefragmentationHeap>{
+        MakeHeap(0, 1024 * KB, {{0, 0, 256 * KB, 64 * KB}}),
+        MakeHeap(1, 1024 * KB, {{0, 0, 896 * KB, 64 * KB}})
+    };
+
+    EXPECT_TRUE(planner.Plan(heaps, UINT64_MAX).empty());
+}
+
+TEST(DefragmentationPlanner, AlignmentIsRespectedInTheFreeRanges)
+{
+    auto planner = d3d::DefragmentationPlanner{};
+    auto heaps = std::vector<d3d::DefragmentationHeap>{
+        MakeHeap(0, 8192 * KB, {{0, 0, 64 * KB, 4096 * KB}}),
+        // there is enough free space, but none of it starts at a 4 MiB boundary
+        MakeHeap(1, 8192 * KB, {{0, 0, 3072 * KB, 64 * KB}, {1, 4096 * KB, 2048 * KB, 64 * KB}})
+    };
+
+    EXPECT_TRUE(planner.Plan(heaps, UINT64_MAX).empty());
+}
+
+TEST(DefragmentationPlanner, EmptyHeapsAreIgnored)
+{
+    auto planner = d3d::DefragmentationPlanner{};
+    auto heaps = std::vector<d3d::DefragmentationHeap>{
+        MakeHeap(0, 1024 * KB, {}),
+        MakeHeap(1, 0, {}),
+        MakeHeap(2, 1024 * KB, {{0, 0, 768 * KB, 64 * KB}})
+    };
+
+    EXPECT_TRUE(planner.Plan(heaps, UINT64_MAX).empty());
+}
@@ -0,0 +1,251 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <d12w/d3d/DescriptorCopyBatcher.h>
+#include <d12w/d3d/Device.h>
+#include <d12wnull/null.h>
+
+using namespace d12w;
+
+namespace
+{
+    using Ranges = std::vector<std::pair<SIZE_T, UINT>>;
+
+    struct CopyCall
+    {
+        bool   simple;
+        Ranges dest;
+        Ranges src;
+    };
+
+    // remembers the ranges of every copy call
+    class RecordingDevice : public null::Device
+    {
+    public:
+        std::vector<CopyCall> calls;
+
+        void STDMETHODCALLTYPE CopyDescriptors(UINT NumDestDescriptorRanges, const D3D12_CPU_DESCRIPTOR_HANDLE* pDestDescriptorRangeStarts, const UINT* pDestDescriptorRangeSizes, UINT NumSrcDescriptorRanges, const D3D12_CPU_DESCRIPTOR_HANDLE* pSrcDescriptorRangeStarts, const UINT* pSrcDescriptorRangeSizes, D3D12_DESCRIPTOR_HEAP_TYPE DescriptorHeapsType) override
+        {
+            auto call = CopyCall{false, {}, {}};
+            for (auto i = 0u; i < NumDestDescriptorRanges; i++)
+            {
+                call.dest.emplace_back(pDestDescriptorRangeStarts[i].ptr, pDestDescriptorRangeSizes[i]);
+            }
+            for (auto i = 0u; i < NumSrcDescriptorRanges; i++)
+            {
+                call.src.emplace_back(pSrcDescriptorRangeStarts[i].ptr, pSrcDescriptorRangeSizes[i]);
+            }
+            calls.push_back(call);
+            null::Device::CopyDescriptors(NumDestDescriptorRanges, pDestDescriptorRangeStarts, pDestDescriptorRangeSizes, NumSrcDescriptorRanges, pSrcDescriptorRangeStarts, pSrcDescriptorRangeSizes, DescriptorHeapsType);
+        }
+
+        void STDMETHODCALLTYPE CopyDescriptorsSimple(UINT NumDescriptors, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptorRangeStart, D3D12_CPU_DESCRIPTOR_HANDLE SrcDescriptorRangeStart, D3D12_DESCRIPTOR_HEAP_TYPE DescriptorHeapsType) override
+        {
+            calls.push_back({true, {{DestDescriptorRangeStart.ptr, NumDescriptors}}, {{SrcDescriptorRangeStart.ptr, NumDescriptors}}});
+            null::Device::CopyDescriptorsSimple(NumDescriptors, DestDescriptorRangeStart, SrcDescriptorRangeStart, DescriptorHeapsType);
+        }
+    };
+
+    constexpr auto TYPE = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+
+    // a source heap where every descriptor holds its index, and an empty destination heap
+    struct Heaps
+    {
+        RecordingDevice*             recording = nullptr;
+        d3d::Device                  device{MakeDevice()};
+        UINT                         increment = device.GetDescriptorHandleIncrementSize(TYPE);
+        ComPtr<ID3D12DescriptorHeap> src       = MakeHeap();
+        ComPtr<ID3D12DescriptorHeap> dest      = MakeHeap();
+
+        Heaps()
+        {
+            for (auto i = 0u; i < 64u; i++)
+            {
+                auto ptr = reinterpret_cast<void*>(Src(i).ptr);
+                std::memcpy(ptr, &i, sizeof(i));
+            }
+        }
+
+        ComPtr<ID3D12Device2> MakeDevice()
+        {
+            recording = new RecordingDevice;
+            auto result = ComPtr<ID3D12Device2>{};
+            result.Attach(recording);
+            return result;
+        }
+
+        ComPtr<ID3D12DescriptorHeap> MakeHeap()
+        {
+            auto desc = D3D12_DESCRIPTOR_HEAP_DESC{};
+            desc.Type           = TYPE;
+            desc.NumDescriptors = 64;
+            return device.CreateDescriptorHeap(desc);
+        }
+
+        D3D12_CPU_DESCRIPTOR_HANDLE Src(UINT index) const
+        {
+            return {src.Get()->GetCPUDescriptorHandleForHeapStart().ptr + SIZE_T{index} * increment};
+        }
+
+        D3D12_CPU_DESCRIPTOR_HANDLE Dest(UINT index) const
+        {
+            return {dest.Get()->GetCPUDescriptorHandleForHeapStart().ptr + SIZE_T{index} * increment};
+        }
+
+        std::pair<SIZE_T, UINT> SrcRange(UINT index, UINT count) const
+        {
+            return {Src(index).ptr, count};
+        }
+
+        std::pair<SIZE_T, UINT> DestRange(UINT index, UINT count) const
+        {
+            return {Dest(index).ptr, count};
+        }
+
+        UINT Read(UINT destIndex) const
+        {
+            auto value = UINT{0};
+            std::memcpy(&value, reinterpret_cast<const void*>(Dest(destIndex).ptr), sizeof(value));
+            return value;
+        }
+    };
+}
+
+TEST(DescriptorCopyBatcher, FlushWithoutCopiesDoesNothing)
+{
+    auto heaps   = Heaps{};
+    auto batcher = d3d::DescriptorCopyBatcher{heaps.device, TYPE};
+
+    batcher.Add(heaps.Dest(0), heaps.Src(0), 0);
+    batcher.Flush();
+
+    EXPECT_TRUE(heaps.recording->calls.empty());
+    EXPECT_EQ(0u, batcher.GetStats().calls);
+}
+
+TEST(DescriptorCopyBatcher, SingleRunUsesCopyDescriptorsSimple)
+{
+    auto heaps   = Heaps{};
+    auto batcher = d3d::DescriptorCopyBatcher{heaps.device, TYPE};
+
+    for (auto i = 0u; i < 8u; i++)
+    {
+        batcher.Add(heaps.Dest(i), heaps.Src(10 + i));
+    }
+    EXPECT_EQ(8u, batcher.GetPendingCount());
+    batcher.Flush();
+
+    ASSERT_EQ(1u, heaps.recording->calls.size());
+    EXPECT_TRUE(heaps.recording->calls[0].simple);
+    EXPECT_EQ(Ranges{heaps.DestRange(0, 8)}, heaps.recording->calls[0].dest);
+    EXPECT_EQ(Ranges{heaps.SrcRange(10, 8)}, heaps.recording->calls[0].src);
+    for (auto i = 0u; i < 8u; i++)
+    {
+        EXPECT_EQ(10 + i, heaps.Read(i));
+    }
+    EXPECT_EQ(0u, batcher.GetPendingCount());
+}
+
+TEST(DescriptorCopyBatcher, CopiesAreSortedByDestination)
+{
+    auto heaps   = Heaps{};
+    auto batcher = d3d::DescriptorCopyBatcher{heaps.device, TYPE};
+
+    // added backwards, after sorting both sides continue each other
+    for (auto i = 8u; i-- > 0u;)
+    {
+        batcher.Add(heaps.Dest(i), heaps.Src(20 + i));
+    }
+    batcher.Flush();
+
+    ASSERT_EQ(1u, heaps.recording->calls.size());
+    EXPECT_TRUE(heaps.recording->calls[0].simple);
+    EXPECT_EQ(Ranges{heaps.DestRange(0, 8)}, heaps.recording->calls[0].dest);
+    for (auto i = 0u; i < 8u; i++)
+    {
+        EXPECT_EQ(20 + i, heaps.Read(i));
+    }
+}
+
+TEST(DescriptorCopyBatcher, ContiguousRunsAreMerged)
+{
+    auto heaps   = Heaps{};
+    auto batcher = d3d::DescriptorCopyBatcher{heaps.device, TYPE};
+
+    // a table of two blocks from different places, and a second table
+    batcher.Add(heaps.Dest(20), heaps.Src(40), 2);
+    batcher.Add(heaps.Dest(4), heaps.Src(30), 2);
+    batcher.Add(heaps.Dest(0), heaps.Src(10), 4);
+    batcher.Add(heaps.Dest(6), heaps.Src(32), 2);
+    batcher.Flush();
+
+    ASSERT_EQ(1u, heaps.recording->calls.size());
+    EXPECT_FALSE(heaps.recording->calls[0].simple);
+    EXPECT_EQ((Ranges{heaps.DestRange(0, 8), heaps.DestRange(20, 2)}), heaps.recording->calls[0].dest);
+    EXPECT_EQ((Ranges{heaps.SrcRange(10, 4), heaps.SrcRange(30, 4), heaps.SrcRange(40, 2)}), heaps.recording->calls[0].src);
+
+    auto expected = std::vector<UINT>{10, 11, 12, 13, 30, 31, 32, 33};
+    for (auto i = 0u; i < expected.size(); i++)
+    {
+        EXPECT_EQ(expected[i], heaps.Read(i));
+    }
+    EXPECT_EQ(40u, heaps.Read(20));
+    EXPECT_EQ(41u, heaps.Read(21));
+}
+
+TEST(DescriptorCopyBatcher, StatsCountTheSavedCalls)
+{
+    auto heaps   = Heaps{};
+    auto batcher = d3d::DescriptorCopyBatcher{heaps.device, TYPE};
+
+    for (auto i = 0u; i < 16u; i++)
+    {
+        batcher.Add(heaps.Dest(i), heaps.Src(63 - i));
+    }
+    batcher.Flush();
+
+    EXPECT_EQ(16u, batcher.GetStats().requests);
+    EXPECT_EQ(16u, batcher.GetStats().descriptors);
+    EXPECT_EQ(1u, batcher.GetStats().calls);
+    EXPECT_EQ(1u, heaps.recording->calls.size());
+
+    batcher.ResetStats();
+    EXPECT_EQ(0u, batcher.GetStats().requests);
+}
+
+#ifndef NDEBUG
+TEST(DescriptorCopyBatcher, OverlappingDestinationsAssert)
+{
+    auto heaps   = Heaps{};
+    auto batcher = d3d::DescriptorCopyBatcher{heaps.device, TYPE};
+
+    batcher.Add(heaps.Dest(0), heaps.Src(0), 4);
+    batcher.Add(heaps.Dest(2), heaps.Src(10));
+    EXPECT_THROW(batcher.Flush(), std::logic_error);
+}
+#endif
@@ -0,0 +1,285 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+#include <d12w/d3d/Device.h>
+#include <d12w/d3d/Fence.h>
+#include <d12wnull/null.h>
+
+using namespace d12w;
+
+namespace
+{
+    // starts right away and destroys itself when done
+    struct Task
+    {
+        struct promise_type
+        {
+            Task get_return_object() { return {}; }
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+        };
+    };
+
+    struct Log
+    {
+        std::mutex            mutex;
+        std::vector<int>      reached;
+        std::atomic<unsigned> cancelled = 0;
+
+        size_t GetReachedCount()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return reached.size();
+        }
+    };
+
+    Task Wait(d3d::Fence& fence, UINT64 value, int id, Log& log, std::stop_token token = {})
+    {
+        if (co_await fence.Reached(value, token))
+        {
+            std::lock_guard<std::mutex> lock(log.mutex);
+            log.reached.push_back(id);
+        }
+        else
+        {
+            log.cancelled++;
+        }
+    }
+
+    void WaitForCompletion(d3d::FenceWaiter& waiter, Log& log, size_t count)
+    {
+        while (waiter.GetPendingCount() != 0 || log.GetReachedCount() + log.cancelled < count)
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+TEST(FenceWaiter, ReachedValueCompletesWithoutSuspending)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    auto waiter = d3d::FenceWaiter{};
+    auto fence  = d3d::Fence{device, waiter, 5};
+    auto log    = Log{};
+
+    Wait(fence, 5, 0, log);
+
+    EXPECT_EQ(1u, log.GetReachedCount());
+    EXPECT_EQ(0u, waiter.GetPendingCount());
+}
+
+TEST(FenceWaiter, ResumesInValueOrder)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    auto waiter = d3d::FenceWaiter{};
+    auto fence  = d3d::Fence{device, waiter};
+    auto log    = Log{};
+
+    // the id is the value, so the log must come out sorted
+    auto rng    = std::mt19937{42};
+    auto values = std::vector<int>{};
+    for (auto i = 0; i < 200; i++)
+    {
+        auto value = 1 + static_cast<int>(rng() % 50);
+        values.push_back(value);
+        Wait(fence, value, value, log);
+    }
+    EXPECT_EQ(200u, waiter.GetPendingCount());
+
+    fence.Signal(50);
+    WaitForCompletion(waiter, log, values.size());
+
+    std::sort(values.begin(), values.end());
+    EXPECT_EQ(values, log.reached);
+}
+
+TEST(FenceWaiter, EqualValuesResumeInWaitOrder)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    auto waiter = d3d::FenceWaiter{};
+    auto fence  = d3d::Fence{device, waiter};
+    auto log    = Log{};
+
+    auto expected = std::vector<int>{};
+    for (auto i = 0; i < 100; i++)
+    {
+        Wait(fence, 1, i, log);
+        expected.push_back(i);
+    }
+
+    fence.Signal(1);
+    WaitForCompletion(waiter, log, expected.size());
+
+    EXPECT_EQ(expected, log.reached);
+}
+
+TEST(FenceWaiter, OnlyReachedValuesResume)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    auto waiter = d3d::FenceWaiter{};
+    auto fence  = d3d::Fence{device, waiter};
+    auto log    = Log{};
+
+    Wait(fence, 1, 1, log);
+    Wait(fence, 2, 2, log);
+    Wait(fence, 3, 3, log);
+
+    fence.Signal(2);
+    while (log.GetReachedCount() < 2)
+    {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ((std::vector<int>{1, 2}), log.reached);
+    EXPECT_EQ(1u, waiter.GetPendingCount());
+
+    fence.Signal(3);
+    WaitForCompletion(waiter, log, 3);
+    EXPECT_EQ((std::vector<int>{1, 2, 3}), log.reached);
+}
+
+TEST(FenceWaiter, StopBeforeTheWaitCancels)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    auto waiter = d3d::FenceWaiter{};
+    auto fence  = d3d::Fence{device, waiter};
+    auto log    = Log{};
+
+    auto stop = std::stop_source{};
+    stop.request_stop();
+    Wait(fence, 1, 0, log, stop.get_token());
+
+    EXPECT_EQ(1u, log.cancelled);
+    EXPECT_EQ(0u, waiter.GetPendingCount());
+}
+
+TEST(FenceWaiter, StopWhilePendingCancels)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    auto waiter = d3d::FenceWaiter{};
+    auto fence  = d3d::Fence{device, waiter};
+    auto log    = Log{};
+
+    auto stop = std::stop_source{};
+    for (auto i = 0; i < 100; i++)
+    {
+        Wait(fence, 10, i, log, stop.get_token());
+    }
+    Wait(fence, 10, 100, log);
+    EXPECT_EQ(101u, waiter.GetPendingCount());
+
+    stop.request_stop();
+    while (log.cancelled < 100)
+    {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(1u, waiter.GetPendingCount());
+
+    fence.Signal(10);
+    WaitForCompletion(waiter, log, 101);
+    EXPECT_EQ((std::vector<int>{100}), log.reached);
+}
+
+TEST(FenceWaiter, StopRacingTheSignalCompletesOnce)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    auto waiter = d3d::FenceWaiter{};
+    auto fence  = d3d::Fence{device, waiter};
+    auto log    = Log{};
+
+    for (auto round = 1u; round <= 100u; round++)
+    {
+        auto stop = std::stop_source{};
+        for (auto i = 0; i < 10; i++)
+        {
+            Wait(fence, round, i, log, stop.get_token());
+        }
+        auto cancel = std::thread([&] () { stop.request_stop(); });
+        fence.Signal(round);
+        cancel.join();
+    }
+
+    WaitForCompletion(waiter, log, 1000);
+    EXPECT_EQ(1000u, log.GetReachedCount() + log.cancelled);
+}
+
+TEST(FenceWaiter, DeviceRemovalCancelsPendingWaits)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    auto waiter = d3d::FenceWaiter{};
+    auto fence  = d3d::Fence{device, waiter};
+    auto log    = Log{};
+
+    for (auto i = 0; i < 10; i++)
+    {
+        Wait(fence, 1 + i, i, log);
+    }
+
+    // a removed device reports UINT64_MAX as the completed value
+    fence.Signal(UINT64_MAX);
+    WaitForCompletion(waiter, log, 10);
+
+    EXPECT_EQ(0u, log.GetReachedCount());
+    EXPECT_EQ(10u, log.cancelled);
+}
+
+TEST(FenceWaiter, WaitAfterDeviceRemovalIsCancelled)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    auto waiter = d3d::FenceWaiter{};
+    auto fence  = d3d::Fence{device, waiter, UINT64_MAX};
+    auto log    = Log{};
+
+    Wait(fence, 1, 0, log);
+
+    EXPECT_EQ(0u, log.GetReachedCount());
+    EXPECT_EQ(1u, log.cancelled);
+    EXPECT_EQ(0u, waiter.GetPendingCount());
+}
+
+TEST(FenceWaiter, DestructionCancelsPendingWaits)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    auto log    = Log{};
+    {
+        auto waiter = d3d::FenceWaiter{};
+        auto fence  = d3d::Fence{device, waiter};
+        for (auto i = 0; i < 10; i++)
+        {
+            Wait(fence, 1, i, log);
+        }
+        EXPECT_EQ(10u, waiter.GetPendingCount());
+    }
+    EXPECT_EQ(10u, log.cancelled);
+}
@@ -0,0 +1,518 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include <d12w/d3d/FrameGraph.h>
+
+using namespace d12w;
+
+namespace
+{
+    constexpr auto RT  = D3D12_RESOURCE_STATE_RENDER_TARGET;
+    constexpr auto UA  = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
+    constexpr auto PSR = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+    constexpr auto NPS = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
+
+    constexpr auto MB = uint64_t{1024 * 1024};
+
+    std::vector<uint32_t> GetPasses(const d3d::FrameGraphPlan& plan)
+    {
+        auto passes = std::vector<uint32_t>{};
+        for (const auto& step : plan.steps)
+        {
+            passes.push_back(step.pass);
+        }
+        return passes;
+    }
+
+    size_t CountBarriers(const d3d::FrameGraphStep& step, d3d::FrameGraphBarrierType type, uint32_t resource)
+    {
+        return std::count_if(step.barriers.begin(), step.barriers.end(), [&] (const auto& barrier) {
+            return barrier.type == type && barrier.resource == resource;
+        });
+    }
+
+    bool IsWrite(D3D12_RESOURCE_STATES state)
+    {
+        return state == D3D12_RESOURCE_STATE_RENDER_TARGET || state == D3D12_RESOURCE_STATE_UNORDERED_ACCESS ||
+               state == D3D12_RESOURCE_STATE_COPY_DEST || state == D3D12_RESOURCE_STATE_DEPTH_WRITE;
+    }
+}
+
+TEST(FrameGraph, InvalidArgumentsThrow)
+{
+    auto graph = d3d::FrameGraph{};
+    EXPECT_THROW(graph.CreateResource(0, 4096), std::invalid_argument);
+    EXPECT_THROW(graph.CreateResource(100, 3), std::invalid_argument);
+    EXPECT_THROW(graph.AddPass({{0, RT, true}}), std::invalid_argument);
+}
+
+TEST(FrameGraph, PassesWithoutEffectAreCulled)
+{
+    auto graph  = d3d::FrameGraph{};
+    auto a      = graph.CreateResource(MB, 65536);
+    auto unused = graph.CreateResource(MB, 65536);
+    auto output = graph.ImportResource(D3D12_RESOURCE_STATE_PRESENT);
+
+    graph.AddPass({{a, RT, true}});
+    graph.AddPass({{unused, UA, true}});
+    graph.AddPass({{a, PSR, false}, {output, RT, true}});
+
+    auto plan = graph.Compile();
+    EXPECT_EQ((std::vector<uint32_t>{0, 2}), GetPasses(plan));
+    EXPECT_EQ(UINT32_MAX, plan.placements[unused].heap);
+}
+
+TEST(FrameGraph, KeptPassesAndTheirWritersSurvive)
+{
+    auto graph = d3d::FrameGraph{};
+    auto a     = graph.CreateResource(MB, 65536);
+    auto b     = graph.CreateResource(MB, 65536);
+
+    graph.AddPass({{a, RT, true}});
+    graph.AddPass({{b, RT, true}});
+    graph.AddPass({{a, PSR, false}}, true);
+
+    auto plan = graph.Compile();
+    EXPECT_EQ((std::vector<uint32_t>{0, 2}), GetPasses(plan));
+}
+
+TEST(FrameGraph, WritesKeepEarlierWriters)
+{
+    auto graph  = d3d::FrameGraph{};
+    auto a      = graph.CreateResource(MB, 65536);
+    auto output = graph.ImportResource(D3D12_RESOURCE_STATE_COMMON);
+
+    // the second write may only overwrite a part of the first
+    graph.AddPass({{a, RT, true}});
+    graph.AddPass({{a, RT, true}});
+    graph.AddPass({{a, PSR, false}, {output, UA, true}});
+
+    auto plan = graph.Compile();
+    EXPECT_EQ((std::vector<uint32_t>{0, 1, 2}), GetPasses(plan));
+}
+
+TEST(FrameGraph, StepsDependOnConflictingSteps)
+{
+    auto graph = d3d::FrameGraph{};
+    auto a     = graph.CreateResource(MB, 65536);
+    auto b     = graph.CreateResource(MB, 65536);
+
+    graph.AddPass({{a, RT, true}}, true);
+    graph.AddPass({{b, RT, true}}, true);
+    graph.AddPass({{a, PSR, false}}, true);
+    graph.AddPass({{a, PSR, false}, {b, PSR, false}}, true);
+
+    auto plan = graph.Compile();
+    ASSERT_EQ(4u, plan.steps.size());
+    EXPECT_TRUE(plan.steps[0].dependencies.empty());
+    EXPECT_TRUE(plan.steps[1].dependencies.empty());
+    EXPECT_EQ((std::vector<uint32_t>{0}), plan.steps[2].dependencies);
+    // two reads do not conflict
+    EXPECT_EQ(0, std::count(plan.steps[3].dependencies.begin(), plan.steps[3].dependencies.end(), 2u));
+    EXPECT_EQ(1, std::count(plan.steps[3].dependencies.begin(), plan.steps[3].dependencies.end(), 1u));
+}
+
+TEST(FrameGraph, TransitionsFollowTheAccesses)
+{
+    auto graph  = d3d::FrameGraph{};
+    auto a      = graph.CreateResource(MB, 65536);
+    auto output = graph.ImportResource(D3D12_RESOURCE_STATE_PRESENT);
+
+    graph.AddPass({{a, RT, true}});
+    graph.AddPass({{a, PSR, false}, {a, NPS, false}, {output, RT, true}});
+    graph.AddPass({{output, D3D12_RESOURCE_STATE_PRESENT, false}}, true);
+
+    auto plan = graph.Compile();
+    ASSERT_EQ(3u, plan.steps.size());
+
+    // transient resources start in the state of their last use
+    EXPECT_EQ(PSR | NPS, plan.initialStates[a]);
+    EXPECT_EQ(plan.initialStates[a], plan.finalStates[a]);
+    EXPECT_EQ(D3D12_RESOURCE_STATE_PRESENT, plan.initialStates[output]);
+    EXPECT_EQ(D3D12_RESOURCE_STATE_PRESENT, plan.finalStates[output]);
+
+    ASSERT_EQ(1u, CountBarriers(plan.steps[1], d3d::FrameGraphBarrierType::TRANSITION, a));
+    auto& barrier = *std::find_if(plan.steps[1].barriers.begin(), plan.steps[1].barriers.end(), [&] (const auto& b) {
+        return b.resource == a;
+    });
+    EXPECT_EQ(RT, barrier.before);
+    EXPECT_EQ(PSR | NPS, barrier.after);
+    EXPECT_EQ(1u, CountBarriers(plan.steps[2], d3d::FrameGraphBarrierType::TRANSITION, output));
+}
+
+TEST(FrameGraph, ConsecutiveUavWritesGetAUavBarrier)
+{
+    auto graph = d3d::FrameGraph{};
+    auto a     = graph.CreateResource(MB, 65536);
+
+    graph.AddPass({{a, UA, true}}, true);
+    graph.AddPass({{a, UA, true}}, true);
+    graph.AddPass({{a, UA, false}}, true);
+
+    auto plan = graph.Compile();
+    ASSERT_EQ(3u, plan.steps.size());
+    EXPECT_EQ(0u, CountBarriers(plan.steps[0], d3d::FrameGraphBarrierType::UAV, a));
+    EXPECT_EQ(1u, CountBarriers(plan.steps[1], d3d::FrameGraphBarrierType::UAV, a));
+    EXPECT_EQ(1u, CountBarriers(plan.steps[2], d3d::FrameGraphBarrierType::UAV, a));
+}
+
+TEST(FrameGraph, ResourcesWithDisjointLifetimesShareMemory)
+{
+    auto graph  = d3d::FrameGraph{};
+    auto a      = graph.CreateResource(MB, 65536);
+    auto b      = graph.CreateResource(MB, 65536);
+    auto c      = graph.CreateResource(MB, 65536);
+    auto output = graph.ImportResource(D3D12_RESOURCE_STATE_COMMON);
+
+    graph.AddPass({{a, RT, true}});
+    graph.AddPass({{a, PSR, false}, {b, RT, true}});
+    graph.AddPass({{b, PSR, false}, {c, RT, true}});
+    graph.AddPass({{c, PSR, false}, {output, RT, true}});
+
+    auto plan = graph.Compile();
+    ASSERT_EQ(4u, plan.steps.size());
+    ASSERT_EQ(1u, plan.heaps.size());
+
+    // a and c never live at the same time, b overlaps both
+    EXPECT_EQ(plan.placements[a].offset, plan.placements[c].offset);
+    EXPECT_NE(plan.placements[a].offset, plan.placements[b].offset);
+    EXPECT_EQ(2 * MB, plan.heaps[0].size);
+    EXPECT_EQ(3 * MB, plan.unaliasedSize);
+
+    EXPECT_EQ(1u, CountBarriers(plan.steps[0], d3d::FrameGraphBarrierType::ALIASING, a));
+    EXPECT_EQ(0u, CountBarriers(plan.steps[1], d3d::FrameGraphBarrierType::ALIASING, b));
+    EXPECT_EQ(1u, CountBarriers(plan.steps[2], d3d::FrameGraphBarrierType::ALIASING, c));
+}
+
+TEST(FrameGraph, CategoriesDoNotShareHeaps)
+{
+    auto graph  = d3d::FrameGraph{};
+    auto a      = graph.CreateResource(MB, 65536, 0);
+    auto b      = graph.CreateResource(MB, 65536, 1);
+    auto output = graph.ImportResource(D3D12_RESOURCE_STATE_COMMON);
+
+    graph.AddPass({{a, RT, true}});
+    graph.AddPass({{a, PSR, false}, {output, RT, true}});
+    graph.AddPass({{b, UA, true}});
+    graph.AddPass({{b, NPS, false}, {output, UA, true}});
+
+    auto plan = graph.Compile();
+    ASSERT_EQ(2u, plan.heaps.size());
+    EXPECT_NE(plan.placements[a].heap, plan.placements[b].heap);
+    EXPECT_EQ(0u, plan.heaps[plan.placements[a].heap].category);
+    EXPECT_EQ(1u, plan.heaps[plan.placements[b].heap].category);
+    EXPECT_EQ(UINT32_MAX, plan.placements[output].heap);
+}
+
+TEST(FrameGraph, PlacementsRespectTheAlignment)
+{
+    auto graph = d3d::FrameGraph{};
+    auto small = graph.CreateResource(4096, 4096);
+    auto large = graph.CreateResource(MB, 4 * MB);
+
+    graph.AddPass({{small, RT, true}, {large, RT, true}}, true);
+
+    auto plan = graph.Compile();
+    ASSERT_EQ(1u, plan.heaps.size());
+    EXPECT_EQ(4 * MB, plan.heaps[0].alignment);
+    EXPECT_EQ(0u, plan.placements[large].offset % (4 * MB));
+    EXPECT_EQ(0u, plan.placements[small].offset % 4096);
+    EXPECT_LE(plan.placements[small].offset + 4096, plan.heaps[0].size);
+    EXPECT_LE(plan.placements[large].offset + MB, plan.heaps[0].size);
+}
+
+TEST(FrameGraph, FuzzPlansAreConsistent)
+{
+    constexpr D3D12_RESOURCE_STATES STATES[] = {
+        D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+        D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE,
+        D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_DEPTH_WRITE
+    };
+    constexpr auto STATE_COUNT = static_cast<uint32_t>(std::size(STATES));
+
+    struct Spec
+    {
+        uint64_t              size;
+        uint64_t              alignment;
+        uint32_t              category;
+        bool                  imported;
+        D3D12_RESOURCE_STATES state;
+    };
+
+    auto rng = std::mt19937{7};
+    for (auto round = 0; round < 300; round++)
+    {
+        auto resourceCount = 1 + rng() % 40;
+        auto passCount     = 1 + rng() % 120;
+
+        auto graph = d3d::FrameGraph{};
+        auto specs = std::vector<Spec>{};
+        for (auto r = 0u; r < resourceCount; r++)
+        {
+            if (rng() % 8 == 0)
+            {
+                auto state = STATES[rng() % STATE_COUNT];
+                specs.push_back({0, 1, 0, true, state});
+                graph.ImportResource(state);
+            }
+            else
+            {
+                auto alignment = rng() % 5 == 0 ? 4 * MB : (rng() % 3 == 0 ? 4096 : 65536);
+                auto size      = (1 + rng() % 64) * 4096 * (1 + rng() % 4);
+                auto category  = static_cast<uint32_t>(rng() % 3);
+                specs.push_back({size, alignment, category, false, D3D12_RESOURCE_STATE_COMMON});
+                graph.CreateResource(size, alignment, category);
+            }
+        }
+
+        auto passes = std::vector<std::vector<d3d::FrameGraphAccess>>{};
+        auto keeps  = std::vector<bool>{};
+        for (auto p = 0u; p < passCount; p++)
+        {
+            // mostly resources near the position of the pass, so that lifetimes are short
+            auto accesses = std::vector<d3d::FrameGraphAccess>{};
+            auto count    = 1 + rng() % 4;
+            for (auto i = 0u; i < count; i++)
+            {
+                auto state    = STATES[rng() % STATE_COUNT];
+                auto resource = static_cast<int>(rng() % resourceCount);
+                if (rng() % 3 != 0)
+                {
+                    auto center = static_cast<int>(p * resourceCount / passCount);
+                    resource = std::clamp(center + static_cast<int>(rng() % 9) - 4, 0, static_cast<int>(resourceCount) - 1);
+                }
+                accesses.push_back({static_cast<uint32_t>(resource), state, IsWrite(state)});
+            }
+            auto keep = rng() % 20 == 0;
+            passes.push_back(accesses);
+            keeps.push_back(keep);
+            graph.AddPass(accesses, keep);
+        }
+
+        auto plan = graph.Compile();
+
+        // culling against a fixed point iteration
+        auto needed = std::vector<bool>(passCount);
+        for (auto p = 0u; p < passCount; p++)
+        {
+            needed[p] = keeps[p];
+            for (const auto& access : passes[p])
+            {
+                needed[p] = needed[p] || (access.write && specs[access.resource].imported);
+            }
+        }
+        for (auto changed = true; changed;)
+        {
+            changed = false;
+            for (auto q = passCount; q-- > 0;)
+            {
+                if (!needed[q])
+                {
+                    continue;
+                }
+                for (const auto& access : passes[q])
+                {
+                    for (auto w = q; w-- > 0;)
+                    {
+                        auto writes = std::any_of(passes[w].begin(), passes[w].end(), [&] (const auto& a) {
+                            return a.resource == access.resource && a.write;
+                        });
+                        if (writes)
+                        {
+                            changed = changed || !needed[w];
+                            needed[w] = true;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+        auto expected = std::vector<uint32_t>{};
+        for (auto p = 0u; p < passCount; p++)
+        {
+            if (needed[p])
+            {
+                expected.push_back(p);
+            }
+        }
+        ASSERT_EQ(expected, GetPasses(plan));
+
+        // every earlier conflicting step is reachable through the dependencies
+        auto stepCount = plan.steps.size();
+        auto reach = std::vector<std::vector<bool>>(stepCount, std::vector<bool>(stepCount));
+        for (auto i = 0u; i < stepCount; i++)
+        {
+            for (auto d : plan.steps[i].dependencies)
+            {
+                ASSERT_LT(d, i);
+                reach[i][d] = true;
+                for (auto k = 0u; k < stepCount; k++)
+                {
+                    reach[i][k] = reach[i][k] || reach[d][k];
+                }
+            }
+            for (auto j = 0u; j < i; j++)
+            {
+                auto conflict = false;
+                for (const auto& a : passes[plan.steps[i].pass])
+                {
+                    for (const auto& b : passes[plan.steps[j].pass])
+                    {
+                        conflict = conflict || (a.resource == b.resource && (a.write || b.write));
+                    }
+                }
+                EXPECT_TRUE(!conflict || reach[i][j]);
+            }
+        }
+
+        // lifetimes and placements
+        auto first = std::vector<int>(resourceCount, -1);
+        auto last  = std::vector<int>(resourceCount, -1);
+        for (auto s = 0u; s < stepCount; s++)
+        {
+            for (const auto& access : passes[plan.steps[s].pass])
+            {
+                if (first[access.resource] < 0)
+                {
+                    first[access.resource] = static_cast<int>(s);
+                }
+                last[access.resource] = static_cast<int>(s);
+            }
+        }
+        for (auto r = 0u; r < resourceCount; r++)
+        {
+            const auto& placement = plan.placements[r];
+            if (specs[r].imported || first[r] < 0)
+            {
+                EXPECT_EQ(UINT32_MAX, placement.heap);
+                continue;
+            }
+            ASSERT_LT(placement.heap, plan.heaps.size());
+            const auto& heap = plan.heaps[placement.heap];
+            EXPECT_EQ(specs[r].category, heap.category);
+            EXPECT_EQ(0u, placement.offset % specs[r].alignment);
+            EXPECT_LE(placement.offset + specs[r].size, heap.size);
+            EXPECT_GE(heap.alignment, specs[r].alignment);
+        }
+
+        // resources that share memory never live at the same time
+        auto aliased = std::vector<bool>(resourceCount);
+        for (auto a = 0u; a < resourceCount; a++)
+        {
+            for (auto b = a + 1; b < resourceCount; b++)
+            {
+                const auto& pa = plan.placements[a];
+                const auto& pb = plan.placements[b];
+                if (pa.heap == UINT32_MAX || pa.heap != pb.heap)
+                {
+                    continue;
+                }
+                auto memory   = pa.offset < pb.offset + specs[b].size && pb.offset < pa.offset + specs[a].size;
+                auto lifetime = first[a] <= last[b] && first[b] <= last[a];
+                EXPECT_FALSE(memory && lifetime);
+                if (memory)
+                {
+                    aliased[a] = aliased[b] = true;
+                }
+            }
+        }
+
+        // replaying the barriers yields the states of the accesses
+        auto states = plan.initialStates;
+        auto uavWritten = std::vector<bool>(resourceCount);
+        for (auto r = 0u; r < resourceCount; r++)
+        {
+            if (specs[r].imported)
+            {
+                EXPECT_EQ(specs[r].state, states[r]);
+            }
+        }
+        for (auto s = 0u; s < stepCount; s++)
+        {
+            auto combined = std::map<uint32_t, D3D12_RESOURCE_STATES>{};
+            auto written  = std::map<uint32_t, bool>{};
+            for (const auto& access : passes[plan.steps[s].pass])
+            {
+                auto i = combined.find(access.resource);
+                combined[access.resource] = i != combined.end() ? i->second | access.state : access.state;
+                written[access.resource]  = written[access.resource] || access.write;
+            }
+
+            auto transitioned = std::set<uint32_t>{};
+            auto uavs         = std::set<uint32_t>{};
+            auto aliasing     = std::set<uint32_t>{};
+            for (const auto& barrier : plan.steps[s].barriers)
+            {
+                ASSERT_EQ(1u, combined.count(barrier.resource));
+                switch (barrier.type)
+                {
+                case d3d::FrameGraphBarrierType::TRANSITION:
+                    EXPECT_EQ(states[barrier.resource], barrier.before);
+                    EXPECT_NE(barrier.before, barrier.after);
+                    EXPECT_TRUE(transitioned.insert(barrier.resource).second);
+                    states[barrier.resource] = barrier.after;
+                    break;
+                case d3d::FrameGraphBarrierType::UAV:
+                    uavs.insert(barrier.resource);
+                    break;
+                case d3d::FrameGraphBarrierType::ALIASING:
+                    EXPECT_EQ(0u, transitioned.count(barrier.resource));
+                    aliasing.insert(barrier.resource);
+                    break;
+                }
+            }
+
+            for (const auto& [r, state] : combined)
+            {
+                EXPECT_EQ(state, states[r]);
+                auto firstUse = static_cast<int>(s) == first[r];
+                EXPECT_EQ(!specs[r].imported && firstUse && aliased[r], aliasing.count(r) == 1);
+                auto uav = (state & D3D12_RESOURCE_STATE_UNORDERED_ACCESS) != 0;
+                if (uavWritten[r] && uav && transitioned.count(r) == 0 && aliasing.count(r) == 0)
+                {
+                    EXPECT_EQ(1u, uavs.count(r));
+                }
+                if (!uavWritten[r] || !uav)
+                {
+                    EXPECT_EQ(0u, uavs.count(r));
+                }
+                uavWritten[r] = written[r] && uav;
+            }
+        }
+        EXPECT_EQ(plan.finalStates, states);
+        for (auto r = 0u; r < resourceCount; r++)
+        {
+            if (!specs[r].imported)
+            {
+                EXPECT_EQ(plan.initialStates[r], plan.finalStates[r]);
+            }
+        }
+    }
+}
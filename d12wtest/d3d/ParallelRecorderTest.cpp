@@ -0,0 +1,120 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include <d12w/d3d/Device.h>
+#include <d12w/d3d/ParallelRecorder.h>
+#include <d12wnull/null.h>
+
+using namespace d12w;
+
+TEST(ParallelRecorder, ChunksAreRecordedIntoOneSubmission)
+{
+    auto device     = d3d::Device{null::CreateDevice()};
+    auto queue      = d3d::CommandQueue{device, D3D12_COMMAND_LIST_TYPE_DIRECT};
+    auto allocators = d3d::CommandAllocatorPool{device, D3D12_COMMAND_LIST_TYPE_DIRECT};
+    auto jobs       = JobPool{4};
+    auto recorder   = d3d::ParallelRecorder{device, allocators, jobs};
+
+    auto recorded = std::vector<std::atomic<int>>(1000);
+    auto lists    = std::vector<null::CommandList*>(4);
+    null::ResetCallCounts();
+    auto fenceValue = recorder.Record(queue, recorded.size(), 256, [&] (d3d::CommandList& list, size_t begin, size_t end) {
+        lists[begin / 256] = static_cast<null::CommandList*>(list.GetCommandList());
+        for (auto i = begin; i < end; i++)
+        {
+            list.DrawInstanced(3);
+            recorded[i]++;
+        }
+    });
+
+    EXPECT_EQ(queue.GetLastSignaledValue(), fenceValue);
+    EXPECT_EQ(1u, null::GetCallCount(null::Call::ExecuteCommandLists));
+    for (const auto& count : recorded)
+    {
+        EXPECT_EQ(1, count.load());
+    }
+    for (auto i = 0u; i < lists.size(); i++)
+    {
+        ASSERT_NE(nullptr, lists[i]);
+        EXPECT_TRUE(lists[i]->IsClosed());
+        EXPECT_EQ(i < 3 ? 256u : 232u, lists[i]->GetCommandCount());
+    }
+    EXPECT_EQ(4u, allocators.GetStats().acquired);
+}
+
+TEST(ParallelRecorder, ListsAndAllocatorsAreReused)
+{
+    auto device     = d3d::Device{null::CreateDevice()};
+    auto queue      = d3d::CommandQueue{device, D3D12_COMMAND_LIST_TYPE_DIRECT};
+    auto allocators = d3d::CommandAllocatorPool{device, D3D12_COMMAND_LIST_TYPE_DIRECT};
+    auto jobs       = JobPool{2};
+    auto recorder   = d3d::ParallelRecorder{device, allocators, jobs};
+
+    auto record = [] (d3d::CommandList& list, size_t begin, size_t end) {
+        for (auto i = begin; i < end; i++)
+        {
+            list.DrawInstanced(3);
+        }
+    };
+    for (auto frame = 0; frame < 10; frame++)
+    {
+        auto fenceValue = recorder.Record(queue, 100, 25, record);
+        queue.WaitForValue(fenceValue);
+        allocators.Retire(queue.GetCompletedValue());
+    }
+
+    EXPECT_EQ(40u, allocators.GetStats().acquired);
+    EXPECT_EQ(4u, allocators.GetStats().created);
+    EXPECT_EQ(0u, recorder.Record(queue, 0, 25, record));
+}
+
+TEST(ParallelRecorder, NothingIsSubmittedIfRecordingThrows)
+{
+    auto device     = d3d::Device{null::CreateDevice()};
+    auto queue      = d3d::CommandQueue{device, D3D12_COMMAND_LIST_TYPE_DIRECT};
+    auto allocators = d3d::CommandAllocatorPool{device, D3D12_COMMAND_LIST_TYPE_DIRECT};
+    auto jobs       = JobPool{4};
+    auto recorder   = d3d::ParallelRecorder{device, allocators, jobs};
+
+    null::ResetCallCounts();
+    EXPECT_THROW(recorder.Record(queue, 100, 10, [] (d3d::CommandList& list, size_t begin, size_t) {
+        list.DrawInstanced(3);
+        if (begin == 50)
+        {
+            throw std::runtime_error("recording failed");
+        }
+    }), std::runtime_error);
+    EXPECT_EQ(0u, null::GetCallCount(null::Call::ExecuteCommandLists));
+
+    // the allocators went back to the pool and the lists can be recorded again
+    allocators.Retire(queue.GetCompletedValue());
+    recorder.Record(queue, 100, 10, [] (d3d::CommandList& list, size_t, size_t) {
+        list.DrawInstanced(3);
+    });
+    EXPECT_EQ(1u, null::GetCallCount(null::Call::ExecuteCommandLists));
+    EXPECT_EQ(10u, allocators.GetStats().created);
+}
@@ -0,0 +1,201 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <d12w/d3d/QueueGraph.h>
+
+using namespace d12w;
+
+namespace
+{
+    constexpr auto DIRECT  = 0u;
+    constexpr auto COMPUTE = 1u;
+    constexpr auto COPY    = 2u;
+
+    struct Graph
+    {
+        std::vector<uint32_t>              queues;
+        std::vector<std::vector<uint32_t>> dependencies;
+    };
+
+    // checks that every dependency is ordered by queue order and the waits,
+    // optionally with one wait left out
+    bool IsOrdered(const Graph& graph, const std::vector<d3d::QueueStep>& steps, size_t skipItem = SIZE_MAX, size_t skipWait = SIZE_MAX)
+    {
+        auto count  = graph.queues.size();
+        auto before = std::vector<std::vector<bool>>(count, std::vector<bool>(count, false));
+        auto last   = std::vector<size_t>(4, SIZE_MAX);
+
+        for (auto i = size_t{0}; i < count; i++)
+        {
+            auto add = [&] (size_t earlier) {
+                before[earlier][i] = true;
+                for (auto k = size_t{0}; k < count; k++)
+                {
+                    if (before[k][earlier])
+                    {
+                        before[k][i] = true;
+                    }
+                }
+            };
+
+            if (last[graph.queues[i]] != SIZE_MAX)
+            {
+                add(last[graph.queues[i]]);
+            }
+            for (auto w = size_t{0}; w < steps[i].waits.size(); w++)
+            {
+                if (i != skipItem || w != skipWait)
+                {
+                    add(steps[i].waits[w].item);
+                }
+            }
+            last[graph.queues[i]] = i;
+        }
+
+        for (auto i = size_t{0}; i < count; i++)
+        {
+            for (auto dependency : graph.dependencies[i])
+            {
+                if (!before[dependency][i])
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+}
+
+TEST(QueueGraph, DependenciesOnTheSameQueueNeedNoWait)
+{
+    auto graph = d3d::QueueGraph{3};
+    auto a = graph.Add(DIRECT);
+    graph.Add(DIRECT, {a});
+
+    auto steps = graph.Compile();
+    ASSERT_EQ(2u, steps.size());
+    EXPECT_TRUE(steps[1].waits.empty());
+    EXPECT_FALSE(steps[0].signal);
+}
+
+TEST(QueueGraph, CrossQueueDependenciesWaitAndSignal)
+{
+    auto graph = d3d::QueueGraph{3};
+    auto upload = graph.Add(COPY);
+    auto draw   = graph.Add(DIRECT, {upload});
+
+    auto steps = graph.Compile();
+    EXPECT_TRUE(steps[upload].signal);
+    ASSERT_EQ(1u, steps[draw].waits.size());
+    EXPECT_EQ(COPY, steps[draw].waits[0].queue);
+    EXPECT_EQ(upload, steps[draw].waits[0].item);
+}
+
+TEST(QueueGraph, ImpliedDependenciesAreDropped)
+{
+    auto graph = d3d::QueueGraph{3};
+    auto upload = graph.Add(COPY);
+    auto shadow = graph.Add(DIRECT);
+    auto sim    = graph.Add(COMPUTE, {upload});
+    // the upload is implied by the simulation
+    auto main   = graph.Add(DIRECT, {shadow, sim, upload});
+    auto post   = graph.Add(DIRECT, {main});
+
+    auto steps = graph.Compile();
+    ASSERT_EQ(1u, steps[sim].waits.size());
+    ASSERT_EQ(1u, steps[main].waits.size());
+    EXPECT_EQ(sim, steps[main].waits[0].item);
+    EXPECT_TRUE(steps[post].waits.empty());
+    EXPECT_FALSE(steps[shadow].signal);
+}
+
+TEST(QueueGraph, EarlierWaitsCoverLaterDependencies)
+{
+    auto graph = d3d::QueueGraph{2};
+    auto a = graph.Add(COMPUTE);
+    auto b = graph.Add(COMPUTE);
+    graph.Add(DIRECT, {b});
+    auto d = graph.Add(DIRECT, {a});
+
+    // the wait for b already orders a
+    auto steps = graph.Compile();
+    EXPECT_TRUE(steps[d].waits.empty());
+    EXPECT_FALSE(steps[a].signal);
+}
+
+TEST(QueueGraph, InvalidItemsThrow)
+{
+    auto graph = d3d::QueueGraph{2};
+    EXPECT_THROW(graph.Add(2), std::invalid_argument);
+    EXPECT_THROW(graph.Add(0, {0}), std::invalid_argument);
+
+    graph.Add(0);
+    EXPECT_EQ(1u, graph.GetItemCount());
+    graph.Clear();
+    EXPECT_EQ(0u, graph.GetItemCount());
+}
+
+TEST(QueueGraph, FuzzWaitsAreSufficientAndMinimal)
+{
+    auto rng = std::mt19937{7};
+    for (auto iteration = 0; iteration < 1000; iteration++)
+    {
+        auto queueCount = static_cast<uint32_t>(1 + rng() % 4);
+        auto itemCount  = static_cast<uint32_t>(1 + rng() % 25);
+
+        auto graph = d3d::QueueGraph{queueCount};
+        auto plain = Graph{};
+        for (auto i = 0u; i < itemCount; i++)
+        {
+            auto dependencies = std::vector<uint32_t>{};
+            for (auto j = 0u; j < i; j++)
+            {
+                if (rng() % 5 == 0)
+                {
+                    dependencies.push_back(j);
+                }
+            }
+            plain.queues.push_back(rng() % queueCount);
+            plain.dependencies.push_back(dependencies);
+            graph.Add(plain.queues.back(), dependencies);
+        }
+
+        auto steps = graph.Compile();
+        ASSERT_TRUE(IsOrdered(plain, steps));
+        for (auto i = size_t{0}; i < steps.size(); i++)
+        {
+            for (auto w = size_t{0}; w < steps[i].waits.size(); w++)
+            {
+                const auto& wait = steps[i].waits[w];
+                // no wait can be left out
+                ASSERT_FALSE(IsOrdered(plain, steps, i, w));
+                ASSERT_EQ(plain.queues[wait.item], wait.queue);
+                ASSERT_TRUE(steps[wait.item].signal);
+            }
+        }
+    }
+}
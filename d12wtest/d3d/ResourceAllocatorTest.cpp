@@ -0,0 +1,201 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include <d12w/d3d/CommandList.h>
+#include <d12w/d3d/CommandQueue.h>
+#include <d12w/d3d/Device.h>
+#include <d12w/d3d/ResourceAllocator.h>
+#include <d12wnull/null.h>
+
+using namespace d12w;
+
+namespace
+{
+    // the heaps are 16 units, units are a multiple of the buffer alignment
+    constexpr auto UNIT      = UINT64{256} << 10;
+    constexpr auto HEAP_SIZE = 16 * UNIT;
+
+    d3d::ResourceAllocation CreateBuffer(d3d::ResourceAllocator& allocator, UINT64 units)
+    {
+        auto desc = D3D12_RESOURCE_DESC{};
+        desc.Dimension        = D3D12_RESOURCE_DIMENSION_BUFFER;
+        desc.Width            = units * UNIT;
+        desc.Height           = 1;
+        desc.DepthOrArraySize = 1;
+        desc.MipLevels        = 1;
+        desc.SampleDesc.Count = 1;
+        desc.Layout           = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+        return allocator.CreateResource(D3D12_HEAP_TYPE_DEFAULT, desc, D3D12_RESOURCE_STATE_COMMON);
+    }
+
+    // heap 0 holds the 1 unit source, heap 1 is the densest with room for it
+    struct Fragmented
+    {
+        d3d::ResourceAllocation filler;
+        d3d::ResourceAllocation dense;
+        d3d::ResourceAllocation medium;
+        d3d::ResourceAllocation source;
+
+        explicit
+        Fragmented(d3d::ResourceAllocator& allocator)
+        {
+            filler = CreateBuffer(allocator, 15);
+            dense  = CreateBuffer(allocator, 13);
+            medium = CreateBuffer(allocator, 10);
+            source = CreateBuffer(allocator, 1);
+            allocator.Free(filler);
+        }
+    };
+}
+
+TEST(ResourceAllocator, ResourcesShareHeaps)
+{
+    auto device    = d3d::Device{null::CreateDevice()};
+    auto allocator = d3d::ResourceAllocator{device, HEAP_SIZE};
+
+    auto a = CreateBuffer(allocator, 1);
+    auto b = CreateBuffer(allocator, 1);
+    EXPECT_EQ(a.heap, b.heap);
+    EXPECT_EQ(0u, a.offset);
+    EXPECT_EQ(UNIT, b.offset);
+
+    // too large for the heap, it gets its own
+    auto c = CreateBuffer(allocator, 32);
+    EXPECT_NE(a.heap, c.heap);
+    EXPECT_EQ(2u, allocator.GetStats().size());
+
+    allocator.Free(a);
+    allocator.Free(b);
+    allocator.Free(c);
+    EXPECT_FALSE(a);
+    allocator.Trim();
+    EXPECT_TRUE(allocator.GetStats().empty());
+}
+
+TEST(ResourceAllocator, DefragmentationMovesOutOfSparseHeaps)
+{
+    auto device    = d3d::Device{null::CreateDevice()};
+    auto allocator = d3d::ResourceAllocator{device, HEAP_SIZE};
+    auto heaps     = Fragmented{allocator};
+
+    auto moves = allocator.BeginDefragmentation(UINT64_MAX);
+    ASSERT_EQ(1u, moves.size());
+    EXPECT_EQ(heaps.source.resource.Get(), moves[0].source);
+    EXPECT_EQ(heaps.dense.heap, moves[0].destination.heap);
+
+    allocator.CompleteMove(heaps.source, moves[0]);
+    EXPECT_EQ(heaps.dense.heap, heaps.source.heap);
+
+    allocator.Trim();
+    EXPECT_EQ(2u, allocator.GetStats().size());
+}
+
+TEST(ResourceAllocator, DestinationsAreNotMovedUntilTheMoveIsDone)
+{
+    auto device    = d3d::Device{null::CreateDevice()};
+    auto allocator = d3d::ResourceAllocator{device, HEAP_SIZE};
+    auto heaps     = Fragmented{allocator};
+
+    auto moves = allocator.BeginDefragmentation(UINT64_MAX);
+    ASSERT_EQ(1u, moves.size());
+
+    // the destination heap becomes sparse, but the copy is still in flight
+    allocator.Free(heaps.dense);
+    EXPECT_TRUE(allocator.BeginDefragmentation(UINT64_MAX).empty());
+
+    // once the move is done, the moved resource may be moved again
+    allocator.CompleteMove(heaps.source, moves[0]);
+    auto again = allocator.BeginDefragmentation(UINT64_MAX);
+    ASSERT_EQ(1u, again.size());
+    EXPECT_EQ(heaps.source.resource.Get(), again[0].source);
+    allocator.CancelMove(again[0]);
+}
+
+TEST(ResourceAllocator, CancelingAStaleMoveLeavesReusedBlocksAlone)
+{
+    auto device    = d3d::Device{null::CreateDevice()};
+    auto allocator = d3d::ResourceAllocator{device, HEAP_SIZE};
+    auto heaps     = Fragmented{allocator};
+
+    auto stale = allocator.BeginDefragmentation(UINT64_MAX);
+    ASSERT_EQ(1u, stale.size());
+
+    // the source goes away and its heap is trimmed, a new heap takes its slot
+    allocator.Free(heaps.source);
+    allocator.Trim();
+    auto filler = CreateBuffer(allocator, 15);
+    auto reused = CreateBuffer(allocator, 1);
+    ASSERT_EQ(stale[0].sourceHeapIndex, reused.heapIndex);
+    ASSERT_EQ(stale[0].sourceBlock, reused.block.block);
+
+    // the resource in the reused block is moved
+    allocator.Free(filler);
+    auto moves = allocator.BeginDefragmentation(UINT64_MAX);
+    ASSERT_EQ(1u, moves.size());
+    EXPECT_EQ(reused.resource.Get(), moves[0].source);
+
+    // canceling the stale move must not make it movable again
+    allocator.CancelMove(stale[0]);
+    EXPECT_TRUE(allocator.BeginDefragmentation(UINT64_MAX).empty());
+
+    allocator.CompleteMove(reused, moves[0]);
+}
+
+TEST(ResourceAllocator, SubmittedMovesAreCopiedAndCompleted)
+{
+    auto device    = d3d::Device{null::CreateDevice()};
+    auto allocator = d3d::ResourceAllocator{device, HEAP_SIZE};
+    auto heaps     = Fragmented{allocator};
+    auto queue     = d3d::CommandQueue{device, D3D12_COMMAND_LIST_TYPE_COPY};
+    auto commands  = device.CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY);
+    auto list      = d3d::CommandList{device, D3D12_COMMAND_LIST_TYPE_COPY, commands.Get()};
+
+    auto moves = allocator.BeginDefragmentation(UINT64_MAX);
+    ASSERT_EQ(1u, moves.size());
+    auto destination = moves[0].destination.resource.Get();
+
+    auto value = allocator.SubmitMoves(queue, list, moves);
+    EXPECT_EQ(queue.GetLastSignaledValue(), value);
+    EXPECT_EQ(1u, static_cast<null::CommandList*>(list.GetCommandList())->GetCommandCount());
+
+    allocator.CompleteMoves(queue, value, {&heaps.source}, moves);
+    EXPECT_TRUE(moves.empty());
+    EXPECT_EQ(destination, heaps.source.resource.Get());
+    EXPECT_EQ(heaps.dense.heap, heaps.source.heap);
+}
+
+TEST(ResourceAllocator, CompletingMovesNeedsAnAllocationPerMove)
+{
+    auto device    = d3d::Device{null::CreateDevice()};
+    auto allocator = d3d::ResourceAllocator{device, HEAP_SIZE};
+    auto heaps     = Fragmented{allocator};
+    auto queue     = d3d::CommandQueue{device, D3D12_COMMAND_LIST_TYPE_COPY};
+
+    auto moves = allocator.BeginDefragmentation(UINT64_MAX);
+    ASSERT_EQ(1u, moves.size());
+
+    EXPECT_THROW(allocator.CompleteMoves(queue, 0, {}, moves), std::invalid_argument);
+    allocator.CancelMove(moves[0]);
+}
@@ -0,0 +1,146 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <d12w/d3d/ShaderVisibleDescriptorHeap.h>
+#include <d12wnull/null.h>
+
+using namespace d12w;
+
+namespace
+{
+    d3d::ShaderVisibleDescriptorHeap MakeHeap(uint32_t persistentSize, uint32_t ringSize)
+    {
+        return d3d::ShaderVisibleDescriptorHeap{null::CreateDevice().As<ID3D12Device>(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, persistentSize, ringSize};
+    }
+}
+
+TEST(ShaderVisibleDescriptorHeap, RangesMapOntoTheHeap)
+{
+    auto heap = MakeHeap(16, 16);
+    auto start = heap.GetHeap()->GetGPUDescriptorHandleForHeapStart();
+
+    auto persistent = heap.AllocatePersistent(4);
+    auto transient  = heap.AllocateTransient(4);
+    EXPECT_EQ(0u, persistent.index);
+    EXPECT_EQ(16u, transient.index);
+    EXPECT_EQ(start.ptr, persistent.gpu.ptr);
+    EXPECT_EQ(start.ptr + 16 * transient.incrementSize, transient.gpu.ptr);
+    EXPECT_EQ(transient.cpu.ptr + 3 * transient.incrementSize, transient.GetCpuHandle(3).ptr);
+}
+
+TEST(ShaderVisibleDescriptorHeap, FreedPersistentRangesWaitForTheFence)
+{
+    auto heap = MakeHeap(12, 4);
+
+    auto a = heap.AllocatePersistent(4);
+    auto b = heap.AllocatePersistent(4);
+    auto c = heap.AllocatePersistent(4);
+    EXPECT_THROW(heap.AllocatePersistent(1), std::runtime_error);
+
+    heap.FreePersistent(a, 1);
+    heap.FreePersistent(b, 2);
+    heap.Retire(0);
+    EXPECT_THROW(heap.AllocatePersistent(1), std::runtime_error);
+
+    // the freed ranges are merged, so that a larger table fits
+    heap.Retire(2);
+    auto merged = heap.AllocatePersistent(8);
+    EXPECT_EQ(0u, merged.index);
+    EXPECT_EQ(8u, c.index);
+}
+
+TEST(ShaderVisibleDescriptorHeap, RingRangesAreReusedAfterRetire)
+{
+    auto heap = MakeHeap(0, 16);
+
+    auto first = heap.AllocateTransient(10);
+    heap.FinishFrame(1);
+    EXPECT_EQ(10u, heap.GetTransientUsage());
+
+    // does not fit before the end of the ring, and the start is still in flight
+    EXPECT_THROW(heap.AllocateTransient(8), std::runtime_error);
+
+    auto second = heap.AllocateTransient(6);
+    EXPECT_EQ(10u, second.index);
+    heap.FinishFrame(2);
+
+    heap.Retire(1);
+    EXPECT_EQ(6u, heap.GetTransientUsage());
+
+    // wraps to the start of the ring
+    auto third = heap.AllocateTransient(8);
+    EXPECT_EQ(first.index, third.index);
+}
+
+TEST(ShaderVisibleDescriptorHeap, TransientRangesMustFitTheRing)
+{
+    auto heap = MakeHeap(4, 8);
+    EXPECT_THROW(heap.AllocateTransient(9), std::invalid_argument);
+    EXPECT_EQ(4u, heap.AllocateTransient(8).index);
+
+    // a heap without a ring only has persistent ranges
+    auto persistent = MakeHeap(4, 0);
+    EXPECT_THROW(persistent.AllocateTransient(1), std::invalid_argument);
+    EXPECT_EQ(0u, persistent.AllocatePersistent(4).index);
+}
+
+TEST(ShaderVisibleDescriptorHeap, StressConcurrentTransientAllocations)
+{
+    constexpr auto THREADS = 8u;
+    constexpr auto RANGES  = 500u;
+
+    auto heap   = MakeHeap(0, THREADS * RANGES * 3);
+    auto mutex  = std::mutex{};
+    auto ranges = std::vector<std::pair<uint32_t, uint32_t>>{};
+
+    auto threads = std::vector<std::thread>{};
+    for (auto t = 0u; t < THREADS; t++)
+    {
+        threads.emplace_back([&, t] () {
+            auto local = std::vector<std::pair<uint32_t, uint32_t>>{};
+            for (auto i = 0u; i < RANGES; i++)
+            {
+                auto range = heap.AllocateTransient(1 + (i + t) % 3);
+                local.emplace_back(range.index, range.count);
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            ranges.insert(ranges.end(), local.begin(), local.end());
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    std::sort(ranges.begin(), ranges.end());
+    for (auto i = size_t{1}; i < ranges.size(); i++)
+    {
+        ASSERT_LE(ranges[i - 1].first + ranges[i - 1].second, ranges[i].first);
+    }
+}
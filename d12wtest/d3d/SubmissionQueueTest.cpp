@@ -0,0 +1,131 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <future>
+#include <thread>
+#include <vector>
+
+#include <d12w/d3d/CommandQueue.h>
+#include <d12w/d3d/Device.h>
+#include <d12w/d3d/SubmissionQueue.h>
+#include <d12wnull/null.h>
+
+using namespace d12w;
+
+namespace
+{
+    ComPtr<ID3D12GraphicsCommandList> MakeClosedList(d3d::Device& device)
+    {
+        auto allocator = device.CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT);
+        auto list = device.CreateCommandList(D3D12_COMMAND_LIST_TYPE_DIRECT, allocator.Get());
+        list->Close();
+        return list;
+    }
+}
+
+TEST(SubmissionQueue, SubmissionsGetTheFenceValueOfTheirBatch)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    auto queue  = d3d::CommandQueue{device, D3D12_COMMAND_LIST_TYPE_DIRECT};
+    auto list   = MakeClosedList(device);
+
+    auto submissions = d3d::SubmissionQueue{queue};
+    auto raw = static_cast<ID3D12CommandList*>(list.Get());
+    auto first  = submissions.Submit(1, &raw);
+    auto second = submissions.Submit(1, &raw);
+    auto flushed = submissions.Flush();
+
+    EXPECT_LE(first.get(), second.get());
+    EXPECT_EQ(second.get(), flushed);
+    EXPECT_EQ(queue.GetLastSignaledValue(), flushed);
+    EXPECT_TRUE(queue.IsComplete(flushed));
+}
+
+TEST(SubmissionQueue, FlushWithoutSubmissionsReturnsTheLastValue)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    auto queue  = d3d::CommandQueue{device, D3D12_COMMAND_LIST_TYPE_DIRECT};
+
+    auto submissions = d3d::SubmissionQueue{queue};
+    EXPECT_EQ(queue.GetLastSignaledValue(), submissions.Flush());
+    EXPECT_EQ(0u, submissions.GetStats().calls);
+}
+
+TEST(SubmissionQueue, SubmissionsOfAllThreadsAreBatched)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    auto queue  = d3d::CommandQueue{device, D3D12_COMMAND_LIST_TYPE_DIRECT};
+    auto list   = MakeClosedList(device);
+
+    constexpr auto THREADS     = 4u;
+    constexpr auto SUBMISSIONS = 500u;
+
+    auto submissions = d3d::SubmissionQueue{queue};
+    auto threads = std::vector<std::thread>{};
+    for (auto t = 0u; t < THREADS; t++)
+    {
+        threads.emplace_back([&] () {
+            auto raw  = static_cast<ID3D12CommandList*>(list.Get());
+            auto last = UINT64{0};
+            for (auto i = 0u; i < SUBMISSIONS; i++)
+            {
+                // the fence values of one thread never go back
+                auto value = submissions.Submit(1, &raw);
+                if (i % 50 == 0)
+                {
+                    EXPECT_LE(last, value.get());
+                    last = value.get();
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    auto flushed = submissions.Flush();
+
+    auto stats = submissions.GetStats();
+    EXPECT_EQ(THREADS * SUBMISSIONS + 1, stats.submissions);
+    EXPECT_LE(stats.calls, THREADS * SUBMISSIONS);
+    EXPECT_EQ(stats.calls, flushed);
+}
+
+TEST(SubmissionQueue, PendingListsAreSubmittedOnDestruction)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    auto queue  = d3d::CommandQueue{device, D3D12_COMMAND_LIST_TYPE_DIRECT};
+    auto list   = MakeClosedList(device);
+
+    auto future = std::shared_future<UINT64>{};
+    {
+        auto submissions = d3d::SubmissionQueue{queue};
+        auto raw = static_cast<ID3D12CommandList*>(list.Get());
+        for (auto i = 0; i < 100; i++)
+        {
+            future = submissions.Submit(1, &raw);
+        }
+    }
+    EXPECT_EQ(std::future_status::ready, future.wait_for(std::chrono::seconds(0)));
+    EXPECT_EQ(queue.GetLastSignaledValue(), future.get());
+}
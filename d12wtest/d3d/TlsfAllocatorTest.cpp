@@ -0,0 +1,169 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <map>
+#include <random>
+#include <vector>
+
+#include <d12w/d3d/TlsfAllocator.h>
+
+using namespace d12w;
+
+namespace
+{
+    constexpr auto HEAP_SIZE = uint64_t{64} << 20;
+}
+
+TEST(TlsfAllocator, AllocationsAreAligned)
+{
+    auto allocator = d3d::TlsfAllocator{HEAP_SIZE};
+
+    auto a = allocator.Allocate(1000);
+    auto b = allocator.Allocate(65536, 65536);
+    ASSERT_TRUE(a);
+    ASSERT_TRUE(b);
+    EXPECT_EQ(0u, a.offset);
+    EXPECT_EQ(1000u, a.size);
+    EXPECT_EQ(65536u, b.offset);
+
+    auto stats = allocator.GetStats();
+    EXPECT_EQ(2u, stats.allocationCount);
+    EXPECT_EQ(1024u + 65536u, stats.usedSize);
+    EXPECT_EQ(2u, stats.freeBlockCount);
+}
+
+TEST(TlsfAllocator, FreeMergesAdjacentBlocks)
+{
+    auto allocator = d3d::TlsfAllocator{HEAP_SIZE};
+
+    auto a = allocator.Allocate(1000);
+    auto b = allocator.Allocate(65536, 65536);
+    allocator.Free(a);
+    allocator.Free(b);
+
+    auto stats = allocator.GetStats();
+    EXPECT_TRUE(allocator.IsEmpty());
+    EXPECT_EQ(1u, stats.freeBlockCount);
+    EXPECT_EQ(HEAP_SIZE, stats.largestFreeBlock);
+    EXPECT_EQ(0.0, stats.GetFragmentation());
+}
+
+TEST(TlsfAllocator, AllocationsLargerThanTheRangeFail)
+{
+    auto allocator = d3d::TlsfAllocator{HEAP_SIZE};
+    EXPECT_FALSE(allocator.Allocate(HEAP_SIZE + 1));
+    EXPECT_TRUE(allocator.IsEmpty());
+
+    // freeing an empty allocation is ignored
+    allocator.Free(d3d::TlsfAllocation{});
+    EXPECT_TRUE(allocator.IsEmpty());
+}
+
+TEST(TlsfAllocator, TheRangeCanBeFilledCompletely)
+{
+    auto allocator = d3d::TlsfAllocator{HEAP_SIZE};
+
+    auto all = allocator.Allocate(HEAP_SIZE, 65536);
+    ASSERT_TRUE(all);
+    EXPECT_EQ(0u, all.offset);
+    EXPECT_FALSE(allocator.Allocate(1));
+    allocator.Free(all);
+
+    auto count = 0u;
+    while (allocator.Allocate(65536, 65536))
+    {
+        count++;
+    }
+    EXPECT_EQ(HEAP_SIZE / 65536, count);
+}
+
+TEST(TlsfAllocator, FragmentationOfScatteredFreeSpace)
+{
+    auto allocator = d3d::TlsfAllocator{4 * 65536};
+
+    auto blocks = std::vector<d3d::TlsfAllocation>{};
+    for (auto i = 0; i < 4; i++)
+    {
+        blocks.push_back(allocator.Allocate(65536));
+    }
+    allocator.Free(blocks[0]);
+    allocator.Free(blocks[2]);
+
+    auto stats = allocator.GetStats();
+    EXPECT_EQ(2u, stats.freeBlockCount);
+    EXPECT_EQ(65536u, stats.largestFreeBlock);
+    EXPECT_DOUBLE_EQ(0.5, stats.GetFragmentation());
+}
+
+TEST(TlsfAllocator, FuzzAllocationsNeverOverlap)
+{
+    auto allocator = d3d::TlsfAllocator{HEAP_SIZE};
+    auto rng  = std::mt19937_64{7};
+    auto live = std::map<uint64_t, d3d::TlsfAllocation>{};
+
+    for (auto i = 0; i < 100000; i++)
+    {
+        if (live.empty() || rng() % 3 != 0)
+        {
+            auto size       = 1 + rng() % (1 << 20);
+            auto alignment  = uint64_t{1} << (8 + rng() % 9);
+            auto allocation = allocator.Allocate(size, alignment);
+            if (!allocation)
+            {
+                continue;
+            }
+            ASSERT_EQ(0u, allocation.offset % alignment);
+            ASSERT_LE(allocation.offset + size, HEAP_SIZE);
+
+            auto next = live.lower_bound(allocation.offset);
+            if (next != live.end())
+            {
+                ASSERT_LE(allocation.offset + size, next->first);
+            }
+            if (next != live.begin())
+            {
+                auto prev = std::prev(next);
+                ASSERT_LE(prev->first + prev->second.size, allocation.offset);
+            }
+            live[allocation.offset] = allocation;
+        }
+        else
+        {
+            auto victim = live.begin();
+            std::advance(victim, rng() % live.size());
+            allocator.Free(victim->second);
+            live.erase(victim);
+        }
+    }
+
+    EXPECT_EQ(live.size(), allocator.GetStats().allocationCount);
+    for (auto& [offset, allocation] : live)
+    {
+        allocator.Free(allocation);
+    }
+    auto stats = allocator.GetStats();
+    EXPECT_TRUE(allocator.IsEmpty());
+    EXPECT_EQ(1u, stats.freeBlockCount);
+    EXPECT_EQ(0u, stats.usedSize);
+}
@@ -0,0 +1,167 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <d12w/d3d/Device.h>
+#include <d12w/d3d/UploadRing.h>
+#include <d12wnull/null.h>
+
+using namespace d12w;
+
+TEST(UploadRing, AllocationsAreAligned)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    auto ring   = d3d::UploadRing{device, 1024 * 1024};
+
+    auto a = ring.Allocate(4);
+    auto b = ring.Allocate(300);
+    auto c = ring.Allocate(16, 65536);
+    EXPECT_EQ(0u, a.offset);
+    EXPECT_EQ(256u, b.offset);
+    EXPECT_EQ(65536u, c.offset);
+    EXPECT_EQ(a.gpu + c.offset, c.gpu);
+    EXPECT_EQ(static_cast<uint8_t*>(a.cpu) + b.offset, b.cpu);
+    EXPECT_EQ(300u, b.size);
+}
+
+TEST(UploadRing, BuffersBelowTheGranularityAreRejected)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    EXPECT_THROW(d3d::UploadRing(device, 0), std::invalid_argument);
+
+    auto heap = D3D12_HEAP_PROPERTIES{};
+    heap.Type = D3D12_HEAP_TYPE_UPLOAD;
+
+    auto desc = D3D12_RESOURCE_DESC{};
+    desc.Dimension        = D3D12_RESOURCE_DIMENSION_BUFFER;
+    desc.Width            = 100;
+    desc.Height           = 1;
+    desc.DepthOrArraySize = 1;
+    desc.MipLevels        = 1;
+    desc.SampleDesc.Count = 1;
+    desc.Layout           = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+    auto buffer = device.CreateCommittedResource(heap, D3D12_HEAP_FLAG_NONE, desc, D3D12_RESOURCE_STATE_GENERIC_READ);
+    EXPECT_THROW(d3d::UploadRing{buffer}, std::invalid_argument);
+}
+
+TEST(UploadRing, UploadCopiesTheData)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    auto ring   = d3d::UploadRing{device, 4096};
+
+    const float data[] = {1.0f, 2.0f, 3.0f, 4.0f};
+    auto allocation = ring.Upload(data, sizeof(data));
+    EXPECT_EQ(0, std::memcmp(data, allocation.cpu, sizeof(data)));
+}
+
+TEST(UploadRing, MemoryIsReclaimedAfterRetire)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    auto ring   = d3d::UploadRing{device, 1024};
+
+    ring.Allocate(512);
+    ring.FinishFrame(1);
+    ring.Allocate(512);
+    ring.FinishFrame(2);
+    EXPECT_EQ(1024u, ring.GetUsage());
+    EXPECT_THROW(ring.Allocate(256), std::runtime_error);
+
+    ring.Retire(1);
+    EXPECT_EQ(512u, ring.GetUsage());
+    EXPECT_EQ(0u, ring.Allocate(512).offset);
+}
+
+TEST(UploadRing, AllocationsDoNotRunOverTheEnd)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    auto ring   = d3d::UploadRing{device, 1024};
+
+    ring.Allocate(768);
+    ring.FinishFrame(1);
+    ring.Retire(1);
+
+    // the tail of the ring is skipped, the allocation starts at the beginning
+    auto allocation = ring.Allocate(512);
+    EXPECT_EQ(0u, allocation.offset);
+    EXPECT_EQ(768u, ring.GetUsage());
+}
+
+TEST(UploadRing, FailedAllocationsLeaveTheRingUnchanged)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    auto ring   = d3d::UploadRing{device, 1024};
+
+    ring.Allocate(512);
+    EXPECT_THROW(ring.Allocate(768), std::runtime_error);
+    EXPECT_EQ(512u, ring.GetUsage());
+
+    // the space the failed allocation asked for is still available
+    EXPECT_EQ(512u, ring.Allocate(512).offset);
+    EXPECT_THROW(ring.Allocate(2048), std::runtime_error);
+}
+
+TEST(UploadRing, StressConcurrentAllocations)
+{
+    auto device = d3d::Device{null::CreateDevice()};
+    auto ring   = d3d::UploadRing{device, 1024 * 1024};
+
+    constexpr auto THREADS     = 8u;
+    constexpr auto ALLOCATIONS = 256u;
+
+    auto offsets = std::vector<std::vector<UINT64>>(THREADS);
+    auto threads = std::vector<std::thread>{};
+    for (auto t = 0u; t < THREADS; t++)
+    {
+        threads.emplace_back([&, t] () {
+            for (auto i = 0u; i < ALLOCATIONS; i++)
+            {
+                auto allocation = ring.Allocate(256);
+                std::memset(allocation.cpu, static_cast<int>(t), 256);
+                offsets[t].push_back(allocation.offset);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // every allocation got its own memory and kept its content
+    auto seen = std::vector<bool>(THREADS * ALLOCATIONS, false);
+    auto base = static_cast<uint8_t*>(ring.Allocate(1).cpu) - THREADS * ALLOCATIONS * 256;
+    for (auto t = 0u; t < THREADS; t++)
+    {
+        for (auto offset : offsets[t])
+        {
+            EXPECT_FALSE(seen[offset / 256]);
+            seen[offset / 256] = true;
+            EXPECT_EQ(t, base[offset]);
+            EXPECT_EQ(t, base[offset + 255]);
+        }
+    }
+    EXPECT_EQ((THREADS * ALLOCATIONS + 1) * 256, ring.GetUsage());
+}
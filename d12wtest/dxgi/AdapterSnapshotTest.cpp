@@ -0,0 +1,75 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <cwchar>
+
+#include <d12w/dxgi/AdapterSnapshot.h>
+
+using namespace d12w;
+
+namespace
+{
+    dxgi::AdapterSnapshot MakeSnapshot(DXGI_ADAPTER_FLAG3 flags)
+    {
+        auto desc = DXGI_ADAPTER_DESC3{};
+        std::wcsncpy(desc.Description, L"Test Adapter", 128);
+        desc.VendorId             = 0x10DE;
+        desc.DedicatedVideoMemory = 1 << 30;
+        desc.AdapterLuid          = LUID{42, 0};
+        desc.Flags                = flags;
+        desc.ComputePreemptionGranularity = DXGI_COMPUTE_PREEMPTION_THREAD_GROUP_BOUNDARY;
+
+        auto version = LARGE_INTEGER{};
+        version.QuadPart = 7;
+        return dxgi::AdapterSnapshot{desc, version};
+    }
+}
+
+TEST(AdapterSnapshot, OlderDescriptionsAreDerived)
+{
+    auto snapshot = MakeSnapshot(DXGI_ADAPTER_FLAG3_NONE);
+
+    auto desc2 = snapshot.GetDesc2();
+    EXPECT_EQ(std::wstring_view{L"Test Adapter"}, desc2.Description);
+    EXPECT_EQ(0x10DEu, desc2.VendorId);
+    EXPECT_EQ(SIZE_T{1} << 30, desc2.DedicatedVideoMemory);
+    EXPECT_EQ(42u, desc2.AdapterLuid.LowPart);
+    EXPECT_EQ(DXGI_COMPUTE_PREEMPTION_THREAD_GROUP_BOUNDARY, desc2.ComputePreemptionGranularity);
+
+    EXPECT_EQ("Test Adapter", snapshot.GetDescription());
+    EXPECT_EQ(7, snapshot.GetDriverVersion().QuadPart);
+}
+
+TEST(AdapterSnapshot, OlderDescriptionsOnlyCarryTheLegacyFlags)
+{
+    auto snapshot = MakeSnapshot(DXGI_ADAPTER_FLAG3_SOFTWARE | DXGI_ADAPTER_FLAG3_ACG_COMPATIBLE | DXGI_ADAPTER_FLAG3_SUPPORT_MONITORED_FENCES);
+
+    EXPECT_EQ(static_cast<UINT>(DXGI_ADAPTER_FLAG_SOFTWARE), snapshot.GetDesc1().Flags);
+    EXPECT_EQ(static_cast<UINT>(DXGI_ADAPTER_FLAG_SOFTWARE), snapshot.GetDesc2().Flags);
+    EXPECT_EQ(DXGI_ADAPTER_FLAG3_SOFTWARE | DXGI_ADAPTER_FLAG3_ACG_COMPATIBLE | DXGI_ADAPTER_FLAG3_SUPPORT_MONITORED_FENCES, snapshot.GetDesc3().Flags);
+    EXPECT_TRUE(snapshot.IsSoftware());
+
+    auto remote = MakeSnapshot(DXGI_ADAPTER_FLAG3_REMOTE | DXGI_ADAPTER_FLAG3_KEYED_MUTEX_CONFORMANCE);
+    EXPECT_EQ(static_cast<UINT>(DXGI_ADAPTER_FLAG_REMOTE), remote.GetDesc1().Flags);
+    EXPECT_FALSE(remote.IsSoftware());
+}
@@ -0,0 +1,195 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <exception>
+
+#include <d12w/dxgi/Adapter.h>
+#include <d12w/dxgi/Factory.h>
+#include <d12wnull/null.h>
+
+using namespace d12w;
+
+namespace
+{
+    std::vector<null::AdapterConfig> MakeAdapters()
+    {
+        return {
+            null::MakeAdapterConfig(L"Small", 1 << 20, 1),
+            null::MakeAdapterConfig(L"Software", 4 << 20, 2, true),
+            null::MakeAdapterConfig(L"Large", 2 << 20, 3)
+        };
+    }
+
+    // a factory that was created before the adapter configuration changed
+    class StaleFactory : public null::Factory
+    {
+    public:
+        using null::Factory::Factory;
+
+        BOOL STDMETHODCALLTYPE IsCurrent() override
+        {
+            null::Factory::IsCurrent();
+            return FALSE;
+        }
+    };
+
+    // a factory that fails to enumerate past the first adapter
+    class FailingFactory : public null::Factory
+    {
+    public:
+        using null::Factory::Factory;
+
+        HRESULT STDMETHODCALLTYPE EnumAdapters(UINT Adapter, IDXGIAdapter** ppAdapter) override
+        {
+            return Adapter == 0 ? null::Factory::EnumAdapters(Adapter, ppAdapter) : E_FAIL;
+        }
+
+        HRESULT STDMETHODCALLTYPE EnumAdapters1(UINT Adapter, IDXGIAdapter1** ppAdapter) override
+        {
+            return Adapter == 0 ? null::Factory::EnumAdapters1(Adapter, ppAdapter) : E_FAIL;
+        }
+
+        HRESULT STDMETHODCALLTYPE EnumWarpAdapter(REFIID riid, void** ppvAdapter) override
+        {
+            return E_FAIL;
+        }
+
+        HRESULT STDMETHODCALLTYPE EnumAdapterByGpuPreference(UINT Adapter, DXGI_GPU_PREFERENCE GpuPreference, REFIID riid, void** ppvAdapter) override
+        {
+            return E_FAIL;
+        }
+    };
+
+    std::vector<DWORD> GetLuids(const std::vector<std::shared_ptr<dxgi::Adapter>>& adapters)
+    {
+        auto result = std::vector<DWORD>{};
+        for (const auto& adapter : adapters)
+        {
+            result.push_back(adapter->GetSnapshot().GetLuid().LowPart);
+        }
+        return result;
+    }
+}
+
+TEST(Factory, EnumAdaptersIsCached)
+{
+    auto factory = dxgi::Factory{null::CreateFactory(MakeAdapters()).As<IDXGIFactory4>()};
+
+    auto first = factory.EnumAdapters1();
+    null::ResetCallCounts();
+    auto second = factory.EnumAdapters1();
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(0u, null::GetCallCount(null::Call::EnumAdapters1));
+}
+
+TEST(Factory, EnumAdapterByGpuPreferenceFallbackRanksByVideoMemory)
+{
+    auto factory = dxgi::Factory{null::CreateFactory4(MakeAdapters())};
+
+    EXPECT_EQ((std::vector<DWORD>{3, 1, 2}), GetLuids(factory.EnumAdapterByGpuPreference(DXGI_GPU_PREFERENCE_HIGH_PERFORMANCE)));
+    EXPECT_EQ((std::vector<DWORD>{1, 3, 2}), GetLuids(factory.EnumAdapterByGpuPreference(DXGI_GPU_PREFERENCE_MINIMUM_POWER)));
+    EXPECT_EQ((std::vector<DWORD>{1, 2, 3}), GetLuids(factory.EnumAdapterByGpuPreference(DXGI_GPU_PREFERENCE_UNSPECIFIED)));
+}
+
+// the fallback used to rank on every call and to check the factory twice, with a slow driver that adds up
+TEST(Factory, EnumAdapterByGpuPreferenceFallbackIsCached)
+{
+    auto factory = dxgi::Factory{null::CreateFactory4(MakeAdapters(), std::chrono::milliseconds(2))};
+
+    auto first = factory.EnumAdapterByGpuPreference(DXGI_GPU_PREFERENCE_HIGH_PERFORMANCE);
+    null::ResetCallCounts();
+    auto start = std::chrono::steady_clock::now();
+    for (auto i = 0; i < 10; i++)
+    {
+        EXPECT_EQ(first, factory.EnumAdapterByGpuPreference(DXGI_GPU_PREFERENCE_HIGH_PERFORMANCE));
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    // only IsCurrent is called, to check if the cache is still valid
+    EXPECT_EQ(10u, null::GetTotalCallCount());
+    EXPECT_EQ(10u, null::GetCallCount(null::Call::IsCurrent));
+    EXPECT_LT(elapsed, std::chrono::milliseconds(20));
+}
+
+TEST(Factory, EnumAdapterByGpuPreferenceUsesFactory6)
+{
+    auto factory = dxgi::Factory{null::CreateFactory(MakeAdapters()).As<IDXGIFactory4>()};
+
+    factory.EnumAdapterByGpuPreference(DXGI_GPU_PREFERENCE_HIGH_PERFORMANCE);
+    null::ResetCallCounts();
+    factory.EnumAdapterByGpuPreference(DXGI_GPU_PREFERENCE_HIGH_PERFORMANCE);
+    EXPECT_EQ(0u, null::GetCallCount(null::Call::EnumAdapterByGpuPreference));
+}
+
+TEST(Factory, StaleWrappedFactoryIsEnumeratedOnce)
+{
+    auto stale = ComPtr<IDXGIFactory4>{};
+    stale.Attach(new StaleFactory{MakeAdapters(), null::MakeAdapterConfig(L"Warp", 0, 0xFFFF, true)});
+    auto factory = dxgi::Factory{stale};
+
+    null::ResetCallCounts();
+    auto first  = factory.EnumAdapters1();
+    auto second = factory.EnumAdapters1();
+    auto third  = factory.EnumAdapters1();
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(second, third);
+    EXPECT_EQ(4u, null::GetCallCount(null::Call::EnumAdapters1));
+}
+
+TEST(Factory, TryEnumReturnsTheAdapters)
+{
+    auto factory = dxgi::Factory{null::CreateFactory(MakeAdapters()).As<IDXGIFactory4>()};
+
+    auto adapters1 = factory.TryEnumAdapters1();
+    ASSERT_TRUE(adapters1);
+    EXPECT_EQ(factory.EnumAdapters1(), adapters1.Value());
+
+    auto adapters = factory.TryEnumAdapters();
+    ASSERT_TRUE(adapters);
+    EXPECT_EQ(3u, adapters.Value().size());
+
+    auto preferred = factory.TryEnumAdapterByGpuPreference(DXGI_GPU_PREFERENCE_HIGH_PERFORMANCE);
+    ASSERT_TRUE(preferred);
+    EXPECT_EQ(factory.EnumAdapterByGpuPreference(DXGI_GPU_PREFERENCE_HIGH_PERFORMANCE), preferred.Value());
+
+    auto warp = factory.TryEnumWarpAdapter();
+    ASSERT_TRUE(warp);
+    EXPECT_EQ(factory.EnumWarpAdapter(), warp.Value());
+}
+
+TEST(Factory, TryEnumReturnsTheFailure)
+{
+    auto failing = ComPtr<IDXGIFactory4>{};
+    failing.Attach(new FailingFactory{MakeAdapters(), null::MakeAdapterConfig(L"Warp", 0, 0xFFFF, true)});
+    auto factory = dxgi::Factory{failing};
+
+    EXPECT_EQ(E_FAIL, factory.TryEnumAdapters().GetHr());
+    EXPECT_EQ(E_FAIL, factory.TryEnumAdapters1().GetHr());
+    EXPECT_EQ(E_FAIL, factory.TryEnumAdapterByGpuPreference(DXGI_GPU_PREFERENCE_MINIMUM_POWER).GetHr());
+    EXPECT_EQ(E_FAIL, factory.TryEnumWarpAdapter().GetHr());
+
+    EXPECT_THROW(factory.EnumAdapters1(), std::exception);
+
+    // a failed enumeration is not cached
+    EXPECT_EQ(E_FAIL, factory.TryEnumAdapters1().GetHr());
+}
@@ -0,0 +1,117 @@
+// d12w - The C++ DirectX 12 Wrapper
+// Copyright (c) 2019 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <d12wnull/null.h>
+
+using namespace d12w;
+
+TEST(NullFactory, EnumAdapters1ReturnsTheConfiguredAdapters)
+{
+    auto factory = null::CreateFactory({null::MakeAdapterConfig(L"First", 1024, 1), null::MakeAdapterConfig(L"Second", 2048, 2)});
+
+    auto adapter = ComPtr<IDXGIAdapter1>{};
+    ASSERT_EQ(S_OK, factory->EnumAdapters1(1, adapter.GetAddressOf()));
+
+    auto desc = DXGI_ADAPTER_DESC1{};
+    ASSERT_EQ(S_OK, adapter->GetDesc1(&desc));
+    EXPECT_EQ(std::wstring_view{L"Second"}, desc.Description);
+    EXPECT_EQ(2048u, desc.DedicatedVideoMemory);
+    EXPECT_EQ(2u, desc.AdapterLuid.LowPart);
+
+    auto missing = ComPtr<IDXGIAdapter1>{};
+    EXPECT_EQ(DXGI_ERROR_NOT_FOUND, factory->EnumAdapters1(2, missing.GetAddressOf()));
+    EXPECT_FALSE(missing);
+}
+
+TEST(NullFactory, EnumWarpAdapterReturnsASoftwareAdapter)
+{
+    auto factory = null::CreateFactory({});
+
+    auto adapter = ComPtr<IDXGIAdapter4>{};
+    ASSERT_EQ(S_OK, factory->EnumWarpAdapter(adapter.UUID(), reinterpret_cast<void**>(adapter.GetAddressOf())));
+
+    auto desc = DXGI_ADAPTER_DESC3{};
+    ASSERT_EQ(S_OK, adapter->GetDesc3(&desc));
+    EXPECT_EQ(DXGI_ADAPTER_FLAG3_SOFTWARE, desc.Flags & DXGI_ADAPTER_FLAG3_SOFTWARE);
+}
+
+TEST(NullFactory, EnumAdapterByLuidFindsTheAdapter)
+{
+    auto factory = null::CreateFactory({null::MakeAdapterConfig(L"First", 1024, 7)});
+
+    auto luid = LUID{7, 0};
+    auto adapter = ComPtr<IDXGIAdapter1>{};
+    EXPECT_EQ(S_OK, factory->EnumAdapterByLuid(luid, adapter.UUID(), reinterpret_cast<void**>(adapter.GetAddressOf())));
+    EXPECT_TRUE(adapter);
+
+    luid.LowPart = 8;
+    auto missing = ComPtr<IDXGIAdapter1>{};
+    EXPECT_EQ(DXGI_ERROR_NOT_FOUND, factory->EnumAdapterByLuid(luid, missing.UUID(), reinterpret_cast<void**>(missing.GetAddressOf())));
+}
+
+TEST(NullUnknown, QueryInterfaceSucceedsForAllBases)
+{
+    auto factory = null::CreateFactory({});
+
+    EXPECT_TRUE(factory.TryAs<IDXGIFactory>());
+    EXPECT_TRUE(factory.TryAs<IDXGIFactory4>());
+    EXPECT_TRUE(factory.TryAs<IUnknown>());
+    EXPECT_FALSE(factory.TryAs<IDXGIAdapter>());
+}
+
+TEST(NullDebug, RecordsTheSettings)
+{
+    auto debug = null::CreateDebug();
+    debug->EnableDebugLayer();
+    debug->SetEnableGPUBasedValidation(TRUE);
+
+    auto& state = static_cast<null::Debug&>(*debug.Get());
+    EXPECT_TRUE(state.IsDebugLayerEnabled());
+    EXPECT_TRUE(state.IsGPUBasedValidationEnabled());
+}
+
+TEST(NullFence, SetEventOnCompletionSignalsTheEvent)
+{
+    auto fence = null::CreateFence(0);
+    auto event = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+    ASSERT_NE(nullptr, event);
+
+    ASSERT_EQ(S_OK, fence->SetEventOnCompletion(2, event));
+    EXPECT_EQ(WAIT_TIMEOUT, WaitForSingleObject(event, 0));
+
+    fence->SignalAfter(2, std::chrono::milliseconds(1));
+    EXPECT_EQ(WAIT_OBJECT_0, WaitForSingleObject(event, INFINITE));
+    EXPECT_EQ(2u, fence->GetCompletedValue());
+
+    CloseHandle(event);
+}
+
+TEST(NullStats, CountsCalls)
+{
+    auto factory = null::CreateFactory({});
+
+    null::ResetCallCounts();
+    factory->IsCurrent();
+    factory->IsCurrent();
+    EXPECT_EQ(2u, null::GetCallCount(null::Call::IsCurrent));
+}